@@ -16,6 +16,12 @@ namespace Basic {
 //              TCP/IP, Multicast and Broadcast.  Each handler manages a socket
 //              and can be used to send data, receive data, or both.
 //
+//              Packets can be sent and received one at a time, using sendData()
+//              and recvData(), or in batches, using sendPackets() and recvPackets().
+//              By default, the batched functions simply loop over sendData() and
+//              recvData(), but handlers can override them to move a whole batch
+//              with a single system call (e.g., see PosixHandler).
+//
 // Windows: using Winsock2.h; link with Ws2_32.lib
 //
 //------------------------------------------------------------------------------
@@ -54,6 +60,15 @@ public:
    // the actual number of bytes received.
    virtual unsigned int recvData(char* const packet, const int maxSize) =0;
 
+   // Sends 'n' packets, where packets[i] is 'sizes[i]' bytes; returns the
+   // number of packets that were sent.
+   virtual unsigned int sendPackets(const char* const packets[], const int sizes[], const unsigned int n);
+
+   // Receives up to 'n' packets, of a maximum of 'maxSize' bytes each, into
+   // packets[i] and sets 'sizes[i]' to the number of bytes received.  Returns
+   // the number of packets received, which stops at the first empty read.
+   virtual unsigned int recvPackets(char* const packets[], unsigned int sizes[], const int maxSize, const unsigned int n);
+
    // Set our socket for blocked (wait) I/O
    virtual bool setBlocked() =0;
 
@@ -0,0 +1,117 @@
+//------------------------------------------------------------------------------
+// Class: PhaseBarrier
+//------------------------------------------------------------------------------
+#ifndef __Eaagles_Basic_PhaseBarrier_H__
+#define __Eaagles_Basic_PhaseBarrier_H__
+
+#include "openeaagles/basic/Statistic.h"
+
+#include <atomic>
+
+namespace Eaagles {
+namespace Basic {
+
+//------------------------------------------------------------------------------
+// Class: PhaseBarrier
+//
+// Description: Reusable fork/join barrier between one parent thread and a
+//              fixed pool of worker threads (see ThreadSyncTask).
+//
+//    The parent starts a phase for all of the workers with a single call to
+//    release(), which increments the generation counter and wakes all of the
+//    waiting workers at once.  Each worker then calls arrive() when it has
+//    completed the phase, and the parent uses waitForCompleted() to wait for
+//    the last of the workers.
+//
+//    Waiting threads first spin for 'spin count' polls of the counter before
+//    blocking (Linux: futex; Windows: yielding), so short phases are handed
+//    off without any system calls.
+//
+//    The time from release() until each worker wakes up (i.e., the dispatch
+//    latency) is added to the worker's own statistic, so the workers don't
+//    contend for a lock when they wake up.  getDispatchLatencyStats() merges
+//    the workers' statistics, which can be used to tune the spin count.
+//
+// Usage:
+//    Parent, each phase:
+//       barrier->release();
+//       ... parent's share of the work ...
+//       barrier->waitForCompleted();
+//
+//    Workers, loop:
+//       gen = barrier->waitForRelease(gen, worker);
+//       ... worker's share of the work ...
+//       barrier->arrive();
+//
+//    A worker's first 'gen' must be the generation at the time that it was
+//    created -- getGeneration() -- which is called by the parent thread.
+//    Each worker has its own index, 'worker', from zero to getNumWorkers()-1.
+//
+// Notes:
+//    1) The number of workers can not be changed while a phase is active.
+//    2) Not an Object; can not be copied.
+//    3) The statistics are read and cleared by the parent thread between
+//    phases.  Only the first MAX_WORKERS workers' latencies are recorded.
+//------------------------------------------------------------------------------
+class PhaseBarrier {
+public:
+   static const unsigned int DEFAULT_SPIN_COUNT = 4000;
+   static const unsigned int MAX_WORKERS = 32;     // Max workers with latency statistics
+
+public:
+   PhaseBarrier(const unsigned int numWorkers, const unsigned int spinCount = DEFAULT_SPIN_COUNT);
+   ~PhaseBarrier();
+
+   unsigned int getNumWorkers() const              { return nWorkers; }
+   unsigned int getGeneration() const              { return generation.load(std::memory_order_acquire); }
+   unsigned int getSpinCount() const               { return spinCount; }
+
+   bool setNumWorkers(const unsigned int n);
+   bool setSpinCount(const unsigned int n);
+
+   // Parent thread
+   void release();                  // Starts the next phase; wakes all workers
+   void waitForCompleted();         // Waits for all workers to arrive()
+
+   // Worker threads
+   unsigned int waitForRelease(const unsigned int lastGen,   // Waits for a generation other than 'lastGen'; returns it
+      const unsigned int worker);
+   void arrive();                   // This worker has completed the phase
+
+   // Dispatch latency (seconds) from release() to worker wake up; all workers, or worker 'worker'
+   const Statistic& getDispatchLatencyStats() const;
+   const Statistic* getDispatchLatencyStats(const unsigned int worker) const;
+   void clearStats();
+
+private:
+   PhaseBarrier(const PhaseBarrier&);
+   PhaseBarrier& operator=(const PhaseBarrier&);
+
+   // Implementation dependent (see linux/PhaseBarrier.cxx & windows/PhaseBarrier.cxx)
+   static void waitOnValue(std::atomic<int>* const addr, const int value);
+   static void wakeAll(std::atomic<int>* const addr);
+   static void wakeOne(std::atomic<int>* const addr);
+   static void pause();
+
+   std::atomic<int> generation;     // Generation (phase) counter
+   char pad0[60];                   // Keeps the counters on separate cache lines
+   std::atomic<int> pending;        // Number of workers that have not arrived
+   char pad1[60];
+
+   unsigned int nWorkers;           // Number of workers
+   unsigned int spinCount;          // Number of polls before blocking
+   double releaseTime;              // Time of the last release() (sec)
+
+   // Each worker's dispatch latency statistics (sec)
+   struct Latency {
+      Statistic stats;
+      char pad[64];                 // Keeps the workers' statistics on separate cache lines
+   };
+   Latency latency[MAX_WORKERS];
+   mutable Statistic latencyStats;  // All of the workers' statistics (merged as needed)
+};
+
+} // End Basic namespace
+} // End Eaagles namespace
+
+#endif
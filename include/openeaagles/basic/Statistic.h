@@ -35,6 +35,9 @@ namespace Basic {
 //    sigma(const float* const values, int size)
 //       Adds an array of 'size' data points to the statistic
 //
+//    sigma(const Statistic& stat)
+//       Adds all of the data points of statistic 'stat' to the statistic
+//
 //    int getN() const
 //       Returns the number of data points that have been added to the statistic
 //
@@ -72,6 +75,7 @@ public:
    void sigma(const double value);                                   // Adds a data point
    void sigma(const double* const values, const unsigned int size);  // Adds an array of data points
    void sigma(const float* const values, const unsigned int size);   // Adds an array of data points
+   void sigma(const Statistic& stat);                                // Adds the data points of another statistic
 
    unsigned long getN() const  { return n; }        // Returns the number of data points
    double mean() const;                             // Returns the mean of the data
@@ -143,6 +147,20 @@ inline void Statistic::sigma(const float* const values, const unsigned int size)
    }
 }
 
+// adds the data points of another statistic
+inline void Statistic::sigma(const Statistic& stat)
+{
+   if (stat.n > 0) {
+      value1 = stat.value1;
+      if (stat.maximum > maximum) maximum = stat.maximum;
+      if (stat.minimum < minimum) minimum = stat.minimum;
+      sum = sum + stat.sum;
+      absSum = absSum + stat.absSum;
+      sumSq = sumSq + stat.sumSq;
+      n = n + stat.n;
+   }
+}
+
 // returns the mean of the data points
 inline double Statistic::mean() const
 {
@@ -10,7 +10,9 @@ namespace Eaagles {
 
 namespace Basic {
 
+class Distance;
 class Hsva;
+class Number;
 class String;
 
 //------------------------------------------------------------------------------
@@ -22,8 +24,28 @@ class String;
 //              various database formats (e.g., DTED, DED, SRTM).
 //
 // Slots:
-//    file  <String>   ! Data file name (default: 0)
-//    path  <String>   ! Data path name (default: 0)
+//    file              <String>    ! Data file name (default: 0)
+//    path              <String>    ! Data path name (default: 0)
+//    losCacheSize      <Number>    ! Number of entries in the LOS result cache (zero to disable)
+//                                  ! (default: 0)
+//    losCacheThreshold <Distance>  ! Distance that the ref or target points can move before a
+//                                  ! cached LOS result is no longer used (default: 10 meters)
+//    losCacheMaxAge    <Number>    ! Number of frames (see updateData()) that a cached LOS
+//                                  ! result is used (default: 1)
+//
+// LOS result cache:
+//    When enabled, the results of targetOcculting() are saved in a small,
+//    direct mapped cache keyed on the ref and target positions.  Later calls,
+//    from any thread, whose ref and target points are each within
+//    'losCacheThreshold' of a cached pair and whose result was computed
+//    within the last 'losCacheMaxAge' frames reuse the cached result.  The
+//    frame counter is advanced by updateData(), which is called once per
+//    background frame by the Simulation.  Results from targetOcculting2()
+//    are not cached.
+//
+//    The actual LOS checks are done by computeOcculting() and
+//    computeOcculting2(), which derived classes can override to use faster,
+//    database specific methods (e.g., DataFile's max elevation pyramid).
 //
 // Notes:
 //    1) the first point [0] of all arrays is at the reference point
@@ -75,6 +97,18 @@ public:
          const bool interp = false     // Interpolate between elevation posts (default: false)
       ) const = 0;
 
+   // Locates the elevations of an array of 'n' points (and sets the valid flags
+   // of the points found).  Points whose valid flags are already set are skipped.
+   // Returns the number of points found within this database.
+   virtual unsigned int getPointElevations(
+         LCreal* const elevations,     // The elevation array (meters)
+         bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+         const double* const lats,     // Latitude array (degs)
+         const double* const lons,     // Longitude array (degs)
+         const unsigned int n,         // Size of the arrays
+         const bool interp = false     // Interpolate between elevation posts (default: false)
+      ) const;
+
    // Returns true if a target point is occulted by the terrain as seen from the ref point
    virtual bool targetOcculting(
          const double refLat,          // Ref latitude (degs)
@@ -96,6 +130,37 @@ public:
       const double tanLookAng          // Tangent of the look angle
    ) const;
 
+   // Same as targetOcculting(), but without the LOS result cache
+   virtual bool computeOcculting(
+         const double refLat,          // Ref latitude (degs)
+         const double refLon,          // Ref longitude (degs)
+         const LCreal refAlt,          // Ref altitude (meters)
+         const double tgtLat,          // Target latitude (degs)
+         const double tgtLon,          // Target longitude (degs)
+         const LCreal tgtAlt           // Target altitude (meters)
+      ) const;
+
+   // Same as targetOcculting2()
+   virtual bool computeOcculting2(
+      const double refLat,             // Ref latitude (degs)
+      const double refLon,             // Ref longitude (degs)
+      const double refAlt,             // Ref altitude (meters)
+      const double truBrg,             // True direction angle from north to look (degs)
+      const double dist,               // Distance to check (meters)
+      const double tanLookAng          // Tangent of the look angle
+   ) const;
+
+   // LOS result cache
+   unsigned int getLosCacheSize() const      { return losCacheSize; }       // Number of entries (zero if disabled)
+   double getLosCacheThreshold() const       { return losCacheThreshold; }  // Movement threshold (meters)
+   unsigned int getLosCacheMaxAge() const    { return losCacheMaxAge; }     // Max age (frames)
+   unsigned int getLosCacheHits() const      { return losCacheHits; }       // Number of cache hits
+   unsigned int getLosCacheMisses() const    { return losCacheMisses; }     // Number of cache misses
+   virtual bool setLosCacheSize(const unsigned int n);     // Sets the number of entries (zero to disable)
+   virtual bool setLosCacheThreshold(const double meters); // Sets the movement threshold (meters)
+   virtual bool setLosCacheMaxAge(const unsigned int n);   // Sets the max age (frames)
+   virtual void clearLosCache();                           // Clears the cached results and the hit/miss counters
+
    // Returns true if the target at the altitude 'tgtAlt' and range 'range' is
    // occulted by the elevation points as seen from the reference altitude, 'refAlt'.
    static bool occultCheck(
@@ -176,9 +241,17 @@ public:
       const unsigned int numColors,     // Number of colors
       osg::Vec3& rgb);                  // Color
 
+   void updateData(const LCreal dt = 0.0) override;
    void reset() override;
 
 protected:
+   // 1200 points gives us 100 meter data up to a distance
+   // of one degree at the equator
+   static const unsigned int MAX_LOS_POINTS = 1200;
+
+   // Number of elevation points used to check occulting over 'dist' meters
+   static unsigned int getNumLosPoints(const double dist);
+
    virtual void clearData();                       // Clear the data arrays
 
    virtual bool setMinElevation(const LCreal v);   // Minimum elevation in this database (meters)
@@ -188,15 +261,43 @@ protected:
    virtual bool setLatitudeNE(const double v);     // Northeast corner latitude of this database (degs: +/-90)
    virtual bool setLongitudeNE(const double v);    // Northeast corner longitude of this database (degs: +/-180)
 
+   // Slot functions
+   virtual bool setSlotLosCacheSize(const Number* const msg);
+   virtual bool setSlotLosCacheThreshold(const Distance* const msg);
+   virtual bool setSlotLosCacheMaxAge(const Number* const msg);
+
 private:
+   // LOS cache entry
+   struct LosEntry {
+      double refLat, refLon, refAlt;      // Ref point (degs, degs, meters)
+      double tgtLat, tgtLon, tgtAlt;      // Target point (degs, degs, meters)
+      unsigned int frame;                 // Frame that the result was computed
+      bool valid;                         // Entry is valid
+      bool occulted;                      // Cached result
+   };
+
    virtual bool loadData() =0;      // Load the data file
 
+   bool findLosEntry(bool* const occulted, const double refLat, const double refLon, const double refAlt,
+                     const double tgtLat, const double tgtLon, const double tgtAlt, const unsigned int idx) const;
+   unsigned int losEntryIndex(const double refLat, const double refLon, const double refAlt,
+                              const double tgtLat, const double tgtLon, const double tgtAlt) const;
+
    const String* path;              // Data path name
    const String* file;              // Data file name
    double neLat, neLon;             // Northeast lat/lon (degs)
    double swLat, swLon;             // Southwest lat/lon (degs)
    LCreal   minElev;                // Minimum elevation (m)
    LCreal   maxElev;                // Maximum elevation (m)
+
+   mutable LosEntry* losCache;      // LOS result cache
+   unsigned int losCacheSize;       // Number of cache entries (power of two, or zero if disabled)
+   double losCacheThreshold;        // Movement threshold (meters)
+   unsigned int losCacheMaxAge;     // Max age (frames)
+   unsigned int losFrame;           // Frame counter
+   mutable unsigned int losCacheHits;     // Number of cache hits
+   mutable unsigned int losCacheMisses;   // Number of cache misses
+   mutable long losCacheLock;       // Semaphore to protect the LOS cache
 };
 
 
@@ -28,6 +28,7 @@
 namespace Eaagles {
 namespace Basic {
    class Component;
+   class PhaseBarrier;
 
 //------------------------------------------------------------------------------
 // Class:  Thread
@@ -227,12 +228,22 @@ private:
 //    'completed' signal, or use the static function waitForAllCompleted() to
 //    wait for several sync task threads.  Loop will end with the shutdown of
 //    the parent.
+//
+//    Pools of sync task threads can instead share a PhaseBarrier (see
+//    PhaseBarrier.h), which is passed to the constructor with the thread's
+//    worker index (zero to the number of threads minus one).  The parent then
+//    starts all of the pool's threads with one barrier->release() and waits
+//    for them with barrier->waitForCompleted(); signalStart() and the
+//    waitFor*Completed() functions are not used with a barrier.
 //------------------------------------------------------------------------------
 class ThreadSyncTask : public Thread {
    DECLARE_SUBCLASS(ThreadSyncTask,Thread)
 
 public:
    ThreadSyncTask(Component* const parent, const LCreal priority);
+   ThreadSyncTask(Component* const parent, const LCreal priority, PhaseBarrier* const barrier, const unsigned int worker);
+
+   PhaseBarrier* getBarrier();                     // Shared phase barrier (or zero)
 
    void signalStart();
    void waitForCompleted();
@@ -263,6 +274,10 @@ private:
    // Implementation dependent
    void* startSig;      // Start signal
    void* completedSig;  // completed signal
+
+   PhaseBarrier* barrier;     // Shared phase barrier (not owned)
+   unsigned int barrierGen;   // Last barrier generation that we've processed
+   unsigned int barrierWorker; // Our worker index in the barrier's pool
 };
 
 } // End Basic namespace
@@ -0,0 +1,107 @@
+//------------------------------------------------------------------------------
+// Class: WorkStealingExecutor
+//------------------------------------------------------------------------------
+#ifndef __Eaagles_Basic_WorkStealingExecutor_H__
+#define __Eaagles_Basic_WorkStealingExecutor_H__
+
+#include "openeaagles/basic/Statistic.h"
+
+#include <atomic>
+
+namespace Eaagles {
+namespace Basic {
+
+//------------------------------------------------------------------------------
+// Class: WorkStealingExecutor
+//
+// Description: Distributes the items [ 0 .. n-1 ] of a contiguous array across
+//              a fixed set of workers (e.g., a pool of ThreadSyncTask threads
+//              plus the parent thread) using chunked work stealing.
+//
+//    Each pass, the items are partitioned into one contiguous range per worker.
+//    Workers claim chunks from the front of their own range and, once their
+//    range is empty, steal chunks from the front of the other workers' ranges.
+//    All claims are a single atomic fetch-and-add, so one expensive item no
+//    longer stalls the workers that were assigned its neighbors.
+//
+//    The busy time (beginWork() to endWork()) and idle time (the remainder of
+//    the pass, which is set by the slowest worker) of each worker are added
+//    to statistics at the end of each pass.
+//
+// Usage, per pass:
+//    1) The parent thread calls beginPass(n) before signaling its workers.
+//    2) Each worker, including the parent, calls ...
+//          beginWork(w);
+//          while (nextChunk(w, &b, &e)) { for (i = b; i < e; i++) ...item i... }
+//          endWork(w);
+//    3) After all workers have completed, the parent calls endPass().
+//
+//    Worker indexes are zero based: [ 0 .. getNumWorkers()-1 ]
+//
+// Notes:
+//    1) A chunk size of zero (default) selects a chunk size that splits
+//       each worker's range into about CHUNKS_PER_WORKER chunks.
+//    2) Not an Object; can not be copied.
+//------------------------------------------------------------------------------
+class WorkStealingExecutor {
+public:
+   static const unsigned int MAX_WORKERS = 32;
+   static const unsigned int CHUNKS_PER_WORKER = 8;
+
+public:
+   WorkStealingExecutor(const unsigned int numWorkers);
+   ~WorkStealingExecutor();
+
+   unsigned int getNumWorkers() const                 { return nWorkers; }
+   unsigned int getNumItems() const                   { return nItems; }
+   unsigned int getChunkSize() const                  { return chunkSize; }
+   bool setChunkSize(const unsigned int n);           // Zero for automatic
+
+   // Parent thread: starts (and ends) a pass over 'numItems' items
+   void beginPass(const unsigned int numItems);
+   void endPass();
+
+   // Workers: claim the next chunk [ *begin .. *end ), stealing if required;
+   // returns false when all items have been claimed.
+   bool nextChunk(const unsigned int worker, unsigned int* const begin, unsigned int* const end);
+
+   // Workers: mark the start and end of their work for this pass
+   void beginWork(const unsigned int worker);
+   void endWork(const unsigned int worker);
+
+   // Per-worker statistics (seconds per pass) and steal counts
+   const Statistic* getBusyTimeStats(const unsigned int worker) const;
+   const Statistic* getIdleTimeStats(const unsigned int worker) const;
+   unsigned long getNumSteals(const unsigned int worker) const;
+   void clearStats();
+
+private:
+   // Each worker's range and timing; padded to avoid false sharing
+   struct Worker {
+      std::atomic<unsigned int> next;  // Next unclaimed item in our range
+      unsigned int end;                // End of our range
+      double t0;                       // Start of work (sec)
+      double t1;                       // End of work (sec)
+      unsigned long steals;            // Number of chunks stolen by this worker
+      char pad[64];                    // Keeps neighbors off of our cache line
+   };
+
+   WorkStealingExecutor(const WorkStealingExecutor&);
+   WorkStealingExecutor& operator=(const WorkStealingExecutor&);
+
+   bool claim(Worker* const wp, unsigned int* const begin, unsigned int* const end);
+
+   Worker workers[MAX_WORKERS];
+   Statistic busyStats[MAX_WORKERS];
+   Statistic idleStats[MAX_WORKERS];
+   unsigned int nWorkers;     // Number of workers
+   unsigned int nItems;       // Number of items in this pass
+   unsigned int chunkSize;    // Requested chunk size (or zero for automatic)
+   unsigned int passChunk;    // Chunk size used for this pass
+   double passT0;             // Start time of this pass (sec)
+};
+
+} // End Basic namespace
+} // End Eaagles namespace
+
+#endif
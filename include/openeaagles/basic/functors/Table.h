@@ -25,6 +25,7 @@ class Number;
 // Slots:
 //    data        <List>      ! Dependant variable data. (default: 0)
 //    extrapolate <Boolean>   ! Extrapolate beyond the given data table limits (default: 0)
+//    float32     <Boolean>   ! Interpolate from a single precision copy of the data (default: 0)
 //
 // Notes:
 //    1) The isValid() function will return true only if all of the required
@@ -39,6 +40,19 @@ class Number;
 //       result is clamped at the last known dependent value.  If the extrapolate
 //       flag is true, we'll extrapolate beyond the given data table.
 //
+//    4) The breakpoint tables are compiled when they're loaded: each one is
+//       checked for monotone and uniformly spaced breakpoints (see lfi::Axis),
+//       so the lfi() functions, when they're not given an FStorage object,
+//       index uniform breakpoints directly and binary search the others.  The
+//       results are the same as the static lfi::lfi_ND() functions.
+//
+//    5) With the 'float32' flag, a single precision copy of the data table is
+//       interpolated, which halves the table's cache footprint; the breakpoint
+//       search, the extrapolation and the arithmetic are unchanged, so the
+//       results differ only by the rounding of the data to float.  The FStorage
+//       object isn't used in this mode, and getDataTable() still returns the
+//       full precision data.
+//
 // Exceptions:
 //      ExpInvalidTable
 //          Thrown by Table derived classes' lfi(), minX(), maxX(), minY(),
@@ -63,6 +77,10 @@ public:
    // Returns a pointer to the dependent variable data table.
    const LCreal* getDataTable() const                            { return dtable; }
 
+   // Returns a pointer to the single precision copy of the data table, or zero
+   // if the 'float32' flag isn't set.
+   const float* getFloatTable() const                            { return ftable; }
+
    // Returns the number of entries in the data table
    virtual unsigned int tableSize() const = 0;
    virtual bool setDataTable(const List* const msg);
@@ -77,6 +95,13 @@ public:
    bool setExtrapolationEnabled(const bool flg);
    virtual bool setExtrapolationEnabled(const Number* const msg);
 
+   // Returns true if the single precision data table is interpolated.
+   bool isFloat32Enabled() const                                 { return f32Flg; }
+
+   // Sets the single precision data table enabled flag.
+   bool setFloat32Enabled(const bool flg);
+   virtual bool setFloat32Enabled(const Number* const msg);
+
    // Data storage factory (pre-ref()'d)
    virtual FStorage* storageFactory() const;
 
@@ -112,9 +137,13 @@ protected:
    bool    valid;     // Table is valid
 
 private:
+   void updateFloatTable();
+
    LCreal* dtable;    // Data Table
    unsigned int nd;   // Number of data points
    bool    extFlg;    // Extrapolation enabled flag
+   float*  ftable;    // Single precision copy of the data table (float32 only)
+   bool    f32Flg;    // Single precision data table enabled flag
 };
 
 //==============================================================================
@@ -7,6 +7,7 @@
 #include "openeaagles/basic/Object.h"
 #include "openeaagles/basic/functors/Functions.h"
 #include "openeaagles/basic/functors/Table.h"
+#include "openeaagles/basic/util/lfi.h"
 
 namespace Eaagles {
 namespace Basic {
@@ -22,6 +23,14 @@ class Number;
 // Factory name: Table1
 // Slots:
 //    x    <List>  Independent variable #1 (iv1) points
+//
+// Note:
+//    1) Each table class has an array lfi() for its own number of independent
+//       variables, which interpolates 'n' points (iv1[i], iv2[i], ...) into
+//       out[i].  The results are the same as the single point lfi(), and the
+//       breakpoints are found by checking the previous point's breakpoints
+//       first, then by the compiled breakpoint tables (see Table.h), and
+//       there's one call for all of the points.
 //==============================================================================
 class Table1 : public Table {
     DECLARE_SUBCLASS(Table1, Table)
@@ -43,6 +52,9 @@ public:
    // 1D Linear Function Interpolator: returns the result of f(x) using linear interpolation
    virtual LCreal lfi(const LCreal iv1, FStorage* const s = nullptr) const;
 
+   // 1D Linear Function Interpolator for 'n' points: out[i] = f(iv1[i])
+   void lfi(const LCreal* const iv1, LCreal* const out, const unsigned int n) const;
+
    // Load the X (iv1) breakpoints
    virtual bool setXBreakpoints1(const List* const bkpts);
 
@@ -54,9 +66,13 @@ protected:
    bool loadData(const List& list, LCreal* const table) override;
    void printData(std::ostream& sout, const LCreal* table, const unsigned int indent) const override;
 
+   // Compiled X breakpoint table
+   const lfi::Axis& getXAxis() const { return xaxis; }
+
 private:
    LCreal* xtable;    // X Breakpoint Table
    unsigned int nx;   // Number of x breakpoints
+   lfi::Axis xaxis;   // Compiled X breakpoint table
 };
 
 
@@ -91,6 +107,9 @@ public:
    // 2D Linear Function Interpolator: returns the result of f(x,y) using linear interpolation
    virtual LCreal lfi(const LCreal iv1, const LCreal iv2, FStorage* const s = nullptr) const;
 
+   // 2D Linear Function Interpolator for 'n' points: out[i] = f(iv1[i], iv2[i])
+   void lfi(const LCreal* const iv1, const LCreal* const iv2, LCreal* const out, const unsigned int n) const;
+
    // Load the Y (iv2) breakpoints
    virtual bool setYBreakpoints2(const List* const bkpts);
 
@@ -103,9 +122,13 @@ protected:
    bool loadData(const List& list, LCreal* const table) override;
    void printData(std::ostream& sout, const LCreal* table, const unsigned int indent) const override;
 
+   // Compiled Y breakpoint table
+   const lfi::Axis& getYAxis() const { return yaxis; }
+
 private:
    LCreal* ytable;    // Y Breakpoint Table
    unsigned int ny;   // Number of y breakpoints
+   lfi::Axis yaxis;   // Compiled Y breakpoint table
 };
 
 
@@ -141,6 +164,10 @@ public:
    // 3D Linear Function Interpolator: returns the result of f(x,y,z) using linear interpolation
    virtual LCreal lfi(const LCreal iv1, const LCreal iv2, const LCreal iv3, FStorage* const s = nullptr) const;
 
+   // 3D Linear Function Interpolator for 'n' points: out[i] = f(iv1[i], iv2[i], iv3[i])
+   void lfi(const LCreal* const iv1, const LCreal* const iv2, const LCreal* const iv3,
+            LCreal* const out, const unsigned int n) const;
+
    // Loads the Z (iv3) breakpoints
    virtual bool setZBreakpoints3(const List* const bkpts);
 
@@ -154,9 +181,13 @@ protected:
    bool loadData(const List& list, LCreal* const table) override;
    void printData(std::ostream& sout, const LCreal* table, const unsigned int indent) const override;
 
+   // Compiled Z breakpoint table
+   const lfi::Axis& getZAxis() const { return zaxis; }
+
 private:
    LCreal* ztable;    // Z Breakpoint Table
    unsigned int nz;   // Number of z breakpoints
+   lfi::Axis zaxis;   // Compiled Z breakpoint table
 };
 
 
@@ -193,6 +224,10 @@ public:
    // 4D Linear Function Interpolator: returns the result of f(x,y,z,w) using linear interpolation
    virtual LCreal lfi(const LCreal iv1, const LCreal iv2, const LCreal iv3, const LCreal iv4, FStorage* const s = nullptr) const;
 
+   // 4D Linear Function Interpolator for 'n' points: out[i] = f(iv1[i], iv2[i], iv3[i], iv4[i])
+   void lfi(const LCreal* const iv1, const LCreal* const iv2, const LCreal* const iv3, const LCreal* const iv4,
+            LCreal* const out, const unsigned int n) const;
+
    // Loads the W (iv4) breakpoints
    virtual bool setWBreakpoints4(const List* const bkpts);
 
@@ -207,9 +242,13 @@ protected:
    bool loadData(const List& list, LCreal* const table) override;
    void printData(std::ostream& sout, const LCreal* table, const unsigned int indent) const override;
 
+   // Compiled W breakpoint table
+   const lfi::Axis& getWAxis() const { return waxis; }
+
 private:
    LCreal* wtable;    // W Breakpoint Table
    unsigned int nw;   // Number of w breakpoints
+   lfi::Axis waxis;   // Compiled W breakpoint table
 };
 
 //==============================================================================
@@ -245,6 +284,10 @@ public:
 
    virtual LCreal lfi(const LCreal iv1, const LCreal iv2, const LCreal iv3, const LCreal iv4, const LCreal iv5, FStorage* const s = nullptr) const;
 
+   // 5D Linear Function Interpolator for 'n' points: out[i] = f(iv1[i], iv2[i], iv3[i], iv4[i], iv5[i])
+   void lfi(const LCreal* const iv1, const LCreal* const iv2, const LCreal* const iv3, const LCreal* const iv4,
+            const LCreal* const iv5, LCreal* const out, const unsigned int n) const;
+
    // Loads the V (iv5) breakpoints
    virtual bool setVBreakpoints5(const List* const bkpts);
 
@@ -260,9 +303,13 @@ protected:
    bool loadData(const List& list, LCreal* const table) override;
    void printData(std::ostream& sout, const LCreal* table, const unsigned int indent) const override;
 
+   // Compiled V breakpoint table
+   const lfi::Axis& getVAxis() const  { return vaxis; }
+
 private:
    LCreal* vtable;     // V Breakpoint Table
    unsigned int nv;    // Number of v breakpoints
+   lfi::Axis vaxis;    // Compiled V breakpoint table
 };
 
 } // End Basic namespace
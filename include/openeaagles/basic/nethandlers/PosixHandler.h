@@ -21,6 +21,11 @@ class String;
 //
 // Windows: using Winsock2.h; link with Ws2_32.lib
 //
+// Linux: sendPackets() and recvPackets() use sendmmsg() and recvmmsg() to
+//        move up to MAX_BATCH packets per system call, so the UDP unicast,
+//        broadcast and multicast handlers all send and receive in batches.
+//        On other systems, the packets are sent and received one at a time.
+//
 // Slots:
 //    localIpAddress    ! String containing the local host's name or its IP
 //                      ! address in the Internet standard "." (dotted) notation.
@@ -62,6 +67,9 @@ class PosixHandler : public NetHandler
 {
    DECLARE_SUBCLASS(PosixHandler, NetHandler)
 
+public:
+   static const unsigned int MAX_BATCH = 64;    // Max packets per sendmmsg()/recvmmsg() call
+
 public:
    PosixHandler();
 
@@ -80,10 +88,12 @@ public:
    bool closeConnection() override;
    bool sendData(const char* const packet, const int size) override;
    unsigned int recvData(char* const packet, const int maxSize) override;
+   unsigned int sendPackets(const char* const packets[], const int sizes[], const unsigned int n) override;
+   unsigned int recvPackets(char* const packets[], unsigned int sizes[], const int maxSize, const unsigned int n) override;
    bool setBlocked() override;
    bool setNoWait() override;
 
-   // Last recvData() origin IP and port
+   // Last recvData() (or last packet of recvPackets()) origin IP and port
    uint32_t getLastFromAddr() const;     // IP address of last valid recvData()
    uint16_t getLastFromPort() const;     // Port address of last valid recvData()
 
@@ -27,6 +27,8 @@ public:
 
    bool sendData(const char* const packet, const int size) override;
    unsigned int recvData(char* const packet, const int maxSize) override;
+   unsigned int sendPackets(const char* const packets[], const int sizes[], const unsigned int n) override;
+   unsigned int recvPackets(char* const packets[], unsigned int sizes[], const int maxSize, const unsigned int n) override;
    bool isConnected() const override;
    bool closeConnection() override;
 
@@ -426,6 +426,30 @@ void postMultVec3Array(
       const unsigned int n
    );
 
+// Post-multiply 'n' 3D vectors, which are stored as separate x, y and z
+// arrays (structure-of-arrays), with a 4x4 matrix; the results may
+// overwrite the original vectors.
+void postMultVec3Array(
+      const double* const x,
+      const double* const y,
+      const double* const z,
+      const osg::Matrixd& matrix,
+      double* const rx,
+      double* const ry,
+      double* const rz,
+      const unsigned int n
+   );
+
+// Normalizes, in place, 'n' 3D vectors, which are stored as separate x, y
+// and z arrays, and returns their lengths; zero length vectors are unchanged.
+void normalizeVec3Array(
+      double* const x,
+      double* const y,
+      double* const z,
+      double* const lengths,
+      const unsigned int n
+   );
+
 // Returns the sine and cosine of an angle (radians)
 void lcSinCos(const LCreal angleRad, LCreal* const sine, LCreal* const cosine);
 void sinCos(const double angleRad, double* const sine, double* const cosine);
@@ -446,6 +470,12 @@ void lcSinCosArray(const LCreal* const anglesRad, LCreal* const sines, LCreal* c
 void sinCosArray(const double* const anglesRad, double* const sines, double* const cosines, const unsigned int n);
 void sinCosArray(const float*  const anglesRad, float*  const sines, float*  const cosines, const unsigned int n);
 
+// Note: when EAAGLES_CONFIG_SIMD is set and the target supports SSE2, the
+// double precision versions of the following acos, atan2 and sqrt array
+// functions, and of the structure-of-arrays Vec3 functions above, process
+// two values at a time.  The square roots and vectors are identical to the
+// scalar versions; the arc-cosines and arc-tangents are within a few ULPs.
+
 // Computes the arc-cosines of an array of 'n' angles (radians)
 void lcAcosArray(const LCreal* const anglesRad, LCreal* const acosines, const int n);
 void acosArray(const double* const anglesRad, double* const acosines, const unsigned int n);
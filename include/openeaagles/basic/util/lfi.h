@@ -113,6 +113,50 @@ LCreal lfi_5D(const LCreal x, const LCreal y, const LCreal z, const LCreal w, co
          unsigned int* const vbp=nullptr
       );
 
+//==============================================================================
+// Breakpoint search for the batch interpolators (e.g., the Table classes'
+// array lfi() functions)
+//==============================================================================
+
+// ---
+// Breakpoint table of an independent variable; set by initAxis()
+// ---
+struct Axis {
+   const LCreal* data;     // Breakpoints
+   unsigned int n;         // Number of breakpoints
+   unsigned int low;       // Index of the 'low' end breakpoint
+   unsigned int high;      // Index of the 'high' end breakpoint
+   int delta;              // Index step from 'low' toward 'high' (1 or -1)
+   bool monotone;          // Breakpoints never step back (from 'low' toward 'high')
+   bool uniform;           // Breakpoints are uniformly spaced
+   LCreal scale;           // Breakpoint intervals per unit of the variable (uniform only)
+};
+
+// ---
+// Breakpoints and interpolation fraction of an independent variable
+// ---
+struct Bracket {
+   unsigned int i1;        // First breakpoint
+   unsigned int i2;        // Second breakpoint
+   LCreal m;               // Fraction from i1 to i2
+};
+
+// ---
+// Sets up 'axis' for the 'n' breakpoints in 'data'
+// ---
+void initAxis(Axis* const axis, const LCreal* const data, const unsigned int n);
+
+// ---
+// Finds the breakpoints and fraction of 'x' the same way as lfi_1D(), which
+// interpolates m * (a[i2] - a[i1]) + a[i1].  If 'x' is clamped to an end point
+// then both breakpoints are the end point and the fraction is zero.  The
+// search starts with the previous bracket in 'b' (initialize it to zeros);
+// then uniform breakpoints are indexed directly and others are searched with
+// a binary search.  Breakpoints that aren't monotone are searched linearly,
+// exactly as lfi_1D() does.
+// ---
+void findBracket(Bracket* const b, const LCreal x, const Axis& axis, const bool eFlg=false);
+
 }
 }
 }
@@ -60,4 +60,10 @@
 #define EAAGLES_CONFIG_MAX_NETIO_NEW_OUTGOING   150
 #endif
 
+// Use the SSE2 versions of the double precision array functions, when
+// supported by the target (see support.h); zero for the scalar versions
+#ifndef EAAGLES_CONFIG_SIMD
+#define EAAGLES_CONFIG_SIMD                     1
+#endif
+
 #endif
@@ -19,6 +19,10 @@ namespace Dis {
    class Nib;
    class Ntm;
    class EmissionPduHandler;
+   class RegionOfInterest;
+   class EmissionPduView;
+   class EntityStatePduView;
+   class PduView;
 
    struct EeFundamentalParameterData;
    struct EmitterBeamData;
@@ -84,6 +88,16 @@ namespace Dis {
 //
 //    EmissionPduHandlers <Basic::PairStream> ! List of Electromagnetic-Emission PDU handlers
 //
+//    maxBundleSize  <Basic::Number>      ! Max size (bytes) of a datagram of bundled output PDUs, or
+//                                        ! zero to send one PDU per datagram (default: 0) (see note #8)
+//
+//    regionsOfInterest <Basic::PairStream> ! List of regions of interest for our output entities (see note #10)
+//                   <RegionOfInterest>   ! A single region of interest (default: none -- no interest management)
+//
+//    heartbeatTime  <Basic::Time>        ! Max DR time of our output entities that are outside of all
+//                                        ! of the regions of interest (default: 10 seconds) (see note #10)
+//                   <Basic::PairStream>  ! List of heartbeat times by kinds and domains (see note #4)
+//
 //
 // Notes:
 //    1) NetIO creates its own federate name based on the site and application numbers
@@ -95,7 +109,9 @@ namespace Dis {
 //    3) findDisNib() searches the same input and output lists that are maintained by
 //       NetIO, which are in order of player ID and the federate name.  Since our DIS
 //       federate names are generated by site and app IDs, the lists are seen by DIS as
-//       being order by player ID, site ID and app ID.
+//       being order by player ID, site ID and app ID.  The NIB hash index is keyed
+//       by makeNibKey() of the player, site and app IDs, so findDisNib() is a single
+//       hash lookup, without making a federate name.
 //
 //    4) For the slots maxTimeDR, maxPositionError, maxOrientationError, maxAge and
 //       maxEntityRange, if the slot type is Basic::Time, Basic::Angle or Basic::Distance then that
@@ -117,6 +133,40 @@ namespace Dis {
 //       type id.  For incoming emission PDUs, the "emitter name" from the PDU
 //       is matched with the EmissionPduHandler's "emitterName" value.
 //
+//    7) The network is read in batches of up to MAX_PDUs PDUs using the input
+//       handler's recvPackets().  During outputFrame(), the PDUs passed to
+//       sendData() are queued and sent in batches of up to MAX_OUTPUT_PDUs PDUs
+//       using the output handler's sendPackets(); the queue is flushed when it's
+//       full and at the end of the frame.  PDUs sent outside of outputFrame()
+//       are sent right away.  There are two output queues: a flush swaps them
+//       and sends the full one without holding the queue's lock, so other
+//       threads can keep queuing PDUs while the batch is being sent.
+//
+//    8) PDU bundling (IEEE 1278.1): when 'maxBundleSize' is set (e.g., to the
+//       path's MTU less the IP and UDP headers), the PDUs that are queued during
+//       outputFrame() are packed, back to back, into datagrams of up to
+//       'maxBundleSize' bytes.  Received datagrams are always split into their
+//       PDUs using the length field of each PDU header, so bundled and unbundled
+//       input are both accepted.
+//
+//    9) Received PDUs are filtered before they're byte swapped: the exercise ID
+//       and the originating entity's site and application IDs are read directly
+//       from the network ordered bytes using the zero-copy views (see views.h).
+//       Entity State and Electromagnetic Emission PDUs are passed to the
+//       filterEntityStatePDU() and filterElectromagneticEmissionPDU() functions,
+//       which can also reject the PDUs that their process*PDU() functions would
+//       just ignore.  Only the PDUs that pass are copied (if not aligned), byte
+//       swapped and passed to their process*PDU() functions.
+//
+//   10) Interest management: each NetIO is one destination (e.g., one multicast
+//       group), and its 'regionsOfInterest' are where its receivers need full
+//       fidelity entity state.  Our output entities that are inside any of the
+//       regions are dead reckoned as usual.  Those outside all of the regions
+//       are only sent at their 'heartbeatTime' rate; their position and
+//       orientation thresholds are ignored.  The heartbeat time must be less
+//       than the receivers' 'maxAge' or they'll time the entities out.  With
+//       no regions of interest, all output entities are 'inside'.
+//
 //==============================================================================
 class NetIO : public Simulation::NetIO
 {
@@ -231,9 +281,15 @@ public:
    unsigned short getApplicationID() const                 { return appID;      }
    unsigned char getExerciseID() const                     { return exerciseID; }
 
-   // Sends a packet (PDU) to the network
+   // Max size of a datagram of bundled PDUs (bytes), or zero if not bundling
+   unsigned int getMaxBundleSize() const                   { return maxBundleSize; }
+
+   // Sends a packet (PDU) to the network (queued during outputFrame(); see note #7)
    bool sendData(const char* const packet, const int size);
 
+   // Sends the queued output PDUs
+   bool flushOutput();
+
    // Receives a packet (PDU) from the network
    int recvData(char* const packet, const int maxSize);
 
@@ -244,6 +300,10 @@ public:
    unsigned char getVersion() const               { return version; }         // Returns the current version number
    virtual bool setVersion(const unsigned char v);                            // Sets the operating version number
 
+   // Regions of interest (see note #10)
+   unsigned int getNumRegionsOfInterest() const            { return nRegions; }
+   virtual bool isInRegionsOfInterest(const Simulation::Player* const p) const; // True if 'p' is inside, or if there are no regions
+
    // Emission PDU handler
    const EmissionPduHandler* findEmissionPduHandler(const Simulation::RfSensor* const);
    const EmissionPduHandler* findEmissionPduHandler(const EmissionSystem* const);
@@ -267,6 +327,9 @@ public:
    // Finds the Nib for 'ioType' by player, site and app IDs
    virtual Nib* findDisNib(const unsigned short playerId, const unsigned short siteId, const unsigned short appId, const IoType ioType);
 
+   // Packed NIB key of the player, site and app IDs (see findNibByKey())
+   static unsigned long long makeNibKey(const unsigned short playerId, const unsigned short siteId, const unsigned short appId);
+
    // Finds the Ntm by DIS entity type codes
    virtual const Ntm* findNtmByTypeCodes(
          const unsigned char  kind,
@@ -284,6 +347,7 @@ public:
    LCreal getMaxPositionErr(const Simulation::Nib* const nib) const override;
    LCreal getMaxOrientationErr(const Simulation::Nib* const nib) const override;
    LCreal getMaxAge(const Simulation::Nib* const nib) const override;
+   virtual LCreal getHeartbeatTime(const Simulation::Nib* const nib) const;
    Simulation::Nib* createNewOutputNib(Simulation::Player* const player) override;
 
    // DIS v7 additions
@@ -299,6 +363,11 @@ public:
    virtual LCreal getEePwThrsh() const;
 
 protected:
+   // Received PDU filters; called with a view of the PDU, which is still in
+   // network byte order, and return true if the PDU is to be processed (see note #9)
+   virtual bool filterEntityStatePDU(const EntityStatePduView& view);
+   virtual bool filterElectromagneticEmissionPDU(const EmissionPduView& view);
+
    virtual void processEntityStatePDU(const EntityStatePDU* const pdu);
    virtual void processFirePDU(const FirePDU* const pdu);
    virtual void processDetonationPDU(const DetonationPDU* const pdu);
@@ -320,6 +389,8 @@ protected:
 
    virtual void clearEmissionPduHandlers();
    virtual void addEmissionPduHandler(const EmissionPduHandler* const item);
+   virtual void clearRegionsOfInterest();
+   virtual void addRegionOfInterest(const RegionOfInterest* const item);
    virtual void defineFederateName();
    virtual void defineFederationName();
 
@@ -327,6 +398,7 @@ protected:
    virtual bool setSiteID(const unsigned short v);          // Sets the network's site ID
    virtual bool setApplicationID(const unsigned short v);   // Sets the network's application ID
    virtual bool setExerciseID(const unsigned char v);       // Sets the network's exercise ID
+   virtual bool setMaxBundleSize(const unsigned int v);     // Sets the max size of a datagram of bundled PDUs (bytes)
 
    virtual bool setSlotNetInput(Basic::NetHandler* const msg);                // Network input handler
    virtual bool setSlotNetOutput(Basic::NetHandler* const msg);               // Network output handler
@@ -345,6 +417,11 @@ protected:
    virtual bool setSlotSiteID(const Basic::Number* const num);                // Sets Site ID
    virtual bool setSlotApplicationID(const Basic::Number* const num);         // Sets Application ID
    virtual bool setSlotExerciseID(const Basic::Number* const num);            // Sets Exercise ID
+   virtual bool setSlotMaxBundleSize(const Basic::Number* const num);         // Sets the max size of a datagram of bundled PDUs
+   virtual bool setSlotRegionsOfInterest(const Basic::PairStream* const msg); // Sets the list of regions of interest
+   virtual bool setSlotRegionsOfInterest(const RegionOfInterest* const msg);  // Sets a single region of interest
+   virtual bool setSlotHeartbeatTime(const Basic::PairStream* const msg);     // Sets the heartbeat time(s) for selected entity types
+   virtual bool setSlotHeartbeatTime(const Basic::Time* const msg);           // Sets the heartbeat time(s) for all entity types
 
    virtual bool slot2KD(const char* const slotname, unsigned char* const k, unsigned char* const d);
    virtual bool setMaxTimeDR(const LCreal v, const unsigned char kind, const unsigned char domain);
@@ -357,6 +434,8 @@ protected:
    virtual bool setMaxAge(const Basic::Time* const p, const unsigned char kind, const unsigned char domain);
    virtual bool setMaxEntityRange(const LCreal v, const unsigned char kind, const unsigned char domain);
    virtual bool setMaxEntityRange(const Basic::Distance* const p, const unsigned char kind, const unsigned char domain);
+   virtual bool setHeartbeatTime(const LCreal v, const unsigned char kind, const unsigned char domain);
+   virtual bool setHeartbeatTime(const Basic::Time* const p, const unsigned char kind, const unsigned char domain);
 
    // NetIO Interface (overriding these slots!)
    bool setSlotFederateName(const Basic::String* const msg) override;         // Sets our federate name
@@ -365,14 +444,22 @@ protected:
    // NetIO Interface
    bool initNetwork() override;                                                   // Initialize the network
    void netInputHander() override;                                                // Network input handler
+   void outputFrame(const LCreal dt) override;                                    // Output frame (sends the queued PDUs)
    void processInputList() override;                                              // Update players/systems from the Input-list
    Simulation::Nib* nibFactory(const Simulation::NetIO::IoType ioType) override;  // Create a new Nib
    Simulation::NetIO::NtmInputNode* rootNtmInputNodeFactory() const override;
    void testOutputEntityTypes(const unsigned int) override;                       // Test quick lookup of outgoing entity types
    void testInputEntityTypes(const unsigned int) override;                        // Test quick lookup of incoming entity types
 
+protected:
+   unsigned long long getNibKey(const unsigned short playerID, const Basic::String* const federateName) const override;
+
 private:
     void initData();
+    unsigned int recvPdus();                          // Reads a batch of PDUs into the input buffer
+    void processPdu(unsigned char* const pdu, const unsigned int length, const bool aligned); // Processes one received PDU
+    unsigned char* alignPdu(unsigned char* const pdu, const unsigned int length, const bool aligned); // Returns the PDU, or an aligned copy
+    bool isLocalPdu(const PduView& view, const unsigned int idOffset) const;   // True if the PDU's entity ID has our site and app IDs
 
     Basic::safe_ptr<Basic::NetHandler>   netInput;    // Input network handler
     Basic::safe_ptr<Basic::NetHandler>   netOutput;   // Output network handler
@@ -385,6 +472,20 @@ private:
 
    static const unsigned int MAX_PDUs = 500;            // Max PDUs in input buffer
    unsigned int inputBuffer[MAX_PDUs][MAX_PDU_SIZE/4];  // Input buffer
+   char* inputPdus[MAX_PDUs];                           // Input buffer PDU pointers
+   unsigned int inputSizes[MAX_PDUs];                   // Input PDU sizes (bytes)
+   unsigned int alignedPdu[MAX_PDU_SIZE/4];             // Aligned copy of a bundled PDU
+
+   static const unsigned int MAX_OUTPUT_PDUs = 64;                // Max PDUs in output queue
+   unsigned int outputBuffer[2][MAX_OUTPUT_PDUs][MAX_PDU_SIZE/4]; // Output queues (see note #7)
+   const char* outputPdus[2][MAX_OUTPUT_PDUs];                    // Output queue PDU pointers
+   int outputSizes[2][MAX_OUTPUT_PDUs];                           // Output PDU sizes (bytes)
+   unsigned int outputQueue;                                      // Output queue that's being filled
+   unsigned int numOutputPdus;                                    // Number of PDUs in the output queue
+   unsigned int maxBundleSize;                                    // Max size of a datagram of bundled PDUs (bytes)
+   bool outputQueued;                                             // Output PDUs are being queued (in outputFrame())
+   mutable long outputLock;                                       // Semaphore to protect the output queue
+   mutable long outputSendLock;                                   // Semaphore to allow one sender of the queues at a time
 
    // Distance filter by entity kind/domain
    LCreal  maxEntityRange[NUM_ENTITY_KINDS][MAX_ENTITY_DOMAINS];     // Max range from ownship           (meters)
@@ -395,6 +496,7 @@ private:
    LCreal  maxPositionErr[NUM_ENTITY_KINDS][MAX_ENTITY_DOMAINS];     // Maximum position error           (meters)
    LCreal  maxOrientationErr[NUM_ENTITY_KINDS][MAX_ENTITY_DOMAINS];  // Maximum orientation error        (radians)
    LCreal  maxAge[NUM_ENTITY_KINDS][MAX_ENTITY_DOMAINS];             // Maximum age of networked players (seconds)
+   LCreal  heartbeatTime[NUM_ENTITY_KINDS][MAX_ENTITY_DOMAINS];      // Max DR time outside the regions of interest (seconds)
 
    static const unsigned int MAX_EMISSION_HANDLERS = 500;            // Max table size
 
@@ -403,6 +505,10 @@ private:
 
    // Number of emission PDU handlers in the table, 'emissionHandlers'
    unsigned int   nEmissionHandlers;
+
+   static const unsigned int MAX_REGIONS = 100;                      // Max number of regions of interest
+   const RegionOfInterest* regions[MAX_REGIONS];                     // Regions of interest (see note #10)
+   unsigned int   nRegions;                                          // Number of regions of interest
 };
 
 
@@ -40,6 +40,10 @@ public:
    virtual void updateTheIPlayer();
    virtual void entityStatePdu2Nib(const EntityStatePDU* const pdu);
 
+   // Output entity is outside of the network's regions of interest (see Dis::NetIO note #10)
+   bool isOutsideRegionsOfInterest() const                    { return outsideROI; }
+   virtual void setOutsideRegionsOfInterest(const bool flg);
+
    // Update check functions
    virtual bool isIffUpdateRequired(const LCreal curExecTime, const Simulation::Iff* const iffSystem);
 
@@ -87,6 +91,7 @@ protected:
 private:
    unsigned short  siteID;     // Site ID
    unsigned short  appID;      // Application ID
+   bool outsideROI;            // Outside of the network's regions of interest
 
    // IFF PDU data
    FundamentalOpData* iffFunOpData;   // IFF Functional Operational Data
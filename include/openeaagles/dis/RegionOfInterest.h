@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------------
+// Class: Dis::RegionOfInterest
+//------------------------------------------------------------------------------
+#ifndef __Eaagles_Network_Dis_RegionOfInterest_H__
+#define __Eaagles_Network_Dis_RegionOfInterest_H__
+
+#include "openeaagles/basic/Object.h"
+
+namespace Eaagles {
+   namespace Basic { class Distance; class LatLon; class Number; class PairStream; }
+
+namespace Network {
+namespace Dis {
+
+//==============================================================================
+// Class: Dis::RegionOfInterest
+// Description: A geographic region that a network's receivers are interested
+//              in (see Dis::NetIO's 'regionsOfInterest' slot).  The region is
+//              either a circle, given by its center and radius, or a polygon,
+//              given by its vertices, and it's limited to an altitude band.
+//
+// Factory name: RegionOfInterest
+// Slots:
+//    latitude    <Basic::LatLon>      ! Circle's center latitude (default: 0)
+//                <Basic::Number>      ! Circle's center latitude (degrees)
+//    longitude   <Basic::LatLon>      ! Circle's center longitude (default: 0)
+//                <Basic::Number>      ! Circle's center longitude (degrees)
+//    radius      <Basic::Distance>    ! Circle's radius (default: 0)
+//    vertices    <Basic::PairStream>  ! Polygon's vertices; a list of [ lat lon ] (degrees)
+//    minAltitude <Basic::Distance>    ! Min altitude (default: no min altitude)
+//    maxAltitude <Basic::Distance>    ! Max altitude (default: no max altitude)
+//
+// Example:
+//
+//    ( RegionOfInterest
+//       latitude: 35.0  longitude: -118.0  radius: ( NauticalMiles 150 )
+//       maxAltitude: ( Feet 60000 )
+//    )
+//
+//    ( RegionOfInterest
+//       vertices: { [ 34.0 -119.0 ] [ 36.0 -119.0 ] [ 36.0 -116.5 ] [ 34.0 -116.5 ] }
+//    )
+//
+// Notes:
+//    1) When three or more vertices are given, the region is a polygon, and
+//       the circle slots are ignored.  A region without a polygon or a
+//       positive radius is empty.
+//    2) The polygon's edges are straight lines of latitude and longitude, and
+//       they are not wrapped across the +/-180 degree meridian.
+//==============================================================================
+class RegionOfInterest : public Basic::Object
+{
+   DECLARE_SUBCLASS(RegionOfInterest,Basic::Object)
+
+public:
+   RegionOfInterest();
+
+   bool isCircle() const                     { return (numVertices < 3 && radius > 0); }
+   bool isPolygon() const                    { return (numVertices >= 3); }
+
+   double getLatitude() const                { return latitude; }       // Circle's center latitude (degs)
+   double getLongitude() const               { return longitude; }      // Circle's center longitude (degs)
+   double getRadius() const                  { return radius; }         // Circle's radius (meters)
+   unsigned int getNumVertices() const       { return numVertices; }    // Number of polygon vertices
+   double getMinAltitude() const             { return minAlt; }         // Min altitude (meters)
+   double getMaxAltitude() const             { return maxAlt; }         // Max altitude (meters)
+
+   // True if the point is inside the region
+   virtual bool isInside(
+      const double lat,          // Latitude (degs)
+      const double lon,          // Longitude (degs)
+      const double alt           // Altitude (meters)
+   ) const;
+
+   virtual bool setCircle(const double lat, const double lon, const double radius);
+   virtual bool setVertices(const double* const lats, const double* const lons, const unsigned int n);
+   virtual bool setAltitudes(const double minAlt, const double maxAlt);
+
+protected:
+   // Slot functions
+   virtual bool setSlotLatitude(const Basic::LatLon* const msg);
+   virtual bool setSlotLatitude(const Basic::Number* const msg);
+   virtual bool setSlotLongitude(const Basic::LatLon* const msg);
+   virtual bool setSlotLongitude(const Basic::Number* const msg);
+   virtual bool setSlotRadius(const Basic::Distance* const msg);
+   virtual bool setSlotVertices(const Basic::PairStream* const msg);
+   virtual bool setSlotMinAltitude(const Basic::Distance* const msg);
+   virtual bool setSlotMaxAltitude(const Basic::Distance* const msg);
+
+private:
+   void initData();
+
+   double latitude;           // Circle's center latitude (degs)
+   double longitude;          // Circle's center longitude (degs)
+   double radius;             // Circle's radius (meters)
+   double radiusNM;           // Circle's radius (nm)
+
+   double* vLats;             // Polygon vertex latitudes (degs)
+   double* vLons;             // Polygon vertex longitudes (degs)
+   unsigned int numVertices;  // Number of polygon vertices
+
+   // Polygon's bounding box (degs)
+   double minLat, maxLat;
+   double minLon, maxLon;
+
+   double minAlt;             // Min altitude (meters)
+   double maxAlt;             // Max altitude (meters)
+};
+
+} // End Dis namespace
+} // End Network namespace
+} // End Eaagles namespace
+
+#endif
@@ -0,0 +1,318 @@
+//------------------------------------------------------------------------------
+// Zero-copy views of received DIS PDUs
+//
+//    The view classes read a PDU's fields directly from the received bytes,
+//    which are still in network (big endian) byte order.  Scalar fields are
+//    decoded on the fly using the loadUInt*(), loadFloat() and loadDouble()
+//    functions, and records (structs.h) are copied out and byte swapped only
+//    when they're asked for.  The PDU itself is never copied or changed, so
+//    the views can be used to filter or inspect a PDU before (or instead of)
+//    byte swapping it, and the PDU doesn't need to be aligned.
+//
+//    A view is valid only for as long as the PDU's buffer is unchanged, and
+//    it doesn't read past the 'size' bytes that it was given.
+//
+// View List
+//    PduView              -- Any PDU (header and fields by offset)
+//    EntityStatePduView   -- Entity State PDU
+//    EmissionPduView      -- Electromagnetic Emission PDU
+//    EmissionSystemView   -- Emission system of an Electromagnetic Emission PDU
+//    EmitterBeamView      -- Emitter beam of an emission system
+//------------------------------------------------------------------------------
+#ifndef __Eaagles_Network_Dis_Views_H__
+#define __Eaagles_Network_Dis_Views_H__
+
+#include "openeaagles/dis/pdu.h"
+
+#include <cstddef>
+#include <cstring>
+
+namespace Eaagles {
+namespace Network {
+namespace Dis {
+
+//--------------------------------------------------------------
+// Big endian (network order) load functions; 'p' doesn't need to be aligned
+//--------------------------------------------------------------
+
+inline uint16_t loadUInt16(const uint8_t* const p) {
+   return static_cast<uint16_t>((static_cast<uint16_t>(p[0]) << 8) | p[1]);
+}
+
+inline uint32_t loadUInt32(const uint8_t* const p) {
+   return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+          (static_cast<uint32_t>(p[2]) << 8)  |  static_cast<uint32_t>(p[3]);
+}
+
+inline uint64_t loadUInt64(const uint8_t* const p) {
+   return (static_cast<uint64_t>(loadUInt32(p)) << 32) | loadUInt32(p + 4);
+}
+
+inline float loadFloat(const uint8_t* const p) {
+   const uint32_t v = loadUInt32(p);
+   float f;
+   std::memcpy(&f, &v, sizeof(f));
+   return f;
+}
+
+inline double loadDouble(const uint8_t* const p) {
+   const uint64_t v = loadUInt64(p);
+   double d;
+   std::memcpy(&d, &v, sizeof(d));
+   return d;
+}
+
+
+//------------------------------------------------------------------------------
+// Class: PduView
+// Description: View of any PDU; the header fields, and fields at a byte offset
+//              from the start of the PDU (e.g., offsetof(FirePDU, eventID)).
+//              Fields that are past the end of the PDU are returned as zero.
+//------------------------------------------------------------------------------
+class PduView {
+public:
+   PduView(const void* const pdu, const unsigned int size)
+      : data(static_cast<const uint8_t*>(pdu)), size(size) {}
+
+   // True if we have at least a PDU header
+   bool isValid() const                   { return (data != nullptr && size >= sizeof(PDUHeader)); }
+
+   const uint8_t* getData() const         { return data; }           // PDU bytes (network order)
+   unsigned int getSize() const           { return size; }           // Number of PDU bytes
+
+   // Header
+   uint8_t getProtocolVersion() const     { return getUInt8(offsetof(PDUHeader, protocolVersion)); }
+   uint8_t getExerciseID() const          { return getUInt8(offsetof(PDUHeader, exerciseIdentifier)); }
+   uint8_t getPDUType() const             { return getUInt8(offsetof(PDUHeader, PDUType)); }
+   uint8_t getProtocolFamily() const      { return getUInt8(offsetof(PDUHeader, protocolFamily)); }
+   uint32_t getTimeStamp() const          { return getUInt32(offsetof(PDUHeader, timeStamp)); }
+   uint16_t getLength() const             { return getUInt16(offsetof(PDUHeader, length)); }
+
+   // Entity identifier (EntityIdentifierDIS) at 'offset'
+   uint16_t getSiteID(const unsigned int offset) const {
+      return getUInt16(offset + offsetof(EntityIdentifierDIS, simulationID) + offsetof(SimulationAddressDIS, siteIdentification));
+   }
+   uint16_t getApplicationID(const unsigned int offset) const {
+      return getUInt16(offset + offsetof(EntityIdentifierDIS, simulationID) + offsetof(SimulationAddressDIS, applicationIdentification));
+   }
+   uint16_t getEntityNumber(const unsigned int offset) const {
+      return getUInt16(offset + offsetof(EntityIdentifierDIS, ID));
+   }
+
+   // Fields at 'offset'
+   uint8_t getUInt8(const unsigned int offset) const {
+      return (offset < size ? data[offset] : 0);
+   }
+   uint16_t getUInt16(const unsigned int offset) const {
+      return (offset + 2 <= size ? loadUInt16(data + offset) : 0);
+   }
+   uint32_t getUInt32(const unsigned int offset) const {
+      return (offset + 4 <= size ? loadUInt32(data + offset) : 0);
+   }
+   float getFloat(const unsigned int offset) const {
+      return (offset + 4 <= size ? loadFloat(data + offset) : 0.0f);
+   }
+   double getDouble(const unsigned int offset) const {
+      return (offset + 8 <= size ? loadDouble(data + offset) : 0.0);
+   }
+
+   // Copies the record at 'offset' to 'rec' and swaps it to host byte order;
+   // returns false (and 'rec' is unchanged) if the record is past the end of the PDU.
+   template <class T> bool getRecord(const unsigned int offset, T* const rec) const {
+      if (rec == nullptr || offset + sizeof(T) > size) return false;
+      std::memcpy(static_cast<void*>(rec), data + offset, sizeof(T));
+      if (checkSwap()) rec->swapBytes();
+      return true;
+   }
+
+protected:
+   const uint8_t* data;    // PDU bytes (network order)
+   unsigned int size;      // Number of bytes
+};
+
+
+//------------------------------------------------------------------------------
+// Class: EntityStatePduView
+// Description: View of an Entity State PDU (see EntityStatePDU)
+//------------------------------------------------------------------------------
+class EntityStatePduView : public PduView {
+public:
+   EntityStatePduView(const void* const pdu, const unsigned int size) : PduView(pdu, size) {}
+
+   // True if we have the whole PDU, including its articulation parameters
+   bool isValid() const {
+      return PduView::isValid() &&
+         size >= sizeof(EntityStatePDU) + sizeof(VpArticulatedPart) * getNumberOfArticulationParameters();
+   }
+
+   uint16_t getSiteID() const                   { return PduView::getSiteID(offsetof(EntityStatePDU, entityID)); }
+   uint16_t getApplicationID() const            { return PduView::getApplicationID(offsetof(EntityStatePDU, entityID)); }
+   uint16_t getPlayerID() const                 { return getEntityNumber(offsetof(EntityStatePDU, entityID)); }
+
+   uint8_t getForceID() const                   { return getUInt8(offsetof(EntityStatePDU, forceID)); }
+   uint8_t getNumberOfArticulationParameters() const { return getUInt8(offsetof(EntityStatePDU, numberOfArticulationParameters)); }
+   uint32_t getAppearance() const               { return getUInt32(offsetof(EntityStatePDU, appearance)); }
+   uint8_t getDeadReckoningAlgorithm() const    { return getUInt8(offsetof(EntityStatePDU, deadReckoningAlgorithm)); }
+   uint32_t getCapabilities() const             { return getUInt32(offsetof(EntityStatePDU, capabilites)); }
+
+   // Geocentric location (meters)
+   double getLocationX() const   { return getDouble(offsetof(EntityStatePDU, entityLocation) + offsetof(WorldCoordinates, X_coord)); }
+   double getLocationY() const   { return getDouble(offsetof(EntityStatePDU, entityLocation) + offsetof(WorldCoordinates, Y_coord)); }
+   double getLocationZ() const   { return getDouble(offsetof(EntityStatePDU, entityLocation) + offsetof(WorldCoordinates, Z_coord)); }
+
+   // Records
+   bool getEntityType(EntityType* const p) const                      { return getRecord(offsetof(EntityStatePDU, entityType), p); }
+   bool getAlternativeType(EntityType* const p) const                 { return getRecord(offsetof(EntityStatePDU, alternativeType), p); }
+   bool getEntityLinearVelocity(VectorDIS* const p) const             { return getRecord(offsetof(EntityStatePDU, entityLinearVelocity), p); }
+   bool getEntityLocation(WorldCoordinates* const p) const            { return getRecord(offsetof(EntityStatePDU, entityLocation), p); }
+   bool getEntityOrientation(EulerAngles* const p) const              { return getRecord(offsetof(EntityStatePDU, entityOrientation), p); }
+   bool getDRLinearAcceleration(VectorDIS* const p) const             { return getRecord(offsetof(EntityStatePDU, DRentityLinearAcceleration), p); }
+   bool getDRAngularVelocity(AngularVelocityVectorDIS* const p) const { return getRecord(offsetof(EntityStatePDU, DRentityAngularVelocity), p); }
+
+   // Byte arrays (no byte swapping needed)
+   const uint8_t* getOtherParameters() const {
+      return (size >= sizeof(EntityStatePDU) ? data + offsetof(EntityStatePDU, otherParameters) : nullptr);
+   }
+   const EntityMarking* getEntityMarking() const {
+      return (size >= sizeof(EntityStatePDU) ? reinterpret_cast<const EntityMarking*>(data + offsetof(EntityStatePDU, entityMarking)) : nullptr);
+   }
+
+   // Copies the idx'th (zero based) articulation parameter to 'p'
+   bool getArticulationParameter(const unsigned int idx, VpArticulatedPart* const p) const {
+      if (idx >= getNumberOfArticulationParameters()) return false;
+      return getRecord(static_cast<unsigned int>(sizeof(EntityStatePDU) + sizeof(VpArticulatedPart) * idx), p);
+   }
+};
+
+
+//------------------------------------------------------------------------------
+// Class: EmitterBeamView
+// Description: View of an emitter beam (see EmitterBeamData); the beam's
+//              offset is from the start of the PDU.
+//------------------------------------------------------------------------------
+class EmitterBeamView : public PduView {
+public:
+   EmitterBeamView(const uint8_t* const pdu, const unsigned int size, const unsigned int offset)
+      : PduView(pdu, size), beam(offset) {}
+
+   // True if the beam's fixed fields and its track/jam targets are within the PDU
+   bool isValid() const {
+      return PduView::isValid() && beam + sizeof(EmitterBeamData) <= size &&
+         beam + sizeof(EmitterBeamData) + sizeof(TrackJamTargets) * getNumberOfTargetsInTrack() <= size;
+   }
+
+   uint8_t getBeamDataLength() const         { return getUInt8(beam + offsetof(EmitterBeamData, beamDataLength)); }
+   uint8_t getBeamIDNumber() const           { return getUInt8(beam + offsetof(EmitterBeamData, beamIDNumber)); }
+   uint16_t getBeamParameterIndex() const    { return getUInt16(beam + offsetof(EmitterBeamData, beamParameterIndex)); }
+   uint8_t getBeamFunction() const           { return getUInt8(beam + offsetof(EmitterBeamData, beamFunction)); }
+   uint8_t getNumberOfTargetsInTrack() const { return getUInt8(beam + offsetof(EmitterBeamData, numberOfTargetsInTrack)); }
+   uint8_t getHighDensityTracks() const      { return getUInt8(beam + offsetof(EmitterBeamData, highDensityTracks)); }
+   uint8_t getBeamStatus() const             { return getUInt8(beam + offsetof(EmitterBeamData, beamStatus)); }
+
+   bool getParameterData(EeFundamentalParameterData* const p) const  { return getRecord(beam + offsetof(EmitterBeamData, parameterData), p); }
+   bool getBeamData(BeamData* const p) const                         { return getRecord(beam + offsetof(EmitterBeamData, beamData), p); }
+   bool getJammingTechnique(JammingTechnique* const p) const         { return getRecord(beam + offsetof(EmitterBeamData, jammingTechnique), p); }
+
+   // Copies the idx'th (zero based) track/jam target to 'p'
+   bool getTrackTarget(const unsigned int idx, TrackJamTargets* const p) const {
+      if (idx >= getNumberOfTargetsInTrack()) return false;
+      return getRecord(static_cast<unsigned int>(beam + sizeof(EmitterBeamData) + sizeof(TrackJamTargets) * idx), p);
+   }
+
+private:
+   unsigned int beam;      // Offset to the beam
+};
+
+
+//------------------------------------------------------------------------------
+// Class: EmissionSystemView
+// Description: View of an emission system (see EmissionSystem); the system's
+//              offset is from the start of the PDU.
+//------------------------------------------------------------------------------
+class EmissionSystemView : public PduView {
+public:
+   EmissionSystemView(const uint8_t* const pdu, const unsigned int size, const unsigned int offset)
+      : PduView(pdu, size), system(offset) {}
+
+   // True if the system, by its 'systemDataLength', is within the PDU
+   bool isValid() const {
+      const unsigned int len = getSystemDataLength() * 4U;
+      return PduView::isValid() && system + sizeof(EmissionSystem) <= size &&
+         len >= sizeof(EmissionSystem) && system + len <= size;
+   }
+
+   uint8_t getSystemDataLength() const       { return getUInt8(system + offsetof(EmissionSystem, systemDataLength)); }
+   uint8_t getNumberOfBeams() const          { return getUInt8(system + offsetof(EmissionSystem, numberOfBeams)); }
+   uint16_t getEmitterName() const           { return getUInt16(system + offsetof(EmissionSystem, emitterSystem) + offsetof(EmitterSystem, emitterName)); }
+
+   bool getEmitterSystem(EmitterSystem* const p) const   { return getRecord(system + offsetof(EmissionSystem, emitterSystem), p); }
+   bool getLocation(VectorDIS* const p) const            { return getRecord(system + offsetof(EmissionSystem, location), p); }
+
+   // Returns a view of the idx'th (zero based) beam, which is found by
+   // stepping over the previous beams using their 'beamDataLength'.
+   // (check the view's isValid())
+   EmitterBeamView getEmitterBeam(const unsigned int idx) const {
+      const unsigned int end = system + getSystemDataLength() * 4U;
+      unsigned int offset = system + static_cast<unsigned int>(sizeof(EmissionSystem));
+      for (unsigned int i = 0; i < idx && offset < end; i++) {
+         const unsigned int len = getUInt8(offset + offsetof(EmitterBeamData, beamDataLength)) * 4U;
+         offset = (len > 0 ? offset + len : end);
+      }
+      if (idx >= getNumberOfBeams() || offset >= end || end > size) return EmitterBeamView(nullptr, 0, 0);
+      return EmitterBeamView(data, end, offset);
+   }
+
+private:
+   unsigned int system;    // Offset to the system
+};
+
+
+//------------------------------------------------------------------------------
+// Class: EmissionPduView
+// Description: View of an Electromagnetic Emission PDU (see ElectromagneticEmissionPDU)
+//------------------------------------------------------------------------------
+class EmissionPduView : public PduView {
+public:
+   EmissionPduView(const void* const pdu, const unsigned int size) : PduView(pdu, size) {}
+
+   // True if we have the fixed fields and all of the systems are within the PDU
+   bool isValid() const {
+      if (!PduView::isValid() || size < sizeof(ElectromagneticEmissionPDU)) return false;
+      const unsigned int n = getNumberOfSystems();
+      unsigned int offset = sizeof(ElectromagneticEmissionPDU);
+      for (unsigned int i = 0; i < n; i++) {
+         const EmissionSystemView es(data, size, offset);
+         if (!es.isValid()) return false;
+         offset += es.getSystemDataLength() * 4U;
+      }
+      return true;
+   }
+
+   uint16_t getSiteID() const                { return PduView::getSiteID(offsetof(ElectromagneticEmissionPDU, emittingEntityID)); }
+   uint16_t getApplicationID() const         { return PduView::getApplicationID(offsetof(ElectromagneticEmissionPDU, emittingEntityID)); }
+   uint16_t getPlayerID() const              { return getEntityNumber(offsetof(ElectromagneticEmissionPDU, emittingEntityID)); }
+
+   uint8_t getStateUpdateIndicator() const   { return getUInt8(offsetof(ElectromagneticEmissionPDU, stateUpdateIndicator)); }
+   uint8_t getNumberOfSystems() const        { return getUInt8(offsetof(ElectromagneticEmissionPDU, numberOfSystems)); }
+
+   bool getEventID(EventIdentifier* const p) const { return getRecord(offsetof(ElectromagneticEmissionPDU, eventID), p); }
+
+   // Returns a view of the idx'th (zero based) system, which is found by
+   // stepping over the previous systems using their 'systemDataLength'.
+   // (check the view's isValid())
+   EmissionSystemView getEmissionSystem(const unsigned int idx) const {
+      unsigned int offset = sizeof(ElectromagneticEmissionPDU);
+      for (unsigned int i = 0; i < idx && offset < size; i++) {
+         const unsigned int len = getUInt8(offset + offsetof(EmissionSystem, systemDataLength)) * 4U;
+         offset = (len > 0 ? offset + len : size);
+      }
+      if (idx >= getNumberOfSystems() || offset >= size) return EmissionSystemView(nullptr, 0, 0);
+      return EmissionSystemView(data, size, offset);
+   }
+};
+
+} // End Dis namespace
+} // End Network namespace
+} // End Eaagles namespace
+
+#endif
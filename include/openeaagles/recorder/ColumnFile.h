@@ -0,0 +1,122 @@
+//------------------------------------------------------------------------------
+// Class: ColumnFile
+//------------------------------------------------------------------------------
+#ifndef __Eaagles_Recorder_ColumnFile_H__
+#define __Eaagles_Recorder_ColumnFile_H__
+
+namespace Eaagles {
+namespace Recorder {
+
+//------------------------------------------------------------------------------
+// Class: ColumnFile
+// Description: Layout and schema of a column data file, which is written by
+//              the ColumnWriter and read, a column at a time, by the
+//              ColumnReader.
+//
+// Column data file:
+//
+//    Header      8 bytes: "OECF", version (1) and three reserved bytes
+//    Row groups  Each row group holds up to 'rowGroupSize' rows of one table,
+//                stored as one column chunk per column; a chunk is the rows'
+//                values, one after the other, with no framing
+//    Dictionary  The names, each a 4 byte length followed by its characters
+//    Directory   One entry of CHUNK_ENTRY_SIZE bytes per column chunk (see below)
+//    Trailer     TRAILER_SIZE bytes: dictionary file offset (8 bytes), number
+//                of names (4 bytes), directory file offset (8 bytes), number
+//                of chunks (4 bytes) and "OECX"
+//
+//    All binary values are little-endian.  Each directory entry contains the
+//    chunk's file offset (8 bytes), the table's row number of its first row
+//    (8 bytes), its number of rows (4 bytes), its table (2 bytes) and its
+//    column (2 bytes).
+//
+// Tables:
+//
+//    PLAYER_TABLE      Player data, new player and player removed records
+//    TRACK_TABLE       Track data and new track records
+//    EMISSION_TABLE    Emission data of the track data and new track records
+//
+//    The columns of each table are listed by the PlayerColumn, TrackColumn
+//    and EmissionColumn enums.  Their names are the field names of the
+//    messages; see getColumnName().
+//
+// Notes:
+//    1) Column types: DOUBLE_TYPE values are 8 byte doubles; a field that
+//       isn't in the record is stored as a quiet NaN.  UINT32_TYPE values are
+//       4 byte unsigned ints (zero when the field isn't in the record), and
+//       NAME_TYPE values are 4 byte dictionary codes.
+//
+//    2) The dictionary holds each name (player names and track ids) once.
+//       Code zero is the empty name, so the first name in the file is code one.
+//------------------------------------------------------------------------------
+class ColumnFile
+{
+public:
+   // Tables
+   enum Table { PLAYER_TABLE, TRACK_TABLE, EMISSION_TABLE, NUM_TABLES };
+
+   // Column types
+   enum Type { DOUBLE_TYPE, UINT32_TYPE, NAME_TYPE };
+
+   // PLAYER_TABLE columns
+   enum PlayerColumn {
+      P_EXEC_TIME, P_SIM_TIME, P_RECORD_ID, P_PLAYER_ID, P_PLAYER_NAME, P_SIDE,
+      P_POS_X, P_POS_Y, P_POS_Z, P_ROLL, P_PITCH, P_YAW, P_VEL_X, P_VEL_Y, P_VEL_Z,
+      P_DAMAGE, P_ALPHA, P_BETA, P_CAS,
+      NUM_PLAYER_COLUMNS
+   };
+
+   // TRACK_TABLE columns
+   enum TrackColumn {
+      T_EXEC_TIME, T_SIM_TIME, T_RECORD_ID, T_PLAYER_ID, T_PLAYER_NAME, T_TRACK_ID,
+      T_TRK_PLAYER_ID, T_TRK_PLAYER_NAME, T_TYPE, T_QUALITY, T_TRUE_AZ, T_REL_AZ,
+      T_ELEVATION, T_RANGE, T_LATITUDE, T_LONGITUDE, T_ALTITUDE, T_AVG_SIGNAL,
+      NUM_TRACK_COLUMNS
+   };
+
+   // EMISSION_TABLE columns
+   enum EmissionColumn {
+      E_EXEC_TIME, E_SIM_TIME, E_PLAYER_ID, E_PLAYER_NAME, E_TRACK_ID,
+      E_FREQUENCY, E_WAVE_LENGTH, E_PULSE_WIDTH, E_BANDWIDTH, E_PRF, E_POWER,
+      E_POLARIZATION, E_AZIMUTH_AOI, E_ELEVATION_AOI, E_ORIGIN_ID, E_TARGET_ID,
+      NUM_EMISSION_COLUMNS
+   };
+
+   static const unsigned int MAX_COLUMNS = NUM_PLAYER_COLUMNS;   // Max columns per table
+
+   static const unsigned int VERSION = 1;             // Column data file version
+   static const unsigned int HEADER_SIZE = 8;         // Size of the file header (bytes)
+   static const unsigned int CHUNK_ENTRY_SIZE = 24;   // Size of a directory entry (bytes)
+   static const unsigned int TRAILER_SIZE = 28;       // Size of the file trailer (bytes)
+
+public:
+   static const char* getTableName(const unsigned int table);
+   static unsigned int getNumColumns(const unsigned int table);
+
+   // Column's name and type; zero and DOUBLE_TYPE for an invalid column
+   static const char* getColumnName(const unsigned int table, const unsigned int column);
+   static Type getColumnType(const unsigned int table, const unsigned int column);
+
+   // Index of the table's column named 'name', or -1 if there isn't one
+   static int findColumn(const unsigned int table, const char* const name);
+
+   // Size of a value of the type (bytes)
+   static unsigned int getTypeSize(const Type type)   { return (type == DOUBLE_TYPE ? 8 : 4); }
+
+   // File header and trailer
+   static void encodeHeader(char* const buffer);
+   static bool isHeader(const char* const buffer);
+   static void encodeTrailerMagic(char* const buffer);
+   static bool isTrailerMagic(const char* const buffer);
+
+   // Little-endian values
+   static void putUInt(char* const p, const unsigned long long v, const unsigned int n);
+   static unsigned long long getUInt(const char* const p, const unsigned int n);
+   static void putDouble(char* const p, const double d);
+   static double getDouble(const char* const p);
+};
+
+} // End Recorder namespace
+} // End Eaagles namespace
+
+#endif
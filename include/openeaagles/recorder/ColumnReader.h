@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------
+// Class: ColumnReader
+//------------------------------------------------------------------------------
+#ifndef __Eaagles_Recorder_ColumnReader_H__
+#define __Eaagles_Recorder_ColumnReader_H__
+
+#include "openeaagles/basic/Object.h"
+#include "openeaagles/recorder/ColumnFile.h"
+
+#include <string>
+
+namespace Eaagles {
+   namespace Basic { class String; }
+namespace Recorder {
+
+//------------------------------------------------------------------------------
+// Class:   ColumnReader
+// Description: Reads the columns of a column data file (see ColumnFile.h),
+//              which was written by a ColumnWriter.
+//
+// Factory name: RecorderColumnReader
+// Slots:
+//     filename       <String>     ! Column data file name (required)
+//     pathname       <String>     ! Path to the data file's directory (optional)
+//
+// Example:
+//
+//    // All player positions
+//    const unsigned int t = ColumnFile::PLAYER_TABLE;
+//    const unsigned long long n = reader->getNumRows(t);
+//    double* x = new double[n];
+//    reader->readColumn(t, ColumnFile::P_POS_X, x, n);
+//
+// Notes:
+//    1) The file's dictionary and chunk directory are loaded by openFile().
+//    readColumn() then reads only the chunks of the column that hold the
+//    requested rows, each with a single read; the other columns aren't read.
+//
+//    2) readColumn() returns the number of values read.  The double version
+//    reads only DOUBLE_TYPE columns, and the unsigned int version reads only
+//    UINT32_TYPE and NAME_TYPE columns; getName() returns the name of a
+//    NAME_TYPE column's code.
+//------------------------------------------------------------------------------
+class ColumnReader : public Basic::Object
+{
+    DECLARE_SUBCLASS(ColumnReader, Basic::Object)
+
+public:
+   ColumnReader();
+
+   bool isOpen() const;                // Is the column data file open?
+   bool isFailed() const;              // Did we have an open or read error?
+
+   virtual bool openFile();            // Open the file and load its dictionary and directory
+   virtual void closeFile();           // Close the file
+
+   // Number of rows in the table
+   unsigned long long getNumRows(const unsigned int table) const;
+
+   // Dictionary; code zero is the empty name
+   unsigned int getNumNames() const;
+   const char* getName(const unsigned int code) const;
+
+   // Reads up to 'maxRows' values of the column, starting with row 'firstRow'
+   unsigned long long readColumn(
+      const unsigned int table,           // Table
+      const unsigned int column,          // Column
+      double* const values,               // Values (DOUBLE_TYPE column)
+      const unsigned long long maxRows,   // Size of 'values'
+      const unsigned long long firstRow = 0
+   );
+
+   unsigned long long readColumn(
+      const unsigned int table,           // Table
+      const unsigned int column,          // Column
+      unsigned int* const values,         // Values (UINT32_TYPE or NAME_TYPE column)
+      const unsigned long long maxRows,   // Size of 'values'
+      const unsigned long long firstRow = 0
+   );
+
+   // File and path names; set before calling openFile()
+   virtual bool setFilename(const Basic::String* const msg);
+   virtual bool setPathName(const Basic::String* const msg);
+
+private:
+   // Column chunk directory entry
+   struct ChunkEntry {
+      unsigned long long offset;       // File offset of the chunk
+      unsigned long long firstRow;     // Table's row number of the chunk's first row
+      unsigned int numRows;            // Number of rows
+      unsigned int table;              // Table
+      unsigned int column;             // Column
+   };
+
+   void initData();
+   void clearDirectory();
+   bool readDirectory();
+   unsigned long long readChunks(const unsigned int table, const unsigned int column, void* const values,
+      const unsigned long long maxRows, const unsigned long long firstRow);
+
+   std::ifstream* sin;              // Input stream
+   const Basic::String* filename;   // Input file name
+   const Basic::String* pathname;   // Path to the input file directory
+   bool fileOpened;                 // File opened
+   bool fileFailed;                 // Open or read failed
+
+   ChunkEntry* chunks;              // Column chunk directory
+   unsigned int numChunks;          // Number of chunks
+   unsigned long long numRows[ColumnFile::NUM_TABLES];   // Number of rows in each table
+
+   std::string* names;              // Dictionary names by code
+   unsigned int numNames;           // Number of names (including the empty name)
+   char* buffer;                    // Chunk read buffer
+   unsigned long long bufferSize;   // Size of the read buffer (bytes)
+};
+
+} // End Recorder namespace
+} // End Eaagles namespace
+
+#endif
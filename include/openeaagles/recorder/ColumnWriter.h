@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+// Class: ColumnWriter
+//------------------------------------------------------------------------------
+#ifndef __Eaagles_Recorder_ColumnWriter_H__
+#define __Eaagles_Recorder_ColumnWriter_H__
+
+#include "openeaagles/recorder/OutputHandler.h"
+#include "openeaagles/recorder/ColumnFile.h"
+
+#include <string>
+
+namespace Eaagles {
+   namespace Basic { class Number; class String; }
+namespace Recorder {
+   namespace Pb { class EmissionData; class PlayerId; class PlayerState; class Time; class TrackData; }
+
+//------------------------------------------------------------------------------
+// Class:   ColumnWriter
+// Description: Writes the player, track and emission data of the data records
+//              to a column data file (see ColumnFile.h), for analysis tools
+//              that read the data a column at a time (see ColumnReader.h).
+//
+// Factory name: RecorderColumnWriter
+// Slots:
+//     filename       <String>     ! Column data file name
+//     pathname       <String>     ! Path to the data file's directory (optional)
+//     rowGroupSize   <Number>     ! Number of rows in each row group (default: 65536)
+//
+// Notes:
+//    1) The file is opened with the first player or track record, and it's
+//    closed, and its dictionary and directory written, with the end of data
+//    (REID_END_OF_DATA) record or at shutdown.  Like the
+//    FileWriter, a version number is appended to the file name if the file
+//    already exists (e.g., filename_v01 to filename_v99).
+//
+//    2) The rows of each table are collected, a column at a time, until the
+//    table has 'rowGroupSize' rows, and then each of its columns is written
+//    as a column chunk with a single write.  Other records are ignored.
+//------------------------------------------------------------------------------
+class ColumnWriter : public OutputHandler
+{
+    DECLARE_SUBCLASS(ColumnWriter, OutputHandler)
+
+public:
+   static const unsigned int DEFAULT_ROW_GROUP_SIZE = 65536;
+
+public:
+   ColumnWriter();
+
+   bool isOpen() const;                      // Is the column data file open?
+   bool isFailed() const;                    // Did we have an open or write error?
+
+   bool openFile();                          // Open the column data file
+   void closeFile();                         // Write the dictionary and directory, and close the file
+
+   const char* getFilename() const;          // File name as entered
+   const char* getPathname() const;          // Path to file
+   unsigned int getRowGroupSize() const;     // Number of rows in each row group
+
+   // Number of rows written to the table (including the current row group)
+   unsigned long long getNumRows(const unsigned int table) const;
+
+   // Set before calling openFile()
+   virtual bool setFilename(const Basic::String* const msg);
+   virtual bool setPathName(const Basic::String* const msg);
+   virtual bool setRowGroupSize(const unsigned int n);
+
+protected:
+   bool setSlotRowGroupSize(const Basic::Number* const msg);
+
+   void processRecordImp(const DataRecordHandle* const handle) override;
+
+   bool shutdownNotification() override;
+
+private:
+   // Column chunk directory entry
+   struct ChunkEntry {
+      unsigned long long offset;       // File offset of the chunk
+      unsigned long long firstRow;     // Table's row number of the chunk's first row
+      unsigned int numRows;            // Number of rows
+      unsigned int table;              // Table
+      unsigned int column;             // Column
+   };
+
+   // Table's current row group
+   struct TableState {
+      char* columns[ColumnFile::MAX_COLUMNS];   // Encoded column values (rowGroupSize rows)
+      unsigned int numColumns;                  // Number of columns
+      unsigned int numRows;                     // Number of rows in the row group
+      unsigned long long totalRows;             // Number of rows written before the row group
+   };
+
+   void initData();
+   void clearTables();
+   void writeData(const char* const data, const unsigned int n);
+
+   void endRow(const unsigned int table);
+   void flushRowGroup(const unsigned int table);
+   void writeDirectory();
+
+   void addPlayerRow(const Pb::Time& time, const unsigned int id, const Pb::PlayerId& pid, const Pb::PlayerState* const state, const double alpha, const double beta, const double cas);
+   void addTrackRow(const Pb::Time& time, const unsigned int id, const Pb::PlayerId& pid, const std::string& trackId, const Pb::PlayerId* const tgtId, const Pb::TrackData* const trk);
+   void addEmissionRow(const Pb::Time& time, const Pb::PlayerId& pid, const std::string& trackId, const Pb::EmissionData& em);
+
+   void putDouble(const unsigned int table, const unsigned int column, const double v);
+   void putUInt(const unsigned int table, const unsigned int column, const unsigned int v);
+   void putName(const unsigned int table, const unsigned int column, const std::string& name);
+   unsigned int getNameCode(const std::string& name);
+
+   std::ofstream* sout;             // Output stream
+   const Basic::String* filename;   // Output file name
+   const Basic::String* pathname;   // Path to the output file directory
+   bool fileOpened;                 // File opened
+   bool fileFailed;                 // Open or write failed
+   unsigned long long fileOffset;   // Number of bytes written to the file
+
+   unsigned int rowGroupSize;       // Number of rows in each row group
+   TableState tables[ColumnFile::NUM_TABLES];
+
+   ChunkEntry* chunks;              // Directory of the column chunks written
+   unsigned int numChunks;          // Number of chunks written
+   unsigned int maxChunks;          // Size of the 'chunks' array
+
+   // Name dictionary; an open addressing hash table of the name codes
+   std::string* names;              // Names by code (code zero is the empty name)
+   unsigned int numNames;           // Number of names (including the empty name)
+   unsigned int maxNames;           // Size of the 'names' array
+   unsigned int* nameHash;          // Name codes (zero: empty slot); two slots per name
+   unsigned int nameHashSize;       // Size of the 'nameHash' table (power of two)
+};
+
+} // End Recorder namespace
+} // End Eaagles namespace
+
+#endif
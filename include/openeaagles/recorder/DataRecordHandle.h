@@ -11,6 +11,7 @@ namespace Recorder {
 
    // Main (protocol buffer) data record
    namespace Pb { class DataRecord; }
+   class RecordArena;
 
 //------------------------------------------------------------------------------
 // Class: DataRecordHandle
@@ -21,6 +22,9 @@ namespace Recorder {
 //    1) This handle will 'own' the DataRecord ...
 //
 //    2) When this handle is destroyed, the DataRecord will be deleted.
+//       If the DataRecord was allocated from a RecordArena then this handle
+//       holds a reference to the arena instead, and the DataRecord is
+//       released with the arena.
 //
 //    3) Using the assignment operator ( e.g., handle1 = handle2; ), the contents
 //       of handle2's DataRecord will be copied into handle1's DataRecord.
@@ -32,17 +36,21 @@ class DataRecordHandle : public Basic::Object
 
 public:
    DataRecordHandle(Pb::DataRecord* const record);
+   DataRecordHandle(Pb::DataRecord* const record, RecordArena* const arena);
 
    const Pb::DataRecord* getRecord() const;
+   const RecordArena* getArena() const;
 
 protected:
    DataRecordHandle();  // Default Constructor
 
 private:
    Pb::DataRecord* record;
+   RecordArena* arena;           // Arena that owns the record (or zero)
 };
 
 inline const Pb::DataRecord* DataRecordHandle::getRecord() const { return record; }
+inline const RecordArena* DataRecordHandle::getArena() const { return arena; }
 
 } // End Recorder namespace
 } // End Eaagles namespace
@@ -15,6 +15,7 @@ namespace Recorder {
       class TrackData; class EmissionData; }
    class DataRecordHandle;
    class OutputHandler;
+   class RecordArena;
 
 //------------------------------------------------------------------------------
 // Class: DataRecorder
@@ -23,10 +24,20 @@ namespace Recorder {
 // Factory name: DataRecorder
 // Slots:
 //    outputHandler     <OutputHandler>      ! Output handler (default: none)
+//    recordsPerArena   <Number>             ! Number of data records allocated from each
+//                                           ! protocol buffer arena (default: 1000; zero
+//                                           ! to allocate each record on the heap)
 //
 // Notes:
 //    1) negative time values are used when time is unknown.
 //
+//    2) Data records are allocated using newDataRecord(), which allocates
+//    them from a RecordArena when arenas are supported (see RecordArena.h).
+//    A new arena is started after every 'recordsPerArena' records, and each
+//    arena is released with the handle of its last data record.  Records that
+//    are allocated on the heap (i.e., new Pb::DataRecord()) may still be
+//    passed to sendDataRecord().
+//
 //------------------------------------------------------------------------------
 // Recorder events handled ---
 //
@@ -82,6 +93,7 @@ protected:
 
    // Set functions
    bool setOutputHandler(OutputHandler* const msg);
+   bool setRecordsPerArena(const unsigned int n);
    bool setSlotEventName(Basic::String* const msg);
    bool setSlotApplication(Basic::String* const msg);
    bool setSlotCaseNum(Basic::Number* const msg);
@@ -91,12 +103,14 @@ protected:
    bool setSlotDay(Basic::Number* const msg);
    bool setSlotMonth(Basic::Number* const msg);
    bool setSlotYear(Basic::Number* const msg);
+   bool setSlotRecordsPerArena(const Basic::Number* const msg);
 
    // data filler functions
    virtual void genPlayerId( Pb::PlayerId* const id, const Simulation::Player* const player );
    virtual void genPlayerState( Pb::PlayerState* const state, const Simulation::Player* const player );
    virtual void genTrackData( Pb::TrackData* const trkMsg, const Simulation::Track* const track );
    virtual void genEmissionData( Pb::EmissionData* const emMsg, const Simulation::Emission* const emData);
+   virtual Pb::DataRecord* newDataRecord();                      // Allocate a new DataRecord
    virtual void sendDataRecord(Pb::DataRecord* const msg);       // Send the DataRecord to our output handler
    virtual void timeStamp(Pb::DataRecord* const msg);            // Time stamp the DataRecord
    virtual std::string genTrackId(const Simulation::Track* const track);
@@ -134,10 +148,22 @@ protected:
 
 private:
    void initData();
+   void retireArena();
+   RecordArena* releaseArena(const Pb::DataRecord* const msg);
+   void clearArenas();
+
+   static const unsigned int MAX_RETIRED_ARENAS = 16;
+   static const unsigned int ARENA_BLOCK_SIZE = 65536;
 
    OutputHandler* outputHandler;          // Our output handler
    bool firstPass;
 
+   RecordArena* arena;                    // Current record arena
+   RecordArena* retired[MAX_RETIRED_ARENAS]; // Retired arenas that still have pending records
+   unsigned int numRetired;               // Number of retired arenas
+   unsigned int recordsPerArena;          // Number of records per arena (or zero)
+   mutable long arenaLock;                // Arena lock
+
    const char* eventName;
    const char* application;
    unsigned int caseNum;
@@ -7,8 +7,10 @@
 #include "openeaagles/recorder/InputHandler.h"
 
 namespace Eaagles {
-   namespace Basic { class String; }
+   namespace Basic { class Number; class String; class Time; }
 namespace Recorder {
+   namespace Pb { class DataRecord; }
+   class RecordIndex;
 
 //------------------------------------------------------------------------------
 // Class:   FileReader
@@ -18,19 +20,28 @@ namespace Recorder {
 // Slots:
 //     filename       <String>     ! Data file name (required)
 //     pathname       <String>     ! Path to the data file's directory (optional)
+//     startTime      <Time>       ! Exec time of the first record to read; negative
+//                                 ! times are from the end of the file (e.g., -300
+//                                 ! seconds for the last five minutes) (default: none)
 //
 // Notes
-//    1) The data file consists of a sequence of serialized data records
-//    that are preceded by 4 bytes that provided the size of each data record
-//    in bytes.  The 4 bytes are stored as an ascii string with leading spaces
-//    (e.g., " 123")
+//    1) Both indexed (version 2) and sequential (version 1) data files are
+//    read; see FileWriter.h and RecordIndex.h for their layouts.
+//
+//    2) seekTime() and seekRecord() use the file's index to find the exec time
+//    or type of data record, and then scan, at most, one index interval for
+//    the exact record.  If an indexed file wasn't closed, then the blocks of
+//    its index file are used, and only the records after the last complete
+//    block are read to finish the index (see FileWriter.h, Note 6).  If the
+//    file doesn't have an index at all (e.g., a version 1 file), then the
+//    index is built by reading the whole file once.
 //------------------------------------------------------------------------------
 class FileReader : public InputHandler
 {
     DECLARE_SUBCLASS(FileReader, InputHandler)
 
 public:
-   static const unsigned int MAX_INPUT_BUFFER_SIZE = 2000;
+   static const unsigned int MAX_INPUT_BUFFER_SIZE = 2000;   // Initial size of the input buffer
 
 public:
    FileReader();
@@ -41,17 +52,58 @@ public:
    virtual bool openFile();         // Open the data file
    virtual void closeFile();        // Close the data file
 
+   unsigned int getVersion() const; // Data file version (valid only while file is open)
+
+   // Seek to the first record at or after the exec time 'execTime' (sec);
+   // returns false, and the file position is unchanged, if there isn't one
+   virtual bool seekTime(const double execTime);
+
+   // Seek to the first record with id 'id' at or after the exec time 'execTime' (sec);
+   // returns false, and the file position is unchanged, if there isn't one
+   virtual bool seekRecord(const unsigned int id, const double execTime = 0);
+
+   // Exec times of the first and last records (sec); the records after the
+   // last index entry, at most one index interval, are read for the last time
+   virtual bool getTimeSpan(double* const first, double* const last);
+
+   // The file's index, which is loaded (or built) as needed; zero if the file can't be opened
+   const RecordIndex* getIndex();
+
+   // File offset of the next record, and positions the file at the record
+   // at file offset 'offset' (e.g., from the index); setOffset() opens the
+   // file, if needed, and then the 'startTime' isn't used.
+   unsigned long long getOffset() const;
+   virtual bool setOffset(const unsigned long long offset);
+
    // File and path names; set before calling openFile()
    virtual bool setFilename(const Basic::String* const msg);
    virtual bool setPathName(const Basic::String* const msg);
+   virtual bool setStartTime(const double sec);
 
 protected:
+   bool setSlotStartTime(const Basic::Time* const msg);
+
    const DataRecordHandle* readRecordImp() override;
 
 private:
    void initData();
+   unsigned int readData();
+   bool loadIndex();
+   bool scanRecords(const unsigned long long start, const unsigned long long end, const unsigned int id, const double execTime);
+   void seekOffset(const unsigned long long offset);
+
+   static const unsigned int ANY_ID = 0xffffffff;
+   static const double DEFAULT_INDEX_INTERVAL;    // Interval used when building an index (sec)
 
    char* ibuf;                      // Input data buffer
+   unsigned int ibufSize;           // Size of the input data buffer
+   unsigned int version;            // Data file version
+   unsigned long long dataOffset;   // File offset of the first record
+   RecordIndex* index;              // Index of the data file's records (or zero)
+   std::string indexFilename;       // Index file name (used if the data file wasn't closed)
+   Pb::DataRecord* scanRecord;      // Data record used while scanning
+   double startTime;                // Exec time of the first record to read (sec)
+   bool startTimeFlg;               // Seek to 'startTime' on the first pass
 
    std::ifstream* sin;              // Input stream
    const Basic::String* filename;   // File name
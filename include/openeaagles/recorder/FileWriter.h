@@ -7,8 +7,9 @@
 #include "openeaagles/recorder/OutputHandler.h"
 
 namespace Eaagles {
-   namespace Basic { class String; }
+   namespace Basic { class Number; class String; class Time; }
 namespace Recorder {
+   class RecordIndex;
 
 //------------------------------------------------------------------------------
 // Class:   FileWriter
@@ -19,12 +20,25 @@ namespace Recorder {
 // Slots:
 //     filename       <String>     ! Data file name
 //     pathname       <String>     ! Path to the data file's directory (optional)
+//     bufferSize     <Number>     ! Size of the write buffer (bytes) (default: 1MB;
+//                                 ! zero to write each record as it's processed)
+//     version        <Number>     ! Data file version: 1 -- sequential, or
+//                                 ! 2 -- indexed (default: 2)
+//     indexInterval  <Time>       ! Exec time between index intervals (default: 1 sec)
+//     indexFileInterval <Time>    ! Exec time between the index blocks that are written to
+//                                 ! the index file (default: 10 sec; zero for no index file)
 //
 // Note:
-//    1) The data file consists of a sequence of serialized data records
-//    that are preceded by 4 bytes that provided the size of each data record
-//    in bytes.  The 4 bytes are stored as an ascii string with leading spaces
-//    (e.g., " 123")
+//    1) An indexed data file (version 2) has a header, a sequence of serialized
+//    data records that are each preceded by their size in bytes, as a binary
+//    varint, and a time and record id index at the end of the file, which is
+//    written when the file is closed.  The FileReader uses the index to seek
+//    to a time or a type of data record (see RecordIndex.h for the layout).
+//
+//    A sequential data file (version 1) consists of a sequence of serialized
+//    data records that are preceded by 4 bytes that provided the size of each
+//    data record in bytes.  The 4 bytes are stored as an ascii string with
+//    leading spaces (e.g., " 123"), so records are limited to 9999 bytes.
 //
 //    2) During open(), if the file already exists then a version number is appended
 //    to the end of the file name.  (e.g., filename_v01 to filename_v99)
@@ -35,6 +49,19 @@ namespace Recorder {
 //    4) File will be closed with an end of data (REID_END_OF_DATA) message.
 //    Calling openFile() or sending any additional data messages will open
 //    a new file with a new version number.
+//
+//    5) Serialized records are collected in the write buffer, which is
+//    written to the file with a single large write when it's full, and when
+//    the file is closed.  Records larger than the buffer are written directly.
+//
+//    6) While an indexed data file is open, the index entries are also
+//    written, in blocks, to an index file (the data file name plus ".idx"),
+//    every 'indexFileInterval' seconds of exec time.  The write buffer is
+//    written to the data file before each block, so the blocks only index
+//    records that are in the data file.  If the data file isn't closed (e.g.,
+//    the application crashed), the FileReader uses the index file's blocks and
+//    only reads the records after the last one.  The index file is removed
+//    when the data file is closed with its own index.
 //------------------------------------------------------------------------------
 class FileWriter : public OutputHandler
 {
@@ -55,19 +82,41 @@ public:
    const char* getFullFilename() const;   // File name with path and possible version number
                                           // (valid only while file is open)
 
+   unsigned int getBufferSize() const;    // Size of the write buffer (bytes)
+   unsigned int getVersion() const;       // Data file version
+   double getIndexInterval() const;       // Exec time between index intervals (sec)
+   double getIndexFileInterval() const;   // Exec time between index file blocks (sec)
+
    // File and path names; set before calling openFile()
    virtual bool setFilename(const Basic::String* const msg);
    virtual bool setPathName(const Basic::String* const msg);
+   virtual bool setBufferSize(const unsigned int size);
+   virtual bool setVersion(const unsigned int v);          // Set before calling openFile()
+   virtual bool setIndexInterval(const double sec);
+   virtual bool setIndexFileInterval(const double sec);    // Zero for no index file
+
+   static const unsigned int DEFAULT_BUFFER_SIZE = 1048576;
 
 protected:
    void setFullFilename(const char* const name);
 
+   bool setSlotBufferSize(const Basic::Number* const msg);
+   bool setSlotVersion(const Basic::Number* const msg);
+   bool setSlotIndexInterval(const Basic::Time* const msg);
+   bool setSlotIndexFileInterval(const Basic::Time* const msg);
+
    void processRecordImp(const DataRecordHandle* const handle) override;
 
    bool shutdownNotification() override;
 
 private:
    void initData();
+   void writeData(const char* const data, const unsigned int n);
+   void flushBuffer();
+   void writeIndex();
+   void openIndexFile();
+   void writeIndexBlock();
+   void closeIndexFile();
 
    std::ofstream* sout;             // Output stream
 
@@ -78,6 +127,21 @@ private:
    bool fileOpened;                 // File opened
    bool fileFailed;                 // Open or write failed
    bool eodFlag;                    // REID_END_OF_DATA message has been written
+
+   char* buffer;                    // Write buffer
+   unsigned int bufferSize;         // Size of the write buffer (bytes)
+   unsigned int bufferLen;          // Number of bytes in the write buffer
+   std::string wireFormat;          // Serialized data record (reused)
+   unsigned long long fileOffset;   // Number of bytes written to the file (including the buffer)
+
+   unsigned int version;            // Data file version
+   double indexInterval;            // Exec time between index intervals (sec)
+   RecordIndex* index;              // Index of the records written to the file
+
+   std::ofstream* isout;            // Index file output stream (see Note 6)
+   double indexFileInterval;        // Exec time between index file blocks (sec)
+   double indexFileTime;            // Exec time of the last index file block (sec), or negative before the first record
+   unsigned int indexFileEntries;   // Number of index entries written to the index file
 };
 
 } // End Recorder namespace
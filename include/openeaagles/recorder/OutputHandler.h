@@ -6,12 +6,16 @@
 
 #include "openeaagles/simulation/DataRecorder.h"
 #include "openeaagles/basic/List.h"
+#include "openeaagles/basic/safe_ptr.h"
+
+#include <atomic>
 
 namespace Eaagles {
-   namespace Basic { class List; }
+   namespace Basic { class List; class Number; class Thread; }
 
 namespace Recorder {
    class DataRecordHandle;
+   class WriterThread;
 
 //------------------------------------------------------------------------------
 // Class: OutputHandler
@@ -30,7 +34,23 @@ namespace Recorder {
 //    of subcomponent OutputHandlers.  The prcessRecord() function for each
 //    subcomponent OutputHandler is called from our processRecord() function.
 //
+//    4) The queue is a fixed size, lock-free ring buffer (QUEUE_SIZE records),
+//    so any number of threads can add records without blocking each other
+//    or the thread that's processing the queue.  When the ring is full, the
+//    records overflow into a locked list, which is emptied, in order, after
+//    the ring.
+//
+//    5) With a 'writerRate', the queue is processed by our own writer thread,
+//    and the processQueue() function only starts the thread, which keeps the
+//    serialization and I/O off of the background thread.  At shutdown, the
+//    writer thread is stopped and the records that are left in the queue are
+//    processed by the shutdownNotification() function.
+//
 // Factory name: OutputHandler
+// Slots:
+//    writerRate     <Number>    ! Writer thread rate (Hz) (default: 0 -- no writer
+//                               ! thread; the queue is processed by processQueue())
+//    writerPriority <Number>    ! Writer thread priority (0.0 to 1.0) (default: 0.5)
 //
 // Overriding the Component class slot:
 //    components     ! Must contain only 'OutputHandler' type objects
@@ -49,10 +69,23 @@ public:
    // Add the data record to a queue for later processing
    void addToQueue(const DataRecordHandle* const handle);
 
-   // Process all data records from the queue
+   // Process all data records from the queue (or start the writer thread)
    void processQueue();
 
+   LCreal getWriterRate() const                 { return writerRate; }
+   LCreal getWriterPriority() const             { return writerPriority; }
+
+   virtual bool setWriterRate(const LCreal hz);
+   virtual bool setWriterPriority(const LCreal pri);
+
+   static const unsigned int QUEUE_SIZE = 4096;          // Size of the lock-free queue (power of two)
+   static const LCreal DEFAULT_WRITER_PRI;               // Default writer thread priority
+
 protected:
+   // Slot functions
+   virtual bool setSlotWriterRate(const Basic::Number* const msg);
+   virtual bool setSlotWriterPriority(const Basic::Number* const msg);
+
    // Process record implementations by derived classes
    virtual void processRecordImp(const DataRecordHandle* const handle);
 
@@ -68,10 +101,35 @@ protected:
    bool shutdownNotification() override;
 
 private:
+   friend class WriterThread;
+
    void initData();
+   bool putQueue(const DataRecordHandle* const handle);
+   const DataRecordHandle* getQueue();
+   void emptyQueue(const bool process);
+   void writeQueue();
+   void drainQueue(const bool process);
+   bool createWriterThread();
+   void stopWriterThread();
+
+   // Lock-free (multiple producer, single consumer) ring buffer
+   struct QueueSlot {
+      std::atomic<unsigned int> seq;         // Sequence number
+      const DataRecordHandle* handle;        // Queued data record
+   };
+   QueueSlot* ring;                          // Ring buffer (QUEUE_SIZE slots)
+   std::atomic<unsigned int> ringHead;       // Next slot to put (producers)
+   unsigned int ringTail;                    // Next slot to get (consumer)
+
+   Basic::List queue;                        // Overflow queue (used when the ring is full)
+   std::atomic<unsigned int> numOverflow;    // Number of records in the overflow queue
+   mutable long semaphore;                   // Overflow queue lock
+   long consumer;                            // Lock held while the queue is being processed
 
-   Basic::List queue; // Data Record Queue
-   mutable long semaphore;
+   LCreal writerRate;                        // Writer thread rate (Hz) (or zero)
+   LCreal writerPriority;                    // Writer thread priority
+   Basic::safe_ptr<Basic::Thread> writer;    // Writer thread
+   std::atomic<bool> writerStopped;          // Writer thread has been stopped
 };
 
 } // End Recorder namespace
@@ -0,0 +1,201 @@
+//------------------------------------------------------------------------------
+// Class: ParallelReader
+//------------------------------------------------------------------------------
+#ifndef __Eaagles_Recorder_ParallelReader_H__
+#define __Eaagles_Recorder_ParallelReader_H__
+
+#include "openeaagles/recorder/InputHandler.h"
+
+#include <atomic>
+
+namespace Eaagles {
+   namespace Basic { class Number; class PairStream; class PhaseBarrier; class Time; class WorkStealingExecutor; }
+namespace Recorder {
+   namespace Pb { class DataRecord; }
+   class FileReader;
+   class ParallelReaderThread;
+   class PrintSelected;
+   class RecordIndex;
+
+//------------------------------------------------------------------------------
+// Class:   ParallelReader
+// Description: Reads, parses and selects the data records of one or more data
+//              files using a pool of threads, and returns the selected records
+//              in exec time order.
+//
+//    Each file is divided into chunks of about 'chunkSize' bytes at the
+//    intervals of its index (see RecordIndex.h).  The chunks are parsed and
+//    checked against the selections by the threads, and then the selected
+//    records of the files are merged, by exec time, as they're read.
+//
+// Factory name: RecorderParallelReader
+// Slots:
+//     files          <PairStream>   ! Data files; a list of RecorderFileReader (required)
+//     selections     <PairStream>   ! Record selections; a list of PrintSelected; a record
+//                                   ! is selected if any of them would print it
+//                                   ! (default: all records)
+//     numThreads     <Number>       ! Number of threads, including the caller's thread
+//                                   ! (default: one per processor)
+//     chunkSize      <Number>       ! Approx size of each file chunk (bytes) (default: 1MB)
+//     startTime      <Time>         ! Exec time of the first record (default: start of the files)
+//     endTime        <Time>         ! Exec time of the last record (default: end of the files)
+//
+// Example:
+//
+//    ( RecorderParallelReader
+//       files: {
+//          ( RecorderFileReader filename: "run1.edr" )
+//          ( RecorderFileReader filename: "run2.edr" )
+//       }
+//       selections: {
+//          // Weapon detonations that hit a player
+//          ( PrintSelected
+//             messageToken: 63
+//             fieldName: "Eaagles.Recorder.Pb.WeaponDetonationEventMsg.det_type"
+//             compareToValI: 1
+//          )
+//       }
+//    )
+//
+// Notes:
+//    1) The slots are used with the first call to readRecord(), which opens
+//    the files and loads their indexes, so files without an index are read
+//    once, by the caller's thread, to build one.
+//
+//    2) The selections only select the records; they're not used to print
+//    them.  A record's id must also be enabled (see RecorderComponent).
+//
+//    3) The records of each file are assumed to be in exec time order.
+//    Records with the same exec time are returned in file order (i.e., the
+//    order of the 'files' list).  The files' end of data records, if they're
+//    selected, are replaced by a single end of data record after the last
+//    record.
+//
+//    4) Our threads end with the SHUTDOWN_EVENT, which is needed before
+//    the reader can be deleted.
+//------------------------------------------------------------------------------
+class ParallelReader : public InputHandler
+{
+    DECLARE_SUBCLASS(ParallelReader, InputHandler)
+
+public:
+   static const unsigned int MAX_THREADS = 32;              // Max number of threads
+   static const unsigned int DEFAULT_CHUNK_SIZE = 1000000;  // Default chunk size (bytes)
+   static const unsigned int CHUNKS_PER_THREAD = 2;         // Chunks parsed by each thread per pass
+   static const LCreal DEFAULT_THREAD_PRI;                  // Default thread priority
+
+public:
+   ParallelReader();
+
+   unsigned int getNumFiles() const;               // Number of data files
+   unsigned int getNumChunks() const;              // Number of file chunks (after the first read)
+   unsigned int getNumThreads() const;             // Number of threads; zero for one per processor
+   unsigned int getChunkSize() const;              // Approx size of each file chunk (bytes)
+   unsigned long getNumRecordsRead() const;        // Number of records parsed
+   unsigned long getNumRecordsSelected() const;    // Number of records selected
+
+   // True if the record is within the start and end times, its id is
+   // enabled and it's selected by one of the selections (thread safe)
+   virtual bool isRecordSelected(const Pb::DataRecord* const dataRecord) const;
+
+   // Set functions; set before the first read
+   virtual bool setNumThreads(const unsigned int n);
+   virtual bool setChunkSize(const unsigned int n);
+   virtual bool setStartTime(const double sec);
+   virtual bool setEndTime(const double sec);
+
+   // Parses and selects the records of the chunks that are assigned to 'worker'
+   // (called by our threads and by the reader's thread)
+   void decodeChunks(const unsigned int worker);
+
+   // Slot functions
+   virtual bool setSlotFiles(const Basic::PairStream* const msg);
+   virtual bool setSlotSelections(const Basic::PairStream* const msg);
+   virtual bool setSlotNumThreads(const Basic::Number* const msg);
+   virtual bool setSlotChunkSize(const Basic::Number* const msg);
+   virtual bool setSlotStartTime(const Basic::Time* const msg);
+   virtual bool setSlotEndTime(const Basic::Time* const msg);
+
+   bool shutdownNotification() override;
+
+protected:
+   const DataRecordHandle* readRecordImp() override;
+
+private:
+   // A chunk of a data file, and its selected records
+   struct Chunk {
+      unsigned int file;                  // Data file index
+      unsigned long long start;           // File offset of the first record
+      unsigned long long end;             // File offset after the last record (or zero: end of records)
+      const DataRecordHandle** records;   // Selected records
+      unsigned int numRecords;            // Number of selected records
+      unsigned int maxRecords;            // Size of the 'records' array
+      const DataRecordHandle* eod;        // Selected end of data record (or zero)
+   };
+
+   // Data file state
+   struct FileState {
+      FileReader* source;                 // Data file (from the 'files' slot)
+      unsigned int firstChunk;            // Index of the file's first chunk
+      unsigned int endChunk;              // Index after the file's last chunk
+      unsigned int nextChunk;             // Next chunk to be parsed
+      unsigned int curChunk;              // Chunk that we're returning records from
+      unsigned int curRecord;             // Next record to return from 'curChunk'
+   };
+
+   void initData();
+   bool prepare();
+   void createThreads();
+   void stopThreads();
+   void clearChunks();
+   void addChunks(const unsigned int file, const RecordIndex* const index);
+   void decodePass();
+   void decodeChunk(Chunk* const chunk, FileReader* const reader);
+   void releaseChunk(Chunk* const chunk, const unsigned int first);
+
+   // Slot data
+   Basic::PairStream* files;           // Data files (FileReader)
+   Basic::PairStream* selections;      // Record selections (PrintSelected)
+   unsigned int numThreads;            // Requested number of threads (zero: one per processor)
+   unsigned int chunkSize;             // Approx size of each file chunk (bytes)
+   double startTime;                   // Exec time of the first record (sec)
+   double endTime;                     // Exec time of the last record (sec)
+   bool startTimeFlg;                  // Start time is valid
+   bool endTimeFlg;                    // End time is valid
+
+   // Files and chunks
+   FileState* fstate;                  // State of each data file
+   unsigned int numFiles;              // Number of data files
+   Chunk* chunks;                      // All chunks, in file order
+   unsigned int numChunks;             // Number of chunks
+   unsigned int* passChunks;           // Chunks to be parsed during this pass
+   unsigned int numPassChunks;         // Number of chunks in this pass
+   const PrintSelected** selects;      // Record selections
+   unsigned int numSelects;            // Number of selections
+   FileReader** readers;               // Each worker's file readers [ worker * numFiles + file ]
+   const DataRecordHandle* eod;        // End of data record; returned after the last record
+   bool prepared;                      // Files have been opened and divided into chunks
+
+   // Workers: our threads plus the reader's thread, which is the last worker
+   ParallelReaderThread* threads[MAX_THREADS];
+   unsigned int numWorkerThreads;      // Number of threads that are running
+   unsigned int numWorkers;            // Number of workers
+   Basic::PhaseBarrier* barrier;       // Starts and joins our threads
+   Basic::WorkStealingExecutor* exec;  // Distributes the chunks to the workers
+
+   std::atomic<unsigned long> numRead;       // Number of records parsed
+   std::atomic<unsigned long> numSelected;   // Number of records selected
+};
+
+// inline
+inline unsigned int ParallelReader::getNumFiles() const           { return numFiles; }
+inline unsigned int ParallelReader::getNumChunks() const          { return numChunks; }
+inline unsigned int ParallelReader::getNumThreads() const         { return numThreads; }
+inline unsigned int ParallelReader::getChunkSize() const          { return chunkSize; }
+inline unsigned long ParallelReader::getNumRecordsRead() const    { return numRead.load(); }
+inline unsigned long ParallelReader::getNumRecordsSelected() const { return numSelected.load(); }
+
+} // End Recorder namespace
+} // End Eaagles namespace
+
+#endif
@@ -23,7 +23,7 @@ namespace Recorder {
       class PlayerKilledEventMsg; class WeaponReleaseEventMsg; class WeaponHungEventMsg;
       class WeaponDetonationEventMsg; class GunFiredEventMsg; class NewTrackEventMsg;
       class TrackRemovedEventMsg; class TrackDataMsg; class PlayerId; class PlayerState;
-      class TrackData; class EmissionData;
+      class TrackData; class EmissionData; class DataRecord;
    }
 
 //------------------------------------------------------------------------------
@@ -39,6 +39,17 @@ namespace Recorder {
 //   compareToValD   <Basic::Number>   ! value to compare (dbl)
 //   condition       <Basic::String>   ! EQ, LT, or GT (ignored for bool and strings)
 //   timeOnly        <Basic::Number>   ! match time conditions only. Print ALL messages that match
+//
+// Notes:
+//    1) The condition is compiled, when the message token or the field name
+//    is set, into lists of field descriptors that lead from the time message
+//    and from the event message down to the fields named 'fieldName'.  Each
+//    record then only looks at those fields, instead of walking all of the
+//    fields of its messages.
+//
+//    2) isSelected() checks a data record against the condition without
+//    printing it.  It doesn't change this object, so it can be called from
+//    several threads at once (e.g., see ParallelReader).
 //------------------------------------------------------------------------------
 class PrintSelected : public PrintHandler
 {
@@ -74,6 +85,9 @@ public:
    bool setCompareCondition(const Condition cc );
    bool setTimeOnly(const bool flg );
 
+   // True if the data record matches the selection criteria (i.e., it would be printed)
+   virtual bool isSelected(const Pb::DataRecord* const dataRecord) const;
+
 protected:
 
    void processRecordImp(const DataRecordHandle* const handle) override;
@@ -89,7 +103,20 @@ protected:
 
    std::string printTimeMsg(double time);
 private:
+   static const unsigned int MAX_PATHS = 8;        // Max fields matching 'fieldNameStr' per message
+   static const unsigned int MAX_PATH_DEPTH = 8;   // Max depth of embedded messages
+
+   // Field descriptors from a message down to one of its (embedded) fields
+   struct FieldPath {
+      const google::protobuf::FieldDescriptor* fields[MAX_PATH_DEPTH];
+      unsigned int depth;
+   };
+
    void initData();
+   void compileConditions();
+   unsigned int compileMessage(const google::protobuf::Descriptor* const descriptor, FieldPath* const paths, const unsigned int n, FieldPath* const path) const;
+   bool matchPaths(const google::protobuf::Message* const msg, const FieldPath* const paths, const unsigned int n) const;
+   bool matchField(const google::protobuf::Message& msg, const google::protobuf::FieldDescriptor* const fieldDescriptor) const;
 
    // slot data:
 
@@ -106,6 +133,13 @@ private:
    bool printHeader;
    bool timeOnly;
 
+   // compiled condition
+   const google::protobuf::FieldDescriptor* eventField;  // DataRecord's field for the 'msgToken' event message
+   FieldPath timePaths[MAX_PATHS];                       // Paths to the selected field in the time message
+   unsigned int numTimePaths;
+   FieldPath eventPaths[MAX_PATHS];                      // Paths to the selected field in the event message
+   unsigned int numEventPaths;
+   mutable bool pathLimitWarned;                         // Warned that MAX_PATHS or MAX_PATH_DEPTH was exceeded
 
 };
 
@@ -0,0 +1,72 @@
+//------------------------------------------------------------------------------
+// Class: RecordArena
+//------------------------------------------------------------------------------
+#ifndef __Eaagles_Recorder_RecordArena_H__
+#define __Eaagles_Recorder_RecordArena_H__
+
+#include "openeaagles/basic/Object.h"
+
+namespace google { namespace protobuf { class Arena; } }
+
+namespace Eaagles {
+namespace Recorder {
+
+   // Main (protocol buffer) data record
+   namespace Pb { class DataRecord; }
+
+//------------------------------------------------------------------------------
+// Class: RecordArena
+// Description: Ref-counted protocol buffer arena that DataRecords are
+//              allocated from.  Allocating a record from an arena is little
+//              more than a pointer bump, and all of the arena's records are
+//              released at once, with the arena.
+//
+// Notes:
+//    1) The DataRecordHandle of an arena allocated record holds a reference
+//       to the arena, so the arena, and all of its records, are deleted
+//       after the last of its handles has been deleted.
+//
+//    2) Arena allocation requires protocol buffers v3.14 or later, where all
+//       messages are arena enabled.  With older versions, isSupported() is
+//       false and createRecord() returns a new heap allocated record, which
+//       the caller owns.
+//
+//    3) This class is not thread safe; the DataRecorder creates the records
+//       and manages the pending count under its own lock.
+//------------------------------------------------------------------------------
+class RecordArena : public Basic::Object
+{
+    DECLARE_SUBCLASS(RecordArena, Basic::Object)
+
+public:
+   RecordArena(const unsigned int blockSize);
+
+   // True if arena allocation is supported by this protocol buffers version
+   static bool isSupported();
+
+   // Creates a new, empty data record
+   Pb::DataRecord* createRecord();
+
+   // True if the data record was allocated from this arena
+   bool isOwner(const Pb::DataRecord* const record) const;
+
+   unsigned int getNumRecords() const     { return numRecords; }    // Records created
+   unsigned int getNumPending() const     { return numPending; }    // Records created but not yet sent
+   void setNumPending(const unsigned int n)  { numPending = n; }
+
+protected:
+   RecordArena();  // Default Constructor
+
+private:
+   void initData();
+
+   google::protobuf::Arena* arena;  // Protocol buffer arena (or zero)
+   unsigned int blockSize;          // Arena block size (bytes)
+   unsigned int numRecords;         // Number of records created
+   unsigned int numPending;         // Number of records created but not yet sent
+};
+
+} // End Recorder namespace
+} // End Eaagles namespace
+
+#endif
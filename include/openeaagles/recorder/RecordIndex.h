@@ -0,0 +1,166 @@
+//------------------------------------------------------------------------------
+// Class: RecordIndex
+//------------------------------------------------------------------------------
+#ifndef __Eaagles_Recorder_RecordIndex_H__
+#define __Eaagles_Recorder_RecordIndex_H__
+
+#include "openeaagles/basic/Object.h"
+#include <string>
+
+namespace Eaagles {
+namespace Recorder {
+
+//------------------------------------------------------------------------------
+// Class: RecordIndex
+// Description: Time and record id index of a data recorder file, which is
+//              written to the end of an indexed (version 2) data file by the
+//              FileWriter and used by the FileReader to seek to a time or to
+//              a type of data record.
+//
+// Indexed data file (version 2):
+//
+//    Header      8 bytes: "OEDR", version (2) and three reserved bytes
+//    Records     Each serialized DataRecord is preceded by its size in bytes,
+//                which is stored as a base 128 varint (same as protocol buffers)
+//    End         A zero size marks the end of the records
+//    Index       Entries of ENTRY_SIZE bytes (see below)
+//    Trailer     TRAILER_SIZE bytes: index file offset (8 bytes), number of
+//                index entries (4 bytes) and "OEDX"
+//
+//    All binary values are little-endian.  Each index entry contains the
+//    record's sim time and exec time (8 byte doubles), the record's file
+//    offset (8 bytes), its id (4 bytes) and flags (4 bytes).
+//
+// Index file (see getIndexFilename()):
+//
+//    While the data file is open, the FileWriter appends blocks of index
+//    entries to an index file, so the records of a data file that wasn't
+//    closed (e.g., the application crashed) are still indexed.  Each block
+//    holds the entries added since the previous block:
+//
+//    Header      BLOCK_HEADER_SIZE bytes: number of entries (4 bytes) and "OEDB"
+//    Entries     Same as the data file's index entries
+//    Trailer     TRAILER_SIZE bytes: data file offset of the end of the records
+//                that are indexed (8 bytes), number of entries (4 bytes) and "OEDB"
+//
+// Notes:
+//    1) The records are divided into intervals of exec time.  The first record
+//       of each interval is indexed, with the INTERVAL_START flag, and so is
+//       the first record of each record id within an interval.  So an interval
+//       needs to be scanned, at most, to find the exact record.
+//
+//    2) The entries are in file order, so their exec times are assumed to be
+//       increasing; findRecord() is O(log n) using a list of the entries that
+//       is sorted by record id, which is built as needed.
+//------------------------------------------------------------------------------
+class RecordIndex : public Basic::Object
+{
+    DECLARE_SUBCLASS(RecordIndex, Basic::Object)
+
+public:
+   // Index entry
+   struct Entry {
+      double simTime;               // Sim time of day (sec)
+      double execTime;              // Exec time (sec)
+      unsigned long long offset;    // File offset of the record's size
+      unsigned int id;              // Record id (REID_*)
+      unsigned int flags;           // Entry flags
+   };
+
+   static const unsigned int INTERVAL_START = 0x01;   // Entry flag: first record of an interval
+
+   static const unsigned int VERSION = 2;             // Indexed data file version
+   static const unsigned int HEADER_SIZE = 8;         // Size of the file header (bytes)
+   static const unsigned int ENTRY_SIZE = 32;         // Size of an index entry in the file (bytes)
+   static const unsigned int TRAILER_SIZE = 16;       // Size of the file trailer (bytes)
+   static const unsigned int BLOCK_HEADER_SIZE = 8;   // Size of an index file block's header (bytes)
+   static const unsigned int MAX_VARINT_SIZE = 10;    // Max size of a varint (bytes)
+   static const unsigned int MAX_INTERVAL_IDS = 64;   // Max record ids indexed per interval
+
+public:
+   RecordIndex();
+
+   unsigned int getNumEntries() const     { return numEntries; }
+   const Entry* getEntry(const unsigned int idx) const;
+
+   // Adds an entry (entries are added in file order)
+   void add(const Entry& entry);
+
+   // Indexes a record, if it's the first record of a new interval, or the
+   // first record of its id within the current interval (records are added
+   // in file order).  Returns true if the record was indexed.
+   bool addRecord(
+      const double simTime,               // Record's sim time (sec)
+      const double execTime,              // Record's exec time (sec)
+      const unsigned int id,              // Record's id
+      const unsigned long long offset,    // Record's file offset
+      const double interval               // Exec time between intervals (sec)
+   );
+
+   // Removes all entries
+   void clear();
+
+   // Index of the last interval start entry with an exec time before 'execTime',
+   // or -1 if there isn't one
+   int findInterval(const double execTime) const;
+
+   // Index of the next interval start entry after entry 'idx', or -1 if there isn't one
+   int findNextInterval(const int idx) const;
+
+   // Index of the first entry for record 'id' with an exec time at or after
+   // 'execTime', or -1 if there isn't one
+   int findRecord(const unsigned int id, const double execTime) const;
+
+   // Encodes the index entries and the trailer; 'offset' is the file offset of
+   // the first entry.  Returns the number of bytes, which is
+   // (getNumEntries() * ENTRY_SIZE + TRAILER_SIZE), in 'buffer'.
+   unsigned int encode(char* const buffer, const unsigned long long offset) const;
+
+   // Reads the index from the end of an indexed data file; returns false if
+   // the file doesn't have an index (e.g., the writer didn't close the file)
+   bool read(std::istream& sin);
+
+   // Encodes an index file block of the entries from entry 'first' on; 'offset'
+   // is the data file offset of the end of the indexed records.  Returns the
+   // number of bytes, which is ((getNumEntries() - first) * ENTRY_SIZE +
+   // BLOCK_HEADER_SIZE + TRAILER_SIZE), in 'buffer'.
+   unsigned int encodeBlock(char* const buffer, const unsigned int first, const unsigned long long offset) const;
+
+   // Reads the complete blocks of an index file; returns false if there
+   // aren't any, else the data file offset of the end of the indexed records
+   // is returned in 'offset'
+   bool readBlocks(std::istream& sin, unsigned long long* const offset);
+
+   // Name of the index file of data file 'dataFilename'
+   static std::string getIndexFilename(const char* const dataFilename);
+
+   // File header
+   static void encodeHeader(char* const buffer);
+   static bool isHeader(const char* const buffer);
+
+   // Base 128 varints: putVarint() returns the number of bytes
+   // used, and getVarint() returns false at end of file or error.
+   static unsigned int putVarint(char* const buffer, const unsigned long long value);
+   static bool getVarint(std::istream& sin, unsigned long long* const value);
+
+private:
+   void initData();
+   void sortById() const;
+
+   Entry* entries;                  // Index entries
+   unsigned int numEntries;         // Number of entries
+   unsigned int maxEntries;         // Size of the entries array
+
+   mutable unsigned int* byId;      // Entry indices sorted by record id (and file order)
+   mutable bool byIdValid;          // 'byId' is valid
+
+   double intervalTime;             // Exec time of the current interval's first record
+   bool intervalStarted;            // An interval has been started
+   unsigned int intervalIds[MAX_INTERVAL_IDS]; // Record ids indexed in the current interval
+   unsigned int numIntervalIds;     // Number of record ids indexed in the current interval
+};
+
+} // End Recorder namespace
+} // End Eaagles namespace
+
+#endif
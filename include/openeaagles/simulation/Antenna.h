@@ -5,8 +5,6 @@
 #define __Eaagles_Simulation_Antenna_H__
 
 #include "openeaagles/simulation/ScanGimbal.h"
-#include "openeaagles/basic/safe_queue.h"
-#include "openeaagles/basic/safe_stack.h"
 
 namespace Eaagles {
    namespace Basic {
@@ -53,6 +51,14 @@ class RfSystem;
 //       system will try to reuse Emission objects, which removes the overhead
 //       of creating and deleting them.
 //
+//    3) The recycled emissions are kept in an emission pool that's owned by
+//       the antenna and is only used by its player's thread (rfTransmit(),
+//       process() and the reset and shutdown), so the pool isn't locked.
+//       Sent emissions are held on the pool's in-use list, and process()
+//       clears them and returns them to the free list once the targets have
+//       released them, so the pool doesn't keep players or data messages
+//       referenced.
+//
 //------------------------------------------------------------------------------
 class Antenna : public ScanGimbal
 {
@@ -133,11 +139,8 @@ protected:
 
    bool shutdownNotification() override;
 
-   Basic::safe_stack<Emission*> freeEmStack;  // Free emission stack
-   mutable long      freeEmLock;              // Semaphore to protect 'freeEmStack'
-
-   Basic::safe_queue<Emission*> inUseEmQueue; // In use emission queue
-   mutable long      inUseEmLock;             // Semaphore to protect 'inUseEmQueue'
+   Emission* getFreeEmission(const Emission* const xmit);  // Free emission packet from the pool (or a clone of 'xmit')
+   void recycleEmissions();                                // Moves released emissions to the free list
 
 private:
    void initData();
@@ -146,6 +149,12 @@ private:
 
    RfSystem*    sys;               // Assigned R/F system (e.g., sensor, radio)
 
+   // Emission pool (see Note 3)
+   Emission**   freeEms;           // Free emissions (stack)
+   unsigned int numFreeEms;        // Number of free emissions
+   Emission**   inUseEms;          // Emissions sent to the targets
+   unsigned int numInUseEms;       // Number of in-use emissions
+
    // Antenna parameters
    Polarization polar;             // Polarization                 (enum)
    double      gain;               // Gain                         (no units)
@@ -16,6 +16,7 @@ namespace Eaagles {
 namespace Simulation {
 
 class Emission;
+class Player;
 class SensorMsg;
 class Tdb;
 
@@ -239,6 +240,10 @@ public:  // Public section
    // Process the Players-Of-Interest (POI) list
    virtual unsigned int processPlayersOfInterest(Basic::PairStream* const poi);
 
+   // Arrays, at least 'n' long, for the Tdb's player spatial index queries;
+   // they're kept between frames and only used by our player's thread
+   Player** getPoiCandidateArrays(const unsigned int n, unsigned int** const work) const;
+
    // Sets the servo mode: { FREEZE_SERVO, RATE_SERVO, POSITION_SERVO }
    // Returns false if the mode could not be changed
    virtual bool setServoMode(const ServoMode m);
@@ -388,6 +393,10 @@ private:
    bool     ownHeadingOnly;   // Whether only the ownship heading is used by the target data block
 
    Basic::safe_ptr<Tdb> tdb;  // Current Target Data Block
+
+   mutable Player** poiCands;       // Player index query arrays (see getPoiCandidateArrays())
+   mutable unsigned int* poiWork;
+   mutable unsigned int poiArraySize;
 };
 
 } // End Simulation namespace
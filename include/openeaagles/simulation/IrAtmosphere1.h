@@ -35,6 +35,7 @@ class IrQueryMsg;
 //    solarRadiationTable        <Table2>       The table containing solar radiation tables
 //    backgroundRadiationTable   <Table3>       The background radiation table
 //    transmissivityTable        <Table4>       The table containing transmissivity data
+//    precompute                 <Number>       Precompute the tables at each waveband center on reset (default: false)
 //
 // Public Member Functions:
 //
@@ -100,6 +101,16 @@ class IrQueryMsg;
 //
 // Notes:
 //    1) The first index of each table represents the center frequency of the bins
+//
+//    2) If 'precompute' is true then reset() calls buildGrids(), which interpolates
+//       the three tables at each waveband's center and stores the results on the
+//       tables' other breakpoints, with the wavebands as the innermost index.
+//       calculateAtmosphereContribution() then finds the seeker altitude, target
+//       altitude, range and view angle breakpoints once per query, and interpolates
+//       all of the wavebands with the same breakpoints and fractions.  The results
+//       are the same as the tables' lfi() results, which buildGrids() checks at
+//       the center of each grid cell; getGridMaxError() returns the largest
+//       difference found.  All three tables are required.
 //------------------------------------------------------------------------------
 
 class IrAtmosphere1 : public IrAtmosphere
@@ -108,8 +119,18 @@ class IrAtmosphere1 : public IrAtmosphere
 
 public:
    IrAtmosphere1();
+
+   bool isPrecomputeEnabled() const    { return precomputeFlg; }
+   virtual bool setPrecomputeEnabled(const bool flg);
+
+   bool isGridValid() const            { return gridValid; }      // Grids have been built
+   LCreal getGridMaxError() const      { return gridMaxErr; }     // Largest difference found by buildGrids()
+   virtual bool buildGrids();
+
    bool calculateAtmosphereContribution(IrQueryMsg* const msg, LCreal* totalSignal, LCreal* totalBackground) override;
 
+   void reset() override;
+
 protected:
 
    LCreal getTransmissivity(
@@ -160,11 +181,42 @@ protected:
    virtual bool setSlotSolarRadiationTable(const Basic::Table2* const tbl);
    virtual bool setSlotBackgroundRadiationTable(const Basic::Table3* const tbl);
    virtual bool setSlotTransmissivityTable(const Basic::Table4* const tbl);
+   virtual bool setSlotPrecompute(const Basic::Number* const msg);
+
+   bool setSlotWaveBands(const Basic::Table1* const tbl) override;
 
 private:
+   // Breakpoints and interpolation fraction of an independent variable
+   struct Breakpoints {
+      unsigned int i1;     // First breakpoint
+      unsigned int i2;     // Second breakpoint
+      LCreal m;            // Fraction from i1 to i2
+   };
+
+   void initData();
+   void clearGrids();
+   void checkGrids();
+
+   static void findBreakpoints(Breakpoints* const bp, const LCreal x, const LCreal* const xData, const unsigned int nx, const bool eFlg);
+
+   LCreal getGridSolarRadiation(const unsigned int band, const Breakpoints& alt) const;
+   LCreal getGridBackgroundRadiation(const unsigned int band, const Breakpoints& alt, const Breakpoints& angle) const;
+   LCreal getGridTransmissivity(const unsigned int band, const Breakpoints& seekerAlt, const Breakpoints& targetAlt, const Breakpoints& range) const;
+
    const Basic::Table2* solarRadiationTable;
    const Basic::Table3* backgroundRadiationTable;
    const Basic::Table4* transmissivityTable;
+
+   bool precomputeFlg;        // Build the grids on reset()
+   bool gridValid;            // Grids have been built
+   unsigned int gridNumBands; // Number of wavebands in the grids
+   LCreal* bandLower;         // Lower wavelength of each band (microns)
+   LCreal* bandUpper;         // Upper wavelength of each band (microns)
+   LCreal* bandFraction;      // Ratio of each band's width to the total waveband
+   LCreal* solarGrid;         // Solar radiation by [target altitude][band]
+   LCreal* backgroundGrid;    // Background radiation by [view angle][seeker altitude][band]
+   LCreal* transGrid;         // Transmissivity by [range][target altitude][seeker altitude][band]
+   LCreal gridMaxErr;         // Largest difference found by buildGrids()
 };
 
 } // End Simulation namespace
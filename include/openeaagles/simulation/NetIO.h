@@ -50,6 +50,11 @@ namespace Simulation {
 //    maxEntityRange       (Basic::Distance)    ! Max entity range of networked players,
 //                                              !  or zero for no max range (default: 0 -- no range filtering)
 //
+//    maxDrCheckInterval   (Basic::Time)        ! Max time between the DR error checks of an outgoing entity,
+//                                              !  or zero to check every frame (default: 0) (see "Update scheduling")
+//    maxUpdateRate        (Basic::Number)      ! Max rate of DR updates of outgoing entities (updates/second),
+//                                              !  or zero for no limit (default: 0) (see "Update scheduling")
+//
 //
 // NetIO class objects:
 //
@@ -118,6 +123,39 @@ namespace Simulation {
 //    players that were discovered from other interoperability networks.
 //
 //
+// Nib lookup:
+//
+//    The input and output Nib lists are kept in player ID and federate name
+//    order, and each list also has a hash index (open addressing) from a
+//    packed integer key of the Nib's IDs, getNibKey(), to the Nib.  The
+//    findNib() functions use the hash index, so their lookups take constant
+//    time.  The default key is a hash of the player ID and federate name,
+//    which may not be unique, so findNib() confirms the IDs of each Nib that
+//    it finds.  Network specific classes can replace getNibKey() with an exact
+//    key, which their own lookups can then use directly with findNibByKey()
+//    (e.g., DIS player, site and application IDs).
+//
+//
+// Update scheduling:
+//
+//    Each frame, the outgoing Nibs check if their entity state needs to be
+//    sent (see Nib::isPlayerStateUpdateRequired()).  When 'maxDrCheckInterval'
+//    is set, a Nib that's within its DR error thresholds predicts, from the
+//    differences between its player's and DR model's velocity, acceleration
+//    and angular rates, when its errors could next reach the thresholds, and
+//    skips its DR error computations until then (but no longer than the
+//    interval).  Mode, appearance and articulated part changes and the max DR
+//    time are still checked every frame.
+//
+//    When 'maxUpdateRate' is set, the DR updates (max DR time and DR errors)
+//    are limited to that many per second; the budget is refilled each output
+//    frame, and the DR updates over the budget are deferred to later frames.
+//    The output list is processed starting with the first deferred Nib, so
+//    the deferred updates are sent first.  All other updates are always sent
+//    right away.  The rate should allow each entity at least one update per
+//    the receivers' max age.
+//
+//
 // Input/Output frames:
 //
 //    The functions inputFrame() and outputFrame() need to be called by our
@@ -213,6 +251,16 @@ public:
    // Dead-Reckoning: Returns max age before a networked player is removed (seconds)
    virtual LCreal getMaxAge(const Nib* const nib = 0) const;
 
+   // Update scheduling: max time between DR error checks (seconds), or zero for every frame
+   LCreal getMaxDrCheckInterval() const { return maxDrCheckInterval; }
+
+   // Update scheduling: max rate of DR updates (updates/second), or zero for no limit
+   LCreal getMaxUpdateRate() const { return maxUpdateRate; }
+
+   // Update scheduling: reserves a DR update from this frame's budget; returns
+   // false if the update must be deferred (see "Update scheduling")
+   virtual bool reserveOutputUpdate();
+
    // Network initialization
    bool isNetworkInitialized() const { return netInit; }
    bool didInitializationFail() const { return netInitFail; }
@@ -251,6 +299,8 @@ protected:
    virtual bool setMaxOrientationErr(const LCreal v);       // Sets the max orientation error (rad)
    virtual bool setMaxAge(const LCreal v);                  // Sets the max age; for removal (sec)
    virtual bool setMaxEntityRange(const LCreal v);          // Sets the max entity range (meters)
+   virtual bool setMaxDrCheckInterval(const LCreal v);      // Sets the max time between DR error checks (sec)
+   virtual bool setMaxUpdateRate(const LCreal v);           // Sets the max rate of DR updates (updates/sec)
    virtual bool setFederateName(const Basic::String* const msg);   // Sets our federate name
    virtual bool setFederationName(const Basic::String* const msg); // Sets our federation name
 
@@ -269,6 +319,8 @@ protected:
    virtual bool setSlotMaxOrientationErr(const Basic::Angle* const msg);       // Sets the max orientation error(s)
    virtual bool setSlotMaxAge(const Basic::Time* const msg);                   // Sets the max age(s)
    virtual bool setSlotMaxEntityRange(const Basic::Distance* const msg);       // Sets the max entity range(s)
+   virtual bool setSlotMaxDrCheckInterval(const Basic::Time* const msg);       // Sets the max time between DR error checks
+   virtual bool setSlotMaxUpdateRate(const Basic::Number* const msg);          // Sets the max rate of DR updates
 
    bool shutdownNotification() override;
 
@@ -286,6 +338,7 @@ public:
    // NIB support
    virtual Nib* findNib(const unsigned short playerID, const Basic::String* const federateName, const IoType ioType);
    virtual Nib* findNib(const Player* const player, const IoType ioType);
+   virtual Nib* findNibByKey(const unsigned long long key, const IoType ioType) const;
    virtual bool addNibToList(Nib* const nib, const IoType ioType);
    virtual void removeNibFromList(Nib* const nib, const IoType ioType);
 
@@ -303,6 +356,9 @@ protected:
    // Create NIB unique to protocol (pure functions!)
    virtual Nib* nibFactory(const NetIO::IoType ioType)=0;
 
+   // Packed integer key of the NIB hash index for these IDs (see "Nib lookup" above)
+   virtual unsigned long long getNibKey(const unsigned short playerID, const Basic::String* const federateName) const;
+
    // Create a new Network Interface Block (NIB) for 'player' and insert it
    // in the output list.  Returns a pointer to the new NIB or 0.
    Nib* insertNewOutputNib(Player* const player);
@@ -442,6 +498,14 @@ private:
    LCreal            maxOrientationErr;  // Maximum orientation error      (radians)
    LCreal            maxAge;           // Maximum age of networked players (seconds)
 
+   // Update scheduling
+   LCreal            maxDrCheckInterval; // Max time between DR error checks (seconds)
+   LCreal            maxUpdateRate;    // Max rate of DR updates           (updates/second)
+   LCreal            updateBudget;     // DR updates left in this frame's budget
+   unsigned int      outputIdx;        // Output list index of the Nib being processed
+   unsigned int      outputStartIdx;   // Output list index to start processing (first deferred Nib)
+   bool              updateDeferred;   // A DR update was deferred during this frame
+
 private: // Nib related private
    // input tables
    Nib*  inputList[MAX_OBJECTS];    // Table of input objects in name order
@@ -466,6 +530,22 @@ private: // Nib related private
    //   True types are (const NibKey* key, const Nib** nib)
    static int compareKey2Nib(const void* key, const void* nib);
 
+   // NIB hash index: open addressing with linear probing
+   struct NibIndex {
+      unsigned long long* keys;     // NIB keys (see getNibKey())
+      Nib** nibs;                   // NIBs (not ref()'d), or zero for empty slots
+      unsigned int mask;            // Table size less one (power of two)
+   };
+   NibIndex inputIndex;             // Index of the input list
+   NibIndex outputIndex;            // Index of the output list
+
+   void initNibIndex(NibIndex* const idx);
+   void freeNibIndex(NibIndex* const idx);
+   void clearNibIndex(NibIndex* const idx);
+   void insertNibIndex(NibIndex* const idx, Nib* const nib);
+   void eraseNibIndex(NibIndex* const idx, Nib* const nib);
+   static unsigned int hashNibKey(const unsigned long long key);
+
 private:  // Ntm related private
    static const unsigned int MAX_ENTITY_TYPES = EAAGLES_CONFIG_MAX_NETIO_ENTITY_TYPES;
 
@@ -225,6 +225,17 @@ protected:
    // Update our DR time and return the new time
    double updateDrTime(const double dt)               { return (drTime += dt); }
 
+   // Predicts the exec time (seconds) of our next DR error check (output only)
+   virtual LCreal predictDrCheckTime(
+         const SynchronizedState& state,  // Player's state
+         const double dT,                 // DR time (seconds)
+         const LCreal posMargin,          // Position error margin (meters), or negative if not checked
+         const LCreal angMargin           // Orientation error margin (radians), or negative if not checked
+      ) const;
+
+   // Checks the DR errors on the next update (e.g., after the DR thresholds have changed)
+   void resetDrCheckTime()                            { drCheckTime = 0.0; }
+
    bool shutdownNotification() override;
 
 private:
@@ -317,6 +328,9 @@ private:
    osg::Vec3d drPos;                   // Current DR position vector (meters) (ECEF)
    osg::Vec3d drAngles;                // Current DR angles (rad) [ roll pitch yaw ] (Body/ECEF)
 
+   // DR error check scheduling (outgoing only)
+   LCreal drCheckTime;                 // Exec time of our next DR error check (sec)
+
    // DR smoothing data
    osg::Vec3d  smoothVel;              // Smoothing Velocity (meters/second) (ECEF)
    double      smoothTime;             // Smoothing Time
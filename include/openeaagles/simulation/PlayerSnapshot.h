@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+// Class: PlayerSnapshot
+//------------------------------------------------------------------------------
+#ifndef __Eaagles_Simulation_PlayerSnapshot_H__
+#define __Eaagles_Simulation_PlayerSnapshot_H__
+
+#include "openeaagles/basic/Object.h"
+
+namespace Eaagles {
+   namespace Basic { class PairStream; }
+
+namespace Simulation {
+   class Player;
+
+//------------------------------------------------------------------------------
+// Class: PlayerSnapshot
+// Description: Read-only, frame stamped structure-of-arrays (SoA) copy of the
+//              player list's state, which is published by the Simulation at
+//              the end of the dynamics phase (phase 0) of each time-critical
+//              frame (see Simulation::getPlayerSnapshot()).
+//
+//    Consumers that only need to scan the players' state (e.g., sensors,
+//    network output lists, collision detection) can loop over these
+//    contiguous arrays instead of walking the player list and calling each
+//    player's getters.  All values are from the same point in the frame, so
+//    the time-critical and background threads see a consistent view.
+//
+//    Arrays are indexed [ 0 .. getNumPlayers()-1 ] in player list order:
+//
+//       getPlayers()                  Player pointers (see note 2)
+//       getGeocPosX(), Y(), Z()       Geocentric (ECEF) position (meters)
+//       getGeocVelX(), Y(), Z()       Geocentric (ECEF) velocity (m/s)
+//       getPosX(), Y(), Z()           Gaming area (NED) position (meters)
+//       getPhi(), getTheta(), getPsi() Euler angles (radians)
+//       getMajorTypes()               Player::MajorType bits
+//       getModes()                    Player::Mode
+//       getSides()                    Player::Side bits
+//       getNetworkIDs()               Network IDs (see Player::getNetworkID())
+//       getPlayerIDs()                Player IDs
+//       getFlags()                    Flag bits: NETWORKED, POS_VEC_VALID
+//                                     and NET_OUTPUT
+//
+// Notes:
+//    1) A snapshot is never changed once it has been published.  The
+//       Simulation recycles a snapshot only after all other references
+//       to it have been released.
+//
+//    2) The snapshot holds a reference to its player list, so its player
+//       pointers remain valid for as long as the snapshot is held.  Only the
+//       arrays are frozen; the players' own getters return their current state.
+//
+// Factory name: PlayerSnapshot
+//------------------------------------------------------------------------------
+class PlayerSnapshot : public Basic::Object
+{
+   DECLARE_SUBCLASS(PlayerSnapshot,Basic::Object)
+
+public:
+   // Flag bits
+   enum {
+      NETWORKED      = 0x01,     // Networked player (see Player::isNetworkedPlayer())
+      POS_VEC_VALID  = 0x02,     // Gaming area position is valid (see Player::isPositionVectorValid())
+      NET_OUTPUT     = 0x04      // Network output is enabled (see Player::isNetOutputEnabled())
+   };
+
+public:
+   PlayerSnapshot();
+
+   unsigned int getNumPlayers() const                 { return numPlayers; }
+   unsigned int getExecCounter() const                { return execCounter; }   // Simulation's executive counter when built
+   double getExecTime() const                         { return execTime; }      // Simulation's executive time when built (sec)
+
+   // The player list that we were built from
+   const Basic::PairStream* getPlayerList() const     { return playerList; }
+
+   Player* const* getPlayers() const                  { return players; }
+   const double* getGeocPosX() const                  { return gPosX; }
+   const double* getGeocPosY() const                  { return gPosY; }
+   const double* getGeocPosZ() const                  { return gPosZ; }
+   const double* getGeocVelX() const                  { return gVelX; }
+   const double* getGeocVelY() const                  { return gVelY; }
+   const double* getGeocVelZ() const                  { return gVelZ; }
+   const double* getPosX() const                      { return posX; }
+   const double* getPosY() const                      { return posY; }
+   const double* getPosZ() const                      { return posZ; }
+   const double* getPhi() const                       { return phi; }
+   const double* getTheta() const                     { return theta; }
+   const double* getPsi() const                       { return psi; }
+   const unsigned int* getMajorTypes() const          { return majorTypes; }
+   const unsigned char* getModes() const              { return modes; }
+   const unsigned int* getSides() const               { return sides; }
+   const int* getNetworkIDs() const                   { return netIDs; }
+   const unsigned short* getPlayerIDs() const         { return playerIDs; }
+   const unsigned char* getFlags() const              { return flags; }
+
+   // Builds the snapshot from the player list; only the Simulation should
+   // build a snapshot, and only before it has been published.
+   virtual bool build(Basic::PairStream* const list, const unsigned int execCounter, const double execTime);
+
+private:
+   void initData();
+   void clear();
+   void resize(const unsigned int n);
+
+   Basic::PairStream* playerList;   // Player list (ref()'d)
+   unsigned int numPlayers;         // Number of players
+   unsigned int capacity;           // Size of the arrays
+   unsigned int execCounter;        // Executive counter when built
+   double execTime;                 // Executive time when built (sec)
+
+   Player** players;
+   double* gPosX;
+   double* gPosY;
+   double* gPosZ;
+   double* gVelX;
+   double* gVelY;
+   double* gVelZ;
+   double* posX;
+   double* posY;
+   double* posZ;
+   double* phi;
+   double* theta;
+   double* psi;
+   unsigned int* majorTypes;
+   unsigned char* modes;
+   unsigned int* sides;
+   int* netIDs;
+   unsigned short* playerIDs;
+   unsigned char* flags;
+};
+
+} // End Simulation namespace
+} // End Eaagles namespace
+
+#endif
@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------------
+// Class: PlayerSpatialIndex
+//------------------------------------------------------------------------------
+#ifndef __Eaagles_Simulation_PlayerSpatialIndex_H__
+#define __Eaagles_Simulation_PlayerSpatialIndex_H__
+
+#include "openeaagles/basic/Object.h"
+#include "openeaagles/basic/osg/Vec3"
+
+namespace Eaagles {
+   namespace Basic { class PairStream; }
+
+namespace Simulation {
+   class Player;
+
+//------------------------------------------------------------------------------
+// Class: PlayerSpatialIndex
+// Description: Spatial index of the player list's positions, which is rebuilt
+//              once per background frame by the Simulation and is used by the
+//              Tdb to find the candidate players of interest without scanning
+//              the whole player list.
+//
+//    Two uniform grids of cubic cells are built: one using the players' world
+//    (ECEF) positions, and one using the local gaming area (NED) positions of
+//    the players with valid position vectors (see Player::isPositionVectorValid()).
+//    Only the occupied cells are stored, which are sorted by their cell key.
+//
+//    query() returns, in player list order, all players that were within
+//    'maxRange' meters of the query position and, optionally, within the cone
+//    of half angle 'maxAngle' about the unit 'boresight' vector.  Candidates
+//    are tested using the positions at the time the index was built, so the
+//    range and cone are widened by the caller's 'pad' distance, which is
+//    usually getMotionPad(), and the caller should always make its own final
+//    range and angle tests.
+//
+//    The result is approximate: it's the same as a scan of the player list
+//    only if no player has moved more than the pad since the index was built.
+//    getMotionPad() allows for twice the fastest player's speed at build time,
+//    so a player that is repositioned (e.g., reset, moved by the IG/host, or a
+//    networked player whose dead reckoning jumps to a new update), or whose
+//    gaming area position becomes valid, after the index was built can be
+//    missed until the index is rebuilt on the next background frame.  Use a
+//    cell size of zero (see the Simulation's 'playerIndexCellSize' slot) to
+//    always scan the whole player list.
+//
+//    The index holds a reference to the player list that it was built from
+//    (see getPlayerList()); the index is only valid for that list.
+//
+// Factory name: PlayerSpatialIndex
+//------------------------------------------------------------------------------
+class PlayerSpatialIndex : public Basic::Object
+{
+   DECLARE_SUBCLASS(PlayerSpatialIndex,Basic::Object)
+
+public:
+   static const double DEFAULT_CELL_SIZE;    // Default cell size (meters)
+   static const double MIN_MOTION_PAD;       // Minimum motion pad (meters)
+
+public:
+   PlayerSpatialIndex(const double cellSize);
+
+   double getCellSize() const                         { return cellSize; }
+   double getExecTime() const                         { return execTime; }
+   double getMaxSpeed() const                         { return maxSpeed; }
+   unsigned int getNumPlayers() const                 { return numPlayers; }
+
+   // The player list that we were built from
+   const Basic::PairStream* getPlayerList() const     { return playerList; }
+
+   // Distance (meters) that the players may have moved since the index
+   // was built, given the current executive time (seconds)
+   double getMotionPad(const double currentExecTime) const;
+
+   // (Re)builds the index from the player list
+   virtual bool build(Basic::PairStream* const players, const double execTime);
+
+   // Returns the number of candidate players, in player list order, that were
+   // within range (and the cone, if 'maxAngle' is greater than zero and less
+   // than PI) of 'p0'.  The 'ecef' flag selects the world (ECEF) or the gaming
+   // area (NED) grid.  The 'cands' array and the 'work' array, which is used
+   // as scratch space, must each be at least getNumPlayers() long.
+   virtual unsigned int query(
+      const bool ecef,
+      const osg::Vec3d& p0,
+      const double maxRange,
+      const double pad,
+      const osg::Vec3d& boresight,
+      const double maxAngle,
+      Player** const cands,
+      unsigned int* const work
+   ) const;
+
+protected:
+   PlayerSpatialIndex();
+
+private:
+   // Player entry
+   struct Entry {
+      unsigned long long key;    // Cell key
+      unsigned int idx;          // Index into the player list
+      double pos[3];             // Position (ECEF or NED)
+   };
+
+   // Occupied cell
+   struct Cell {
+      unsigned long long key;    // Cell key
+      int ijk[3];                // Cell indexes
+      unsigned int start;        // First entry
+      unsigned int count;        // Number of entries
+   };
+
+   // Grid of occupied cells
+   struct Grid {
+      Entry* entries;
+      Cell* cells;
+      unsigned int numEntries;
+      unsigned int numCells;
+   };
+
+   void initData();
+   void clear();
+   void buildGrid(Grid* const grid);
+   unsigned int queryGrid(const Grid* const grid, const osg::Vec3d& p0, const double maxRange, const double pad,
+                          const osg::Vec3d& boresight, const double maxAngle, unsigned int* const idx) const;
+   static bool inCone(const double* const v, const double dist, const double margin,
+                      const osg::Vec3d& boresight, const double maxAngle);
+   int cellIndex(const double v) const;
+   static unsigned long long cellKey(const int i, const int j, const int k);
+
+   Basic::PairStream* playerList;   // Player list (ref()'d)
+   Player** players;                // Players from the list, in list order
+   unsigned int numPlayers;         // Number of players
+   double cellSize;                 // Cell size (meters)
+   double execTime;                 // Executive time when built (seconds)
+   double maxSpeed;                 // Max player speed when built (m/s)
+
+   Grid ecefGrid;                   // World (ECEF) grid
+   Grid nedGrid;                    // Gaming area (NED) grid
+};
+
+} // End Simulation namespace
+} // End Eaagles namespace
+
+#endif
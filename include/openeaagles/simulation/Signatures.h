@@ -19,6 +19,7 @@
 
 namespace Eaagles {
    namespace Basic {
+      class Angle;
       class Number;
       class Table2;
    }
@@ -188,6 +189,13 @@ public:
 //    inDecibel  <Basic::Number>   ! True if the dependent data is in decibel meters
 //                                 ! squared instead of the default meters squared (default: false)
 //
+//    cacheResolution  <Basic::Angle>  ! Angular resolution of the aspect angle RCS cache;
+//                                     ! Basic::Angle or Basic::Number (radians)
+//                                     ! (default: 0 -- no cache)
+//
+//    cacheInterpolate <Basic::Number> ! True to interpolate between the cache's aspect bins;
+//                                     ! false to use the nearest bin (default: true)
+//
 // Notes:
 //  1) Must provide a Basic::Table2 (2 dimensional) table, where ...
 //       -- Azimuth is the first independent variable (radians),
@@ -202,10 +210,28 @@ public:
 //
 //  4) If 'inDecibel' is set true then the dependent data is in decibel meters
 //     squared instead of the default meters squared
+//
+//  5) If 'cacheResolution' is set then the RCS (meters squared) is precomputed
+//     on a uniform az/el grid, with a spacing of no more than the resolution,
+//     that covers the table's az/el breakpoints.  getRCS() then looks up the
+//     grid instead of doing the table's lfi() and, for 'inDecibel' tables, the
+//     decibel conversion.  The grid is (re)built when the table, the cache
+//     resolution or one of the flags is set, which is normally while the
+//     input file is loaded, and it's copied with the signature; getRCS() only
+//     reads it, so it can be called by several threads at once.  Angles of
+//     arrival outside of the table's breakpoints use the table itself.
+//
+//  6) buildCache() compares the cache with the table at the center of each of
+//     the grid's cells; getCacheMaxError() returns the largest relative error
+//     found.  The cache isn't built if it would have more than MAX_CACHE_SIZE
+//     bins.
 //------------------------------------------------------------------------------
 class SigAzEl : public RfSignature
 {
     DECLARE_SUBCLASS(SigAzEl,RfSignature)
+public:
+   static const unsigned int MAX_CACHE_SIZE = 1048576;   // Max number of aspect bins in the cache
+
 public:
    SigAzEl();
    SigAzEl(const Basic::Table2* const tbl);
@@ -221,11 +247,27 @@ public:
    bool isDecibel() const           { return dbFlg; }
    virtual bool setDecibel(const bool flg);
 
+   LCreal getCacheResolution() const   { return cacheRes; }     // Cache resolution (radians); zero if no cache
+   virtual bool setCacheResolution(const LCreal radians);
+
+   bool isCacheInterpolated() const    { return cacheLfiFlg; }
+   virtual bool setCacheInterpolate(const bool flg);
+
+   bool isCacheValid() const           { return cacheValid; }   // Cache has been built
+   LCreal getCacheMaxError() const     { return cacheMaxErr; }  // Largest relative error found by buildCache()
+   virtual bool buildCache();
+
+   // RCS (meters squared) from the table for the azimuth and elevation angles of arrival (radians)
+   LCreal computeRCS(const LCreal az, const LCreal el) const;
+
    // Slot functions
    virtual bool setSlotTable(const Basic::Table2* const tbl);
    virtual bool setSlotSwapOrder(const Basic::Number* const msg);
    virtual bool setSlotInDegrees(const Basic::Number* const msg);
    virtual bool setSlotDecibel(const Basic::Number* const msg);
+   virtual bool setSlotCacheResolution(const Basic::Angle* const msg);
+   virtual bool setSlotCacheResolution(const Basic::Number* const msg);
+   virtual bool setSlotCacheInterpolate(const Basic::Number* const msg);
 
    LCreal getRCS(const Emission* const em) override;
 protected:
@@ -233,6 +275,25 @@ protected:
    bool swapOrderFlg;               // Swap independent data order from az/el to el/az
    bool degFlg;                     // independent data in degrees
    bool dbFlg;                      // dependent data in decibels
+
+private:
+   void initData();
+   void clearCache();
+   LCreal lookupCache(const LCreal az, const LCreal el) const;
+
+   LCreal cacheRes;                 // Cache resolution (radians); zero if no cache
+   bool cacheLfiFlg;                // Interpolate between the cache's bins
+   bool cacheValid;                 // Cache has been built
+   LCreal* cache;                   // RCS (meters squared) by az (rows) and el (columns)
+   unsigned int cacheNumAz;         // Number of az grid points
+   unsigned int cacheNumEl;         // Number of el grid points
+   LCreal cacheMinAz;               // Az of the first grid point (radians)
+   LCreal cacheMaxAz;               // Az of the last grid point (radians)
+   LCreal cacheMinEl;               // El of the first grid point (radians)
+   LCreal cacheMaxEl;               // El of the last grid point (radians)
+   LCreal cacheAzScale;             // Az grid points per radian
+   LCreal cacheElScale;             // El grid points per radian
+   LCreal cacheMaxErr;              // Largest relative error found by buildCache()
 };
 
 } // End Simulation namespace
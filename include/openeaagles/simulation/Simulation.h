@@ -8,13 +8,15 @@
 #include "openeaagles/basic/safe_queue.h"
 
 namespace Eaagles {
-   namespace Basic { class Distance; class EarthModel; class LatLon; class Pair; class Time; class Terrain; }
+   namespace Basic { class Distance; class EarthModel; class LatLon; class Pair; class Time; class PhaseBarrier; class Terrain; class WorkStealingExecutor; }
    namespace Dafif { class AirportLoader; class NavaidLoader; class WaypointLoader; }
 
 namespace Simulation {
    class DataRecorder;
    class IrAtmosphere;
    class Player;
+   class PlayerSnapshot;
+   class PlayerSpatialIndex;
    class SimBgThread;
    class SimTcThread;
    class Station;
@@ -49,6 +51,12 @@ namespace Simulation {
 //                                           ! area's NED coordinates.  Otherwise, use a standard spherical
 //                                           ! earth with a radius of Nav::ERAD60. (default: false)
 //
+//    playerIndexCellSize <Basic::Distance>  ! Cell size of the player spatial index (e.g., 20 km), or zero to
+//                                           ! disable the index (default: 0 -- disabled)
+//
+//    terrainElevationBatch <Basic::Boolean> ! If true, the terrain elevations of all players are refreshed
+//                                           ! with one batched query per background frame (default: false)
+//
 //    simulationTime <Basic::Time>           ! Initial simulated time since midnight (UTC) (second),
 //                                           ! or -1 to use current time of day (default: -1)
 //
@@ -155,6 +163,19 @@ namespace Simulation {
 //    threads to traverse the player list.  These threads will each process a subset
 //    of players.  The T/C threads rejoin at the end of each phase (see phases above).
 //
+//    With multiple threads, the player list is copied into a contiguous player
+//    array once per frame, and a Basic::WorkStealingExecutor partitions the array
+//    into one range per thread.  Threads that finish their own range early steal
+//    chunks of players from the other threads' ranges, so a few expensive players
+//    do not stall the whole phase.  The per-thread busy and idle times are
+//    available from getTcExecutor() and getBgExecutor(), and are printed with
+//    the timing statistics.
+//
+//    Each pool shares a Basic::PhaseBarrier, so each phase is started with a
+//    single release of all of the pool's threads, and the threads rejoin at the
+//    barrier.  The barrier's dispatch latency is also printed with the timing
+//    statistics.
+//
 //    There is overhead with managing threads, so this is effective only with
 //    a larger number of players.  The trade off point is dependent on the
 //    complexity of the players and the speed of your computer system, so you
@@ -168,6 +189,43 @@ namespace Simulation {
 //             and our other threads.
 //
 //
+// Player snapshot:
+//
+//    At the end of the dynamics phase (phase 0) of each time-critical frame,
+//    the players' state is copied into a new, read-only PlayerSnapshot, which
+//    is then published (see getPlayerSnapshot()).  Consumers that only scan
+//    the players' state should use the snapshot's arrays instead of walking the
+//    player list.  Two snapshots are rotated: the previous snapshot is reused
+//    once all other references to it have been released.
+//
+//
+// Player spatial index:
+//
+//    Once per background frame, after the player list has been updated, a new
+//    When the 'playerIndexCellSize' slot is set, a PlayerSpatialIndex is built
+//    from the player list (see getPlayerIndex()).  The Tdb uses this index to
+//    find the players that are near its gimbal's field of view instead of
+//    testing every player on the list.  A new index is built each frame, so
+//    the index that a thread is holding is never changed under it.  The
+//    index's candidates are approximate: a player that jumps farther than the
+//    index's motion pad after the index was built can be missed until the
+//    next frame (see PlayerSpatialIndex.h).  So the index is disabled by
+//    default, and the Tdb tests every player on the list.
+//
+//
+// Terrain elevations:
+//
+//    By default, each player queries its own terrain elevation using
+//    Player::updateElevation().  When the 'terrainElevationBatch' slot is
+//    true, the terrain elevations at the locations of all of the active
+//    players that use the terrain database (i.e., not isTerrainElevationRequired())
+//    are refreshed once per background frame, before the players are updated,
+//    with a single batched query (see Basic::Terrain::getPointElevations()),
+//    and Player::updateElevation() doesn't query the database itself.  Player
+//    classes that override updateElevation() with their own elevation source
+//    should not be used with the batched query.
+//
+//
 // Time and Date:
 //
 //    All time and date values are updated only at the start of each frame.
@@ -324,8 +382,37 @@ public:
        const unsigned int n
     );
 
+    // Multi-thread work functions; process chunks of the current
+    // T/C (or background) player array for executor worker 'worker'
+    void updateTcPlayerArray(const LCreal dt, const unsigned int worker);
+    void updateBgPlayerArray(const LCreal dt, const unsigned int worker);
+
+    // Work stealing executors for the T/C and background thread pools
+    // (zero if we're not using the thread pools)
+    const Basic::WorkStealingExecutor* getTcExecutor() const;
+    const Basic::WorkStealingExecutor* getBgExecutor() const;
+
+    // Spatial index of the current player list; pre-ref()'d
+    // (zero if the index is disabled)
+    PlayerSpatialIndex* getPlayerIndex();
+    const PlayerSpatialIndex* getPlayerIndex() const;
+    double getPlayerIndexCellSize() const;         // Cell size (meters), or zero if disabled
+
+    // True if the players' terrain elevations are refreshed by the
+    // simulation's batched query (see updateTerrainElevations())
+    bool isTerrainElevationBatched() const;
+
+    // Snapshot of the players' state from the end of the last
+    // dynamics phase; pre-ref()'d (zero before the first T/C frame)
+    const PlayerSnapshot* getPlayerSnapshot() const;
+    virtual bool setPlayerIndexCellSize(const double v);
+    virtual bool setTerrainElevationBatched(const bool flg);
+
 protected:
     virtual void updatePlayerList();                  // Updates the current player list
+    virtual void updatePlayerIndex();                 // Builds a new spatial index of the current player list
+    virtual void updatePlayerSnapshot(Basic::PairStream* const playerList); // Publishes a new snapshot of the players' state
+    virtual void updateTerrainElevations();           // Refreshes the players' terrain elevations (batched)
     bool setSlotPlayers(Basic::PairStream* const msg);
 
     Basic::Terrain* getTerrain();                     // Returns the terrain elevation database
@@ -353,6 +440,7 @@ private:
    Station* getStationImp();
 
    bool insertPlayerSort(Basic::Pair* const newPlayer, Basic::PairStream* const newList);
+   static unsigned int loadPlayerArray(Basic::PairStream* const playerList, Player*** const array, unsigned int* const size);
    Player* findPlayerPrivate(const short id, const int netID) const;
    Player* findPlayerByNamePrivate(const char* const playerName) const;
 
@@ -373,9 +461,24 @@ private:
    bool setSlotEarthModel(const Basic::EarthModel* const msg);
    bool setSlotEarthModel(const Basic::String* const msg);
    bool setSlotGamingAreaEarthModel(const Basic::Number* const msg);
+   bool setSlotPlayerIndexCellSize(const Basic::Distance* const msg);
+   bool setSlotTerrainElevationBatch(const Basic::Number* const msg);
 
    Basic::safe_ptr<Basic::PairStream> players;     // Main player list (sorted by network and player IDs)
    Basic::safe_ptr<Basic::PairStream> origPlayers; // Original player list
+   Basic::safe_ptr<PlayerSpatialIndex> playerIndex; // Spatial index of the player list
+   double pidxCellSize;          // Player spatial index cell size (meters), or zero to disable
+   Basic::safe_ptr<PlayerSnapshot> snapshot; // Published snapshot of the players' state
+   PlayerSnapshot* spareSnapshot;  // Previous snapshot; recycled once no one else is holding it (ref()'d)
+
+   // Batched terrain elevations
+   bool tElevBatch;              // Refresh the players' terrain elevations with one batched query
+   Player** tePlayers;           // Players
+   double* teLats;               // Player latitudes (degs)
+   double* teLons;               // Player longitudes (degs)
+   LCreal* teElevs;              // Terrain elevations (meters)
+   bool* teValid;                // Terrain elevation valid flags
+   unsigned int teSize;          // Size of the arrays
 
    bool loggedHeadings;          // set true once headings have been added to output file
 
@@ -433,6 +536,11 @@ private:
    unsigned int reqTcThreads;              // Requested number of threads
    unsigned int numTcThreads;              // Number of threads in pool; should be (reqTcThreads - 1)
    bool tcThreadsFailed;                   // Failed to create threads.
+   Basic::WorkStealingExecutor* tcExec;    // Work stealing executor for the T/C player array
+   Basic::PhaseBarrier* tcBarrier;         // Phase barrier for the T/C thread pool
+   Player** tcPlayers;                     // T/C player array (not ref()'d; held by the locked player list)
+   unsigned int tcPlayersSize;             // Size of the T/C player array
+   unsigned int numTcPlayers;              // Number of players in the T/C player array
 
    // Background thread pool
    static const unsigned short MAX_BG_THREADS = 32;
@@ -440,6 +548,11 @@ private:
    unsigned int reqBgThreads;              // Requested number of threads
    unsigned int numBgThreads;              // Number of threads in pool; should be (reqBgThreads - 1)
    bool bgThreadsFailed;                   // Failed to create threads.
+   Basic::WorkStealingExecutor* bgExec;    // Work stealing executor for the background player array
+   Basic::PhaseBarrier* bgBarrier;         // Phase barrier for the background thread pool
+   Player** bgPlayers;                     // Background player array (not ref()'d; held by the locked player list)
+   unsigned int bgPlayersSize;             // Size of the background player array
+   unsigned int numBgPlayers;              // Number of players in the background player array
 };
 
 } // End Simulation namespace
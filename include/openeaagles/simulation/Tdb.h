@@ -37,6 +37,11 @@ namespace Simulation {
 //       If we're using gaming area position vectors (i.e., not usingECEF()) then
 //       all target's with invalid gaming area position vectors are rejected.
 //       
+//       If the simulation's player spatial index (see Simulation::getPlayerIndex())
+//       was built from the provided player list, and the gimbal has a max range,
+//       then only the index's candidate players near the gimbal's field of view
+//       are scanned, and in the same order as the player list.
+//
 // 
 //       (Background task)
 //
@@ -92,6 +97,10 @@ public:
    // processPlayers(), and compute gimbal boresight data (e.g., range, range rate,
    // normalized Line-Of-Sight (LOS) vector) for each target player.
    // (Time-critical task -- in sync with gimbal dynamics & transmit)
+   //
+   // The targets' state is gathered into structure-of-arrays columns, and
+   // the LOS vectors, ranges and angles are computed a column at a time using
+   // the Basic array functions (see support.h), which use SSE2 when available.
    //------------------------------------------------------------------------------
    virtual unsigned int computeBoresightData();
 
@@ -152,6 +161,10 @@ protected:
    osg::Vec3d*  losO2T;       // Ownship to target normalized LOS vector (ownship's NED)
    osg::Vec3d*  losT2O;       // Target to ownship normalized LOS vector (target's NED) 
 
+   // The following arrays are 'maxTargets' long columns of one
+   // structure-of-arrays (SoA) allocation, 'soa' (see resizeArrays())
+   double*     soa;           // SoA allocation
+
    double*     ranges;        // Range to target (meters)
    double*     rngRates;      // Range Rate (m/s)
    double*     aar;           // Compute angle off antenna boresight (radians)
@@ -159,11 +172,21 @@ protected:
    double*     aelr;          // Compute elevation off boresight (radians)
 
    // computeBoresightData() arrays
-   double* xa;
+   double* lx;                // Target positions, then normalized LOS vectors (ECEF or NED)
+   double* ly;
+   double* lz;
+   double* vx;                // Target velocity vectors (ECEF or NED)
+   double* vy;
+   double* vz;
+   double* nx;                // Normalized LOS vectors (ownship's NED)
+   double* ny;
+   double* nz;
+   double* xa;                // Normalized LOS vectors (gimbal coord)
    double* ya;
-   double* za;
-   double* ra2;
-   double* ra;
+   double* ga;                //    (z component)
+   double* za;                // Negative z component (i.e., up)
+   double* ra2;               // x-y range squared
+   double* ra;                // x-y range
 };
 
 } // End Simulation namespace
@@ -34,6 +34,22 @@ class Track;
 //
 //    logTrackUpdates <Boolean>  ! True to log all updates to tracks (default: true)
 //
+// Notes:
+//    1) The track filter is run over all of the tracks as a batch.  The
+//    filter pool holds each state component, X(k) = [ pos vel accel ], input
+//    and gain in its own contiguous array (structure of arrays), indexed the
+//    same as the track list.  processTrackList() sets the input vectors and
+//    gains of the tracks with new reports, then predictFilterStates() copies
+//    the tracks' state vectors into the pool and predicts all of the tracks
+//    with a single pass over the arrays, and storeFilterStates() copies the
+//    results back to the tracks.
+//
+//    The tracks remain the owners of their state, which can also be set by
+//    others (e.g., Track::ownshipDynamics()), so the pool only holds it for
+//    the prediction.  The inputs and gains are cleared after each prediction,
+//    so the pool doesn't need to follow the tracks as they're added to or
+//    removed from the list.
+//
 //==============================================================================
 class TrackManager : public System
 {
@@ -109,6 +125,12 @@ protected:
    LCreal              beta;               // Beta parameter
    LCreal              gamma;              // Gamma parameter
 
+   // Track filter pool (see Note 1); call with the track list locked
+   void setFilterInput(const unsigned int it, const osg::Vec3& u,       // Sets track 'it's input vector U(k)
+      const LCreal b0, const LCreal b1, const LCreal b2);               //   and gains B
+   void predictFilterStates();                                          // X(k+1) = A*X(k) + B*U(k)
+   void storeFilterStates();                                            // Stores X(k+1) in each track
+
    unsigned int        nextTrkId;          // Next track ID
    unsigned int        firstTrkId;         // First (starting) track ID
 
@@ -125,6 +147,18 @@ protected:
 private:
    void initData();
 
+   // Filter pool rows; each row is an array of MAX_TRKS values
+   enum {
+      FP_POS_X, FP_POS_Y, FP_POS_Z,       // Position
+      FP_VEL_X, FP_VEL_Y, FP_VEL_Z,       // Velocity
+      FP_ACC_X, FP_ACC_Y, FP_ACC_Z,       // Acceleration
+      FP_U_X, FP_U_Y, FP_U_Z,             // Input vector
+      FP_B0, FP_B1, FP_B2,                // Gains
+      NUM_FP_ROWS
+   };
+   LCreal*             filterPool;         // Filter pool (NUM_FP_ROWS * MAX_TRKS values)
+   LCreal*             fp[NUM_FP_ROWS];    // Filter pool rows
+
    LCreal              maxTrackAge;        // Max Track age (sec)
    short               type;               // Track type: the bit-wise OR of various type bits (see enum TypeBits in Track.h)
    bool                logTrackUpdates;    // input slot; if false, updates to tracks are not logged.
@@ -139,6 +173,36 @@ private:
 //   positionGate   <Basic::Number>  ! Position Gate (meters) (default: 2.0f * NM2M)
 //   rangeGate      <Basic::Number>  ! Range Gate (meters) (default: 500.0f)
 //   velocityGate   <Basic::Number>  ! Velocity Gate (m/s) (default: 10.0f)
+//   gnnAssociation <Basic::Number>  ! Associate reports to tracks using the gates
+//                                   ! (default: false -- by the reports' target)
+//
+// Notes:
+//    1) By default, a report is associated with the tracks of its target player,
+//    and each of those tracks is updated with the report.
+//
+//    2) With 'gnnAssociation', the reports are associated by a global nearest
+//    neighbor (GNN) assignment, without using the target player:
+//
+//       a) The tracks' predicted positions are bucketed in a grid with cells
+//          the size of the position gate, so each report is only compared
+//          with the tracks in its own and its neighboring cells.
+//
+//       b) A report is within a track's gates if it's within the position gate
+//          of the track's position, the range gate of its range, and the
+//          velocity gate of its last range rate.  The cost of the pair is the
+//          normalized squared position and range rate differences.
+//
+//       c) Reports and tracks that are gated only with each other are
+//          associated directly.  Each other cluster of reports and tracks,
+//          which are linked by their gates, is solved as an assignment problem
+//          (Hungarian method), where a report may also remain unassigned.
+//          Clusters with more than MAX_CLUSTER_SIZE reports or tracks are
+//          assigned greedily, in order of increasing cost, instead.
+//
+//       d) Each track is updated with at most one report, and the track's
+//          range rate is updated with the report's range rate.
+//
+//    3) The reports that aren't associated with a track start new tracks.
 //
 //==============================================================================
 class AirTrkMgr : public TrackManager
@@ -150,25 +214,73 @@ public:
    LCreal getPosGate()                             { return posGate;}
    LCreal getRngGate()                             { return rngGate;}
    LCreal getVelGate()                             { return velGate;}
+   bool isGnnAssociation() const                   { return gnnAssociation; }
+
+   virtual bool setGnnAssociation(const bool b);
+
+   static const unsigned int MAX_CLUSTER_SIZE = 64;  // Max reports or tracks of a cluster that's solved by the Hungarian method
 
 protected:
    void processTrackList(const LCreal dt) override;
 
+   // Associates the reports with the tracks (trkListLock is locked); the
+   // track index of each report, or -1, is returned in 'reportTrack'.  By
+   // target, 'reportTrack' is the first track of the report's target, and
+   // the target's other tracks follow it in 'trackNext'.
+   virtual void associateByTarget(Emission* const* const emissions, const unsigned int nReports);
+   virtual void associateByGates(const osg::Vec3* const rptPos, const LCreal* const rptRdot, const unsigned int nReports);
+
+   bool setSlotGnnAssociation(const Basic::Number* const num);
+
+   int* reportTrack;                         // Track index of each report (or -1)
+
 private:
+   // Gated report/track pair
+   struct GatedPair {
+      unsigned int rpt;                      // Report index
+      unsigned int trk;                      // Track index
+      LCreal cost;                           // Normalized distance
+   };
+
    void initData();
    bool setPositionGate(const Basic::Number* const num);
    bool setRangeGate(const Basic::Number* const num);
    bool setVelocityGate(const Basic::Number* const num);
 
+   void addGatedPair(const unsigned int ir, const unsigned int it, const LCreal cost);
+   int findRoot(int node) const;
+   void solveCluster(const unsigned int firstRpt);
+   void greedyCluster(const unsigned int firstRpt);
+
    // Prediction parameters
    LCreal              posGate;            // Position Gate (meters)
    LCreal              rngGate;            // Range Gate (meters)
    LCreal              velGate;            // Velocity Gate (m/s)
-
-   // Used by processTrackList()
-   bool** report2TrackMatch;                 // Report/Track matched matrix
-   unsigned int* reportNumMatches;           // Number of matches for each report
-   unsigned int* trackNumMatches;            // Number of matcher for each track
+   bool                gnnAssociation;     // Associate by the gates (GNN)
+
+   // Used by associateByTarget() and associateByGates()
+   unsigned int hashSize;                    // Size of the hash tables (power of two)
+   int* hashHead;                            // Target hash (track index) or grid cell lists (first track)
+   int* trackNext;                           // Next track of the same target, or in the same grid cell list
+   int* trackCell;                           // Grid cell of each track [ 3 * MAX_TRKS ]
+
+   GatedPair* gated;                         // Gated pairs, grouped by report
+   unsigned int numGated;                    // Number of gated pairs
+   unsigned int maxGated;                    // Size of the 'gated' array
+   unsigned int* rptFirstPair;               // Index of each report's first gated pair [ MAX_REPORTS + 1 ]
+   unsigned int* trkNumPairs;                // Number of gated pairs of each track
+   mutable int* clusterParent;               // Cluster union-find: reports, then tracks
+   int* clusterNext;                         // Next report in the same cluster
+   int* trackLocal;                          // Track's column in the cluster's cost matrix (or -1)
+   unsigned int* localTrack;                 // Cluster column's track index
+   unsigned int* clusterPairs;               // Gated pairs of a greedy cluster
+   unsigned int maxClusterPairs;             // Size of the 'clusterPairs' array
+
+   double* lapCost;                          // Cluster cost matrix (rows x columns)
+   unsigned int lapCostSize;                 // Size of the 'lapCost' array
+   double* lapWork;                          // Hungarian method work arrays
+   int* lapIdx;                              // Hungarian method index arrays
+   unsigned int lapSize;                     // Size of the work arrays (columns)
 };
 
 //==============================================================================
@@ -14,6 +14,17 @@ namespace Terrain {
 // Description: Common terrain data file
 // Factory name: DataFile
 //
+// Max elevation pyramid:
+//    When the data is loaded (see reset()), a pyramid of maximum elevations is
+//    built from the elevation posts.  Each cell of level 'k' is the maximum of
+//    the 2 by 2 cells of level 'k-1' below it (i.e., the max of a block of
+//    2^k by 2^k posts), and level zero is the elevation data itself.
+//
+//    The LOS checks, computeOcculting() and computeOcculting2(), use the
+//    pyramid to skip whole sections of the ray whose maximum elevation is
+//    below the line of sight, and only sample the posts of the remaining
+//    sections.  The results are the same as sampling every point.
+//
 // Notes:
 //    1) the first elevation point [0] of all arrays is at the reference point
 //    2) the final elevation point [n-1] is at the maximum range
@@ -54,6 +65,22 @@ public:
    //  Elevations are in meters
    const short* getColumn(const unsigned int idx) const;
 
+   // Number of levels in the max elevation pyramid, including level zero,
+   // or zero if the pyramid hasn't been built
+   unsigned int getNumPyramidLevels() const   { return numLevels; }
+
+   // Returns the maximum elevation (meters) of the posts within the block of
+   // columns [ icol0 ... icol1 ] and rows [ irow0 ... irow1 ]; the result may
+   // include some neighboring posts.  Returns false if the pyramid hasn't been
+   // built or the block is empty.
+   bool getMaxElevationInBlock(
+         short* const maxElev,
+         const unsigned int icol0,
+         const unsigned int irow0,
+         const unsigned int icol1,
+         const unsigned int irow1
+      ) const;
+
    // ---
    // Basic::Terrain interface
    // ---
@@ -82,6 +109,38 @@ public:
          const bool interp = false     // Interpolate between elevation posts (default: false)
       ) const;
 
+   // Batched getElevation(): the points are processed in small blocks, with
+   // separate passes for the post indexes, the post lookups and the
+   // (vectorizable) interpolation
+   unsigned int getPointElevations(
+         LCreal* const elevations,     // The elevation array (meters)
+         bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+         const double* const lats,     // Latitude array (degs)
+         const double* const lons,     // Longitude array (degs)
+         const unsigned int n,         // Size of the arrays
+         const bool interp = false     // Interpolate between elevation posts (default: false)
+      ) const override;
+
+   bool computeOcculting(
+         const double refLat,          // Ref latitude (degs)
+         const double refLon,          // Ref longitude (degs)
+         const LCreal refAlt,          // Ref altitude (meters)
+         const double tgtLat,          // Target latitude (degs)
+         const double tgtLon,          // Target longitude (degs)
+         const LCreal tgtAlt           // Target altitude (meters)
+      ) const override;
+
+   bool computeOcculting2(
+      const double refLat,             // Ref latitude (degs)
+      const double refLon,             // Ref longitude (degs)
+      const double refAlt,             // Ref altitude (meters)
+      const double truBrg,             // True direction angle from north to look (degs)
+      const double dist,               // Distance to check (meters)
+      const double tanLookAng          // Tangent of the look angle
+   ) const override;
+
+   void reset() override;
+
 protected:
    short**  columns;                // Array of data columns (values in meters)
    double   latSpacing;             // Spacing between latitude points (degs)
@@ -90,8 +149,35 @@ protected:
    unsigned int nptlong;            // Number of points in longitude (i.e., number of columns)
    short    voidValue;              // Value representing a void (missing) data point
 
+   // Builds (or rebuilds) the max elevation pyramid from the elevation data
+   virtual bool buildMaxPyramid();
+
    // Basic::Terrain protected interface
    void clearData() override;
+
+private:
+   static const unsigned int MAX_LEVELS = 32;   // Max number of pyramid levels
+   static const unsigned int LEAF_POINTS = 16;  // Ray sections of this many points (or less) are sampled
+   static const unsigned int BLOCK_POINTS = 256; // Block size used by getPointElevations()
+
+   // Ray sampled for the LOS checks
+   struct LosRay {
+      const double* pointsLat;      // Points (fractional row indexes)
+      const double* pointsLon;      // Points (fractional column indexes)
+      const double* ranges;         // Range to each point (meters)
+      double refAlt;                // Ref altitude (meters)
+      double tanLimit;              // Occulted if the tangent to a point is greater than or equal to this
+   };
+
+   void clearMaxPyramid();
+   bool occultingRay(const double lat, const double lon, const LCreal direction, const LCreal maxRng,
+                     const unsigned int n, const double refAlt, const double tanLimit) const;
+   bool occultingSection(const LosRay& ray, const unsigned int i0, const unsigned int i1) const;
+
+   short* levels[MAX_LEVELS];          // Max elevation pyramid (level zero is not used; see 'columns')
+   unsigned int levelCols[MAX_LEVELS]; // Number of columns in each level
+   unsigned int levelRows[MAX_LEVELS]; // Number of rows in each level
+   unsigned int numLevels;             // Number of levels (including level zero)
 };
 
 } // End Terrain namespace
@@ -14,6 +14,15 @@ namespace Terrain {
 // Class: QuadMap
 // Description: Manage up to 4 elevation files in a 2x2 pattern
 // Factory name: QuadMap
+//
+// Notes:
+//    1) Where the data files overlap, the elevations are from the first data
+//       file that has them (see getElevations()).  When none of the data files
+//       overlap, except for any shared edge posts, the LOS checks,
+//       computeOcculting() and computeOcculting2(), are passed to each of the
+//       data files, so each can use its own faster methods (e.g., DataFile's
+//       max elevation pyramid).  Otherwise, the LOS checks use the elevations
+//       from getElevations(), so the first data file still wins.
 //------------------------------------------------------------------------------
 class QuadMap : public Basic::Terrain
 {
@@ -54,6 +63,33 @@ public:
          const bool interp = false     // Interpolate between elevation posts (default: false)
       ) const override;
 
+   unsigned int getPointElevations(
+         LCreal* const elevations,     // The elevation array (meters)
+         bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+         const double* const lats,     // Latitude array (degs)
+         const double* const lons,     // Longitude array (degs)
+         const unsigned int n,         // Size of the arrays
+         const bool interp = false     // Interpolate between elevation posts (default: false)
+      ) const override;
+
+   bool computeOcculting(
+         const double refLat,          // Ref latitude (degs)
+         const double refLon,          // Ref longitude (degs)
+         const LCreal refAlt,          // Ref altitude (meters)
+         const double tgtLat,          // Target latitude (degs)
+         const double tgtLon,          // Target longitude (degs)
+         const LCreal tgtAlt           // Target altitude (meters)
+      ) const override;
+
+   bool computeOcculting2(
+      const double refLat,             // Ref latitude (degs)
+      const double refLon,             // Ref longitude (degs)
+      const double refAlt,             // Ref altitude (meters)
+      const double truBrg,             // True direction angle from north to look (degs)
+      const double dist,               // Distance to check (meters)
+      const double tanLookAng          // Tangent of the look angle
+   ) const override;
+
    void reset() override;
 
 protected:
@@ -68,6 +104,7 @@ private:
    unsigned int numDataFiles;                       // Number of data files
 
    bool loadData() override;
+   bool haveOverlappingFiles() const;               // Do any of the data files overlap?
 };
 
 } // End Terrain namespace
@@ -0,0 +1,200 @@
+//------------------------------------------------------------------------------
+// Class: TileMap
+//------------------------------------------------------------------------------
+#ifndef __Eaagles_Terrain_TileMap_H__
+#define __Eaagles_Terrain_TileMap_H__
+
+#include "openeaagles/basic/Terrain.h"
+
+namespace Eaagles {
+   namespace Basic { class Number; class String; }
+namespace Terrain {
+   class DataFile;
+
+//------------------------------------------------------------------------------
+// Class: TileMap
+// Description: Terrain database of one degree by one degree DTED or SRTM
+//              cells (tiles) that are stored in a directory, 'path', using
+//              the standard file naming conventions:
+//
+//                 DTED:   <path>/w118/n35.dt1     (level 0, 1 or 2)
+//                 SRTM:   <path>/N35W118.hgt
+//
+//    Nothing is loaded at reset() time.  Instead, each tile is loaded the
+//    first time that it's needed by an elevation query or an LOS check, and
+//    the tiles are kept in a least recently used (LRU) cache whose memory is
+//    limited to 'cacheSize' megabytes.  The least recently used tiles are
+//    released when the limit is exceeded; they're loaded again, if needed.
+//    Tiles that don't exist are remembered, so they're only looked for once.
+//
+//    Queries are routed to their tile in constant time using a table of all
+//    one degree cells, and there's no limit on the number of tiles.
+//
+//    The queries are thread safe; a tile that is in use by one thread while
+//    it's released by another remains valid until the first thread is done
+//    with it.  Tiles are loaded by the thread that first needs them, and the
+//    cache isn't locked while the tile's file is read, so only the threads
+//    that need that same tile wait for the load.
+//
+//    The corners of the database are the whole earth, and the min and max
+//    elevations are of the tiles that have been loaded so far.
+//
+// Factory name: TileMap
+// Slots:
+//    format      <String>    ! Tile format: "dted0", "dted1", "dted2" or "srtm" (default: "dted1")
+//    cacheSize   <Number>    ! Max memory used by the loaded tiles (megabytes) (default: 512)
+//
+// Notes:
+//    1) Derived classes can support other formats or naming conventions by
+//       overriding getTileFilename() and createTile().
+//    2) Longitudes are not wrapped across the +/-180 degree meridian.
+//------------------------------------------------------------------------------
+class TileMap : public Basic::Terrain
+{
+   DECLARE_SUBCLASS(TileMap,Basic::Terrain)
+
+public:
+   // Tile formats
+   enum Format { DTED0, DTED1, DTED2, SRTM };
+
+   static const unsigned int DEFAULT_CACHE_SIZE = 512;   // Default cache size (megabytes)
+
+public:
+   TileMap();
+
+   Format getFormat() const                        { return format; }
+   unsigned int getCacheSize() const               { return cacheSize; }       // Max memory (megabytes)
+   unsigned int getNumTilesLoaded() const          { return numTiles; }        // Number of tiles currently loaded
+   unsigned int getNumTileLoads() const            { return numLoads; }        // Total number of tile loads
+   unsigned int getNumTileEvictions() const        { return numEvictions; }    // Total number of tiles released by the LRU cache
+   double getMemoryUsed() const                    { return memoryUsed; }      // Memory used by the loaded tiles (bytes)
+
+   virtual bool setFormat(const Format f);
+   virtual bool setCacheSize(const unsigned int megabytes);
+
+   // Releases all of the loaded tiles, and forgets the missing tiles
+   virtual void clearTiles();
+
+   // ---
+   // Basic::Terrain interface
+   // ---
+
+   bool isDataLoaded() const override;
+
+   // Locates an array of (at least two) elevation points (and sets valid flags if found)
+   // returns the number of points found within this TileMap
+   unsigned int getElevations(
+         LCreal* const elevations,     // The elevation array (meters)
+         bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+         const unsigned int n,         // Size of elevation and valdFlags arrays
+         const double lat,             // Starting latitude (degs)
+         const double lon,             // Starting longitude (degs)
+         const LCreal direction,       // True direction (heading) angle of the data (degs)
+         const LCreal maxRng,          // Range to last elevation point (meters)
+         const bool   interp = false   // Interpolate between elevation posts (default: false)
+      ) const override;
+
+   // Locates an elevation value (meters) for a given reference point and returns
+   // it in 'elev'.  Function returns true if successful, otherwise 'elev' is unchanged.
+   bool getElevation(
+         LCreal* const elev,           // The elevation value (meters)
+         const double lat,             // Reference latitude (degs)
+         const double lon,             // Reference longitude (degs)
+         const bool interp = false     // Interpolate between elevation posts (default: false)
+      ) const override;
+
+   unsigned int getPointElevations(
+         LCreal* const elevations,     // The elevation array (meters)
+         bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+         const double* const lats,     // Latitude array (degs)
+         const double* const lons,     // Longitude array (degs)
+         const unsigned int n,         // Size of the arrays
+         const bool interp = false     // Interpolate between elevation posts (default: false)
+      ) const override;
+
+   bool computeOcculting(
+         const double refLat,          // Ref latitude (degs)
+         const double refLon,          // Ref longitude (degs)
+         const LCreal refAlt,          // Ref altitude (meters)
+         const double tgtLat,          // Target latitude (degs)
+         const double tgtLon,          // Target longitude (degs)
+         const LCreal tgtAlt           // Target altitude (meters)
+      ) const override;
+
+   bool computeOcculting2(
+      const double refLat,             // Ref latitude (degs)
+      const double refLon,             // Ref longitude (degs)
+      const double refAlt,             // Ref altitude (meters)
+      const double truBrg,             // True direction angle from north to look (degs)
+      const double dist,               // Distance to check (meters)
+      const double tanLookAng          // Tangent of the look angle
+   ) const override;
+
+protected:
+   // Returns the tile's file name, relative to our path, for the one degree
+   // cell whose southwest corner is at [ swLat swLon ] (degs)
+   virtual bool getTileFilename(char* const buff, const unsigned int size, const int swLat, const int swLon) const;
+
+   // Creates the (not yet loaded) data file object for our format
+   virtual DataFile* createTile() const;
+
+   // Returns the (ref()'d) tile that contains the point, loading it if
+   // needed, or zero if there's no tile.
+   const DataFile* getTile(const double lat, const double lon) const;
+
+   // Returns the (ref()'d) tile of the cell [ ilat ilon ] (see getTile())
+   const DataFile* getTileByCell(const int ilat, const int ilon) const;
+
+   // Slot functions
+   virtual bool setSlotFormat(const Basic::String* const msg);
+   virtual bool setSlotCacheSize(const Basic::Number* const msg);
+
+   void clearData() override;
+
+private:
+   static const int NUM_CELL_LATS = 180;     // Number of one degree cells in latitude
+   static const int NUM_CELL_LONS = 360;     // Number of one degree cells in longitude
+
+   // Cell states (otherwise an index into the tile array)
+   static const int CELL_UNKNOWN = -1;       // Tile hasn't been looked for
+   static const int CELL_MISSING = -2;       // There's no tile
+   static const int CELL_LOADING = -3;       // Tile is being loaded by another thread
+
+   // Loaded tile
+   struct Tile {
+      DataFile* file;                        // Data file (ref()'d)
+      int cell;                              // Cell index
+      double bytes;                          // Memory used (bytes)
+      unsigned long long lastUsed;           // LRU counter when last used
+   };
+
+   bool loadData() override;
+
+   DataFile* readTile(const int cell) const; // Reads the cell's tile file (cache must not be locked)
+   bool addTile(const int cell, DataFile* const file) const;   // Adds a loaded tile to the cache (cache must be locked)
+   void releaseTiles(const int keep) const;  // Releases LRU tiles until we're under our limit (cache must be locked)
+
+   static void getRayEnd(double* const lat1, double* const lon1, const double lat, const double lon,
+                         const double direction, const double maxRng);
+   static void getCells(int* const ilat0, int* const ilon0, int* const ilat1, int* const ilon1,
+                        const double lat0, const double lon0, const double lat1, const double lon1);
+
+   Format format;                   // Tile format
+   unsigned int cacheSize;          // Max memory (megabytes)
+
+   mutable int* cells;              // Cell table: CELL_UNKNOWN, CELL_MISSING or index into 'tiles'
+   mutable Tile* tiles;             // Loaded tiles
+   mutable unsigned int numTiles;   // Number of loaded tiles
+   mutable unsigned int maxTiles;   // Size of the 'tiles' array
+   mutable double memoryUsed;       // Memory used by the loaded tiles (bytes)
+   mutable unsigned long long lruCounter;    // LRU counter
+   mutable unsigned int numLoads;            // Total number of tile loads
+   mutable unsigned int numEvictions;        // Total number of tiles released
+   mutable unsigned int tileGeneration;      // Incremented each time the tiles are cleared
+   mutable long tileLock;           // Semaphore to protect the tile cache
+};
+
+} // End Terrain namespace
+} // End Eaagles namespace
+
+#endif
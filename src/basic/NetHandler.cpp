@@ -86,6 +86,32 @@ bool NetHandler::init()
     return ok;
 }
 
+//------------------------------------------------------------------------------
+// sendPackets() -- sends a batch of packets, one at a time
+//------------------------------------------------------------------------------
+unsigned int NetHandler::sendPackets(const char* const packets[], const int sizes[], const unsigned int n)
+{
+   unsigned int cnt = 0;
+   for (unsigned int i = 0; i < n; i++) {
+      if (sendData(packets[i], sizes[i])) cnt++;
+   }
+   return cnt;
+}
+
+//------------------------------------------------------------------------------
+// recvPackets() -- receives a batch of packets, one at a time
+//------------------------------------------------------------------------------
+unsigned int NetHandler::recvPackets(char* const packets[], unsigned int sizes[], const int maxSize, const unsigned int n)
+{
+   unsigned int cnt = 0;
+   while (cnt < n) {
+      const unsigned int size = recvData(packets[cnt], maxSize);
+      if (size == 0) break;
+      sizes[cnt++] = size;
+   }
+   return cnt;
+}
+
 //------------------------------------------------------------------------------
 // toNet() -- byte swaps a host to network buffer.  The buffer MUST consist
 //            of 'nl' int (4 byte) words followed by 'ns' short (2 byte) words.
@@ -0,0 +1,142 @@
+//------------------------------------------------------------------------------
+// Class: PhaseBarrier
+//------------------------------------------------------------------------------
+#include "openeaagles/basic/PhaseBarrier.h"
+#include "openeaagles/basic/support.h"
+
+namespace Eaagles {
+namespace Basic {
+
+//------------------------------------------------------------------------------
+// Window/Linux specific code
+//------------------------------------------------------------------------------
+#if defined(WIN32)
+  #include "windows/PhaseBarrier.cxx"
+#else
+  #include "linux/PhaseBarrier.cxx"
+#endif
+
+//------------------------------------------------------------------------------
+// Constructor & destructor
+//------------------------------------------------------------------------------
+PhaseBarrier::PhaseBarrier(const unsigned int numWorkers, const unsigned int spin)
+   : generation(0), pending(0), nWorkers(numWorkers), spinCount(spin), releaseTime(0.0)
+{
+}
+
+PhaseBarrier::~PhaseBarrier()
+{
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+bool PhaseBarrier::setNumWorkers(const unsigned int n)
+{
+   nWorkers = n;
+   return true;
+}
+
+bool PhaseBarrier::setSpinCount(const unsigned int n)
+{
+   spinCount = n;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// release() -- starts the next phase; one store and one wake-up call for
+// all of the workers.
+//------------------------------------------------------------------------------
+void PhaseBarrier::release()
+{
+   pending.store(static_cast<int>(nWorkers), std::memory_order_relaxed);
+   releaseTime = getComputerTime();
+   generation.fetch_add(1, std::memory_order_release);
+   wakeAll(&generation);
+}
+
+//------------------------------------------------------------------------------
+// waitForCompleted() -- parent waits for all of the workers to arrive()
+//------------------------------------------------------------------------------
+void PhaseBarrier::waitForCompleted()
+{
+   unsigned int spin = 0;
+   int n = pending.load(std::memory_order_acquire);
+   while (n > 0) {
+      if (spin < spinCount) {
+         pause();
+         spin++;
+      }
+      else {
+         waitOnValue(&pending, n);
+      }
+      n = pending.load(std::memory_order_acquire);
+   }
+}
+
+//------------------------------------------------------------------------------
+// waitForRelease() -- worker waits for a generation other than 'lastGen'
+//------------------------------------------------------------------------------
+unsigned int PhaseBarrier::waitForRelease(const unsigned int lastGen, const unsigned int worker)
+{
+   const int last = static_cast<int>(lastGen);
+   unsigned int spin = 0;
+   int gen = generation.load(std::memory_order_acquire);
+   while (gen == last) {
+      if (spin < spinCount) {
+         pause();
+         spin++;
+      }
+      else {
+         waitOnValue(&generation, last);
+      }
+      gen = generation.load(std::memory_order_acquire);
+   }
+
+   // Dispatch latency, in this worker's own statistic
+   if (worker < MAX_WORKERS) {
+      latency[worker].stats.sigma(getComputerTime() - releaseTime);
+   }
+
+   return static_cast<unsigned int>(gen);
+}
+
+//------------------------------------------------------------------------------
+// arrive() -- worker has completed the phase; the last one wakes the parent
+//------------------------------------------------------------------------------
+void PhaseBarrier::arrive()
+{
+   if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      wakeOne(&pending);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Statistics
+//------------------------------------------------------------------------------
+const Statistic& PhaseBarrier::getDispatchLatencyStats() const
+{
+   latencyStats.clear();
+   for (unsigned int i = 0; i < MAX_WORKERS; i++) {
+      latencyStats.sigma(latency[i].stats);
+   }
+   return latencyStats;
+}
+
+const Statistic* PhaseBarrier::getDispatchLatencyStats(const unsigned int worker) const
+{
+   const Statistic* p = nullptr;
+   if (worker < MAX_WORKERS) p = &latency[worker].stats;
+   return p;
+}
+
+void PhaseBarrier::clearStats()
+{
+   for (unsigned int i = 0; i < MAX_WORKERS; i++) {
+      latency[i].stats.clear();
+   }
+   latencyStats.clear();
+}
+
+} // End Basic namespace
+} // End Eaagles namespace
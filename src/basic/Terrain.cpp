@@ -7,6 +7,7 @@
 #include "openeaagles/basic/Color.h"
 #include "openeaagles/basic/Hsva.h"
 #include "openeaagles/basic/Nav.h"
+#include "openeaagles/basic/Number.h"
 #include "openeaagles/basic/PairStream.h"
 #include "openeaagles/basic/Pair.h"
 #include "openeaagles/basic/Rgba.h"
@@ -21,14 +22,20 @@ IMPLEMENT_ABSTRACT_SUBCLASS(Terrain,"TerrainDatabase")
 
 // slot table
 BEGIN_SLOTTABLE(Terrain)
-   "file",        // 1) Data file name
-   "path",        // 2) Data path name
+   "file",              // 1) Data file name
+   "path",              // 2) Data path name
+   "losCacheSize",      // 3) Number of entries in the LOS result cache
+   "losCacheThreshold", // 4) LOS cache movement threshold
+   "losCacheMaxAge",    // 5) LOS cache max age (frames)
 END_SLOTTABLE(Terrain)
 
 // slot map
 BEGIN_SLOT_MAP(Terrain)
    ON_SLOT(1, setFilename, String)
    ON_SLOT(2, setPathname, String)
+   ON_SLOT(3, setSlotLosCacheSize, Number)
+   ON_SLOT(4, setSlotLosCacheThreshold, Distance)
+   ON_SLOT(5, setSlotLosCacheMaxAge, Number)
 END_SLOT_MAP()
 
 //------------------------------------------------------------------------------
@@ -47,6 +54,15 @@ Terrain::Terrain()
    swLon = 0;
    minElev = 0;
    maxElev = 0;
+
+   losCache = nullptr;
+   losCacheSize = 0;
+   losCacheThreshold = 10.0;
+   losCacheMaxAge = 1;
+   losFrame = 0;
+   losCacheHits = 0;
+   losCacheMisses = 0;
+   losCacheLock = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -59,6 +75,9 @@ void Terrain::copyData(const Terrain& org, const bool cc)
    if (cc) {
       path = nullptr;
       file = nullptr;
+      losCache = nullptr;
+      losCacheSize = 0;
+      losCacheLock = 0;
    }
 
    clearData();
@@ -84,6 +103,12 @@ void Terrain::copyData(const Terrain& org, const bool cc)
 
    minElev = org.minElev;
    maxElev = org.maxElev;
+
+   // Same LOS cache setup, but without the cached results
+   losCacheThreshold = org.losCacheThreshold;
+   losCacheMaxAge = org.losCacheMaxAge;
+   losFrame = 0;
+   setLosCacheSize(org.losCacheSize);
 }
 
 //------------------------------------------------------------------------------
@@ -95,6 +120,20 @@ void Terrain::deleteData()
 
    setPathname(nullptr);
    setFilename(nullptr);
+
+   setLosCacheSize(0);
+}
+
+//------------------------------------------------------------------------------
+// updateData() -- advances the LOS cache's frame counter
+//------------------------------------------------------------------------------
+void Terrain::updateData(const LCreal dt)
+{
+   lcLock(losCacheLock);
+   losFrame++;
+   lcUnlock(losCacheLock);
+
+   BaseClass::updateData(dt);
 }
 
 //------------------------------------------------------------------------------
@@ -226,9 +265,152 @@ bool Terrain::setLongitudeNE(const double v)
    return ok;
 }
 
+// Sets the number of LOS cache entries (rounded up to a power of two), or zero to disable
+bool Terrain::setLosCacheSize(const unsigned int n)
+{
+   unsigned int size = 0;
+   if (n > 0) {
+      size = 1;
+      while (size < n && size < 0x10000) size <<= 1;
+   }
+
+   lcLock(losCacheLock);
+   if (size != losCacheSize) {
+      if (losCache != nullptr) {
+         delete[] losCache;
+         losCache = nullptr;
+      }
+      if (size > 0) losCache = new LosEntry[size];
+      losCacheSize = size;
+   }
+   for (unsigned int i = 0; i < losCacheSize; i++) {
+      losCache[i].valid = false;
+   }
+   losCacheHits = 0;
+   losCacheMisses = 0;
+   lcUnlock(losCacheLock);
+   return true;
+}
+
+// Sets the LOS cache's movement threshold (meters)
+bool Terrain::setLosCacheThreshold(const double meters)
+{
+   bool ok = false;
+   if (meters > 0) {
+      lcLock(losCacheLock);
+      losCacheThreshold = meters;
+      for (unsigned int i = 0; i < losCacheSize; i++) {
+         losCache[i].valid = false;
+      }
+      lcUnlock(losCacheLock);
+      ok = true;
+   }
+   return ok;
+}
+
+// Sets the LOS cache's max age (frames)
+bool Terrain::setLosCacheMaxAge(const unsigned int n)
+{
+   losCacheMaxAge = n;
+   return true;
+}
+
+// Clears the cached LOS results and the hit/miss counters
+void Terrain::clearLosCache()
+{
+   lcLock(losCacheLock);
+   for (unsigned int i = 0; i < losCacheSize; i++) {
+      losCache[i].valid = false;
+   }
+   losCacheHits = 0;
+   losCacheMisses = 0;
+   lcUnlock(losCacheLock);
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+
+bool Terrain::setSlotLosCacheSize(const Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int n = msg->getInt();
+      if (n >= 0) {
+         ok = setLosCacheSize(static_cast<unsigned int>(n));
+      }
+      else {
+         std::cerr << "Terrain::setSlotLosCacheSize(): invalid size; must be zero or greater" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool Terrain::setSlotLosCacheThreshold(const Distance* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setLosCacheThreshold( Meters::convertStatic(*msg) );
+      if (!ok) {
+         std::cerr << "Terrain::setSlotLosCacheThreshold(): invalid threshold; must be greater than zero" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool Terrain::setSlotLosCacheMaxAge(const Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int n = msg->getInt();
+      if (n >= 0) {
+         ok = setLosCacheMaxAge(static_cast<unsigned int>(n));
+      }
+      else {
+         std::cerr << "Terrain::setSlotLosCacheMaxAge(): invalid max age; must be zero or greater" << std::endl;
+      }
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Locates the elevations of an array of 'n' points (and sets the valid flags
+// of the points found).  Points whose valid flags are already set are skipped.
+// Returns the number of points found.  The default is to call getElevation()
+// for each point; derived classes should provide faster versions.
+//------------------------------------------------------------------------------
+unsigned int Terrain::getPointElevations(
+      LCreal* const elevations,     // The elevation array (meters)
+      bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+      const double* const lats,     // Latitude array (degs)
+      const double* const lons,     // Longitude array (degs)
+      const unsigned int n,         // Size of the arrays
+      const bool interp             // Interpolate between elevation posts (if true)
+   ) const
+{
+   unsigned int num = 0;
+
+   // Early out tests
+   if ( elevations == nullptr || validFlags == nullptr || lats == nullptr || lons == nullptr ) return num;
+
+   for (unsigned int i = 0; i < n; i++) {
+      if (!validFlags[i]) {
+         LCreal value = 0;
+         if (getElevation(&value, lats[i], lons[i], interp)) {
+            elevations[i] = value;
+            validFlags[i] = true;
+            num++;
+         }
+      }
+   }
+
+   return num;
+}
+
 //------------------------------------------------------------------------------
 // Target occulting: returns true if a target point [ tgtLat tgtLon tgtAlt ] is
 // occulted by the terrain as seen from the ref point [ refLat refLon refAlt ].
+// Uses the LOS result cache, if enabled.
 //------------------------------------------------------------------------------
 bool Terrain::targetOcculting(
       const double refLat,    // Ref latitude (degs)
@@ -239,10 +421,70 @@ bool Terrain::targetOcculting(
       const LCreal tgtAlt     // Target altitude (meters)
    ) const
 {
-   // 1200 points gives us 100 meter data up to a distance
-   // of one degree at the equator
-   static const unsigned int MAX_POINTS = 1200;
+   if (losCacheSize == 0) {
+      return computeOcculting(refLat, refLon, refAlt, tgtLat, tgtLon, tgtAlt);
+   }
+
+   // Check the cache
+   bool occulted = false;
+   lcLock(losCacheLock);
+   const unsigned int idx = losEntryIndex(refLat, refLon, refAlt, tgtLat, tgtLon, tgtAlt);
+   const bool found = findLosEntry(&occulted, refLat, refLon, refAlt, tgtLat, tgtLon, tgtAlt, idx);
+   if (found) losCacheHits++;
+   else losCacheMisses++;
+   lcUnlock(losCacheLock);
+
+   if (!found) {
+      // Compute it (outside of the lock) and save it
+      occulted = computeOcculting(refLat, refLon, refAlt, tgtLat, tgtLon, tgtAlt);
+
+      lcLock(losCacheLock);
+      if (idx < losCacheSize) {
+         LosEntry* const p = &losCache[idx];
+         p->refLat = refLat;
+         p->refLon = refLon;
+         p->refAlt = refAlt;
+         p->tgtLat = tgtLat;
+         p->tgtLon = tgtLon;
+         p->tgtAlt = tgtAlt;
+         p->frame = losFrame;
+         p->valid = true;
+         p->occulted = occulted;
+      }
+      lcUnlock(losCacheLock);
+   }
+
+   return occulted;
+}
+
+//------------------------------------------------------------------------------
+// Target occulting #2: returns true if any terrain in the 'truBrg' direction
+// for 'dist' meters occults (or masks) a target with a look angle of atan(tanLookAng)
+//------------------------------------------------------------------------------
+bool Terrain::targetOcculting2(
+      const double refLat,    // Ref latitude (degs)
+      const double refLon,    // Ref longitude (degs)
+      const double refAlt,    // Ref altitude (meters)
+      const double truBrg,    // True direction angle from north to look (degs)
+      const double dist,      // Distance to check (meters)
+      const double tanLookAng // Tangent of the look angle
+   ) const
+{
+   return computeOcculting2(refLat, refLon, refAlt, truBrg, dist, tanLookAng);
+}
 
+//------------------------------------------------------------------------------
+// Compute target occulting: targetOcculting() without the LOS result cache
+//------------------------------------------------------------------------------
+bool Terrain::computeOcculting(
+      const double refLat,    // Ref latitude (degs)
+      const double refLon,    // Ref longitude (degs)
+      const LCreal refAlt,    // Ref altitude (meters)
+      const double tgtLat,    // Target latitude (degs)
+      const double tgtLon,    // Target longitude (degs)
+      const LCreal tgtAlt     // Target altitude (meters)
+   ) const
+{
    bool occulted = false;
 
    // Compute bearing and distance to target (flat earth)
@@ -252,17 +494,16 @@ bool Terrain::targetOcculting(
    double dist = (distNM * Distance::NM2M);
 
    // Number of points (default: 100M data)
-   unsigned int numPts = static_cast<unsigned int>((dist / 100.0f) + 0.5f);
-   if (numPts > MAX_POINTS) numPts = MAX_POINTS;
+   const unsigned int numPts = getNumLosPoints(dist);
 
    // Get the elevations and check for target occulting
    if (numPts > 1) {
 
       // Arrays for the elevations
-      LCreal elevations[MAX_POINTS];
+      LCreal elevations[MAX_LOS_POINTS];
 
       // Valid flags
-      bool validFlags[MAX_POINTS];
+      bool validFlags[MAX_LOS_POINTS];
       for (unsigned int i = 0; i < numPts; i++) { validFlags[i] = false; }
 
       // Get the elevations
@@ -280,10 +521,9 @@ bool Terrain::targetOcculting(
 }
 
 //------------------------------------------------------------------------------
-// Target occulting #2: returns true if any terrain in the 'truBrg' direction
-// for 'dist' meters occults (or masks) a target with a look angle of atan(tanLookAng)
+// Compute target occulting #2: targetOcculting2()'s LOS check
 //------------------------------------------------------------------------------
-bool Terrain::targetOcculting2(
+bool Terrain::computeOcculting2(
       const double refLat,    // Ref latitude (degs)
       const double refLon,    // Ref longitude (degs)
       const double refAlt,    // Ref altitude (meters)
@@ -292,24 +532,19 @@ bool Terrain::targetOcculting2(
       const double tanLookAng // Tangent of the look angle
    ) const
 {
-   // 1200 points gives us 100 meter data up to a distance
-   // of one degree at the equator
-   static const unsigned int MAX_POINTS = 1200;
-
    bool occulted = false;
 
    // Number of points (default: 100M data)
-   unsigned int numPts = static_cast<unsigned int>((dist / 100.0f) + 0.5f);
-   if (numPts > MAX_POINTS) numPts = MAX_POINTS;
+   const unsigned int numPts = getNumLosPoints(dist);
 
    // Get the elevations and check for target occulting
    if (numPts > 1) {
 
       // Arrays for the elevations
-      LCreal elevations[MAX_POINTS];
+      LCreal elevations[MAX_LOS_POINTS];
 
       // Valid flags
-      bool validFlags[MAX_POINTS];
+      bool validFlags[MAX_LOS_POINTS];
       for (unsigned int i = 0; i < numPts; i++) { validFlags[i] = false; }
 
       // Get the elevations
@@ -325,6 +560,80 @@ bool Terrain::targetOcculting2(
    return occulted;
 }
 
+//------------------------------------------------------------------------------
+// Number of elevation points used to check occulting over 'dist' meters
+// (default: 100M data, up to MAX_LOS_POINTS)
+//------------------------------------------------------------------------------
+unsigned int Terrain::getNumLosPoints(const double dist)
+{
+   unsigned int numPts = static_cast<unsigned int>((dist / 100.0f) + 0.5f);
+   if (numPts > MAX_LOS_POINTS) numPts = MAX_LOS_POINTS;
+   return numPts;
+}
+
+//------------------------------------------------------------------------------
+// LOS cache index of the ref/target pair; the positions are quantized to
+// cells the size of the movement threshold.  The cache must be locked.
+//------------------------------------------------------------------------------
+unsigned int Terrain::losEntryIndex(
+      const double refLat, const double refLon, const double refAlt,
+      const double tgtLat, const double tgtLon, const double tgtAlt
+   ) const
+{
+   const double d2m = 60.0 * Distance::NM2M;  // degrees (of latitude) to meters
+   const double q = d2m / losCacheThreshold;
+   const double qa = 1.0 / losCacheThreshold;
+
+   const long long k[6] = {
+      static_cast<long long>(std::floor(refLat * q)),
+      static_cast<long long>(std::floor(refLon * q)),
+      static_cast<long long>(std::floor(refAlt * qa)),
+      static_cast<long long>(std::floor(tgtLat * q)),
+      static_cast<long long>(std::floor(tgtLon * q)),
+      static_cast<long long>(std::floor(tgtAlt * qa))
+   };
+
+   unsigned long long h = 14695981039346656037ULL;
+   for (unsigned int i = 0; i < 6; i++) {
+      h ^= static_cast<unsigned long long>(k[i]);
+      h *= 1099511628211ULL;
+   }
+   h ^= (h >> 32);
+
+   return static_cast<unsigned int>(h) & (losCacheSize - 1);
+}
+
+//------------------------------------------------------------------------------
+// Returns true, and sets 'occulted', if the LOS cache entry 'idx' is valid, is
+// not too old, and its ref and target points are within the movement threshold
+// of the given points.  The cache must be locked.
+//------------------------------------------------------------------------------
+bool Terrain::findLosEntry(
+      bool* const occulted,
+      const double refLat, const double refLon, const double refAlt,
+      const double tgtLat, const double tgtLon, const double tgtAlt,
+      const unsigned int idx
+   ) const
+{
+   if (idx >= losCacheSize) return false;
+
+   const LosEntry* const p = &losCache[idx];
+   if (!p->valid || (losFrame - p->frame) > losCacheMaxAge) return false;
+
+   const double thr = losCacheThreshold;
+   if (std::fabs(refAlt - p->refAlt) > thr || std::fabs(tgtAlt - p->tgtAlt) > thr) return false;
+
+   const double d2m = 60.0 * Distance::NM2M;  // degrees (of latitude) to meters
+   if (std::fabs(refLat - p->refLat) * d2m > thr || std::fabs(tgtLat - p->tgtLat) * d2m > thr) return false;
+
+   const double refLonM = d2m * std::cos(refLat * Angle::D2RCC);
+   const double tgtLonM = d2m * std::cos(tgtLat * Angle::D2RCC);
+   if (std::fabs(refLon - p->refLon) * refLonM > thr || std::fabs(tgtLon - p->tgtLon) * tgtLonM > thr) return false;
+
+   *occulted = p->occulted;
+   return true;
+}
+
 //------------------------------------------------------------------------------
 // Occulting check: returns true if a target at the altitude 'tgtAlt' and
 // range 'range' is occulted by the elevation points as seen from the
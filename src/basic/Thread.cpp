@@ -4,6 +4,7 @@
 
 #include "openeaagles/basic/Thread.h"
 #include "openeaagles/basic/Component.h"
+#include "openeaagles/basic/PhaseBarrier.h"
 
 namespace Eaagles {
 namespace Basic {
@@ -223,9 +224,27 @@ ThreadSyncTask::ThreadSyncTask(Component* const p, const LCreal pri) : Thread(p,
 
    startSig = nullptr;
    completedSig = nullptr;
+   barrier = nullptr;
+   barrierGen = 0;
+   barrierWorker = 0;
 }
 
-ThreadSyncTask::ThreadSyncTask() : startSig(nullptr), completedSig(nullptr)
+ThreadSyncTask::ThreadSyncTask(Component* const p, const LCreal pri, PhaseBarrier* const b, const unsigned int worker) : Thread(p, pri)
+{
+   STANDARD_CONSTRUCTOR()
+
+   startSig = nullptr;
+   completedSig = nullptr;
+   barrier = b;
+   barrierGen = 0;
+   barrierWorker = worker;
+
+   // We're created by the parent thread, so this is the generation
+   // before the first release() that we're to respond to.
+   if (barrier != nullptr) barrierGen = barrier->getGeneration();
+}
+
+ThreadSyncTask::ThreadSyncTask() : startSig(nullptr), completedSig(nullptr), barrier(nullptr), barrierGen(0), barrierWorker(0)
 {
    STANDARD_CONSTRUCTOR()
    std::cerr << "ThreadSyncTask(" << this << ")::ThreadSyncTask() -- ERROR: Do not use the default constructor" << std::endl;
@@ -250,6 +269,14 @@ void ThreadSyncTask::deleteData()
    closeSignals();
 }
 
+//-----------------------------------------------------------------------------
+// Get functions
+//-----------------------------------------------------------------------------
+PhaseBarrier* ThreadSyncTask::getBarrier()
+{
+   return barrier;
+}
+
 //-----------------------------------------------------------------------------
 // Configure thread
 //-----------------------------------------------------------------------------
@@ -284,12 +311,14 @@ unsigned long ThreadSyncTask::mainThreadFunc()
    // Main start-complete loop ...
    while ( ok && getParent()->isNotShutdown() ) {
 
-      // Wait for the start signal
-      waitForStart();
+      // Wait for the start signal (or the barrier's release)
+      if (barrier != nullptr) barrierGen = barrier->waitForRelease(barrierGen, barrierWorker);
+      else waitForStart();
 
       // Just in case we've been shutdown while we were waiting
       if (getParent()->isShutdown()) {
-         signalCompleted();
+         if (barrier != nullptr) barrier->arrive();
+         else signalCompleted();
          break;
       }
 
@@ -297,7 +326,8 @@ unsigned long ThreadSyncTask::mainThreadFunc()
       this->userFunc();
 
       // Signal that we've completed
-      signalCompleted();
+      if (barrier != nullptr) barrier->arrive();
+      else signalCompleted();
    }
 
    return rtn;
@@ -0,0 +1,184 @@
+//------------------------------------------------------------------------------
+// Class: WorkStealingExecutor
+//------------------------------------------------------------------------------
+#include "openeaagles/basic/WorkStealingExecutor.h"
+#include "openeaagles/basic/support.h"
+
+namespace Eaagles {
+namespace Basic {
+
+//------------------------------------------------------------------------------
+// Constructor & destructor
+//------------------------------------------------------------------------------
+WorkStealingExecutor::WorkStealingExecutor(const unsigned int numWorkers)
+   : nWorkers(numWorkers), nItems(0), chunkSize(0), passChunk(1), passT0(0.0)
+{
+   if (nWorkers < 1) nWorkers = 1;
+   if (nWorkers > MAX_WORKERS) nWorkers = MAX_WORKERS;
+
+   for (unsigned int i = 0; i < MAX_WORKERS; i++) {
+      workers[i].next = 0;
+      workers[i].end = 0;
+      workers[i].t0 = 0.0;
+      workers[i].t1 = 0.0;
+      workers[i].steals = 0;
+   }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor()
+{
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+bool WorkStealingExecutor::setChunkSize(const unsigned int n)
+{
+   chunkSize = n;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// beginPass() -- partition 'numItems' items into one range per worker
+//------------------------------------------------------------------------------
+void WorkStealingExecutor::beginPass(const unsigned int numItems)
+{
+   nItems = numItems;
+
+   // Chunk size for this pass
+   passChunk = chunkSize;
+   if (passChunk == 0) {
+      passChunk = nItems / (nWorkers * CHUNKS_PER_WORKER);
+      if (passChunk < 1) passChunk = 1;
+   }
+
+   // Contiguous ranges; the first (nItems % nWorkers) workers get one extra item
+   const unsigned int base = nItems / nWorkers;
+   const unsigned int extra = nItems % nWorkers;
+   unsigned int start = 0;
+   for (unsigned int i = 0; i < nWorkers; i++) {
+      unsigned int n = base + (i < extra ? 1 : 0);
+      workers[i].end = start + n;
+      workers[i].next.store(start, std::memory_order_relaxed);
+      workers[i].t0 = 0.0;
+      workers[i].t1 = 0.0;
+      start += n;
+   }
+
+   // The workers are started by the parent using a thread signal,
+   // which also makes these stores visible to the workers.
+   std::atomic_thread_fence(std::memory_order_release);
+
+   passT0 = getComputerTime();
+}
+
+//------------------------------------------------------------------------------
+// endPass() -- all workers have completed; update the statistics
+//------------------------------------------------------------------------------
+void WorkStealingExecutor::endPass()
+{
+   std::atomic_thread_fence(std::memory_order_acquire);
+
+   // The pass ends when the slowest worker ends
+   double passT1 = passT0;
+   for (unsigned int i = 0; i < nWorkers; i++) {
+      if (workers[i].t1 > passT1) passT1 = workers[i].t1;
+   }
+
+   for (unsigned int i = 0; i < nWorkers; i++) {
+      double busy = 0.0;
+      if (workers[i].t1 > workers[i].t0) busy = (workers[i].t1 - workers[i].t0);
+      double idle = (passT1 - passT0) - busy;
+      if (idle < 0.0) idle = 0.0;
+      busyStats[i].sigma(busy);
+      idleStats[i].sigma(idle);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Worker start/end markers
+//------------------------------------------------------------------------------
+void WorkStealingExecutor::beginWork(const unsigned int worker)
+{
+   if (worker < nWorkers) workers[worker].t0 = getComputerTime();
+}
+
+void WorkStealingExecutor::endWork(const unsigned int worker)
+{
+   if (worker < nWorkers) workers[worker].t1 = getComputerTime();
+}
+
+//------------------------------------------------------------------------------
+// nextChunk() -- claim a chunk from our own range, or steal one from the
+// other workers' ranges, starting with our neighbor.
+//------------------------------------------------------------------------------
+bool WorkStealingExecutor::nextChunk(const unsigned int worker, unsigned int* const begin, unsigned int* const end)
+{
+   if (worker >= nWorkers || begin == nullptr || end == nullptr) return false;
+
+   // Our own range first
+   if (claim(&workers[worker], begin, end)) return true;
+
+   // Then steal
+   for (unsigned int i = 1; i < nWorkers; i++) {
+      unsigned int victim = (worker + i) % nWorkers;
+      if (claim(&workers[victim], begin, end)) {
+         workers[worker].steals++;
+         return true;
+      }
+   }
+
+   return false;
+}
+
+// Claim the next chunk from this worker's range
+bool WorkStealingExecutor::claim(Worker* const wp, unsigned int* const begin, unsigned int* const end)
+{
+   // Quick check so that empty ranges are not pushed past their end
+   if (wp->next.load(std::memory_order_relaxed) >= wp->end) return false;
+
+   unsigned int b = wp->next.fetch_add(passChunk, std::memory_order_relaxed);
+   if (b >= wp->end) return false;
+
+   unsigned int e = b + passChunk;
+   if (e > wp->end) e = wp->end;
+   *begin = b;
+   *end = e;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Statistics
+//------------------------------------------------------------------------------
+const Statistic* WorkStealingExecutor::getBusyTimeStats(const unsigned int worker) const
+{
+   const Statistic* p = nullptr;
+   if (worker < nWorkers) p = &busyStats[worker];
+   return p;
+}
+
+const Statistic* WorkStealingExecutor::getIdleTimeStats(const unsigned int worker) const
+{
+   const Statistic* p = nullptr;
+   if (worker < nWorkers) p = &idleStats[worker];
+   return p;
+}
+
+unsigned long WorkStealingExecutor::getNumSteals(const unsigned int worker) const
+{
+   unsigned long n = 0;
+   if (worker < nWorkers) n = workers[worker].steals;
+   return n;
+}
+
+void WorkStealingExecutor::clearStats()
+{
+   for (unsigned int i = 0; i < MAX_WORKERS; i++) {
+      busyStats[i].clear();
+      idleStats[i].clear();
+      workers[i].steals = 0;
+   }
+}
+
+} // End Basic namespace
+} // End Eaagles namespace
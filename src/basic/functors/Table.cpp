@@ -45,17 +45,19 @@ IMPLEMENT_PARTIAL_SUBCLASS(Table, "Table")
 BEGIN_SLOTTABLE(Table)
     "data",          // Data table
     "extrapolate",   // Extrapolate beyond data
+    "float32",       // Single precision data table
 END_SLOTTABLE(Table)
 
 BEGIN_SLOT_MAP(Table)
     ON_SLOT(1,setDataTable,List)
     ON_SLOT(2,setExtrapolationEnabled,Number)
+    ON_SLOT(3,setFloat32Enabled,Number)
 END_SLOT_MAP()
 
 //------------------------------------------------------------------------------
 // Class support functions
 //------------------------------------------------------------------------------
-Table::Table() : valid(false), extFlg(false)
+Table::Table() : valid(false), extFlg(false), ftable(nullptr), f32Flg(false)
 {
    STANDARD_CONSTRUCTOR()
    dtable = nullptr;
@@ -63,7 +65,7 @@ Table::Table() : valid(false), extFlg(false)
 }
 
 Table::Table(const LCreal* dtbl, const unsigned int dsize)
-   : valid(false), dtable(nullptr), nd(0), extFlg(false)
+   : valid(false), dtable(nullptr), nd(0), extFlg(false), ftable(nullptr), f32Flg(false)
 {
     STANDARD_CONSTRUCTOR()
     if (dtbl != nullptr && dsize > 0) {   /* Copy the data table */
@@ -75,7 +77,7 @@ Table::Table(const LCreal* dtbl, const unsigned int dsize)
     }
 }
 
-Table::Table(const Table& org) : valid(false), extFlg(false)
+Table::Table(const Table& org) : valid(false), extFlg(false), ftable(nullptr), f32Flg(false)
 {
     STANDARD_CONSTRUCTOR()
     dtable = nullptr;
@@ -115,6 +117,8 @@ void Table::copyData(const Table& org, const bool cc)
     else dtable = nullptr;
     valid = org.valid;
     extFlg = org.extFlg;
+    f32Flg = org.f32Flg;
+    updateFloatTable();
 }
 
 void Table::deleteData()
@@ -122,6 +126,8 @@ void Table::deleteData()
     if (dtable != nullptr) delete[] dtable;
     dtable = nullptr;
     nd = 0;
+    if (ftable != nullptr) delete[] ftable;
+    ftable = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -158,6 +164,39 @@ bool Table::setExtrapolationEnabled(const Number* const msg)
    return ok;
 }
 
+//------------------------------------------------------------------------------
+// setFloat32Enabled() -- set the single precision data table enabled flag
+//------------------------------------------------------------------------------
+bool Table::setFloat32Enabled(const bool flg)
+{
+   f32Flg = flg;
+   updateFloatTable();
+   return true;
+}
+
+bool Table::setFloat32Enabled(const Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setFloat32Enabled( msg->getBoolean() );
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// updateFloatTable() -- (re)make the single precision copy of the data table
+//------------------------------------------------------------------------------
+void Table::updateFloatTable()
+{
+   if (ftable != nullptr) { delete[] ftable; ftable = nullptr; }
+
+   // (nothing to gain if LCreal is already single precision)
+   if (f32Flg && dtable != nullptr && nd > 0 && sizeof(LCreal) > sizeof(float)) {
+      ftable = new float[nd];
+      for (unsigned int i = 0; i < nd; i++) ftable[i] = static_cast<float>(dtable[i]);
+   }
+}
+
 //------------------------------------------------------------------------------
 // findMinMax() -- find the minimum and maximum values of the table
 //------------------------------------------------------------------------------
@@ -221,6 +260,7 @@ bool Table::setDataTable(const List* const sdtobj)
                 if (dtable != nullptr) delete[] dtable;
                 dtable = p;
                 nd = ts;
+                updateFloatTable();
             }
             else {
                 // Something was wrong!
@@ -258,6 +298,11 @@ std::ostream& Table::serialize(std::ostream& sout, const int i, const bool slots
     sout << "data: ";
     printData(sout, dtable, (i + j));
 
+    if (f32Flg) {
+        indent(sout, i + j);
+        sout << "float32: true" << std::endl;
+    }
+
     if (!slotsOnly) {
         indent(sout, i);
         sout << ")" << std::endl;
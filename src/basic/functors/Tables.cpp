@@ -12,6 +12,113 @@
 namespace Eaagles {
 namespace Basic {
 
+//------------------------------------------------------------------------------
+// lfiCorners() -- ND linear function interpolation of the data at the 2^ND
+// corners of the breakpoint brackets; the interpolations are done in the same
+// order as the lfi::lfi_ND() functions, from the first independent variable
+// to the last.
+//------------------------------------------------------------------------------
+template <unsigned int ND, typename T>
+static inline LCreal lfiCorners(
+         const lfi::Bracket* const b,           // Breakpoint brackets [ND]
+         const lfi::Axis* const* const axes,    // Compiled breakpoint tables [ND]
+         const T* const a_data                  // Dependent variable data
+      )
+{
+   // The data at the 2^ND corners; bit 'd' of the corner's index selects i1 or i2 of variable 'd'
+   unsigned int base = 0;
+   unsigned int ax[1 << ND];
+   ax[0] = 0;
+   unsigned int stride = 1;
+   for (unsigned int d = 0; d < ND; d++) {
+      base += b[d].i1 * stride;
+      const unsigned int step = (b[d].i2 - b[d].i1) * stride;
+      for (unsigned int k = 0; k < (1u << d); k++) {
+         ax[k + (1u << d)] = ax[k] + step;
+      }
+      stride *= axes[d]->n;
+   }
+   LCreal a[1 << ND];
+   for (unsigned int k = 0; k < (1u << ND); k++) {
+      a[k] = static_cast<LCreal>(a_data[base + ax[k]]);
+   }
+
+   // Interpolate one variable at a time
+   for (unsigned int d = 0; d < ND; d++) {
+      const LCreal m = b[d].m;
+      for (unsigned int k = 0; k < (1u << (ND - 1 - d)); k++) {
+         a[k] = m * (a[2*k + 1] - a[2*k]) + a[2*k];
+      }
+   }
+   return a[0];
+}
+
+//------------------------------------------------------------------------------
+// lfiPoint() -- ND linear function interpolation of one point using the
+// table's compiled breakpoint tables
+//------------------------------------------------------------------------------
+template <unsigned int ND>
+static LCreal lfiPoint(
+         const LCreal* const iv,                // Independent variables [ND]
+         const lfi::Axis* const* const axes,    // Compiled breakpoint tables [ND]
+         const Table& tbl                       // Table
+      )
+{
+   lfi::Bracket b[ND];
+   for (unsigned int d = 0; d < ND; d++) {
+      b[d].i1 = 0;
+      b[d].i2 = 0;
+      b[d].m = 0;
+      lfi::findBracket(&b[d], iv[d], *axes[d], tbl.isExtrapolationEnabled());
+   }
+
+   if (tbl.getFloatTable() != nullptr) return lfiCorners<ND>(b, axes, tbl.getFloatTable());
+   else return lfiCorners<ND>(b, axes, tbl.getDataTable());
+}
+
+//------------------------------------------------------------------------------
+// lfiArray() -- ND linear function interpolation of 'n' points using the
+// table's compiled breakpoint tables; each point's search starts with the
+// previous point's breakpoints.
+//------------------------------------------------------------------------------
+template <unsigned int ND, typename T>
+static void lfiArray(
+         const LCreal* const* const iv,         // Independent variable arrays [ND]
+         const lfi::Axis* const* const axes,    // Compiled breakpoint tables [ND]
+         const T* const a_data,                 // Dependent variable data
+         const bool eFlg,                       // Extrapolation is enabled beyond the table
+         LCreal* const out,                     // Results [n]
+         const unsigned int n                   // Number of points
+      )
+{
+   lfi::Bracket b[ND];
+   for (unsigned int d = 0; d < ND; d++) {
+      b[d].i1 = 0;
+      b[d].i2 = 0;
+      b[d].m = 0;
+   }
+
+   for (unsigned int i = 0; i < n; i++) {
+      for (unsigned int d = 0; d < ND; d++) {
+         lfi::findBracket(&b[d], iv[d][i], *axes[d], eFlg);
+      }
+      out[i] = lfiCorners<ND>(b, axes, a_data);
+   }
+}
+
+template <unsigned int ND>
+static void lfiArray(
+         const LCreal* const* const iv,         // Independent variable arrays [ND]
+         const lfi::Axis* const* const axes,    // Compiled breakpoint tables [ND]
+         const Table& tbl,                      // Table
+         LCreal* const out,                     // Results [n]
+         const unsigned int n                   // Number of points
+      )
+{
+   if (tbl.getFloatTable() != nullptr) lfiArray<ND>(iv, axes, tbl.getFloatTable(), tbl.isExtrapolationEnabled(), out, n);
+   else lfiArray<ND>(iv, axes, tbl.getDataTable(), tbl.isExtrapolationEnabled(), out, n);
+}
+
 //==============================================================================
 // Class Table1
 //==============================================================================
@@ -33,6 +140,7 @@ Table1::Table1() : Table()
    STANDARD_CONSTRUCTOR()
    xtable = nullptr;
    nx = 0;
+   lfi::initAxis(&xaxis, nullptr, 0);
 }
 
 Table1::Table1(const LCreal* dtbl, const unsigned int dsize,
@@ -48,6 +156,7 @@ Table1::Table1(const LCreal* dtbl, const unsigned int dsize,
             valid = isValid();
         }
     }
+    lfi::initAxis(&xaxis, xtable, nx);
 }
 
 void Table1::copyData(const Table1& org, const bool cc)
@@ -64,6 +173,7 @@ void Table1::copyData(const Table1& org, const bool cc)
         for (unsigned int i = 0; i < nx; i++) xtable[i] = org.xtable[i];
     }
     else xtable = nullptr;
+    lfi::initAxis(&xaxis, xtable, nx);
     valid = isValid();
 }
 
@@ -72,6 +182,7 @@ void Table1::deleteData()
     if (xtable != nullptr) delete[] xtable;
     xtable = nullptr;
     nx = 0;
+    lfi::initAxis(&xaxis, nullptr, 0);
 }
 
 //------------------------------------------------------------------------------
@@ -142,17 +253,28 @@ Table1::lfi(const LCreal iv1, FStorage* const f) const
 {
    if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
 
-   if (f != nullptr) {
+   if (f != nullptr && getFloatTable() == nullptr) {
       TableStorage* s = dynamic_cast<TableStorage*>(f);
       if (s == nullptr) throw new ExpInvalidFStorage();
 
       return lfi::lfi_1D(iv1, getXData(), getNumXPoints(), getDataTable(), isExtrapolationEnabled(), &s->xbp);
    }
    else {
-      return lfi::lfi_1D(iv1, getXData(), getNumXPoints(), getDataTable(), isExtrapolationEnabled());
+      const LCreal iv[1] = { iv1 };
+      const lfi::Axis* const axes[1] = { &xaxis };
+      return lfiPoint<1>(iv, axes, *this);
    }
 }
 
+void Table1::lfi(const LCreal* const iv1, LCreal* const out, const unsigned int n) const
+{
+   if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
+
+   const LCreal* const iv[1] = { iv1 };
+   const lfi::Axis* const axes[1] = { &xaxis };
+   lfiArray<1>(iv, axes, *this, out, n);
+}
+
 //------------------------------------------------------------------------------
 // setXBreakpoints1() -- for Table1
 //------------------------------------------------------------------------------
@@ -160,6 +282,7 @@ bool Table1::setXBreakpoints1(const List* const sxb1obj)
 {
     if (sxb1obj != nullptr) {
         loadVector(*sxb1obj, &xtable, &nx);
+        lfi::initAxis(&xaxis, xtable, nx);
         valid = isValid();
     }
     return true;
@@ -231,6 +354,7 @@ Table2::Table2() : Table1()
    STANDARD_CONSTRUCTOR()
    ytable = nullptr;
    ny = 0;
+   lfi::initAxis(&yaxis, nullptr, 0);
 }
 
 Table2::Table2(const LCreal* dtbl, const unsigned int dsize,
@@ -247,6 +371,7 @@ Table2::Table2(const LCreal* dtbl, const unsigned int dsize,
             valid = isValid();
         }
     }
+    lfi::initAxis(&yaxis, ytable, ny);
 }
 
 void Table2::copyData(const Table2& org, const bool cc)
@@ -263,6 +388,7 @@ void Table2::copyData(const Table2& org, const bool cc)
         for (unsigned int i = 0; i < ny; i++) ytable[i] = org.ytable[i];
     }
     else ytable = nullptr;
+    lfi::initAxis(&yaxis, ytable, ny);
     valid = isValid();
 }
 
@@ -271,6 +397,7 @@ void Table2::deleteData()
     if (ytable != nullptr) delete[] ytable;
     ytable = nullptr;
     ny = 0;
+    lfi::initAxis(&yaxis, nullptr, 0);
 }
 
 //------------------------------------------------------------------------------
@@ -347,20 +474,7 @@ Table2::lfi(const LCreal iv1, FStorage* const f) const
 {
    if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
 
-   if (f != nullptr) {
-      TableStorage* s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi::lfi_2D( iv1, ytable[0], getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getDataTable(),
-                         isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp );
-   }
-   else {
-      return lfi::lfi_2D( iv1, ytable[0], getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getDataTable(),
-                         isExtrapolationEnabled() );
-   }
+   return Table2::lfi(iv1, ytable[0], f);
 }
 
 LCreal
@@ -368,7 +482,7 @@ Table2::lfi(const LCreal iv1, const LCreal iv2, FStorage* const f) const
 {
    if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
 
-   if (f != nullptr) {
+   if (f != nullptr && getFloatTable() == nullptr) {
       TableStorage* s = dynamic_cast<TableStorage*>(f);
       if (s == nullptr) throw new ExpInvalidFStorage();
 
@@ -378,12 +492,21 @@ Table2::lfi(const LCreal iv1, const LCreal iv2, FStorage* const f) const
                          &s->xbp, &s->ybp );
    }
    else {
-      return lfi::lfi_2D( iv1, iv2, getXData(), getNumXPoints(), getYData(),
-                         getNumYPoints(), getDataTable(),
-                         isExtrapolationEnabled() );
+      const LCreal iv[2] = { iv1, iv2 };
+      const lfi::Axis* const axes[2] = { &getXAxis(), &yaxis };
+      return lfiPoint<2>(iv, axes, *this);
    }
 }
 
+void Table2::lfi(const LCreal* const iv1, const LCreal* const iv2, LCreal* const out, const unsigned int n) const
+{
+   if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
+
+   const LCreal* const iv[2] = { iv1, iv2 };
+   const lfi::Axis* const axes[2] = { &getXAxis(), &yaxis };
+   lfiArray<2>(iv, axes, *this, out, n);
+}
+
 //------------------------------------------------------------------------------
 // setYBreakpoints2() -- for Table2
 //------------------------------------------------------------------------------
@@ -391,6 +514,7 @@ bool Table2::setYBreakpoints2(const List* const syb2obj)
 {
     if (syb2obj != nullptr) {
         loadVector(*syb2obj, &ytable, &ny);
+        lfi::initAxis(&yaxis, ytable, ny);
         valid = isValid();
     }
     return true;
@@ -473,6 +597,7 @@ Table3::Table3() : Table2()
    STANDARD_CONSTRUCTOR()
    ztable = nullptr;
    nz = 0;
+   lfi::initAxis(&zaxis, nullptr, 0);
 }
 
 Table3::Table3(const LCreal* dtbl, const unsigned int dsize,
@@ -491,6 +616,7 @@ Table3::Table3(const LCreal* dtbl, const unsigned int dsize,
             valid = isValid();
         }
     }
+    lfi::initAxis(&zaxis, ztable, nz);
 }
 
 void Table3::copyData(const Table3& org, const bool cc)
@@ -507,6 +633,7 @@ void Table3::copyData(const Table3& org, const bool cc)
         for (unsigned int i = 0; i < nz; i++) ztable[i] = org.ztable[i];
     }
     else ztable = nullptr;
+    lfi::initAxis(&zaxis, ztable, nz);
     valid = isValid();
 }
 
@@ -515,6 +642,7 @@ void Table3::deleteData()
     if (ztable != nullptr) delete[] ztable;
     ztable = nullptr;
     nz = 0;
+    lfi::initAxis(&zaxis, nullptr, 0);
 }
 
 //------------------------------------------------------------------------------
@@ -593,21 +721,7 @@ Table3::lfi(const LCreal iv1, FStorage* const f) const
 {
    if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
 
-   const LCreal* y_data = getYData();
-   if (f != nullptr) {
-      TableStorage* s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi::lfi_3D( iv1, y_data[0], ztable[0], getXData(), getNumXPoints(),
-                         y_data, getNumYPoints(), getZData(), getNumZPoints(),
-                         getDataTable(), isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp, &s->zbp );
-   }
-   else {
-      return lfi::lfi_3D( iv1, y_data[0], ztable[0], getXData(), getNumXPoints(),
-                         y_data, getNumYPoints(), getZData(), getNumZPoints(),
-                         getDataTable(), isExtrapolationEnabled() );
-   }
+   return Table3::lfi(iv1, getYData()[0], ztable[0], f);
 }
 
 LCreal
@@ -615,20 +729,7 @@ Table3::lfi(const LCreal iv1, const LCreal iv2, FStorage* const f) const
 {
    if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
 
-   if (f != nullptr) {
-      TableStorage* s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi::lfi_3D( iv1, iv2, ztable[0], getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getZData(),
-                         getNumZPoints(), getDataTable(), isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp, &s->zbp );
-   }
-   else {
-      return lfi::lfi_3D( iv1, iv2, ztable[0], getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getZData(),
-                         getNumZPoints(), getDataTable(), isExtrapolationEnabled() );
-   }
+   return Table3::lfi(iv1, iv2, ztable[0], f);
 }
 
 LCreal
@@ -636,7 +737,7 @@ Table3::lfi(const LCreal iv1, const LCreal iv2, const LCreal iv3, FStorage* cons
 {
    if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
 
-   if (f != nullptr) {
+   if (f != nullptr && getFloatTable() == nullptr) {
       TableStorage* s = dynamic_cast<TableStorage*>(f);
       if (s == nullptr) throw new ExpInvalidFStorage();
 
@@ -646,12 +747,22 @@ Table3::lfi(const LCreal iv1, const LCreal iv2, const LCreal iv3, FStorage* cons
                          &s->xbp, &s->ybp, &s->zbp );
    }
    else {
-      return lfi::lfi_3D( iv1, iv2, iv3, getXData(), getNumXPoints(), getYData(),
-                         getNumYPoints(), getZData(), getNumZPoints(),
-                         getDataTable(), isExtrapolationEnabled() );
+      const LCreal iv[3] = { iv1, iv2, iv3 };
+      const lfi::Axis* const axes[3] = { &getXAxis(), &getYAxis(), &zaxis };
+      return lfiPoint<3>(iv, axes, *this);
    }
 }
 
+void Table3::lfi(const LCreal* const iv1, const LCreal* const iv2, const LCreal* const iv3,
+                 LCreal* const out, const unsigned int n) const
+{
+   if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
+
+   const LCreal* const iv[3] = { iv1, iv2, iv3 };
+   const lfi::Axis* const axes[3] = { &getXAxis(), &getYAxis(), &zaxis };
+   lfiArray<3>(iv, axes, *this, out, n);
+}
+
 //------------------------------------------------------------------------------
 // setZBreakpoints3() -- for Table3
 //------------------------------------------------------------------------------
@@ -659,6 +770,7 @@ bool Table3::setZBreakpoints3(const List* const szb3obj)
 {
     if (szb3obj != nullptr) {
         loadVector(*szb3obj, &ztable, &nz);
+        lfi::initAxis(&zaxis, ztable, nz);
         valid = isValid();
     }
     return true;
@@ -741,6 +853,7 @@ Table4::Table4() : Table3()
    STANDARD_CONSTRUCTOR()
    wtable = nullptr;
    nw = 0;
+   lfi::initAxis(&waxis, nullptr, 0);
 }
 Table4::Table4(const LCreal* dtbl, const unsigned int dsize,
                    const LCreal* xtbl, const unsigned int xsize,
@@ -759,6 +872,7 @@ Table4::Table4(const LCreal* dtbl, const unsigned int dsize,
             valid = isValid();
         }
     }
+    lfi::initAxis(&waxis, wtable, nw);
 }
 
 void Table4::copyData(const Table4& org, const bool cc)
@@ -775,6 +889,7 @@ void Table4::copyData(const Table4& org, const bool cc)
         for (unsigned int i = 0; i < nw; i++) wtable[i] = org.wtable[i];
     }
     else wtable = nullptr;
+    lfi::initAxis(&waxis, wtable, nw);
     valid = isValid();
 }
 
@@ -783,6 +898,7 @@ void Table4::deleteData()
     if (wtable != nullptr) delete[] wtable;
     wtable = nullptr;
     nw = 0;
+    lfi::initAxis(&waxis, nullptr, 0);
 }
 
 //------------------------------------------------------------------------------
@@ -874,24 +990,7 @@ Table4::lfi(const LCreal iv1, FStorage* const f) const
 {
    if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
 
-   const LCreal* y_data = getYData();
-   const LCreal* z_data = getZData();
-   if (f != nullptr) {
-      TableStorage* s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi::lfi_4D( iv1, y_data[0], z_data[0], wtable[0], getXData(),
-                         getNumXPoints(), y_data, getNumYPoints(), z_data,
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getDataTable(), isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp, &s->zbp, &s->wbp );
-   }
-   else {
-      return lfi::lfi_4D( iv1, y_data[0], z_data[0], wtable[0], getXData(),
-                         getNumXPoints(), y_data, getNumYPoints(), z_data,
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getDataTable(), isExtrapolationEnabled() );
-   }
+   return Table4::lfi(iv1, getYData()[0], getZData()[0], wtable[0], f);
 }
 
 LCreal
@@ -899,23 +998,7 @@ Table4::lfi(const LCreal iv1, const LCreal iv2, FStorage* const f) const
 {
    if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
 
-   const LCreal* z_data = getZData();
-   if (f != nullptr) {
-      TableStorage* s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi::lfi_4D( iv1, iv2, z_data[0], wtable[0], getXData(),
-                         getNumXPoints(), getYData(), getNumYPoints(),
-                         z_data, getNumZPoints(), getWData(), getNumWPoints(),
-                         getDataTable(), isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp, &s->zbp, &s->wbp );
-   }
-   else {
-      return lfi::lfi_4D( iv1, iv2, z_data[0], wtable[0], getXData(),
-                         getNumXPoints(), getYData(), getNumYPoints(),
-                         z_data, getNumZPoints(), getWData(), getNumWPoints(),
-                         getDataTable(), isExtrapolationEnabled() );
-   }
+   return Table4::lfi(iv1, iv2, getZData()[0], wtable[0], f);
 }
 
 LCreal
@@ -923,22 +1006,7 @@ Table4::lfi(const LCreal iv1, const LCreal iv2, const LCreal iv3, FStorage* cons
 {
    if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
 
-   if (f != nullptr) {
-      TableStorage* s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi::lfi_4D( iv1, iv2, iv3, wtable[0], getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getZData(),
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getDataTable(), isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp, &s->zbp, &s->wbp );
-   }
-   else {
-      return lfi::lfi_4D( iv1, iv2, iv3, wtable[0], getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getZData(),
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getDataTable(), isExtrapolationEnabled() );
-   }
+   return Table4::lfi(iv1, iv2, iv3, wtable[0], f);
 }
 
 LCreal
@@ -946,7 +1014,7 @@ Table4::lfi(const LCreal iv1, const LCreal iv2, const LCreal iv3, const LCreal i
 {
    if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
 
-   if (f != nullptr) {
+   if (f != nullptr && getFloatTable() == nullptr) {
        TableStorage* s = dynamic_cast<TableStorage*>(f);
        if (s == nullptr) throw new ExpInvalidFStorage();
 
@@ -957,13 +1025,22 @@ Table4::lfi(const LCreal iv1, const LCreal iv2, const LCreal iv3, const LCreal i
                            &s->xbp, &s->ybp, &s->zbp, &s->wbp );
    }
    else {
-       return lfi::lfi_4D( iv1, iv2, iv3, iv4, getXData(), getNumXPoints(),
-                           getYData(), getNumYPoints(), getZData(),
-                           getNumZPoints(), getWData(), getNumWPoints(),
-                           getDataTable(), isExtrapolationEnabled() );
+      const LCreal iv[4] = { iv1, iv2, iv3, iv4 };
+      const lfi::Axis* const axes[4] = { &getXAxis(), &getYAxis(), &getZAxis(), &waxis };
+      return lfiPoint<4>(iv, axes, *this);
    }
 }
 
+void Table4::lfi(const LCreal* const iv1, const LCreal* const iv2, const LCreal* const iv3, const LCreal* const iv4,
+                 LCreal* const out, const unsigned int n) const
+{
+   if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
+
+   const LCreal* const iv[4] = { iv1, iv2, iv3, iv4 };
+   const lfi::Axis* const axes[4] = { &getXAxis(), &getYAxis(), &getZAxis(), &waxis };
+   lfiArray<4>(iv, axes, *this, out, n);
+}
+
 //------------------------------------------------------------------------------
 // setWBreakpoints4() -- For Table4
 //------------------------------------------------------------------------------
@@ -971,6 +1048,7 @@ bool Table4::setWBreakpoints4(const List* const swb4obj)
 {
     if (swb4obj != nullptr) {
         loadVector(*swb4obj, &wtable, &nw);
+        lfi::initAxis(&waxis, wtable, nw);
         valid = isValid();
     }
     return true;
@@ -1053,6 +1131,7 @@ Table5::Table5() : Table4()
    STANDARD_CONSTRUCTOR()
    vtable = nullptr;
    nv = 0;
+   lfi::initAxis(&vaxis, nullptr, 0);
 }
 
 Table5::Table5(const LCreal* dtbl, const unsigned int dsize,
@@ -1073,6 +1152,7 @@ Table5::Table5(const LCreal* dtbl, const unsigned int dsize,
             valid = isValid();
         }
     }
+    lfi::initAxis(&vaxis, vtable, nv);
 }
 
 void Table5::copyData(const Table5& org, const bool cc)
@@ -1089,6 +1169,7 @@ void Table5::copyData(const Table5& org, const bool cc)
         for (unsigned int i = 0; i < nv; i++) vtable[i] = org.vtable[i];
     }
     else vtable = nullptr;
+    lfi::initAxis(&vaxis, vtable, nv);
     valid = isValid();
 }
 
@@ -1097,6 +1178,7 @@ void Table5::deleteData()
     if (vtable != nullptr) delete[] vtable;
     vtable = nullptr;
     nv = 0;
+    lfi::initAxis(&vaxis, nullptr, 0);
 }
 
 //------------------------------------------------------------------------------
@@ -1172,27 +1254,7 @@ Table5::lfi(const LCreal iv1, FStorage* const f) const
 {
    if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
 
-   const LCreal* y_data = getYData();
-   const LCreal* z_data = getZData();
-   const LCreal* w_data = getWData();
-   if (f != nullptr) {
-      TableStorage* s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi::lfi_5D( iv1, y_data[0], z_data[0], w_data[0], vtable[0], getXData(),
-                         getNumXPoints(), y_data, getNumYPoints(), z_data,
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getVData(), getNumVPoints(),
-                         getDataTable(), isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp, &s->zbp, &s->wbp, &s->vbp );
-   }
-   else {
-      return lfi::lfi_5D( iv1, y_data[0], z_data[0], w_data[0], vtable[0], getXData(),
-                         getNumXPoints(), y_data, getNumYPoints(), z_data,
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getVData(), getNumVPoints(),
-                         getDataTable(), isExtrapolationEnabled());
-   }
+   return Table5::lfi(iv1, getYData()[0], getZData()[0], getWData()[0], vtable[0], f);
 }
 
 LCreal
@@ -1200,26 +1262,7 @@ Table5::lfi(const LCreal iv1, const LCreal iv2, FStorage* const f) const
 {
    if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
 
-   const LCreal* z_data = getZData();
-   const LCreal* w_data = getWData();
-   if (f != nullptr) {
-      TableStorage* s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi::lfi_5D( iv1, iv2, z_data[0], w_data[0], vtable[0], getXData(),
-                         getNumXPoints(), getYData(), getNumYPoints(),
-                         z_data, getNumZPoints(), getWData(), getNumWPoints(),
-                         getVData(), getNumVPoints(),
-                         getDataTable(), isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp, &s->zbp, &s->wbp, &s->vbp );
-   }
-   else {
-      return lfi::lfi_5D( iv1, iv2, z_data[0], w_data[0], vtable[0], getXData(),
-                         getNumXPoints(), getYData(), getNumYPoints(),
-                         z_data, getNumZPoints(), getWData(), getNumWPoints(),
-                         getVData(), getNumVPoints(),
-                         getDataTable(), isExtrapolationEnabled());
-   }
+   return Table5::lfi(iv1, iv2, getZData()[0], getWData()[0], vtable[0], f);
 }
 
 LCreal
@@ -1227,25 +1270,7 @@ Table5::lfi(const LCreal iv1, const LCreal iv2, const LCreal iv3, FStorage* cons
 {
    if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
 
-   const LCreal* w_data = getWData();
-   if (f != nullptr) {
-      TableStorage* s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi::lfi_5D( iv1, iv2, iv3, w_data[0], vtable[0], getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getZData(),
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getVData(), getNumVPoints(),
-                         getDataTable(), isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp, &s->zbp, &s->wbp, &s->vbp );
-   }
-   else {
-      return lfi::lfi_5D( iv1, iv2, iv3, w_data[0], vtable[0], getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getZData(),
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getVData(), getNumVPoints(),
-                         getDataTable(), isExtrapolationEnabled());
-   }
+   return Table5::lfi(iv1, iv2, iv3, getWData()[0], vtable[0], f);
 }
 
 LCreal
@@ -1253,24 +1278,7 @@ Table5::lfi(const LCreal iv1, const LCreal iv2, const LCreal iv3, const LCreal i
 {
    if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
 
-   if (f != nullptr) {
-      TableStorage* s = dynamic_cast<TableStorage*>(f);
-      if (s == nullptr) throw new ExpInvalidFStorage();
-
-      return lfi::lfi_5D( iv1, iv2, iv3, iv4, vtable[0], getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getZData(),
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getVData(), getNumVPoints(),
-                         getDataTable(), isExtrapolationEnabled(),
-                         &s->xbp, &s->ybp, &s->zbp, &s->wbp, &s->vbp );
-   }
-   else {
-      return lfi::lfi_5D( iv1, iv2, iv3, iv4, vtable[0], getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getZData(),
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getVData(), getNumVPoints(),
-                         getDataTable(), isExtrapolationEnabled() );
-   }
+   return Table5::lfi(iv1, iv2, iv3, iv4, vtable[0], f);
 }
 
 LCreal
@@ -1278,7 +1286,7 @@ Table5::lfi(const LCreal iv1, const LCreal iv2, const LCreal iv3, const LCreal i
 {
    if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
 
-   if (f != nullptr) {
+   if (f != nullptr && getFloatTable() == nullptr) {
       TableStorage* s = dynamic_cast<TableStorage*>(f);
       if (s == nullptr) throw new ExpInvalidFStorage();
 
@@ -1290,14 +1298,22 @@ Table5::lfi(const LCreal iv1, const LCreal iv2, const LCreal iv3, const LCreal i
                          &s->xbp, &s->ybp, &s->zbp, &s->wbp, &s->vbp );
    }
    else {
-      return lfi::lfi_5D( iv1, iv2, iv3, iv4, iv5, getXData(), getNumXPoints(),
-                         getYData(), getNumYPoints(), getZData(),
-                         getNumZPoints(), getWData(), getNumWPoints(),
-                         getVData(), getNumVPoints(),
-                         getDataTable(), isExtrapolationEnabled() );
+      const LCreal iv[5] = { iv1, iv2, iv3, iv4, iv5 };
+      const lfi::Axis* const axes[5] = { &getXAxis(), &getYAxis(), &getZAxis(), &getWAxis(), &vaxis };
+      return lfiPoint<5>(iv, axes, *this);
    }
 }
 
+void Table5::lfi(const LCreal* const iv1, const LCreal* const iv2, const LCreal* const iv3, const LCreal* const iv4,
+                 const LCreal* const iv5, LCreal* const out, const unsigned int n) const
+{
+   if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
+
+   const LCreal* const iv[5] = { iv1, iv2, iv3, iv4, iv5 };
+   const lfi::Axis* const axes[5] = { &getXAxis(), &getYAxis(), &getZAxis(), &getWAxis(), &vaxis };
+   lfiArray<5>(iv, axes, *this, out, n);
+}
+
 //------------------------------------------------------------------------------
 // setVBreakpoints5() -- For Table5
 //------------------------------------------------------------------------------
@@ -1305,6 +1321,7 @@ bool Table5::setVBreakpoints5(const List* const swb5obj)
 {
     if (swb5obj != nullptr) {
         loadVector(*swb5obj, &vtable, &nv);
+        lfi::initAxis(&vaxis, vtable, nv);
         valid = isValid();
     }
     return true;
@@ -0,0 +1,39 @@
+//------------------------------------------------------------------------------
+// Class: PhaseBarrier -- Linux version
+//------------------------------------------------------------------------------
+
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+//-----------------------------------------------------------------------------
+// Blocks while the value at 'addr' is still equal to 'value'
+//-----------------------------------------------------------------------------
+void PhaseBarrier::waitOnValue(std::atomic<int>* const addr, const int value)
+{
+   syscall(SYS_futex, reinterpret_cast<int*>(addr), FUTEX_WAIT_PRIVATE, value, nullptr, nullptr, 0);
+}
+
+//-----------------------------------------------------------------------------
+// Wakes all (or one of the) threads waiting on 'addr'
+//-----------------------------------------------------------------------------
+void PhaseBarrier::wakeAll(std::atomic<int>* const addr)
+{
+   syscall(SYS_futex, reinterpret_cast<int*>(addr), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+
+void PhaseBarrier::wakeOne(std::atomic<int>* const addr)
+{
+   syscall(SYS_futex, reinterpret_cast<int*>(addr), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+//-----------------------------------------------------------------------------
+// Spin-wait hint
+//-----------------------------------------------------------------------------
+void PhaseBarrier::pause()
+{
+#if defined(__i386__) || defined(__x86_64__)
+   __builtin_ia32_pause();
+#endif
+}
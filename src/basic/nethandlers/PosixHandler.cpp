@@ -17,6 +17,7 @@
 #else
     #include <netdb.h>
     #include <arpa/inet.h>
+    #include <sys/socket.h>
     #include <sys/fcntl.h>
     #include <sys/ioctl.h>
     #ifdef sun
@@ -390,6 +391,114 @@ unsigned int PosixHandler::recvData(char* const packet, const int maxSize)
    return n;
 }
 
+// -------------------------------------------------------------
+// sendPackets() -- Send a batch of packets
+// -------------------------------------------------------------
+unsigned int PosixHandler::sendPackets(const char* const packets[], const int sizes[], const unsigned int n)
+{
+#if defined(__linux__)
+    if (socketNum == INVALID_SOCKET) return 0;
+
+    struct sockaddr_in addr;        // Working address structure
+    bzero(&addr, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = netAddr;
+    addr.sin_port = htons(port);
+
+    struct mmsghdr msgs[MAX_BATCH];
+    struct iovec iovs[MAX_BATCH];
+
+    unsigned int cnt = 0;   // Number of packets sent
+    unsigned int idx = 0;   // Index of the next packet to send
+    while (idx < n) {
+        unsigned int m = n - idx;
+        if (m > MAX_BATCH) m = MAX_BATCH;
+        for (unsigned int i = 0; i < m; i++) {
+            iovs[i].iov_base = const_cast<char*>(packets[idx+i]);
+            iovs[i].iov_len = sizes[idx+i];
+            bzero(&msgs[i], sizeof(msgs[i]));
+            msgs[i].msg_hdr.msg_name = &addr;
+            msgs[i].msg_hdr.msg_namelen = sizeof(addr);
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        const int result = ::sendmmsg(socketNum, msgs, m, 0);
+        if (result == SOCKET_ERROR) {
+            // The packet at 'idx' failed; skip it, as sendData() would have
+            std::perror("PosixHandler::sendPackets(): sendmmsg error msg");
+            idx++;
+        }
+        else {
+            cnt += result;
+            idx += result;
+        }
+    }
+    return cnt;
+#else
+    return BaseClass::sendPackets(packets, sizes, n);
+#endif
+}
+
+// -------------------------------------------------------------
+// recvPackets() -- Receive a batch of packets and possible ignore
+//                  our own local port messages.
+// -------------------------------------------------------------
+unsigned int PosixHandler::recvPackets(char* const packets[], unsigned int sizes[], const int maxSize, const unsigned int n)
+{
+#if defined(__linux__)
+    if (socketNum == INVALID_SOCKET) return 0;
+
+    fromAddr1 = INADDR_NONE;
+    fromPort1 = 0;
+
+    struct mmsghdr msgs[MAX_BATCH];
+    struct iovec iovs[MAX_BATCH];
+    struct sockaddr_in raddrs[MAX_BATCH];
+
+    unsigned int cnt = 0;    // Number of packets received
+    bool more = true;
+    while (more && cnt < n) {
+        unsigned int m = n - cnt;
+        if (m > MAX_BATCH) m = MAX_BATCH;
+        for (unsigned int i = 0; i < m; i++) {
+            iovs[i].iov_base = packets[cnt+i];
+            iovs[i].iov_len = maxSize;
+            bzero(&msgs[i], sizeof(msgs[i]));
+            msgs[i].msg_hdr.msg_name = &raddrs[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(raddrs[i]);
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        // Only the first call may wait (blocked I/O), and only for one packet
+        const int flags = (cnt == 0 ? MSG_WAITFORONE : MSG_DONTWAIT);
+        const int result = ::recvmmsg(socketNum, msgs, m, flags, nullptr);
+        if (result <= 0) break;
+
+        // A full batch?  Then there may be more waiting
+        more = (static_cast<unsigned int>(result) == m);
+
+        // Keep the packets, dropping empty ones and the ones from the ignored port
+        unsigned int k = cnt;
+        for (int i = 0; i < result; i++) {
+            const unsigned int len = msgs[i].msg_len;
+            const uint16_t rport = ntohs(raddrs[i].sin_port);
+            if (len > 0 && (ignoreSourcePort == 0 || rport != ignoreSourcePort)) {
+                if (k != cnt + i) std::memcpy(packets[k], packets[cnt+i], len);
+                sizes[k++] = len;
+                fromAddr1 = raddrs[i].sin_addr.s_addr;
+                fromPort1 = rport;
+            }
+        }
+        cnt = k;
+    }
+    return cnt;
+#else
+    return BaseClass::recvPackets(packets, sizes, maxSize, n);
+#endif
+}
+
 //------------------------------------------------------------------------------
 // Set functions
 //------------------------------------------------------------------------------
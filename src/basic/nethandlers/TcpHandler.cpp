@@ -204,6 +204,20 @@ unsigned int TcpHandler::recvData(char* const packet, const int maxSize)
    return n;
 }
 
+// -------------------------------------------------------------
+// sendPackets(), recvPackets() -- A TCP stream has no packet
+// boundaries, so the packets are sent and received one at a time
+// -------------------------------------------------------------
+unsigned int TcpHandler::sendPackets(const char* const packets[], const int sizes[], const unsigned int n)
+{
+    return NetHandler::sendPackets(packets, sizes, n);
+}
+
+unsigned int TcpHandler::recvPackets(char* const packets[], unsigned int sizes[], const int maxSize, const unsigned int n)
+{
+    return NetHandler::recvPackets(packets, sizes, maxSize, n);
+}
+
 } // End Basic namespace
 } // End Eaagles namespace
 
@@ -6,6 +6,13 @@
 #include <fstream>
 #include <cstring>
 #include <cctype>
+#include <cfloat>
+
+// SSE2 versions of the double precision array functions (see config.h)
+#if EAAGLES_CONFIG_SIMD && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+  #define EAAGLES_SSE2_ARRAYS
+  #include <emmintrin.h>
+#endif
 
 //------------------------------------------------------------------------------
 // Window/Linux specific code
@@ -277,6 +284,110 @@ void postMultVec3Array(
    }
 }
 
+//------------
+// Post-multiply 'n' 3D vectors, stored as separate x, y and z arrays, with
+// a 4x4 matrix (same as osg::Matrixd::postMult())
+//------------
+void postMultVec3Array(
+      const double* const x,
+      const double* const y,
+      const double* const z,
+      const osg::Matrixd& m,
+      double* const rx,
+      double* const ry,
+      double* const rz,
+      const unsigned int n
+   )
+{
+   // Without perspective, the divisor is always one
+   const bool affine = (m(3,0) == 0 && m(3,1) == 0 && m(3,2) == 0 && m(3,3) == 1.0);
+
+   unsigned int i = 0;
+
+#if defined(EAAGLES_SSE2_ARRAYS)
+   {
+      const __m128d m00 = _mm_set1_pd(m(0,0)), m01 = _mm_set1_pd(m(0,1)), m02 = _mm_set1_pd(m(0,2)), m03 = _mm_set1_pd(m(0,3));
+      const __m128d m10 = _mm_set1_pd(m(1,0)), m11 = _mm_set1_pd(m(1,1)), m12 = _mm_set1_pd(m(1,2)), m13 = _mm_set1_pd(m(1,3));
+      const __m128d m20 = _mm_set1_pd(m(2,0)), m21 = _mm_set1_pd(m(2,1)), m22 = _mm_set1_pd(m(2,2)), m23 = _mm_set1_pd(m(2,3));
+      const __m128d m30 = _mm_set1_pd(m(3,0)), m31 = _mm_set1_pd(m(3,1)), m32 = _mm_set1_pd(m(3,2)), m33 = _mm_set1_pd(m(3,3));
+      const __m128d one = _mm_set1_pd(1.0);
+      for (; (i + 2) <= n; i += 2) {
+         const __m128d vx = _mm_loadu_pd(x + i);
+         const __m128d vy = _mm_loadu_pd(y + i);
+         const __m128d vz = _mm_loadu_pd(z + i);
+         __m128d ox = _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(m00,vx), _mm_mul_pd(m01,vy)), _mm_mul_pd(m02,vz)), m03);
+         __m128d oy = _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(m10,vx), _mm_mul_pd(m11,vy)), _mm_mul_pd(m12,vz)), m13);
+         __m128d oz = _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(m20,vx), _mm_mul_pd(m21,vy)), _mm_mul_pd(m22,vz)), m23);
+         if (!affine) {
+            const __m128d d = _mm_div_pd(one, _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(m30,vx), _mm_mul_pd(m31,vy)), _mm_mul_pd(m32,vz)), m33));
+            ox = _mm_mul_pd(ox, d);
+            oy = _mm_mul_pd(oy, d);
+            oz = _mm_mul_pd(oz, d);
+         }
+         _mm_storeu_pd(rx + i, ox);
+         _mm_storeu_pd(ry + i, oy);
+         _mm_storeu_pd(rz + i, oz);
+      }
+   }
+#endif
+
+   for (; i < n; i++) {
+      const double vx = x[i];
+      const double vy = y[i];
+      const double vz = z[i];
+      double d = 1.0;
+      if (!affine) d = 1.0/(m(3,0)*vx + m(3,1)*vy + m(3,2)*vz + m(3,3));
+      rx[i] = (m(0,0)*vx + m(0,1)*vy + m(0,2)*vz + m(0,3))*d;
+      ry[i] = (m(1,0)*vx + m(1,1)*vy + m(1,2)*vz + m(1,3))*d;
+      rz[i] = (m(2,0)*vx + m(2,1)*vy + m(2,2)*vz + m(2,3))*d;
+   }
+}
+
+//------------
+// Normalizes 'n' 3D vectors, stored as separate x, y and z arrays, in place
+// and returns their lengths (same as osg::Vec3d::normalize())
+//------------
+void normalizeVec3Array(
+      double* const x,
+      double* const y,
+      double* const z,
+      double* const lengths,
+      const unsigned int n
+   )
+{
+   unsigned int i = 0;
+
+#if defined(EAAGLES_SSE2_ARRAYS)
+   {
+      const __m128d zero = _mm_setzero_pd();
+      const __m128d one = _mm_set1_pd(1.0);
+      for (; (i + 2) <= n; i += 2) {
+         const __m128d vx = _mm_loadu_pd(x + i);
+         const __m128d vy = _mm_loadu_pd(y + i);
+         const __m128d vz = _mm_loadu_pd(z + i);
+         const __m128d len = _mm_sqrt_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(vx,vx), _mm_mul_pd(vy,vy)), _mm_mul_pd(vz,vz)));
+         const __m128d nz = _mm_cmpgt_pd(len, zero);
+         const __m128d inv = _mm_div_pd(one, len);
+         _mm_storeu_pd(x + i, _mm_or_pd(_mm_and_pd(nz, _mm_mul_pd(vx,inv)), _mm_andnot_pd(nz, vx)));
+         _mm_storeu_pd(y + i, _mm_or_pd(_mm_and_pd(nz, _mm_mul_pd(vy,inv)), _mm_andnot_pd(nz, vy)));
+         _mm_storeu_pd(z + i, _mm_or_pd(_mm_and_pd(nz, _mm_mul_pd(vz,inv)), _mm_andnot_pd(nz, vz)));
+         _mm_storeu_pd(lengths + i, len);
+      }
+   }
+#endif
+
+   for (; i < n; i++) {
+      const double len = std::sqrt(x[i]*x[i] + y[i]*y[i] + z[i]*z[i]);
+      if (len > 0.0) {
+         const double inv = 1.0/len;
+         x[i] *= inv;
+         y[i] *= inv;
+         z[i] *= inv;
+      }
+      lengths[i] = len;
+   }
+}
+
 
 //------------
 // Returns the sine and cosine of an angle (radians)
@@ -401,6 +512,72 @@ void sinCosArray(const float* const src, float* const dst1, float* const dst2, c
    }
 }
 
+#if defined(EAAGLES_SSE2_ARRAYS)
+//------------
+// SSE2 arc-tangent helpers (two values at a time)
+//------------
+
+// Arc-tangent of 't', where 't' is [ 0 .. 1 ], using the Cephes library's
+// rational approximation, which is accurate to about one ULP.
+static inline __m128d atan01Sse2(const __m128d t)
+{
+   const __m128d one = _mm_set1_pd(1.0);
+
+   // Above 0.66, use atan(t) = PI/4 + atan( (t-1)/(t+1) )
+   const __m128d big = _mm_cmpgt_pd(t, _mm_set1_pd(0.66));
+   const __m128d tr = _mm_div_pd(_mm_sub_pd(t, one), _mm_add_pd(t, one));
+   const __m128d x = _mm_or_pd(_mm_and_pd(big, tr), _mm_andnot_pd(big, t));
+
+   const __m128d z = _mm_mul_pd(x, x);
+   __m128d p = _mm_set1_pd(-8.750608600031904122785E-1);
+   p = _mm_add_pd(_mm_mul_pd(p, z), _mm_set1_pd(-1.615753718733365076637E1));
+   p = _mm_add_pd(_mm_mul_pd(p, z), _mm_set1_pd(-7.500855792314704667340E1));
+   p = _mm_add_pd(_mm_mul_pd(p, z), _mm_set1_pd(-1.228866684490136173410E2));
+   p = _mm_add_pd(_mm_mul_pd(p, z), _mm_set1_pd(-6.485021904942025371773E1));
+   __m128d q = _mm_add_pd(z, _mm_set1_pd(2.485846490142306297962E1));
+   q = _mm_add_pd(_mm_mul_pd(q, z), _mm_set1_pd(1.650270098316988542046E2));
+   q = _mm_add_pd(_mm_mul_pd(q, z), _mm_set1_pd(4.328810604912902668951E2));
+   q = _mm_add_pd(_mm_mul_pd(q, z), _mm_set1_pd(4.853903996359136964868E2));
+   q = _mm_add_pd(_mm_mul_pd(q, z), _mm_set1_pd(1.945506571482613964425E2));
+
+   __m128d r = _mm_div_pd(_mm_mul_pd(z, p), q);
+   r = _mm_add_pd(_mm_mul_pd(x, r), x);
+   r = _mm_add_pd(r, _mm_and_pd(big, _mm_set1_pd(0.5 * 6.123233995736765886130E-17)));
+   return _mm_add_pd(_mm_and_pd(big, _mm_set1_pd(7.85398163397448309616E-1)), r);
+}
+
+// Arc-tangents of y/x; returns false if either lane needs the scalar
+// function (i.e., zero, infinite or NaN values)
+static inline bool atan2Sse2(const __m128d y, const __m128d x, __m128d* const result)
+{
+   const __m128d sign = _mm_set1_pd(-0.0);
+   const __m128d ax = _mm_andnot_pd(sign, x);
+   const __m128d ay = _mm_andnot_pd(sign, y);
+   const __m128d mx = _mm_max_pd(ax, ay);
+   const __m128d mn = _mm_min_pd(ax, ay);
+
+   const __m128d dmax = _mm_set1_pd(DBL_MAX);
+   const __m128d ok = _mm_and_pd(_mm_and_pd(_mm_cmple_pd(ax, dmax), _mm_cmple_pd(ay, dmax)), _mm_cmpgt_pd(mx, _mm_setzero_pd()));
+   if (_mm_movemask_pd(ok) != 3) return false;
+
+   __m128d r = atan01Sse2(_mm_div_pd(mn, mx));
+
+   // Above 45 degrees: PI/2 - r
+   const __m128d swap = _mm_cmpgt_pd(ay, ax);
+   const __m128d rs = _mm_add_pd(_mm_sub_pd(_mm_set1_pd(1.57079632679489661923), r), _mm_set1_pd(6.123233995736765886130E-17));
+   r = _mm_or_pd(_mm_and_pd(swap, rs), _mm_andnot_pd(swap, r));
+
+   // Negative x (including -0.0): PI - r
+   const __m128d xn = _mm_cmplt_pd(_mm_or_pd(_mm_and_pd(sign, x), _mm_set1_pd(1.0)), _mm_setzero_pd());
+   const __m128d rn = _mm_add_pd(_mm_sub_pd(_mm_set1_pd(3.14159265358979323846), r), _mm_set1_pd(1.2246467991473531772E-16));
+   r = _mm_or_pd(_mm_and_pd(xn, rn), _mm_andnot_pd(xn, r));
+
+   // Sign of y
+   *result = _mm_xor_pd(r, _mm_and_pd(sign, y));
+   return true;
+}
+#endif
+
 //------------
 // Computes the arc-cosines of an array of 'n' angles (radians)
 //------------
@@ -415,10 +592,27 @@ void lcAcosArray(const LCreal* const src, LCreal* const dst, const int n)
 
 void acosArray(const double* const src, double* const dst, const unsigned int n)
 {
-   double* pd = dst;
-   const double* ps = src;
-   for (unsigned int i = 0; i < n; i++) {
-      *pd++ = std::acos(*ps++);
+   unsigned int i = 0;
+
+#if defined(EAAGLES_SSE2_ARRAYS)
+   // acos(x) = atan2( sqrt((1-x)*(1+x)), x )
+   const __m128d one = _mm_set1_pd(1.0);
+   for (; (i + 2) <= n; i += 2) {
+      const __m128d x = _mm_loadu_pd(src + i);
+      const __m128d y = _mm_sqrt_pd(_mm_mul_pd(_mm_sub_pd(one, x), _mm_add_pd(one, x)));
+      __m128d r;
+      if (atan2Sse2(y, x, &r)) {
+         _mm_storeu_pd(dst + i, r);
+      }
+      else {
+         dst[i] = std::acos(src[i]);
+         dst[i+1] = std::acos(src[i+1]);
+      }
+   }
+#endif
+
+   for (; i < n; i++) {
+      dst[i] = std::acos(src[i]);
    }
 }
 
@@ -446,11 +640,23 @@ void lcAtan2Array(const LCreal* const yValues, const LCreal* const xValues, LCre
 
 void atan2Array(const double* const yValues, const double* const xValues, double* const dst, const unsigned int n)
 {
-   double* pd = dst;
-   const double* ps1 = yValues;
-   const double* ps2 = xValues;
-   for (unsigned int i = 0; i < n; i++) {
-      *pd++ = std::atan2(*ps1++,*ps2++);
+   unsigned int i = 0;
+
+#if defined(EAAGLES_SSE2_ARRAYS)
+   for (; (i + 2) <= n; i += 2) {
+      __m128d r;
+      if (atan2Sse2(_mm_loadu_pd(yValues + i), _mm_loadu_pd(xValues + i), &r)) {
+         _mm_storeu_pd(dst + i, r);
+      }
+      else {
+         dst[i] = std::atan2(yValues[i], xValues[i]);
+         dst[i+1] = std::atan2(yValues[i+1], xValues[i+1]);
+      }
+   }
+#endif
+
+   for (; i < n; i++) {
+      dst[i] = std::atan2(yValues[i], xValues[i]);
    }
 }
 
@@ -478,10 +684,16 @@ void lcSqrtArray(const LCreal* const src, LCreal* const dst, const int n)
 
 void sqrtArray(const double* const src, double* const dst, const unsigned int n)
 {
-   const double* ps = src;
-   double* pd = dst;
-   for (unsigned int i = 0; i < n; i++) {
-      *pd++ = std::sqrt(*ps++);
+   unsigned int i = 0;
+
+#if defined(EAAGLES_SSE2_ARRAYS)
+   for (; (i + 2) <= n; i += 2) {
+      _mm_storeu_pd(dst + i, _mm_sqrt_pd(_mm_loadu_pd(src + i)));
+   }
+#endif
+
+   for (; i < n; i++) {
+      dst[i] = std::sqrt(src[i]);
    }
 }
 
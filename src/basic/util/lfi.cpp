@@ -483,6 +483,148 @@ LCreal lfi_5D(
    return m * (a2 - a1) + a1;
 }
 
+//------------------------------------------------------------------------------
+// initAxis() -- Sets up the breakpoint table of an independent variable
+//------------------------------------------------------------------------------
+void initAxis(Axis* const axis, const LCreal* const data, const unsigned int n)
+{
+   axis->data = data;
+   axis->n = n;
+   axis->low = 0;
+   axis->high = (n > 0 ? n - 1 : 0);
+   axis->delta = 1;
+   axis->monotone = true;
+   axis->uniform = false;
+   axis->scale = 0;
+   if (n < 2) return;
+
+   // Check increasing vs decreasing order of the breakpoints
+   if (data[1] < data[0]) {
+      axis->low = n - 1;
+      axis->high = 0;
+      axis->delta = -1;
+   }
+
+   // Monotone?  (the binary search and the uniform index require it)
+   for (unsigned int p = 1; p < n && axis->monotone; p++) {
+      axis->monotone = (axis->delta > 0) ? (data[p] >= data[p-1]) : (data[p] <= data[p-1]);
+   }
+   if (!axis->monotone) return;
+
+   // Uniform spacing?  (only a search hint; findBracket() checks the breakpoints it finds)
+   const LCreal x0 = data[axis->low];
+   const LCreal step = (data[axis->high] - x0) / static_cast<LCreal>(n - 1);
+   if (step > 0) {
+      bool uniform = true;
+      for (unsigned int p = 1; p < n && uniform; p++) {
+         const LCreal x = data[(axis->delta > 0) ? p : (n - 1 - p)];
+         const LCreal err = x - (x0 + step * static_cast<LCreal>(p));
+         uniform = (err <= (step * 0.001f) && err >= -(step * 0.001f));
+      }
+      axis->uniform = uniform;
+      axis->scale = static_cast<LCreal>(1.0) / step;
+   }
+}
+
+//------------------------------------------------------------------------------
+// findBracket() -- Finds the breakpoints and fraction of 'x'
+//------------------------------------------------------------------------------
+void findBracket(Bracket* const b, const LCreal x, const Axis& axis, const bool eFlg)
+{
+   const LCreal* const d = axis.data;
+   const int delta = axis.delta;
+
+   // ---
+   // Only one point?
+   // ---
+   if (axis.n == 1) {
+      b->i1 = 0;
+      b->i2 = 0;
+      b->m = 0;
+      return;
+   }
+
+   // ---
+   // Find the breakpoints with endpoint checks
+   // ---
+   unsigned int x2 = 0;
+   if (x <= d[axis.low]) {
+      // At or below the 'low' end
+      x2 = axis.low + delta;
+      if (!eFlg) {
+         b->i1 = axis.low;
+         b->i2 = axis.low;
+         b->m = 0;
+         return;
+      }
+   }
+   else if (x >= d[axis.high]) {
+      // At or above the 'high' end
+      x2 = axis.high;
+      if (!eFlg) {
+         b->i1 = axis.high;
+         b->i2 = axis.high;
+         b->m = 0;
+         return;
+      }
+   }
+   else if (x < d[axis.high]) {
+      // Between the end points: x2 is the first breakpoint, from the 'low' end,
+      // with x <= d[x2] (same as lfi_1D's linear search)
+      if (!axis.monotone) {
+         // Simple linear search
+         x2 = axis.low + delta;
+         while (x > d[x2]) { x2 += delta; }
+      }
+      else if (b->i1 != b->i2 && b->i2 == b->i1 + delta && x <= d[b->i2] && x > d[b->i1]) {
+         // Same as the previous bracket
+         x2 = b->i2;
+      }
+      else if (axis.uniform) {
+         // Index the breakpoint, then step to the exact one
+         unsigned int p = static_cast<unsigned int>((x - d[axis.low]) * axis.scale) + 1;
+         if (p > axis.n - 1) p = axis.n - 1;
+         x2 = (delta > 0) ? p : (axis.n - 1 - p);
+         while (x > d[x2]) { x2 += delta; }
+         while (x <= d[x2 - delta]) { x2 -= delta; }
+      }
+      else if (delta > 0) {
+         // Binary search of breakpoints [1, n-1]
+         unsigned int lo = 1;
+         unsigned int len = axis.n - 1;
+         while (len > 1) {
+            const unsigned int half = len / 2;
+            if (x > d[lo + half - 1]) lo += half;
+            len -= half;
+         }
+         x2 = lo;
+      }
+      else {
+         // Binary search of breakpoints [n-2, 0]
+         unsigned int hi = axis.n - 2;
+         unsigned int len = axis.n - 1;
+         while (len > 1) {
+            const unsigned int half = len / 2;
+            if (x > d[hi - half + 1]) hi -= half;
+            len -= half;
+         }
+         x2 = hi;
+      }
+   }
+   else {
+      // Not a number
+      x2 = axis.low + delta;
+   }
+
+   // ---
+   // Linear interpolation fraction
+   // ---
+   const unsigned int x1 = x2 - delta;
+   b->i1 = x1;
+   b->i2 = x2;
+   b->m = (x - d[x1]) / (d[x2] - d[x1]);
+}
+
 }
 }
 }
@@ -0,0 +1,35 @@
+//------------------------------------------------------------------------------
+// Class: PhaseBarrier -- Windows version
+//
+//    Without an address based wait (i.e., a futex) we simply yield our
+//    time slice while we're waiting.
+//------------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Blocks while the value at 'addr' is still equal to 'value'
+//-----------------------------------------------------------------------------
+void PhaseBarrier::waitOnValue(std::atomic<int>* const addr, const int value)
+{
+   if (addr->load(std::memory_order_acquire) == value) {
+      SwitchToThread();
+   }
+}
+
+//-----------------------------------------------------------------------------
+// Wakes all (or one of the) threads waiting on 'addr'
+//-----------------------------------------------------------------------------
+void PhaseBarrier::wakeAll(std::atomic<int>* const)
+{
+}
+
+void PhaseBarrier::wakeOne(std::atomic<int>* const)
+{
+}
+
+//-----------------------------------------------------------------------------
+// Spin-wait hint
+//-----------------------------------------------------------------------------
+void PhaseBarrier::pause()
+{
+   YieldProcessor();
+}
@@ -9,6 +9,7 @@
 #include "openeaagles/dis/NetIO.h"
 #include "openeaagles/dis/Ntm.h"
 #include "openeaagles/dis/EmissionPduHandler.h"
+#include "openeaagles/dis/RegionOfInterest.h"
 
 #include <cstring>
 
@@ -32,6 +33,9 @@ Basic::Object* Factory::createObj(const char* name)
     else if ( std::strcmp(name, EmissionPduHandler::getFactoryName()) == 0 ) {
         obj = new EmissionPduHandler();
     }
+    else if ( std::strcmp(name, RegionOfInterest::getFactoryName()) == 0 ) {
+        obj = new RegionOfInterest();
+    }
 
     return obj;
 }
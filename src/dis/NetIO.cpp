@@ -5,8 +5,10 @@
 #include "openeaagles/dis/NetIO.h"
 #include "openeaagles/dis/Nib.h"
 #include "openeaagles/dis/Ntm.h"
+#include "openeaagles/dis/RegionOfInterest.h"
 #include "openeaagles/dis/EmissionPduHandler.h"
 #include "openeaagles/dis/pdu.h"
+#include "openeaagles/dis/views.h"
 
 #include "openeaagles/simulation/Radar.h"
 #include "openeaagles/simulation/Simulation.h"
@@ -19,6 +21,7 @@
 #include "openeaagles/basic/units/Distances.h"
 #include "openeaagles/basic/units/Times.h"
 
+#include <cstddef>
 #include <cstdlib>
 #include <cstring>
 #include <cctype>
@@ -77,6 +80,8 @@ static const LCreal HRT_BEAT_MPLIER       = 2.5;
 static const LCreal HRT_BEAT_TIMER        = 5;                                   //  seconds
 static const LCreal DRA_POS_THRST_DFLT    = 3.0;                                 //  meters
 static const LCreal DRA_ORIENT_THRST_DFLT = static_cast<LCreal>(3.0 * PI/180.0); //  radians
+static const LCreal HRT_BEAT_ROI          = 10;                                  //  seconds (outside the regions of interest)
+static const LCreal DRA_NO_THRST          = 1.0e12;                              //  No DR threshold (meters or radians)
 
 // DISv7 default heartbeats
 static const LCreal HBT_PDU_EE          = 10;                           //  seconds
@@ -113,6 +118,9 @@ BEGIN_SLOTTABLE(NetIO)
    "siteID",               // 10: Site Identification
    "applicationID",        // 11: Application Identification
    "exerciseID",           // 12: Exercise Identification
+   "maxBundleSize",        // 13: Max size of a datagram of bundled output PDUs (bytes)
+   "regionsOfInterest",    // 14: List of regions of interest for our output entities (RegionOfInterest)
+   "heartbeatTime",        // 15: Max DR time of entities outside the regions of interest (Basic::Time)
 END_SLOTTABLE(NetIO)
 
 // Map slot table to handles
@@ -141,6 +149,13 @@ BEGIN_SLOT_MAP(NetIO)
    ON_SLOT(10, setSlotSiteID,             Basic::Number)
    ON_SLOT(11, setSlotApplicationID,      Basic::Number)
    ON_SLOT(12, setSlotExerciseID,         Basic::Number)
+   ON_SLOT(13, setSlotMaxBundleSize,      Basic::Number)
+
+   ON_SLOT(14, setSlotRegionsOfInterest,  Basic::PairStream)
+   ON_SLOT(14, setSlotRegionsOfInterest,  RegionOfInterest)
+
+   ON_SLOT(15, setSlotHeartbeatTime,      Basic::Time)
+   ON_SLOT(15, setSlotHeartbeatTime,      Basic::PairStream)
 END_SLOT_MAP()
 
 //------------------------------------------------------------------------------
@@ -168,12 +183,37 @@ void NetIO::initData()
    setMaxOrientationErr(DRA_ORIENT_THRST_DFLT, 255, 255);    //  (radians)
    setMaxAge(HRT_BEAT_MPLIER*HRT_BEAT_TIMER, 255, 255);      //  (seconds)
    setMaxEntityRange(static_cast<LCreal>(0), 255, 255);      // no range filtering
+   setHeartbeatTime(HRT_BEAT_ROI, 255, 255);                 //  (seconds)
 
    // Clear emission PDU handle table
    for (unsigned int i = 0; i < MAX_EMISSION_HANDLERS; i++) {
       emissionHandlers[i] = nullptr;
    }
    nEmissionHandlers = 0;
+
+   // Clear the regions of interest
+   for (unsigned int i = 0; i < MAX_REGIONS; i++) {
+      regions[i] = nullptr;
+   }
+   nRegions = 0;
+
+   // Input and output PDU buffers
+   for (unsigned int i = 0; i < MAX_PDUs; i++) {
+      inputPdus[i] = reinterpret_cast<char*>(&inputBuffer[i][0]);
+      inputSizes[i] = 0;
+   }
+   for (unsigned int q = 0; q < 2; q++) {
+      for (unsigned int i = 0; i < MAX_OUTPUT_PDUs; i++) {
+         outputPdus[q][i] = reinterpret_cast<const char*>(&outputBuffer[q][i][0]);
+         outputSizes[q][i] = 0;
+      }
+   }
+   outputQueue = 0;
+   numOutputPdus = 0;
+   maxBundleSize = 0;
+   outputQueued = false;
+   outputLock = 0;
+   outputSendLock = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -189,6 +229,7 @@ void NetIO::copyData(const NetIO& org, const bool cc)
    siteID = org.siteID;
    appID = org.appID;
    exerciseID = org.exerciseID;
+   maxBundleSize = org.maxBundleSize;
 
    clearEmissionPduHandlers();
    for (unsigned int i = 0; i < org.nEmissionHandlers; i++) {
@@ -197,6 +238,13 @@ void NetIO::copyData(const NetIO& org, const bool cc)
       tmp->unref();
    }
 
+   clearRegionsOfInterest();
+   for (unsigned int i = 0; i < org.nRegions; i++) {
+      const RegionOfInterest* const tmp = org.regions[i]->clone();
+      addRegionOfInterest(tmp);
+      tmp->unref();
+   }
+
    for (unsigned char i = 0; i < NUM_ENTITY_KINDS; i++) {
       for (unsigned char j = 0; j < MAX_ENTITY_DOMAINS; j++) {
          maxEntityRange[i][j] = org.maxEntityRange[i][j];
@@ -205,6 +253,7 @@ void NetIO::copyData(const NetIO& org, const bool cc)
          maxPositionErr[i][j] = org.maxPositionErr[i][j];
          maxOrientationErr[i][j] = org.maxOrientationErr[i][j];
          maxAge[i][j] = org.maxAge[i][j];
+         heartbeatTime[i][j] = org.heartbeatTime[i][j];
       }
    }
 
@@ -219,6 +268,7 @@ void NetIO::copyData(const NetIO& org, const bool cc)
 void NetIO::deleteData()
 {
     clearEmissionPduHandlers();
+    clearRegionsOfInterest();
     netInput = nullptr;
     netOutput = nullptr;
 }
@@ -266,201 +316,259 @@ bool NetIO::initNetwork()
 void NetIO::netInputHander()
 {
    // Read PDUs
-   unsigned int j0 = 0;
-   while ( (j0 < MAX_PDUs) && (recvData(reinterpret_cast<char*>(&inputBuffer[j0]), MAX_PDU_SIZE) > 0) ) {
-      j0++;
-   }
+   unsigned int j0 = recvPdus();
 
    while (j0 > 0) {
 
-      // Process incoming PDUs
-      unsigned int j1 = 0;
-      while (j1 < j0) {
-         PDUHeader* header = reinterpret_cast<PDUHeader*>(&inputBuffer[j1++][0]);
-
+      // Process incoming datagrams
+      for (unsigned int j1 = 0; j1 < j0; j1++) {
          if (isInputEnabled()) {
 
-            // Notes: the header's bytes are still in network order, but since the
-            // data we're using are all type 'char' then we're saving time by not
-            // doing an initial byte swap of the header.
-
-            if (getExerciseID() == 0 || (getExerciseID() == header->exerciseIdentifier)) {
-               // When we're interested in this exercise ...
-               switch (header->PDUType) {
-
-                  case PDU_ENTITY_STATE: {
-                     //std::cout << "Entity State PDU." << std::endl;
-                     EntityStatePDU* pPdu = reinterpret_cast<EntityStatePDU*>(header);
-                     if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->entityID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->entityID.simulationID.applicationIdentification) {
-                           processEntityStatePDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_FIRE: {
-                     FirePDU* pPdu = reinterpret_cast<FirePDU*>(header);
-                     if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->firingEntityID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->firingEntityID.simulationID.applicationIdentification) {
-                           processFirePDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_DETONATION: {
-                     DetonationPDU* pPdu = reinterpret_cast<DetonationPDU*>(header);
-                     if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->firingEntityID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->firingEntityID.simulationID.applicationIdentification) {
-                           processDetonationPDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_SIGNAL: {
-                     SignalPDU* pPdu = reinterpret_cast<SignalPDU*>(header);
-                     if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->radioRefID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->radioRefID.simulationID.applicationIdentification) {
-                           processSignalPDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_TRANSMITTER: {
-                     TransmitterPDU* pPdu = reinterpret_cast<TransmitterPDU*>(header);
-                     if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->radioRefID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->radioRefID.simulationID.applicationIdentification) {
-                           processTransmitterPDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_ELECTROMAGNETIC_EMISSION: {
-                     ElectromagneticEmissionPDU* pPdu = reinterpret_cast<ElectromagneticEmissionPDU*>(header);
-                     if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->emittingEntityID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->emittingEntityID.simulationID.applicationIdentification) {
-                           processElectromagneticEmissionPDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_DATA_QUERY: {
-                     DataQueryPDU* pPdu = reinterpret_cast<DataQueryPDU*>(header);
-                     if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->originatingID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->originatingID.simulationID.applicationIdentification) {
-                           processDataQueryPDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_DATA: {
-                     DataPDU* pPdu = reinterpret_cast<DataPDU*>(header);
-                     if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->originatingID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->originatingID.simulationID.applicationIdentification) {
-                           processDataPDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_COMMENT: {
-                     CommentPDU* pPdu = reinterpret_cast<CommentPDU*>(header);
-                     if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->originatingID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->originatingID.simulationID.applicationIdentification) {
-                           processCommentPDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_START_RESUME: {
-                     StartPDU* pPdu = reinterpret_cast<StartPDU*>(header);
-                     if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->originatingID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->originatingID.simulationID.applicationIdentification) {
-                           processStartPDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_STOP_FREEZE: {
-                     StopPDU* pPdu = reinterpret_cast<StopPDU*>(header);
-                     if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->originatingID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->originatingID.simulationID.applicationIdentification) {
-                           processStopPDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_ACKNOWLEDGE: {
-                     AcknowledgePDU* pPdu = reinterpret_cast<AcknowledgePDU*>(header);
-                     if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->originatingID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->originatingID.simulationID.applicationIdentification) {
-                           processAcknowledgePDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_ACTION_REQUEST: {
-                     ActionRequestPDU* pPdu = reinterpret_cast<ActionRequestPDU*>(header);
-                     if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->originatingID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->originatingID.simulationID.applicationIdentification) {
-                           processActionRequestPDU(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_ACTION_REQUEST_R: {
-                     ActionRequestPDU_R* pPdu = reinterpret_cast<ActionRequestPDU_R*>(header);
-                     if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->originatingID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->originatingID.simulationID.applicationIdentification) {
-                           processActionRequestPDU_R(pPdu);
-                     }
-                  }
-                  break;
-
-                  case PDU_ACTION_RESPONSE_R: {
-                     ActionResponsePDU_R* pPdu = reinterpret_cast<ActionResponsePDU_R*>(header);
-                     if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
-                     if (getSiteID() != pPdu->originatingID.simulationID.siteIdentification ||
-                        getApplicationID() != pPdu->originatingID.simulationID.applicationIdentification) {
-                           processActionResponsePDU_R(pPdu);
-                     }
-                  }
-                  break;
-
-                  default: {
-                     // Note: users will need to do their own byte swapping and checks
-                     processUserPDU(header);
-                  }
-                  break;
+            // Split the datagram into its PDUs (see note #8); each PDU's
+            // length is from its header, which is still in network order.
+            unsigned char* const datagram = reinterpret_cast<unsigned char*>(inputPdus[j1]);
+            const unsigned int size = inputSizes[j1];
+            unsigned int offset = 0;
+            while (offset < size) {
+               const unsigned int remaining = size - offset;
+
+               // The first PDU defaults to the whole datagram, but any
+               // following bytes must be a complete PDU (else it's padding)
+               unsigned int length = 0;
+               if (remaining >= sizeof(PDUHeader)) {
+                  const unsigned char* const p = datagram + offset + offsetof(PDUHeader, length);
+                  const unsigned int len = (static_cast<unsigned int>(p[0]) << 8) | p[1];
+                  if (len >= sizeof(PDUHeader) && len <= remaining) length = len;
+               }
+               if (length == 0) {
+                  if (offset > 0) break;
+                  length = remaining;
+               }
 
-               } // PDU switch
+               // Bundled PDUs may not be aligned
+               processPdu(datagram + offset, length, ((offset % 8) == 0));
+               offset += length;
+            }
 
-            } // if correct exercise
          }  // Inputs enabled
-
-      }  // processing PDUs
+      }  // processing datagrams
 
       // Read more PDUs
-      j0 = 0;
-      while ( (j0 < MAX_PDUs) && (recvData(reinterpret_cast<char*>(&inputBuffer[j0]), MAX_PDU_SIZE) > 0) ) {
-         j0++;
-      }
+      j0 = recvPdus();
    }
 
 }
 
+//------------------------------------------------------------------------------
+// processPdu() -- processes one received PDU
+//------------------------------------------------------------------------------
+void NetIO::processPdu(unsigned char* const pdu, const unsigned int length, const bool aligned)
+{
+   // Notes: the PDU's bytes are still in network order.  The exercise and the
+   // originating entity's site and app IDs are read from them using a view
+   // (see note #9), so the PDUs that we discard are never copied or swapped.
+
+   const PduView view(pdu, length);
+   if (!view.isValid()) return;
+
+   if (getExerciseID() == 0 || (getExerciseID() == view.getExerciseID())) {
+      // When we're interested in this exercise ...
+      switch (view.getPDUType()) {
+
+         case PDU_ENTITY_STATE: {
+            //std::cout << "Entity State PDU." << std::endl;
+            if (filterEntityStatePDU(EntityStatePduView(pdu, length))) {
+               EntityStatePDU* pPdu = reinterpret_cast<EntityStatePDU*>(alignPdu(pdu, length, aligned));
+               if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+               processEntityStatePDU(pPdu);
+            }
+         }
+         break;
+
+         case PDU_FIRE: {
+            if (!isLocalPdu(view, offsetof(FirePDU, firingEntityID))) {
+               FirePDU* pPdu = reinterpret_cast<FirePDU*>(alignPdu(pdu, length, aligned));
+               if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+               processFirePDU(pPdu);
+            }
+         }
+         break;
+
+         case PDU_DETONATION: {
+            if (!isLocalPdu(view, offsetof(DetonationPDU, firingEntityID))) {
+               DetonationPDU* pPdu = reinterpret_cast<DetonationPDU*>(alignPdu(pdu, length, aligned));
+               if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+               processDetonationPDU(pPdu);
+            }
+         }
+         break;
+
+         case PDU_SIGNAL: {
+            if (!isLocalPdu(view, offsetof(SignalPDU, radioRefID))) {
+               SignalPDU* pPdu = reinterpret_cast<SignalPDU*>(alignPdu(pdu, length, aligned));
+               if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+               processSignalPDU(pPdu);
+            }
+         }
+         break;
+
+         case PDU_TRANSMITTER: {
+            if (!isLocalPdu(view, offsetof(TransmitterPDU, radioRefID))) {
+               TransmitterPDU* pPdu = reinterpret_cast<TransmitterPDU*>(alignPdu(pdu, length, aligned));
+               if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+               processTransmitterPDU(pPdu);
+            }
+         }
+         break;
+
+         case PDU_ELECTROMAGNETIC_EMISSION: {
+            if (filterElectromagneticEmissionPDU(EmissionPduView(pdu, length))) {
+               ElectromagneticEmissionPDU* pPdu = reinterpret_cast<ElectromagneticEmissionPDU*>(alignPdu(pdu, length, aligned));
+               if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+               processElectromagneticEmissionPDU(pPdu);
+            }
+         }
+         break;
+
+         case PDU_DATA_QUERY: {
+            if (!isLocalPdu(view, offsetof(DataQueryPDU, originatingID))) {
+               DataQueryPDU* pPdu = reinterpret_cast<DataQueryPDU*>(alignPdu(pdu, length, aligned));
+               if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+               processDataQueryPDU(pPdu);
+            }
+         }
+         break;
+
+         case PDU_DATA: {
+            if (!isLocalPdu(view, offsetof(DataPDU, originatingID))) {
+               DataPDU* pPdu = reinterpret_cast<DataPDU*>(alignPdu(pdu, length, aligned));
+               if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+               processDataPDU(pPdu);
+            }
+         }
+         break;
+
+         case PDU_COMMENT: {
+            if (!isLocalPdu(view, offsetof(CommentPDU, originatingID))) {
+               CommentPDU* pPdu = reinterpret_cast<CommentPDU*>(alignPdu(pdu, length, aligned));
+               if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+               processCommentPDU(pPdu);
+            }
+         }
+         break;
+
+         case PDU_START_RESUME: {
+            if (!isLocalPdu(view, offsetof(StartPDU, originatingID))) {
+               StartPDU* pPdu = reinterpret_cast<StartPDU*>(alignPdu(pdu, length, aligned));
+               if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+               processStartPDU(pPdu);
+            }
+         }
+         break;
+
+         case PDU_STOP_FREEZE: {
+            if (!isLocalPdu(view, offsetof(StopPDU, originatingID))) {
+               StopPDU* pPdu = reinterpret_cast<StopPDU*>(alignPdu(pdu, length, aligned));
+               if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+               processStopPDU(pPdu);
+            }
+         }
+         break;
+
+         case PDU_ACKNOWLEDGE: {
+            if (!isLocalPdu(view, offsetof(AcknowledgePDU, originatingID))) {
+               AcknowledgePDU* pPdu = reinterpret_cast<AcknowledgePDU*>(alignPdu(pdu, length, aligned));
+               if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+               processAcknowledgePDU(pPdu);
+            }
+         }
+         break;
+
+         case PDU_ACTION_REQUEST: {
+            if (!isLocalPdu(view, offsetof(ActionRequestPDU, originatingID))) {
+               ActionRequestPDU* pPdu = reinterpret_cast<ActionRequestPDU*>(alignPdu(pdu, length, aligned));
+               if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+               processActionRequestPDU(pPdu);
+            }
+         }
+         break;
+
+         case PDU_ACTION_REQUEST_R: {
+            if (!isLocalPdu(view, offsetof(ActionRequestPDU_R, originatingID))) {
+               ActionRequestPDU_R* pPdu = reinterpret_cast<ActionRequestPDU_R*>(alignPdu(pdu, length, aligned));
+               if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+               processActionRequestPDU_R(pPdu);
+            }
+         }
+         break;
+
+         case PDU_ACTION_RESPONSE_R: {
+            if (!isLocalPdu(view, offsetof(ActionResponsePDU_R, originatingID))) {
+               ActionResponsePDU_R* pPdu = reinterpret_cast<ActionResponsePDU_R*>(alignPdu(pdu, length, aligned));
+               if (Basic::NetHandler::isNotNetworkByteOrder()) pPdu->swapBytes();
+               processActionResponsePDU_R(pPdu);
+            }
+         }
+         break;
+
+         default: {
+            // Note: users will need to do their own byte swapping and checks
+            processUserPDU(reinterpret_cast<PDUHeader*>(alignPdu(pdu, length, aligned)));
+         }
+         break;
+
+      } // PDU switch
+
+   } // if correct exercise
+}
+
+//------------------------------------------------------------------------------
+// alignPdu() -- returns the PDU, or an aligned copy of it
+//------------------------------------------------------------------------------
+unsigned char* NetIO::alignPdu(unsigned char* const pdu, const unsigned int length, const bool aligned)
+{
+   if (aligned) return pdu;
+   std::memcpy(alignedPdu, pdu, length);
+   return reinterpret_cast<unsigned char*>(alignedPdu);
+}
+
+//------------------------------------------------------------------------------
+// isLocalPdu() -- true if the PDU's entity ID, which is at 'idOffset', has
+// our site and application IDs (the PDU's bytes are still in network order)
+//------------------------------------------------------------------------------
+bool NetIO::isLocalPdu(const PduView& view, const unsigned int idOffset) const
+{
+   return (view.getSiteID(idOffset) == getSiteID() && view.getApplicationID(idOffset) == getApplicationID());
+}
+
+//------------------------------------------------------------------------------
+// filterEntityStatePDU() -- returns true if the Entity State PDU should be
+// byte swapped and passed to processEntityStatePDU().  We reject PDUs that
+// are incomplete, that have our site and application IDs, or that are from
+// players on our output list.
+//------------------------------------------------------------------------------
+bool NetIO::filterEntityStatePDU(const EntityStatePduView& view)
+{
+   if (!view.isValid()) return false;
+   if (view.getSiteID() == getSiteID() && view.getApplicationID() == getApplicationID()) return false;
+   return (findDisNib(view.getPlayerID(), view.getSiteID(), view.getApplicationID(), OUTPUT_NIB) == nullptr);
+}
+
+//------------------------------------------------------------------------------
+// filterElectromagneticEmissionPDU() -- returns true if the Electromagnetic
+// Emission PDU should be byte swapped and passed to processElectromagneticEmissionPDU().
+// We reject PDUs that are incomplete, that have our site and application IDs,
+// or that have no systems, and all PDUs when we have no emission handlers or
+// when we don't have a NIB for the emitting player.
+//------------------------------------------------------------------------------
+bool NetIO::filterElectromagneticEmissionPDU(const EmissionPduView& view)
+{
+   if (view.getNumberOfSystems() == 0 || nEmissionHandlers == 0) return false;
+   if (view.getSiteID() == getSiteID() && view.getApplicationID() == getApplicationID()) return false;
+   if (!view.isValid()) return false;
+   return (findDisNib(view.getPlayerID(), view.getSiteID(), view.getApplicationID(), INPUT_NIB) != nullptr);
+}
+
 //------------------------------------------------------------------------------
 // processInputList() -- Update players/systems from the Input-list
 //------------------------------------------------------------------------------
@@ -637,15 +745,43 @@ Simulation::Nib* NetIO::createNewOutputNib(Simulation::Player* const player)
 Nib* NetIO::findDisNib(const unsigned short playerID, const unsigned short site, const unsigned short app, const IoType ioType)
 {
    Nib* nib = nullptr;
-   char cbuff[32];
-   bool ok = makeFederateName(cbuff, 32, site, app);
-   if (ok) {
-      Basic::String fname(cbuff);
-      nib = dynamic_cast<Nib*>( findNib(playerID, &fname, ioType) );
+   // (site and app IDs of zero don't have federate names, so they can't have NIBs)
+   if (site > 0 && app > 0) {
+      nib = dynamic_cast<Nib*>( findNibByKey(makeNibKey(playerID, site, app), ioType) );
    }
    return nib;
 }
 
+//------------------------------------------------------------------------------
+// makeNibKey() -- packed NIB key: player ID, site ID and app ID
+//------------------------------------------------------------------------------
+unsigned long long NetIO::makeNibKey(const unsigned short playerID, const unsigned short site, const unsigned short app)
+{
+   return ( (static_cast<unsigned long long>(playerID) << 32) |
+            (static_cast<unsigned long long>(site) << 16) |
+            static_cast<unsigned long long>(app) );
+}
+
+//------------------------------------------------------------------------------
+// getNibKey() -- NIB hash index key: federate names that we'd make from site
+// and app IDs have the exact key, makeNibKey(), and all others (e.g., relayed
+// players) have the default key, flagged by the top bit.
+//------------------------------------------------------------------------------
+unsigned long long NetIO::getNibKey(const unsigned short playerID, const Basic::String* const federateName) const
+{
+   if (federateName != nullptr) {
+      unsigned short site = 0;
+      unsigned short app = 0;
+      if (parseFederateName(&site, &app, *federateName)) {
+         char cbuff[32];
+         if (makeFederateName(cbuff, 32, site, app) && *federateName == cbuff) {
+            return makeNibKey(playerID, site, app);
+         }
+      }
+   }
+   return ( BaseClass::getNibKey(playerID, federateName) | (1ULL << 63) );
+}
+
 
 //------------------------------------------------------------------------------
 // processElectromagneticEmissionPDU() callback --
@@ -689,17 +825,106 @@ int NetIO::recvData(char* const packet, const int maxSize)
 }
 
 //------------------------------------------------------------------------------
-// sendData() -- send data packet
+// recvPdus() -- reads a batch of (up to MAX_PDUs) PDUs into the input buffer;
+//               returns the number of PDUs read
+//------------------------------------------------------------------------------
+unsigned int NetIO::recvPdus()
+{
+   unsigned int n = 0;
+   if (netInput != nullptr) {
+      n = netInput->recvPackets(inputPdus, inputSizes, MAX_PDU_SIZE, MAX_PDUs);
+   }
+   return n;
+}
+
+//------------------------------------------------------------------------------
+// sendData() -- send data packet; during the output frame, the packet is
+//               queued and sent with the next batch
 //------------------------------------------------------------------------------
 bool NetIO::sendData(const char* const packet, const int size)
 {
    bool result = 0;
    if (netOutput != nullptr) {
-      result = netOutput->sendData( packet, size );
+      bool queued = false;
+      if (size > 0 && size <= MAX_PDU_SIZE) {
+         lcLock(outputLock);
+         while (outputQueued && !queued) {
+            const unsigned int q = outputQueue;
+            int* const sizes = outputSizes[q];
+            const unsigned int last = numOutputPdus - 1;
+            if ( numOutputPdus > 0 && (sizes[last] + size) <= static_cast<int>(maxBundleSize) ) {
+               // Bundle it with the last datagram (see note #8)
+               char* const p = reinterpret_cast<char*>(&outputBuffer[q][last][0]);
+               std::memcpy(p + sizes[last], packet, size);
+               sizes[last] += size;
+               queued = true;
+            }
+            else if (numOutputPdus < MAX_OUTPUT_PDUs) {
+               std::memcpy(&outputBuffer[q][numOutputPdus][0], packet, size);
+               sizes[numOutputPdus++] = size;
+               queued = true;
+            }
+            else {
+               // The queue is full; send it without holding the lock, and try again
+               lcUnlock(outputLock);
+               flushOutput();
+               lcLock(outputLock);
+            }
+         }
+         lcUnlock(outputLock);
+      }
+
+      if (queued) result = true;
+      else result = netOutput->sendData( packet, size );
    }
    return result;
 }
 
+//------------------------------------------------------------------------------
+// flushOutput() -- sends the queued output PDUs; the queues are swapped under
+//                  the output lock, and the full queue is sent after it's
+//                  unlocked.  Only one thread sends at a time, so the queue
+//                  that's swapped in is never one that's still being sent.
+//------------------------------------------------------------------------------
+bool NetIO::flushOutput()
+{
+   bool ok = true;
+   lcLock(outputSendLock);
+
+   lcLock(outputLock);
+   const unsigned int q = outputQueue;
+   const unsigned int n = numOutputPdus;
+   outputQueue = 1 - q;
+   numOutputPdus = 0;
+   lcUnlock(outputLock);
+
+   if (n > 0 && netOutput != nullptr) {
+      ok = (netOutput->sendPackets(outputPdus[q], outputSizes[q], n) == n);
+   }
+
+   lcUnlock(outputSendLock);
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// outputFrame() -- queue the PDUs that are sent during the output frame,
+//                  and send them in batches
+//------------------------------------------------------------------------------
+void NetIO::outputFrame(const LCreal dt)
+{
+   lcLock(outputLock);
+   outputQueued = true;
+   lcUnlock(outputLock);
+
+   BaseClass::outputFrame(dt);
+
+   lcLock(outputLock);
+   outputQueued = false;
+   lcUnlock(outputLock);
+
+   flushOutput();
+}
+
 //------------------------------------------------------------------------------
 // makeTimeStamp() -- makes a DIS time stamp
 //------------------------------------------------------------------------------
@@ -977,7 +1202,10 @@ LCreal NetIO::getMaxTimeDR(const Simulation::Nib* const nib) const
       if (disNib != nullptr) {
          const unsigned char k = disNib->getEntityKind();
          const unsigned char d = disNib->getEntityDomain();
-         value = (k < NUM_ENTITY_KINDS && d < MAX_ENTITY_DOMAINS) ? maxTimeDR[k][d] : 0;
+         if (k < NUM_ENTITY_KINDS && d < MAX_ENTITY_DOMAINS) {
+            // Outside the regions of interest (see note #10)
+            value = disNib->isOutsideRegionsOfInterest() ? heartbeatTime[k][d] : maxTimeDR[k][d];
+         }
       }
       else {
          value = BaseClass::getMaxTimeDR(nib);
@@ -994,7 +1222,10 @@ LCreal NetIO::getMaxPositionErr(const Simulation::Nib* const nib) const
       if (disNib != nullptr) {
          const unsigned char k = disNib->getEntityKind();
          const unsigned char d = disNib->getEntityDomain();
-         value = (k < NUM_ENTITY_KINDS && d < MAX_ENTITY_DOMAINS) ? maxPositionErr[k][d] : 0;
+         if (k < NUM_ENTITY_KINDS && d < MAX_ENTITY_DOMAINS) {
+            // Outside the regions of interest (see note #10)
+            value = disNib->isOutsideRegionsOfInterest() ? DRA_NO_THRST : maxPositionErr[k][d];
+         }
       }
       else {
          value = BaseClass::getMaxPositionErr(nib);
@@ -1011,7 +1242,10 @@ LCreal NetIO::getMaxOrientationErr(const Simulation::Nib* const nib) const
       if (disNib != nullptr) {
          const unsigned char k = disNib->getEntityKind();
          const unsigned char d = disNib->getEntityDomain();
-         value = (k < NUM_ENTITY_KINDS && d < MAX_ENTITY_DOMAINS) ? maxOrientationErr[k][d] : 0;
+         if (k < NUM_ENTITY_KINDS && d < MAX_ENTITY_DOMAINS) {
+            // Outside the regions of interest (see note #10)
+            value = disNib->isOutsideRegionsOfInterest() ? DRA_NO_THRST : maxOrientationErr[k][d];
+         }
       }
       else {
          value = BaseClass::getMaxOrientationErr(nib);
@@ -1037,6 +1271,35 @@ LCreal NetIO::getMaxAge(const Simulation::Nib* const nib) const
    return value;
 }
 
+LCreal NetIO::getHeartbeatTime(const Simulation::Nib* const nib) const
+{
+   LCreal value = 0;
+   if (nib != nullptr) {
+      const Nib* disNib = dynamic_cast<const Nib*>(nib);
+      if (disNib != nullptr) {
+         const unsigned char k = disNib->getEntityKind();
+         const unsigned char d = disNib->getEntityDomain();
+         value = (k < NUM_ENTITY_KINDS && d < MAX_ENTITY_DOMAINS) ? heartbeatTime[k][d] : 0;
+      }
+   }
+   return value;
+}
+
+// True if the player is inside one of our regions of interest, or if we have none
+bool NetIO::isInRegionsOfInterest(const Simulation::Player* const p) const
+{
+   if (nRegions == 0) return true;
+   if (p == nullptr) return false;
+
+   const double lat = p->getLatitude();
+   const double lon = p->getLongitude();
+   const double alt = p->getAltitude();
+   for (unsigned int i = 0; i < nRegions; i++) {
+      if (regions[i]->isInside(lat, lon, alt)) return true;
+   }
+   return false;
+}
+
 //------------------------------------------------------------------------------
 // Data set routines
 //------------------------------------------------------------------------------
@@ -1099,6 +1362,14 @@ bool NetIO::setExerciseID(const unsigned char v)
     return true;
 }
 
+// Sets the max size of a datagram of bundled PDUs (bytes), or zero to not bundle
+bool NetIO::setMaxBundleSize(const unsigned int v)
+{
+    bool ok = (v == 0 || (v >= sizeof(PDUHeader) && v <= MAX_PDU_SIZE));
+    if (ok) maxBundleSize = v;
+    return ok;
+}
+
 // setMaxEntityRange() -- Sets max entity range (meters)
 bool NetIO::setMaxEntityRange(const LCreal v, const unsigned char kind, const unsigned char domain)
 {
@@ -1250,6 +1521,36 @@ bool NetIO::setMaxAge(const LCreal v, const unsigned char kind, const unsigned c
    return true;
 }
 
+// Sets the heartbeat time (seconds); the max DR time outside the regions of interest
+bool NetIO::setHeartbeatTime(const LCreal v, const unsigned char kind, const unsigned char domain)
+{
+   // default loop limits (just in case we're doing all)
+   unsigned char imin = 0;
+   unsigned char imax = NUM_ENTITY_KINDS;
+   unsigned char jmin = 0;
+   unsigned char jmax = MAX_ENTITY_DOMAINS;
+
+   // Clamp i to kind (if valid)
+   if (kind < NUM_ENTITY_KINDS) {
+      imin = kind;
+      imax = kind+1;
+   }
+
+   // Clamp j to domain (if valid)
+   if (domain < MAX_ENTITY_DOMAINS) {
+      jmin = domain;
+      jmax = domain+1;
+   }
+
+   // Fill as needed
+   for (unsigned char i = imin; i < imax; i++) {
+      for (unsigned char j = jmin; j < jmax; j++) {
+         heartbeatTime[i][j] = v;
+      }
+   }
+   return true;
+}
+
 //------------------------------------------------------------------------------
 // Set DR parameters
 //------------------------------------------------------------------------------
@@ -1302,6 +1603,18 @@ bool NetIO::setMaxOrientationErr(const Basic::Angle* const p, const unsigned cha
     return ok;
 }
 
+// Sets the heartbeat time of an output entity of this kind/domain
+bool NetIO::setHeartbeatTime(const Basic::Time* const p, const unsigned char kind, const unsigned char domain)
+{
+    bool ok = false;
+    if (p != nullptr) {
+        Basic::Seconds ref;
+        LCreal sec = ref.convert(*p);
+        ok = setHeartbeatTime(sec, kind, domain);
+    }
+    return ok;
+}
+
 // Sets max age (without update) of a networked player of this entity kind/domain
 bool NetIO::setMaxAge(const Basic::Time* const p, const unsigned char kind, const unsigned char domain)
 {
@@ -1339,6 +1652,26 @@ void NetIO::addEmissionPduHandler(const EmissionPduHandler* const item)
    }
 }
 
+// Adds a region of interest
+void NetIO::addRegionOfInterest(const RegionOfInterest* const item)
+{
+   if (nRegions < MAX_REGIONS) {
+      item->ref();
+      regions[nRegions] = item;
+      nRegions++;
+   }
+}
+
+// Clears the regions of interest
+void NetIO::clearRegionsOfInterest()
+{
+   while (nRegions > 0) {
+      nRegions--;
+      regions[nRegions]->unref();
+      regions[nRegions] = nullptr;
+   }
+}
+
 // Clears the emission PDU handler table
 void NetIO::clearEmissionPduHandlers()
 {
@@ -1666,6 +1999,49 @@ bool NetIO::setSlotMaxAge(const Basic::Time* const msg)
    return setMaxAge(msg, 255, 255);
 }
 
+// Sets heartbeat times for pairs of entities by kind/domain
+bool NetIO::setSlotHeartbeatTime(const Basic::PairStream* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const Basic::List::Item* item = msg->getFirstItem();
+      while (item != nullptr) {
+
+            // get the slot and object from the pair
+            const Basic::Pair* p = static_cast<const Basic::Pair*>(item->getValue());
+            const char* const slotname = *p->slot();
+            const Basic::Time* pp = dynamic_cast<const Basic::Time*>( p->object() );
+
+            if (pp != nullptr) {
+               // Ok, we have a valid object,
+               //  now can we get valid 'kind' and 'domain' numbers from the slot name?
+               unsigned char kind = 255;
+               unsigned char domain = 255;
+               bool isNum = slot2KD(slotname, &kind, &domain);
+               if (isNum) {
+                  // Everything is valid, so let setHeartbeatTime() handle it
+                  ok = setHeartbeatTime(pp, kind, domain);
+               }
+               else {
+                  std::cerr << "NetIO::setSlotHeartbeatTime(): slot: " << slotname << " is not a valid." << std::endl;
+               }
+            }
+            else {
+               std::cerr << "NetIO::setSlotHeartbeatTime(): slot: " << slotname << " is not a valid Basic::Time!" << std::endl;
+            }
+
+            item = item->getNext();
+      }
+   }
+   return ok;
+}
+
+// Sets heartbeat times for all entity types
+bool NetIO::setSlotHeartbeatTime(const Basic::Time* const msg)
+{
+   return setHeartbeatTime(msg, 255, 255);
+}
+
 // Sets the list of Electromagnetic Emission PDU handlers
 bool NetIO::setSlotEmissionPduHandlers(Basic::PairStream* const msg)
 {
@@ -1785,6 +2161,59 @@ bool NetIO::setSlotExerciseID(const Basic::Number* const num)
     }
     return ok;
 }
+
+// Set the max size of a datagram of bundled PDUs
+bool NetIO::setSlotMaxBundleSize(const Basic::Number* const num)
+{
+    bool ok = false;
+    if (num != nullptr) {
+        int v = num->getInt();
+        if (v >= 0) ok = setMaxBundleSize(static_cast<unsigned int>(v));
+        if (!ok) {
+            std::cerr << "NetIO::setSlotMaxBundleSize(): invalid size(" << v << "); valid: 0 or [" << sizeof(PDUHeader) << " ... " << MAX_PDU_SIZE << "]" << std::endl;
+        }
+    }
+    return ok;
+}
+
+// Sets the list of regions of interest
+bool NetIO::setSlotRegionsOfInterest(const Basic::PairStream* const msg)
+{
+    bool ok = false;
+    if (msg != nullptr) {
+       // First clear the old list
+       clearRegionsOfInterest();
+
+       // Now scan the pair stream and put all RegionOfInterest objects into the table.
+       const Basic::List::Item* item = msg->getFirstItem();
+       while (item != nullptr && nRegions < MAX_REGIONS) {
+          const Basic::Pair* pair = static_cast<const Basic::Pair*>(item->getValue());
+          const RegionOfInterest* region = dynamic_cast<const RegionOfInterest*>( pair->object() );
+          if (region != nullptr) {
+             addRegionOfInterest(region);
+          }
+          else {
+             std::cerr << "NetIO::setSlotRegionsOfInterest(): " << *pair->slot() << " is not a RegionOfInterest!" << std::endl;
+          }
+          item = item->getNext();
+       }
+       ok = true;
+    }
+    return ok;
+}
+
+// Sets a single region of interest
+bool NetIO::setSlotRegionsOfInterest(const RegionOfInterest* const msg)
+{
+    bool ok = false;
+    if (msg != nullptr) {
+       clearRegionsOfInterest();
+       addRegionOfInterest(msg);
+       ok = true;
+    }
+    return ok;
+}
+
 //------------------------------------------------------------------------------
 // getSlotByIndex()
 //------------------------------------------------------------------------------
@@ -394,6 +394,10 @@ bool Nib::entityStateManager(const LCreal curExecTime)
       if (ww->isDummy()) return ok;
    }
 
+   // Are we outside of the network's regions of interest?  (see Dis::NetIO note #10)
+   const NetIO* const netIO = static_cast<const NetIO*>(getNetIO());
+   setOutsideRegionsOfInterest( !netIO->isInRegionsOfInterest(player) );
+
    if (isPlayerStateUpdateRequired(curExecTime)) {
 
       //
@@ -39,6 +39,7 @@ Nib::Nib(const Simulation::NetIO::IoType ioType) : Simulation::Nib(ioType)
 
    siteID = 0;
    appID = 0;
+   outsideROI = false;
 
    for (unsigned int i = 0; i < MAX_AMSL; i++) {
       apartMslTypes[i] = nullptr;
@@ -118,6 +119,7 @@ void Nib::copyData(const Nib& org, const bool cc)
 
    siteID = org.siteID;
    appID = org.appID;
+   outsideROI = org.outsideROI;
 
    if (iffFunOpData != nullptr) {
       delete iffFunOpData;
@@ -191,6 +193,16 @@ void Nib::setApplicationID(const unsigned short v)
     appID = v;
 }
 
+// The DR thresholds change with the regions of interest, so the check time
+// that was predicted using the old thresholds is no longer valid
+void Nib::setOutsideRegionsOfInterest(const bool flg)
+{
+    if (flg != outsideROI) {
+       outsideROI = flg;
+       resetDrCheckTime();
+    }
+}
+
 //------------------------------------------------------------------------------
 // networkOutputManagers() --  derived networkOutputManagers()
 //------------------------------------------------------------------------------
@@ -0,0 +1,289 @@
+//------------------------------------------------------------------------------
+// Class: Dis::RegionOfInterest
+//------------------------------------------------------------------------------
+
+#include "openeaagles/dis/RegionOfInterest.h"
+
+#include "openeaagles/basic/LatLon.h"
+#include "openeaagles/basic/List.h"
+#include "openeaagles/basic/Nav.h"
+#include "openeaagles/basic/Number.h"
+#include "openeaagles/basic/Pair.h"
+#include "openeaagles/basic/PairStream.h"
+#include "openeaagles/basic/units/Distances.h"
+
+#include <cfloat>
+
+namespace Eaagles {
+namespace Network {
+namespace Dis {
+
+IMPLEMENT_SUBCLASS(RegionOfInterest,"RegionOfInterest")
+EMPTY_SERIALIZER(RegionOfInterest)
+
+//------------------------------------------------------------------------------
+// slot table for this class type
+//------------------------------------------------------------------------------
+BEGIN_SLOTTABLE(RegionOfInterest)
+   "latitude",          // 1) Circle's center latitude
+   "longitude",         // 2) Circle's center longitude
+   "radius",            // 3) Circle's radius
+   "vertices",          // 4) Polygon's vertices
+   "minAltitude",       // 5) Min altitude
+   "maxAltitude",       // 6) Max altitude
+END_SLOTTABLE(RegionOfInterest)
+
+// Map slot table to handles
+BEGIN_SLOT_MAP(RegionOfInterest)
+   ON_SLOT(1, setSlotLatitude,      Basic::LatLon)
+   ON_SLOT(1, setSlotLatitude,      Basic::Number)
+   ON_SLOT(2, setSlotLongitude,     Basic::LatLon)
+   ON_SLOT(2, setSlotLongitude,     Basic::Number)
+   ON_SLOT(3, setSlotRadius,        Basic::Distance)
+   ON_SLOT(4, setSlotVertices,      Basic::PairStream)
+   ON_SLOT(5, setSlotMinAltitude,   Basic::Distance)
+   ON_SLOT(6, setSlotMaxAltitude,   Basic::Distance)
+END_SLOT_MAP()
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+RegionOfInterest::RegionOfInterest()
+{
+   STANDARD_CONSTRUCTOR()
+
+   initData();
+}
+
+void RegionOfInterest::initData()
+{
+   latitude = 0;
+   longitude = 0;
+   radius = 0;
+   radiusNM = 0;
+
+   vLats = nullptr;
+   vLons = nullptr;
+   numVertices = 0;
+
+   minLat = 0;
+   maxLat = 0;
+   minLon = 0;
+   maxLon = 0;
+
+   minAlt = -DBL_MAX;
+   maxAlt = DBL_MAX;
+}
+
+//------------------------------------------------------------------------------
+// copyData() -- copy member data
+//------------------------------------------------------------------------------
+void RegionOfInterest::copyData(const RegionOfInterest& org, const bool cc)
+{
+   BaseClass::copyData(org);
+   if (cc) initData();
+
+   setCircle(org.latitude, org.longitude, org.radius);
+   setVertices(org.vLats, org.vLons, org.numVertices);
+   setAltitudes(org.minAlt, org.maxAlt);
+}
+
+//------------------------------------------------------------------------------
+// deleteData() -- delete member data
+//------------------------------------------------------------------------------
+void RegionOfInterest::deleteData()
+{
+   setVertices(nullptr, nullptr, 0);
+}
+
+//------------------------------------------------------------------------------
+// isInside() -- True if the point is inside the region
+//------------------------------------------------------------------------------
+bool RegionOfInterest::isInside(const double lat, const double lon, const double alt) const
+{
+   // Altitude band
+   if (alt < minAlt || alt > maxAlt) return false;
+
+   bool inside = false;
+
+   if (isPolygon()) {
+      // Bounding box first, then count the edges crossed by a ray
+      // from the point toward the north (even-odd rule)
+      if (lat >= minLat && lat <= maxLat && lon >= minLon && lon <= maxLon) {
+         for (unsigned int i = 0, j = numVertices - 1; i < numVertices; j = i++) {
+            if ( (vLons[i] > lon) != (vLons[j] > lon) ) {
+               const double xlat = vLats[j] + (lon - vLons[j]) * (vLats[i] - vLats[j]) / (vLons[i] - vLons[j]);
+               if (lat < xlat) inside = !inside;
+            }
+         }
+      }
+   }
+
+   else if (isCircle()) {
+      double brg = 0;
+      double dist = 0;
+      Basic::Nav::gll2bdS(latitude, longitude, lat, lon, &brg, &dist);
+      inside = (dist <= radiusNM);
+   }
+
+   return inside;
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+
+bool RegionOfInterest::setCircle(const double lat, const double lon, const double r)
+{
+   latitude = lat;
+   longitude = lon;
+   radius = (r > 0 ? r : 0);
+   radiusNM = radius * Basic::Distance::M2NM;
+   return true;
+}
+
+bool RegionOfInterest::setVertices(const double* const lats, const double* const lons, const unsigned int n)
+{
+   if (vLats != nullptr) { delete[] vLats; vLats = nullptr; }
+   if (vLons != nullptr) { delete[] vLons; vLons = nullptr; }
+   numVertices = 0;
+
+   if (lats != nullptr && lons != nullptr && n > 0) {
+      vLats = new double[n];
+      vLons = new double[n];
+      minLat = maxLat = lats[0];
+      minLon = maxLon = lons[0];
+      for (unsigned int i = 0; i < n; i++) {
+         vLats[i] = lats[i];
+         vLons[i] = lons[i];
+         if (lats[i] < minLat) minLat = lats[i];
+         if (lats[i] > maxLat) maxLat = lats[i];
+         if (lons[i] < minLon) minLon = lons[i];
+         if (lons[i] > maxLon) maxLon = lons[i];
+      }
+      numVertices = n;
+   }
+   return true;
+}
+
+bool RegionOfInterest::setAltitudes(const double min, const double max)
+{
+   minAlt = min;
+   maxAlt = max;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+
+bool RegionOfInterest::setSlotLatitude(const Basic::LatLon* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setCircle(msg->getDouble(), longitude, radius);
+   }
+   return ok;
+}
+
+bool RegionOfInterest::setSlotLatitude(const Basic::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setCircle(msg->getDouble(), longitude, radius);
+   }
+   return ok;
+}
+
+bool RegionOfInterest::setSlotLongitude(const Basic::LatLon* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setCircle(latitude, msg->getDouble(), radius);
+   }
+   return ok;
+}
+
+bool RegionOfInterest::setSlotLongitude(const Basic::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setCircle(latitude, msg->getDouble(), radius);
+   }
+   return ok;
+}
+
+bool RegionOfInterest::setSlotRadius(const Basic::Distance* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setCircle(latitude, longitude, Basic::Meters::convertStatic(*msg));
+   }
+   return ok;
+}
+
+bool RegionOfInterest::setSlotVertices(const Basic::PairStream* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const unsigned int max = msg->entries();
+      double* lats = new double[max];
+      double* lons = new double[max];
+      unsigned int n = 0;
+      ok = true;
+
+      const Basic::List::Item* item = msg->getFirstItem();
+      while (item != nullptr && n < max) {
+         const Basic::Pair* p = static_cast<const Basic::Pair*>(item->getValue());
+         const Basic::List* list = dynamic_cast<const Basic::List*>(p->object());
+         double values[2];
+         if (list != nullptr && list->getNumberList(values, 2) == 2) {
+            lats[n] = values[0];
+            lons[n] = values[1];
+            n++;
+         }
+         else {
+            if (isMessageEnabled(MSG_ERROR)) {
+               std::cerr << "RegionOfInterest::setSlotVertices(): vertices must be in the form [ lat lon ]" << std::endl;
+            }
+            ok = false;
+         }
+         item = item->getNext();
+      }
+
+      if (ok) setVertices(lats, lons, n);
+      delete[] lats;
+      delete[] lons;
+   }
+   return ok;
+}
+
+bool RegionOfInterest::setSlotMinAltitude(const Basic::Distance* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setAltitudes(Basic::Meters::convertStatic(*msg), maxAlt);
+   }
+   return ok;
+}
+
+bool RegionOfInterest::setSlotMaxAltitude(const Basic::Distance* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setAltitudes(minAlt, Basic::Meters::convertStatic(*msg));
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// getSlotByIndex()
+//------------------------------------------------------------------------------
+Basic::Object* RegionOfInterest::getSlotByIndex(const int si)
+{
+   return BaseClass::getSlotByIndex(si);
+}
+
+} // End Dis namespace
+} // End Network namespace
+} // End Eaagles namespace
@@ -0,0 +1,201 @@
+#include "openeaagles/recorder/ColumnFile.h"
+
+#include <cstring>
+
+namespace Eaagles {
+namespace Recorder {
+
+// File magic numbers
+static const char HEADER_MAGIC[4] = { 'O', 'E', 'C', 'F' };
+static const char TRAILER_MAGIC[4] = { 'O', 'E', 'C', 'X' };
+
+//------------------------------------------------------------------------------
+// Schema
+//------------------------------------------------------------------------------
+struct ColumnDef {
+   const char* name;
+   ColumnFile::Type type;
+};
+
+static const ColumnDef playerColumns[ColumnFile::NUM_PLAYER_COLUMNS] = {
+   { "exec_time",       ColumnFile::DOUBLE_TYPE },
+   { "sim_time",        ColumnFile::DOUBLE_TYPE },
+   { "record_id",       ColumnFile::UINT32_TYPE },
+   { "player_id",       ColumnFile::UINT32_TYPE },
+   { "player_name",     ColumnFile::NAME_TYPE },
+   { "side",            ColumnFile::UINT32_TYPE },
+   { "pos_x",           ColumnFile::DOUBLE_TYPE },
+   { "pos_y",           ColumnFile::DOUBLE_TYPE },
+   { "pos_z",           ColumnFile::DOUBLE_TYPE },
+   { "roll",            ColumnFile::DOUBLE_TYPE },
+   { "pitch",           ColumnFile::DOUBLE_TYPE },
+   { "yaw",             ColumnFile::DOUBLE_TYPE },
+   { "vel_x",           ColumnFile::DOUBLE_TYPE },
+   { "vel_y",           ColumnFile::DOUBLE_TYPE },
+   { "vel_z",           ColumnFile::DOUBLE_TYPE },
+   { "damage",          ColumnFile::DOUBLE_TYPE },
+   { "alpha",           ColumnFile::DOUBLE_TYPE },
+   { "beta",            ColumnFile::DOUBLE_TYPE },
+   { "cas",             ColumnFile::DOUBLE_TYPE }
+};
+
+static const ColumnDef trackColumns[ColumnFile::NUM_TRACK_COLUMNS] = {
+   { "exec_time",       ColumnFile::DOUBLE_TYPE },
+   { "sim_time",        ColumnFile::DOUBLE_TYPE },
+   { "record_id",       ColumnFile::UINT32_TYPE },
+   { "player_id",       ColumnFile::UINT32_TYPE },
+   { "player_name",     ColumnFile::NAME_TYPE },
+   { "track_id",        ColumnFile::NAME_TYPE },
+   { "trk_player_id",   ColumnFile::UINT32_TYPE },
+   { "trk_player_name", ColumnFile::NAME_TYPE },
+   { "type",            ColumnFile::UINT32_TYPE },
+   { "quality",         ColumnFile::DOUBLE_TYPE },
+   { "true_az",         ColumnFile::DOUBLE_TYPE },
+   { "rel_az",          ColumnFile::DOUBLE_TYPE },
+   { "elevation",       ColumnFile::DOUBLE_TYPE },
+   { "range",           ColumnFile::DOUBLE_TYPE },
+   { "latitude",        ColumnFile::DOUBLE_TYPE },
+   { "longitude",       ColumnFile::DOUBLE_TYPE },
+   { "altitude",        ColumnFile::DOUBLE_TYPE },
+   { "avg_signal",      ColumnFile::DOUBLE_TYPE }
+};
+
+static const ColumnDef emissionColumns[ColumnFile::NUM_EMISSION_COLUMNS] = {
+   { "exec_time",       ColumnFile::DOUBLE_TYPE },
+   { "sim_time",        ColumnFile::DOUBLE_TYPE },
+   { "player_id",       ColumnFile::UINT32_TYPE },
+   { "player_name",     ColumnFile::NAME_TYPE },
+   { "track_id",        ColumnFile::NAME_TYPE },
+   { "frequency",       ColumnFile::DOUBLE_TYPE },
+   { "wave_length",     ColumnFile::DOUBLE_TYPE },
+   { "pulse_width",     ColumnFile::DOUBLE_TYPE },
+   { "bandwidth",       ColumnFile::DOUBLE_TYPE },
+   { "prf",             ColumnFile::DOUBLE_TYPE },
+   { "power",           ColumnFile::DOUBLE_TYPE },
+   { "polarization",    ColumnFile::UINT32_TYPE },
+   { "azimuth_aoi",     ColumnFile::DOUBLE_TYPE },
+   { "elevation_aoi",   ColumnFile::DOUBLE_TYPE },
+   { "origin_id",       ColumnFile::UINT32_TYPE },
+   { "target_id",       ColumnFile::UINT32_TYPE }
+};
+
+static const char* const tableNames[ColumnFile::NUM_TABLES] = { "player", "track", "emission" };
+
+static const ColumnDef* getColumnDef(const unsigned int table, const unsigned int column)
+{
+   const ColumnDef* p = nullptr;
+   if (column < ColumnFile::getNumColumns(table)) {
+      switch (table) {
+         case ColumnFile::PLAYER_TABLE :     p = &playerColumns[column]; break;
+         case ColumnFile::TRACK_TABLE :      p = &trackColumns[column]; break;
+         case ColumnFile::EMISSION_TABLE :   p = &emissionColumns[column]; break;
+      }
+   }
+   return p;
+}
+
+const char* ColumnFile::getTableName(const unsigned int table)
+{
+   const char* p = nullptr;
+   if (table < NUM_TABLES) p = tableNames[table];
+   return p;
+}
+
+unsigned int ColumnFile::getNumColumns(const unsigned int table)
+{
+   unsigned int n = 0;
+   switch (table) {
+      case PLAYER_TABLE :     n = NUM_PLAYER_COLUMNS; break;
+      case TRACK_TABLE :      n = NUM_TRACK_COLUMNS; break;
+      case EMISSION_TABLE :   n = NUM_EMISSION_COLUMNS; break;
+   }
+   return n;
+}
+
+const char* ColumnFile::getColumnName(const unsigned int table, const unsigned int column)
+{
+   const ColumnDef* p = getColumnDef(table, column);
+   return (p != nullptr ? p->name : nullptr);
+}
+
+ColumnFile::Type ColumnFile::getColumnType(const unsigned int table, const unsigned int column)
+{
+   const ColumnDef* p = getColumnDef(table, column);
+   return (p != nullptr ? p->type : DOUBLE_TYPE);
+}
+
+int ColumnFile::findColumn(const unsigned int table, const char* const name)
+{
+   int idx = -1;
+   if (name != nullptr) {
+      const unsigned int n = getNumColumns(table);
+      for (unsigned int i = 0; i < n && idx < 0; i++) {
+         if (std::strcmp(getColumnName(table, i), name) == 0) idx = static_cast<int>(i);
+      }
+   }
+   return idx;
+}
+
+//------------------------------------------------------------------------------
+// File header and trailer
+//------------------------------------------------------------------------------
+void ColumnFile::encodeHeader(char* const buffer)
+{
+   std::memcpy(buffer, HEADER_MAGIC, 4);
+   buffer[4] = static_cast<char>(VERSION);
+   buffer[5] = 0;
+   buffer[6] = 0;
+   buffer[7] = 0;
+}
+
+bool ColumnFile::isHeader(const char* const buffer)
+{
+   return (std::memcmp(buffer, HEADER_MAGIC, 4) == 0 && static_cast<unsigned char>(buffer[4]) == VERSION);
+}
+
+void ColumnFile::encodeTrailerMagic(char* const buffer)
+{
+   std::memcpy(buffer, TRAILER_MAGIC, 4);
+}
+
+bool ColumnFile::isTrailerMagic(const char* const buffer)
+{
+   return (std::memcmp(buffer, TRAILER_MAGIC, 4) == 0);
+}
+
+//------------------------------------------------------------------------------
+// Little-endian values
+//------------------------------------------------------------------------------
+void ColumnFile::putUInt(char* const p, const unsigned long long v, const unsigned int n)
+{
+   for (unsigned int i = 0; i < n; i++) {
+      p[i] = static_cast<char>( (v >> (8*i)) & 0xff );
+   }
+}
+
+unsigned long long ColumnFile::getUInt(const char* const p, const unsigned int n)
+{
+   unsigned long long v = 0;
+   for (unsigned int i = 0; i < n; i++) {
+      v |= static_cast<unsigned long long>( static_cast<unsigned char>(p[i]) ) << (8*i);
+   }
+   return v;
+}
+
+void ColumnFile::putDouble(char* const p, const double d)
+{
+   unsigned long long v = 0;
+   std::memcpy(&v, &d, sizeof(v));
+   putUInt(p, v, 8);
+}
+
+double ColumnFile::getDouble(const char* const p)
+{
+   const unsigned long long v = getUInt(p, 8);
+   double d = 0;
+   std::memcpy(&d, &v, sizeof(d));
+   return d;
+}
+
+} // End Recorder namespace
+} // End Eaagles namespace
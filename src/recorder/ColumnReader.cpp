@@ -0,0 +1,437 @@
+#include "openeaagles/recorder/ColumnReader.h"
+
+#include "openeaagles/basic/String.h"
+#include <fstream>
+
+namespace Eaagles {
+namespace Recorder {
+
+//==============================================================================
+// Class ColumnReader
+//==============================================================================
+IMPLEMENT_SUBCLASS(ColumnReader,"RecorderColumnReader")
+
+// Slot table for this form type
+BEGIN_SLOTTABLE(ColumnReader)
+    "filename",         // 1) Column data file name (required)
+    "pathname",         // 2) Path to the data file directory (optional)
+END_SLOTTABLE(ColumnReader)
+
+// Map slot table to handles
+BEGIN_SLOT_MAP(ColumnReader)
+    ON_SLOT( 1, setFilename, Basic::String)
+    ON_SLOT( 2, setPathName, Basic::String)
+END_SLOT_MAP()
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+ColumnReader::ColumnReader()
+{
+   STANDARD_CONSTRUCTOR()
+   initData();
+}
+
+void ColumnReader::initData()
+{
+   sin = nullptr;
+   filename = nullptr;
+   pathname = nullptr;
+   fileOpened = false;
+   fileFailed = false;
+
+   chunks = nullptr;
+   numChunks = 0;
+   for (unsigned int t = 0; t < ColumnFile::NUM_TABLES; t++) {
+      numRows[t] = 0;
+   }
+
+   names = nullptr;
+   numNames = 0;
+   buffer = nullptr;
+   bufferSize = 0;
+}
+
+//------------------------------------------------------------------------------
+// copyData() -- copy member data
+//------------------------------------------------------------------------------
+void ColumnReader::copyData(const ColumnReader& org, const bool cc)
+{
+   BaseClass::copyData(org);
+   if (cc) initData();
+
+   // Need to re-open the file
+   closeFile();
+   if (sin != nullptr) { delete sin; sin = nullptr; }
+
+   setFilename(org.filename);
+   setPathName(org.pathname);
+}
+
+//------------------------------------------------------------------------------
+// deleteData() -- delete member data
+//------------------------------------------------------------------------------
+void ColumnReader::deleteData()
+{
+   closeFile();
+   if (sin != nullptr) { delete sin; sin = nullptr; }
+   if (buffer != nullptr) { delete[] buffer; buffer = nullptr; }
+   bufferSize = 0;
+
+   setFilename(nullptr);
+   setPathName(nullptr);
+}
+
+// Frees the directory and the dictionary
+void ColumnReader::clearDirectory()
+{
+   if (chunks != nullptr) { delete[] chunks; chunks = nullptr; }
+   numChunks = 0;
+   for (unsigned int t = 0; t < ColumnFile::NUM_TABLES; t++) {
+      numRows[t] = 0;
+   }
+
+   if (names != nullptr) { delete[] names; names = nullptr; }
+   numNames = 0;
+}
+
+//------------------------------------------------------------------------------
+// get functions
+//------------------------------------------------------------------------------
+
+bool ColumnReader::isOpen() const
+{
+   return fileOpened && sin != nullptr && sin->is_open();
+}
+
+bool ColumnReader::isFailed() const
+{
+   return fileFailed;
+}
+
+unsigned long long ColumnReader::getNumRows(const unsigned int table) const
+{
+   unsigned long long n = 0;
+   if (table < ColumnFile::NUM_TABLES) n = numRows[table];
+   return n;
+}
+
+unsigned int ColumnReader::getNumNames() const
+{
+   return numNames;
+}
+
+const char* ColumnReader::getName(const unsigned int code) const
+{
+   const char* p = nullptr;
+   if (code < numNames) p = names[code].c_str();
+   return p;
+}
+
+//------------------------------------------------------------------------------
+// Open the column data file and load its dictionary and directory
+//------------------------------------------------------------------------------
+bool ColumnReader::openFile()
+{
+   if (isOpen()) return true;
+
+   fileOpened = false;
+   fileFailed = true;
+
+   if (filename == nullptr || filename->len() == 0) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "ColumnReader::openFile(): Unable to open data file: no file name" << std::endl;
+      }
+      return false;
+   }
+
+   // The full file name
+   size_t nameLength = filename->len() + 1;
+   if (pathname != nullptr) nameLength += pathname->len() + 1;
+   char* fullname = new char[nameLength];
+   fullname[0] = '\0';
+   if (pathname != nullptr && pathname->len() > 0) {
+      lcStrcat(fullname, nameLength, *pathname);
+      lcStrcat(fullname, nameLength, "/");
+   }
+   lcStrcat(fullname, nameLength, *filename);
+
+   if (sin == nullptr) sin = new std::ifstream();
+   sin->open(fullname, std::ios_base::in | std::ios_base::binary);
+
+   if (sin->fail()) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "ColumnReader::openFile(): Failed to open data file: " << fullname << std::endl;
+      }
+   }
+   else if (!readDirectory()) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "ColumnReader::openFile(): Not a column data file, or the file wasn't closed: " << fullname << std::endl;
+      }
+      sin->close();
+   }
+   else {
+      fileOpened = true;
+      fileFailed = false;
+   }
+
+   delete[] fullname;
+   return fileOpened;
+}
+
+//------------------------------------------------------------------------------
+// Close the column data file
+//------------------------------------------------------------------------------
+void ColumnReader::closeFile()
+{
+   if (sin != nullptr && sin->is_open()) sin->close();
+   fileOpened = false;
+   clearDirectory();
+}
+
+//------------------------------------------------------------------------------
+// Reads the header, the trailer, the dictionary and the directory
+//------------------------------------------------------------------------------
+bool ColumnReader::readDirectory()
+{
+   clearDirectory();
+
+   // Header
+   char header[ColumnFile::HEADER_SIZE];
+   sin->read(header, ColumnFile::HEADER_SIZE);
+   if (sin->fail() || !ColumnFile::isHeader(header)) return false;
+
+   // Trailer
+   sin->seekg(0, std::ios_base::end);
+   const long long size = static_cast<long long>(sin->tellg());
+   if (size < static_cast<long long>(ColumnFile::HEADER_SIZE + ColumnFile::TRAILER_SIZE)) return false;
+
+   char trailer[ColumnFile::TRAILER_SIZE];
+   sin->seekg(size - ColumnFile::TRAILER_SIZE, std::ios_base::beg);
+   sin->read(trailer, ColumnFile::TRAILER_SIZE);
+   if (sin->fail() || !ColumnFile::isTrailerMagic(&trailer[24])) return false;
+
+   const unsigned long long dictOffset = ColumnFile::getUInt(&trailer[0], 8);
+   const unsigned int nNames = static_cast<unsigned int>( ColumnFile::getUInt(&trailer[8], 4) );
+   const unsigned long long dirOffset = ColumnFile::getUInt(&trailer[12], 8);
+   const unsigned int nChunks = static_cast<unsigned int>( ColumnFile::getUInt(&trailer[20], 4) );
+   if (dictOffset > dirOffset ||
+      dirOffset + static_cast<unsigned long long>(nChunks) * ColumnFile::CHUNK_ENTRY_SIZE + ColumnFile::TRAILER_SIZE != static_cast<unsigned long long>(size)) {
+      return false;
+   }
+
+   // Each name has at least its four byte length in the dictionary, so a
+   // corrupt name count can't size our arrays beyond the file
+   if (static_cast<unsigned long long>(nNames) * 4 > dirOffset - dictOffset) return false;
+   unsigned long long remaining = (dirOffset - dictOffset) - static_cast<unsigned long long>(nNames) * 4;
+
+   // Dictionary; code zero is the empty name
+   names = new std::string[nNames + 1];
+   numNames = 1;
+   sin->seekg(static_cast<std::streamoff>(dictOffset), std::ios_base::beg);
+   bool ok = true;
+   for (unsigned int i = 0; i < nNames && ok; i++) {
+      char len[4];
+      sin->read(len, 4);
+      const unsigned int n = static_cast<unsigned int>( ColumnFile::getUInt(len, 4) );
+      ok = !sin->fail() && (n <= remaining);
+      if (ok) remaining -= n;
+      if (ok && n > 0) {
+         names[numNames].resize(n);
+         sin->read(&names[numNames][0], n);
+         ok = !sin->fail();
+      }
+      if (ok) numNames++;
+   }
+
+   // Directory
+   if (ok) {
+      chunks = new ChunkEntry[nChunks > 0 ? nChunks : 1];
+      char entry[ColumnFile::CHUNK_ENTRY_SIZE];
+      sin->seekg(static_cast<std::streamoff>(dirOffset), std::ios_base::beg);
+      for (unsigned int i = 0; i < nChunks && ok; i++) {
+         sin->read(entry, ColumnFile::CHUNK_ENTRY_SIZE);
+         ChunkEntry* const p = &chunks[i];
+         p->offset = ColumnFile::getUInt(&entry[0], 8);
+         p->firstRow = ColumnFile::getUInt(&entry[8], 8);
+         p->numRows = static_cast<unsigned int>( ColumnFile::getUInt(&entry[16], 4) );
+         p->table = static_cast<unsigned int>( ColumnFile::getUInt(&entry[20], 2) );
+         p->column = static_cast<unsigned int>( ColumnFile::getUInt(&entry[22], 2) );
+         ok = !sin->fail() && p->table < ColumnFile::NUM_TABLES && p->column < ColumnFile::getNumColumns(p->table);
+
+         // The chunk's rows must lie between the header and the dictionary
+         if (ok) {
+            const unsigned int size = ColumnFile::getTypeSize( ColumnFile::getColumnType(p->table, p->column) );
+            ok = p->offset >= ColumnFile::HEADER_SIZE && p->offset <= dictOffset &&
+               static_cast<unsigned long long>(p->numRows) * size <= dictOffset - p->offset;
+         }
+         if (ok) {
+            numChunks++;
+            if (p->firstRow + p->numRows > numRows[p->table]) numRows[p->table] = p->firstRow + p->numRows;
+         }
+      }
+   }
+
+   sin->clear();
+   if (!ok) clearDirectory();
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Read column values
+//------------------------------------------------------------------------------
+unsigned long long ColumnReader::readColumn(
+      const unsigned int table,
+      const unsigned int column,
+      double* const values,
+      const unsigned long long maxRows,
+      const unsigned long long firstRow
+   )
+{
+   unsigned long long n = 0;
+   if (column < ColumnFile::getNumColumns(table) && ColumnFile::getColumnType(table, column) == ColumnFile::DOUBLE_TYPE) {
+      n = readChunks(table, column, values, maxRows, firstRow);
+   }
+   return n;
+}
+
+unsigned long long ColumnReader::readColumn(
+      const unsigned int table,
+      const unsigned int column,
+      unsigned int* const values,
+      const unsigned long long maxRows,
+      const unsigned long long firstRow
+   )
+{
+   unsigned long long n = 0;
+   if (column < ColumnFile::getNumColumns(table) && ColumnFile::getColumnType(table, column) != ColumnFile::DOUBLE_TYPE) {
+      n = readChunks(table, column, values, maxRows, firstRow);
+   }
+   return n;
+}
+
+//------------------------------------------------------------------------------
+// Reads and decodes the column's chunks that hold the rows
+//------------------------------------------------------------------------------
+unsigned long long ColumnReader::readChunks(
+      const unsigned int table,
+      const unsigned int column,
+      void* const values,
+      const unsigned long long maxRows,
+      const unsigned long long firstRow
+   )
+{
+   if (!isOpen() || values == nullptr) return 0;
+
+   const ColumnFile::Type type = ColumnFile::getColumnType(table, column);
+   const unsigned int size = ColumnFile::getTypeSize(type);
+   const unsigned long long endRow = firstRow + maxRows;
+
+   unsigned long long n = 0;
+   bool ok = true;
+   for (unsigned int i = 0; i < numChunks && ok; i++) {
+      const ChunkEntry* const p = &chunks[i];
+      if (p->table != table || p->column != column) continue;
+
+      // The chunk's rows that were requested
+      const unsigned long long first = (p->firstRow > firstRow ? p->firstRow : firstRow);
+      const unsigned long long last = (p->firstRow + p->numRows < endRow ? p->firstRow + p->numRows : endRow);
+      if (first >= last) continue;
+      const unsigned int rows = static_cast<unsigned int>(last - first);
+
+      // Read them
+      const unsigned long long len = static_cast<unsigned long long>(rows) * size;
+      if (len > bufferSize) {
+         if (buffer != nullptr) delete[] buffer;
+         buffer = new char[static_cast<size_t>(len)];
+         bufferSize = len;
+      }
+      sin->seekg(static_cast<std::streamoff>(p->offset + (first - p->firstRow) * size), std::ios_base::beg);
+      sin->read(buffer, static_cast<std::streamsize>(len));
+      ok = !sin->fail();
+
+      // and decode them
+      if (ok) {
+         const unsigned long long k = first - firstRow;
+         if (type == ColumnFile::DOUBLE_TYPE) {
+            double* const v = static_cast<double*>(values) + k;
+            for (unsigned int j = 0; j < rows; j++) {
+               v[j] = ColumnFile::getDouble(&buffer[j * 8]);
+            }
+         }
+         else {
+            unsigned int* const v = static_cast<unsigned int*>(values) + k;
+            for (unsigned int j = 0; j < rows; j++) {
+               v[j] = static_cast<unsigned int>( ColumnFile::getUInt(&buffer[j * 4], 4) );
+            }
+         }
+         n += rows;
+      }
+   }
+
+   if (!ok) {
+      sin->clear();
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "ColumnReader::readColumn(): read error" << std::endl;
+      }
+   }
+   return n;
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+
+bool ColumnReader::setFilename(const Basic::String* const msg)
+{
+   if (filename != nullptr) { filename->unref(); filename = nullptr; }
+   if (msg != nullptr) filename = new Basic::String(*msg);
+   return true;
+}
+
+bool ColumnReader::setPathName(const Basic::String* const msg)
+{
+   if (pathname != nullptr) { pathname->unref(); pathname = nullptr; }
+   if (msg != nullptr) pathname = new Basic::String(*msg);
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// getSlotByIndex()
+//------------------------------------------------------------------------------
+Basic::Object* ColumnReader::getSlotByIndex(const int si)
+{
+   return BaseClass::getSlotByIndex(si);
+}
+
+//------------------------------------------------------------------------------
+// serialize
+//------------------------------------------------------------------------------
+std::ostream& ColumnReader::serialize(std::ostream& sout, const int i, const bool slotsOnly) const
+{
+    int j = 0;
+    if ( !slotsOnly ) {
+        sout << "( " << getFactoryName() << std::endl;
+        j = 4;
+    }
+
+    if (filename != nullptr && filename->len() > 0) {
+        indent(sout,i+j);
+        sout << "filename: \"" << *filename << "\""<< std::endl;
+    }
+
+    if (pathname != nullptr && pathname->len() > 0) {
+        indent(sout,i+j);
+        sout << "pathname: \"" << *pathname << "\"" << std::endl;
+    }
+
+    if ( !slotsOnly ) {
+        indent(sout,i);
+        sout << ")" << std::endl;
+    }
+
+    return sout;
+}
+
+} // End Recorder namespace
+} // End Eaagles namespace
@@ -0,0 +1,720 @@
+#include "openeaagles/recorder/ColumnWriter.h"
+#include "openeaagles/recorder/protobuf/DataRecord.pb.h"
+#include "openeaagles/recorder/DataRecordHandle.h"
+
+#include "openeaagles/basic/Number.h"
+#include "openeaagles/basic/String.h"
+#include <cstdio>
+#include <fstream>
+#include <limits>
+
+namespace Eaagles {
+namespace Recorder {
+
+//==============================================================================
+// Class ColumnWriter
+//==============================================================================
+IMPLEMENT_SUBCLASS(ColumnWriter,"RecorderColumnWriter")
+
+// Slot table for this form type
+BEGIN_SLOTTABLE(ColumnWriter)
+    "filename",         // 1) Column data file name (required)
+    "pathname",         // 2) Path to the data file directory (optional)
+    "rowGroupSize",     // 3) Number of rows in each row group
+END_SLOTTABLE(ColumnWriter)
+
+// Map slot table to handles
+BEGIN_SLOT_MAP(ColumnWriter)
+    ON_SLOT( 1, setFilename, Basic::String)
+    ON_SLOT( 2, setPathName, Basic::String)
+    ON_SLOT( 3, setSlotRowGroupSize, Basic::Number)
+END_SLOT_MAP()
+
+// Value of a missing field
+static const double MISSING = std::numeric_limits<double>::quiet_NaN();
+
+// Dictionary hash of a name (FNV-1a)
+static unsigned int hashName(const std::string& name)
+{
+   unsigned int h = 2166136261u;
+   for (std::string::size_type i = 0; i < name.length(); i++) {
+      h = (h ^ static_cast<unsigned char>(name[i])) * 16777619u;
+   }
+   return h;
+}
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+ColumnWriter::ColumnWriter()
+{
+   STANDARD_CONSTRUCTOR()
+   initData();
+}
+
+void ColumnWriter::initData()
+{
+   sout = nullptr;
+   filename = nullptr;
+   pathname = nullptr;
+   fileOpened = false;
+   fileFailed = false;
+   fileOffset = 0;
+
+   rowGroupSize = DEFAULT_ROW_GROUP_SIZE;
+   for (unsigned int t = 0; t < ColumnFile::NUM_TABLES; t++) {
+      for (unsigned int c = 0; c < ColumnFile::MAX_COLUMNS; c++) {
+         tables[t].columns[c] = nullptr;
+      }
+      tables[t].numColumns = 0;
+      tables[t].numRows = 0;
+      tables[t].totalRows = 0;
+   }
+
+   chunks = nullptr;
+   numChunks = 0;
+   maxChunks = 0;
+
+   names = nullptr;
+   numNames = 0;
+   maxNames = 0;
+   nameHash = nullptr;
+   nameHashSize = 0;
+}
+
+//------------------------------------------------------------------------------
+// copyData() -- copy member data
+//------------------------------------------------------------------------------
+void ColumnWriter::copyData(const ColumnWriter& org, const bool cc)
+{
+   BaseClass::copyData(org);
+   if (cc) initData();
+
+   // Need to re-open the file
+   if (sout != nullptr) {
+      if (isOpen()) sout->close();
+      delete sout;
+   }
+   sout = nullptr;
+   fileOpened = false;
+   fileFailed = false;
+   clearTables();
+
+   setFilename(org.filename);
+   setPathName(org.pathname);
+   setRowGroupSize(org.rowGroupSize);
+}
+
+//------------------------------------------------------------------------------
+// deleteData() -- delete member data
+//------------------------------------------------------------------------------
+void ColumnWriter::deleteData()
+{
+   if (sout != nullptr) {
+      if (isOpen()) sout->close();
+      delete sout;
+   }
+   sout = nullptr;
+
+   clearTables();
+
+   setFilename(nullptr);
+   setPathName(nullptr);
+}
+
+// Frees the row groups, the directory and the dictionary
+void ColumnWriter::clearTables()
+{
+   for (unsigned int t = 0; t < ColumnFile::NUM_TABLES; t++) {
+      for (unsigned int c = 0; c < ColumnFile::MAX_COLUMNS; c++) {
+         if (tables[t].columns[c] != nullptr) { delete[] tables[t].columns[c]; tables[t].columns[c] = nullptr; }
+      }
+      tables[t].numColumns = 0;
+      tables[t].numRows = 0;
+      tables[t].totalRows = 0;
+   }
+
+   if (chunks != nullptr) { delete[] chunks; chunks = nullptr; }
+   numChunks = 0;
+   maxChunks = 0;
+
+   if (names != nullptr) { delete[] names; names = nullptr; }
+   numNames = 0;
+   maxNames = 0;
+   if (nameHash != nullptr) { delete[] nameHash; nameHash = nullptr; }
+   nameHashSize = 0;
+}
+
+//------------------------------------------------------------------------------
+// shutdownNotification() -- Shutdown the simulation
+//------------------------------------------------------------------------------
+bool ColumnWriter::shutdownNotification()
+{
+   // Our base class processes the records that are left in the queue, so it goes first
+   const bool ok = BaseClass::shutdownNotification();
+
+   if (isOpen()) closeFile();
+
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// get functions
+//------------------------------------------------------------------------------
+
+bool ColumnWriter::isOpen() const
+{
+   return fileOpened && sout != nullptr && sout->is_open();
+}
+
+bool ColumnWriter::isFailed() const
+{
+   return fileFailed || (sout != nullptr && sout->fail());
+}
+
+const char* ColumnWriter::getFilename() const
+{
+   const char* p = nullptr;
+   if (filename != nullptr) p = *filename;
+   return p;
+}
+
+const char* ColumnWriter::getPathname() const
+{
+   const char* p = nullptr;
+   if (pathname != nullptr) p = *pathname;
+   return p;
+}
+
+unsigned int ColumnWriter::getRowGroupSize() const
+{
+   return rowGroupSize;
+}
+
+unsigned long long ColumnWriter::getNumRows(const unsigned int table) const
+{
+   unsigned long long n = 0;
+   if (table < ColumnFile::NUM_TABLES) n = tables[table].totalRows + tables[table].numRows;
+   return n;
+}
+
+//------------------------------------------------------------------------------
+// Open the column data file
+//------------------------------------------------------------------------------
+bool ColumnWriter::openFile()
+{
+   if (isOpen()) return true;
+
+   fileOpened = false;
+   fileFailed = true;
+
+   if (filename == nullptr || filename->len() == 0) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "ColumnWriter::openFile(): Unable to open data file: no file name" << std::endl;
+      }
+      return false;
+   }
+
+   // The full file name, with room for a version number ("_v99")
+   size_t nameLength = filename->len() + 5;
+   if (pathname != nullptr) nameLength += pathname->len() + 1;
+   char* fullname = new char[nameLength];
+   fullname[0] = '\0';
+   if (pathname != nullptr && pathname->len() > 0) {
+      lcStrcat(fullname, nameLength, *pathname);
+      lcStrcat(fullname, nameLength, "/");
+   }
+   lcStrcat(fullname, nameLength, *filename);
+
+   // Don't over write an existing file; append a version number
+   bool validName = !doesFileExist(fullname);
+   if (!validName) {
+      char* origname = new char[nameLength];
+      lcStrcpy(origname, nameLength, fullname);
+      for (unsigned int i = 1; i <= 99 && !validName; i++) {
+         std::sprintf(fullname, "%s_v%02d", origname, i);
+         validName = !doesFileExist(fullname);
+      }
+      if (!validName && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "ColumnWriter::openFile(): All version of the data file already exists: " << origname << std::endl;
+      }
+      delete[] origname;
+   }
+
+   if (validName) {
+      if (sout == nullptr) sout = new std::ofstream();
+      sout->open(fullname, std::ios_base::out | std::ios_base::binary);
+
+      if (isMessageEnabled(MSG_INFO)) {
+         std::cout << "ColumnWriter::openFile() Opening data file = " << fullname << std::endl;
+      }
+
+      if (sout->fail()) {
+         if (isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "ColumnWriter::openFile(): Failed to open data file: " << fullname << std::endl;
+         }
+      }
+      else {
+         fileOpened = true;
+         fileFailed = false;
+      }
+   }
+   delete[] fullname;
+
+   // Start the tables, the directory and the dictionary, and write the header
+   if (fileOpened) {
+      clearTables();
+      for (unsigned int t = 0; t < ColumnFile::NUM_TABLES; t++) {
+         tables[t].numColumns = ColumnFile::getNumColumns(t);
+         for (unsigned int c = 0; c < tables[t].numColumns; c++) {
+            const unsigned int size = ColumnFile::getTypeSize( ColumnFile::getColumnType(t, c) );
+            tables[t].columns[c] = new char[rowGroupSize * size];
+         }
+      }
+      getNameCode("");
+
+      fileOffset = 0;
+      char header[ColumnFile::HEADER_SIZE];
+      ColumnFile::encodeHeader(header);
+      writeData(header, ColumnFile::HEADER_SIZE);
+   }
+
+   return fileOpened;
+}
+
+//------------------------------------------------------------------------------
+// Write the remaining rows, the dictionary and the directory, and close the file
+//------------------------------------------------------------------------------
+void ColumnWriter::closeFile()
+{
+   if (isOpen()) {
+      for (unsigned int t = 0; t < ColumnFile::NUM_TABLES; t++) {
+         flushRowGroup(t);
+      }
+      writeDirectory();
+      sout->close();
+      fileOpened = false;
+      fileFailed = false;
+   }
+}
+
+//------------------------------------------------------------------------------
+// Adds the player, track and emission data of the record to the tables
+//------------------------------------------------------------------------------
+void ColumnWriter::processRecordImp(const DataRecordHandle* const handle)
+{
+   const Pb::DataRecord* dataRecord = handle->getRecord();
+   const unsigned int id = dataRecord->id();
+
+   // Open the file with the first player or track record
+   const bool tableRecord = (
+      id == REID_NEW_PLAYER || id == REID_PLAYER_REMOVED || id == REID_PLAYER_DATA ||
+      id == REID_NEW_TRACK || id == REID_TRACK_DATA );
+   if (tableRecord && !fileOpened && !fileFailed) openFile();
+   if (!isOpen()) return;
+
+   const Pb::Time& time = dataRecord->time();
+
+   switch (id) {
+
+      case REID_NEW_PLAYER : {
+         if (dataRecord->has_new_player_event_msg()) {
+            const Pb::NewPlayerEventMsg& msg = dataRecord->new_player_event_msg();
+            addPlayerRow(time, id, msg.id(), &msg.state(), MISSING, MISSING, MISSING);
+         }
+      }
+      break;
+
+      case REID_PLAYER_REMOVED : {
+         if (dataRecord->has_player_removed_event_msg()) {
+            const Pb::PlayerRemovedEventMsg& msg = dataRecord->player_removed_event_msg();
+            addPlayerRow(time, id, msg.id(), (msg.has_state() ? &msg.state() : nullptr), MISSING, MISSING, MISSING);
+         }
+      }
+      break;
+
+      case REID_PLAYER_DATA : {
+         if (dataRecord->has_player_data_msg()) {
+            const Pb::PlayerDataMsg& msg = dataRecord->player_data_msg();
+            addPlayerRow(time, id, msg.id(), &msg.state(),
+               (msg.has_alpha() ? msg.alpha() : MISSING),
+               (msg.has_beta() ? msg.beta() : MISSING),
+               (msg.has_cas() ? msg.cas() : MISSING) );
+         }
+      }
+      break;
+
+      case REID_NEW_TRACK : {
+         if (dataRecord->has_new_track_event_msg()) {
+            const Pb::NewTrackEventMsg& msg = dataRecord->new_track_event_msg();
+            addTrackRow(time, id, msg.player_id(), msg.track_id(),
+               (msg.has_trk_player_id() ? &msg.trk_player_id() : nullptr),
+               (msg.has_track_data() ? &msg.track_data() : nullptr) );
+            if (msg.has_emission_data()) addEmissionRow(time, msg.player_id(), msg.track_id(), msg.emission_data());
+         }
+      }
+      break;
+
+      case REID_TRACK_DATA : {
+         if (dataRecord->has_track_data_msg()) {
+            const Pb::TrackDataMsg& msg = dataRecord->track_data_msg();
+            addTrackRow(time, id, msg.player_id(), msg.track_id(),
+               (msg.has_trk_player_id() ? &msg.trk_player_id() : nullptr),
+               (msg.has_track_data() ? &msg.track_data() : nullptr) );
+            if (msg.has_emission_data()) addEmissionRow(time, msg.player_id(), msg.track_id(), msg.emission_data());
+         }
+      }
+      break;
+
+      case REID_END_OF_DATA : {
+         closeFile();
+      }
+      break;
+   }
+}
+
+//------------------------------------------------------------------------------
+// Table rows
+//------------------------------------------------------------------------------
+void ColumnWriter::addPlayerRow(
+      const Pb::Time& time,
+      const unsigned int id,
+      const Pb::PlayerId& pid,
+      const Pb::PlayerState* const state,
+      const double alpha,
+      const double beta,
+      const double cas
+   )
+{
+   const unsigned int t = ColumnFile::PLAYER_TABLE;
+   putDouble(t, ColumnFile::P_EXEC_TIME, time.exec_time());
+   putDouble(t, ColumnFile::P_SIM_TIME, time.sim_time());
+   putUInt(t, ColumnFile::P_RECORD_ID, id);
+   putUInt(t, ColumnFile::P_PLAYER_ID, pid.id());
+   putName(t, ColumnFile::P_PLAYER_NAME, pid.name());
+   putUInt(t, ColumnFile::P_SIDE, pid.side());
+
+   const bool hasState = (state != nullptr);
+   const bool hasVel = (hasState && state->has_vel());
+   putDouble(t, ColumnFile::P_POS_X, (hasState ? state->pos().x() : MISSING));
+   putDouble(t, ColumnFile::P_POS_Y, (hasState ? state->pos().y() : MISSING));
+   putDouble(t, ColumnFile::P_POS_Z, (hasState && state->pos().has_z() ? state->pos().z() : MISSING));
+   putDouble(t, ColumnFile::P_ROLL, (hasState ? state->angles().x() : MISSING));
+   putDouble(t, ColumnFile::P_PITCH, (hasState ? state->angles().y() : MISSING));
+   putDouble(t, ColumnFile::P_YAW, (hasState && state->angles().has_z() ? state->angles().z() : MISSING));
+   putDouble(t, ColumnFile::P_VEL_X, (hasVel ? state->vel().x() : MISSING));
+   putDouble(t, ColumnFile::P_VEL_Y, (hasVel ? state->vel().y() : MISSING));
+   putDouble(t, ColumnFile::P_VEL_Z, (hasVel && state->vel().has_z() ? state->vel().z() : MISSING));
+   putDouble(t, ColumnFile::P_DAMAGE, (hasState && state->has_damage() ? state->damage() : MISSING));
+   putDouble(t, ColumnFile::P_ALPHA, alpha);
+   putDouble(t, ColumnFile::P_BETA, beta);
+   putDouble(t, ColumnFile::P_CAS, cas);
+   endRow(t);
+}
+
+void ColumnWriter::addTrackRow(
+      const Pb::Time& time,
+      const unsigned int id,
+      const Pb::PlayerId& pid,
+      const std::string& trackId,
+      const Pb::PlayerId* const tgtId,
+      const Pb::TrackData* const trk
+   )
+{
+   const unsigned int t = ColumnFile::TRACK_TABLE;
+   putDouble(t, ColumnFile::T_EXEC_TIME, time.exec_time());
+   putDouble(t, ColumnFile::T_SIM_TIME, time.sim_time());
+   putUInt(t, ColumnFile::T_RECORD_ID, id);
+   putUInt(t, ColumnFile::T_PLAYER_ID, pid.id());
+   putName(t, ColumnFile::T_PLAYER_NAME, pid.name());
+   putName(t, ColumnFile::T_TRACK_ID, trackId);
+   putUInt(t, ColumnFile::T_TRK_PLAYER_ID, (tgtId != nullptr ? tgtId->id() : 0));
+   putName(t, ColumnFile::T_TRK_PLAYER_NAME, (tgtId != nullptr ? tgtId->name() : std::string()));
+
+   const bool hasTrk = (trk != nullptr);
+   putUInt(t, ColumnFile::T_TYPE, (hasTrk ? trk->type() : 0));
+   putDouble(t, ColumnFile::T_QUALITY, (hasTrk && trk->has_quality() ? trk->quality() : MISSING));
+   putDouble(t, ColumnFile::T_TRUE_AZ, (hasTrk && trk->has_true_az() ? trk->true_az() : MISSING));
+   putDouble(t, ColumnFile::T_REL_AZ, (hasTrk && trk->has_rel_az() ? trk->rel_az() : MISSING));
+   putDouble(t, ColumnFile::T_ELEVATION, (hasTrk && trk->has_elevation() ? trk->elevation() : MISSING));
+   putDouble(t, ColumnFile::T_RANGE, (hasTrk && trk->has_range() ? trk->range() : MISSING));
+   putDouble(t, ColumnFile::T_LATITUDE, (hasTrk && trk->has_latitude() ? trk->latitude() : MISSING));
+   putDouble(t, ColumnFile::T_LONGITUDE, (hasTrk && trk->has_longitude() ? trk->longitude() : MISSING));
+   putDouble(t, ColumnFile::T_ALTITUDE, (hasTrk && trk->has_altitude() ? trk->altitude() : MISSING));
+   putDouble(t, ColumnFile::T_AVG_SIGNAL, (hasTrk && trk->has_avg_signal() ? trk->avg_signal() : MISSING));
+   endRow(t);
+}
+
+void ColumnWriter::addEmissionRow(
+      const Pb::Time& time,
+      const Pb::PlayerId& pid,
+      const std::string& trackId,
+      const Pb::EmissionData& em
+   )
+{
+   const unsigned int t = ColumnFile::EMISSION_TABLE;
+   putDouble(t, ColumnFile::E_EXEC_TIME, time.exec_time());
+   putDouble(t, ColumnFile::E_SIM_TIME, time.sim_time());
+   putUInt(t, ColumnFile::E_PLAYER_ID, pid.id());
+   putName(t, ColumnFile::E_PLAYER_NAME, pid.name());
+   putName(t, ColumnFile::E_TRACK_ID, trackId);
+   putDouble(t, ColumnFile::E_FREQUENCY, (em.has_frequency() ? em.frequency() : MISSING));
+   putDouble(t, ColumnFile::E_WAVE_LENGTH, (em.has_wave_length() ? em.wave_length() : MISSING));
+   putDouble(t, ColumnFile::E_PULSE_WIDTH, (em.has_pulse_width() ? em.pulse_width() : MISSING));
+   putDouble(t, ColumnFile::E_BANDWIDTH, (em.has_bandwidth() ? em.bandwidth() : MISSING));
+   putDouble(t, ColumnFile::E_PRF, (em.has_prf() ? em.prf() : MISSING));
+   putDouble(t, ColumnFile::E_POWER, (em.has_power() ? em.power() : MISSING));
+   putUInt(t, ColumnFile::E_POLARIZATION, em.polarization());
+   putDouble(t, ColumnFile::E_AZIMUTH_AOI, (em.has_azimuth_aoi() ? em.azimuth_aoi() : MISSING));
+   putDouble(t, ColumnFile::E_ELEVATION_AOI, (em.has_elevation_aoi() ? em.elevation_aoi() : MISSING));
+   putUInt(t, ColumnFile::E_ORIGIN_ID, (em.has_origin_id() ? em.origin_id().id() : 0));
+   putUInt(t, ColumnFile::E_TARGET_ID, (em.has_target_id() ? em.target_id().id() : 0));
+   endRow(t);
+}
+
+//------------------------------------------------------------------------------
+// Column values of the table's current row
+//------------------------------------------------------------------------------
+void ColumnWriter::putDouble(const unsigned int table, const unsigned int column, const double v)
+{
+   ColumnFile::putDouble(&tables[table].columns[column][tables[table].numRows * 8], v);
+}
+
+void ColumnWriter::putUInt(const unsigned int table, const unsigned int column, const unsigned int v)
+{
+   ColumnFile::putUInt(&tables[table].columns[column][tables[table].numRows * 4], v, 4);
+}
+
+void ColumnWriter::putName(const unsigned int table, const unsigned int column, const std::string& name)
+{
+   putUInt(table, column, getNameCode(name));
+}
+
+// Ends the table's current row; writes the row group when it's full
+void ColumnWriter::endRow(const unsigned int table)
+{
+   tables[table].numRows++;
+   if (tables[table].numRows >= rowGroupSize) flushRowGroup(table);
+}
+
+//------------------------------------------------------------------------------
+// Writes the table's row group, a column chunk at a time
+//------------------------------------------------------------------------------
+void ColumnWriter::flushRowGroup(const unsigned int table)
+{
+   TableState* const ts = &tables[table];
+   if (ts->numRows == 0) return;
+
+   for (unsigned int c = 0; c < ts->numColumns; c++) {
+
+      // Grow the directory as needed
+      if (numChunks >= maxChunks) {
+         const unsigned int n = (maxChunks > 0 ? maxChunks * 2 : 256);
+         ChunkEntry* tmp = new ChunkEntry[n];
+         for (unsigned int i = 0; i < numChunks; i++) {
+            tmp[i] = chunks[i];
+         }
+         if (chunks != nullptr) delete[] chunks;
+         chunks = tmp;
+         maxChunks = n;
+      }
+
+      ChunkEntry* const p = &chunks[numChunks++];
+      p->offset = fileOffset;
+      p->firstRow = ts->totalRows;
+      p->numRows = ts->numRows;
+      p->table = table;
+      p->column = c;
+
+      const unsigned int size = ColumnFile::getTypeSize( ColumnFile::getColumnType(table, c) );
+      writeData(ts->columns[c], ts->numRows * size);
+   }
+
+   ts->totalRows += ts->numRows;
+   ts->numRows = 0;
+}
+
+//------------------------------------------------------------------------------
+// Writes the dictionary, the directory and the trailer
+//------------------------------------------------------------------------------
+void ColumnWriter::writeDirectory()
+{
+   // Dictionary (code zero, the empty name, isn't written)
+   const unsigned long long dictOffset = fileOffset;
+   for (unsigned int i = 1; i < numNames; i++) {
+      char len[4];
+      const unsigned int n = static_cast<unsigned int>(names[i].length());
+      ColumnFile::putUInt(len, n, 4);
+      writeData(len, 4);
+      writeData(names[i].c_str(), n);
+   }
+
+   // Directory
+   const unsigned long long dirOffset = fileOffset;
+   char* dbuff = new char[numChunks * ColumnFile::CHUNK_ENTRY_SIZE + 1];
+   for (unsigned int i = 0; i < numChunks; i++) {
+      char* const p = &dbuff[i * ColumnFile::CHUNK_ENTRY_SIZE];
+      ColumnFile::putUInt(&p[0], chunks[i].offset, 8);
+      ColumnFile::putUInt(&p[8], chunks[i].firstRow, 8);
+      ColumnFile::putUInt(&p[16], chunks[i].numRows, 4);
+      ColumnFile::putUInt(&p[20], chunks[i].table, 2);
+      ColumnFile::putUInt(&p[22], chunks[i].column, 2);
+   }
+   writeData(dbuff, numChunks * ColumnFile::CHUNK_ENTRY_SIZE);
+   delete[] dbuff;
+
+   // Trailer
+   char trailer[ColumnFile::TRAILER_SIZE];
+   ColumnFile::putUInt(&trailer[0], dictOffset, 8);
+   ColumnFile::putUInt(&trailer[8], (numNames > 0 ? numNames - 1 : 0), 4);
+   ColumnFile::putUInt(&trailer[12], dirOffset, 8);
+   ColumnFile::putUInt(&trailer[20], numChunks, 4);
+   ColumnFile::encodeTrailerMagic(&trailer[24]);
+   writeData(trailer, ColumnFile::TRAILER_SIZE);
+}
+
+//------------------------------------------------------------------------------
+// Writes the data to the file
+//------------------------------------------------------------------------------
+void ColumnWriter::writeData(const char* const data, const unsigned int n)
+{
+   if (n > 0) sout->write(data, n);
+   fileOffset += n;
+}
+
+//------------------------------------------------------------------------------
+// Dictionary code of the name; adds the name to the dictionary, as needed
+//------------------------------------------------------------------------------
+unsigned int ColumnWriter::getNameCode(const std::string& name)
+{
+   if (numNames > 0 && name.empty()) return 0;
+
+   // Find the name
+   const unsigned int h = hashName(name);
+   if (nameHashSize > 0) {
+      unsigned int slot = h & (nameHashSize - 1);
+      while (nameHash[slot] != 0) {
+         if (names[nameHash[slot]] == name) return nameHash[slot];
+         slot = (slot + 1) & (nameHashSize - 1);
+      }
+   }
+
+   // Add the name
+   if (numNames >= maxNames) {
+      const unsigned int n = (maxNames > 0 ? maxNames * 2 : 64);
+      std::string* tmp = new std::string[n];
+      for (unsigned int i = 0; i < numNames; i++) {
+         tmp[i].swap(names[i]);
+      }
+      if (names != nullptr) delete[] names;
+      names = tmp;
+      maxNames = n;
+   }
+   const unsigned int code = numNames++;
+   names[code] = name;
+
+   // Code zero, the empty name, isn't hashed; rehash when the table is half full
+   if (code > 0) {
+      if (code * 2 >= nameHashSize) {
+         if (nameHash != nullptr) delete[] nameHash;
+         nameHashSize = (nameHashSize > 0 ? nameHashSize * 2 : 128);
+         nameHash = new unsigned int[nameHashSize];
+         for (unsigned int i = 0; i < nameHashSize; i++) {
+            nameHash[i] = 0;
+         }
+         for (unsigned int i = 1; i < code; i++) {
+            unsigned int slot = hashName(names[i]) & (nameHashSize - 1);
+            while (nameHash[slot] != 0) slot = (slot + 1) & (nameHashSize - 1);
+            nameHash[slot] = i;
+         }
+      }
+      unsigned int slot = h & (nameHashSize - 1);
+      while (nameHash[slot] != 0) slot = (slot + 1) & (nameHashSize - 1);
+      nameHash[slot] = code;
+   }
+   return code;
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+
+bool ColumnWriter::setFilename(const Basic::String* const msg)
+{
+   if (filename != nullptr) { filename->unref(); filename = nullptr; }
+   if (msg != nullptr) filename = new Basic::String(*msg);
+   return true;
+}
+
+bool ColumnWriter::setPathName(const Basic::String* const msg)
+{
+   if (pathname != nullptr) { pathname->unref(); pathname = nullptr; }
+   if (msg != nullptr) pathname = new Basic::String(*msg);
+   return true;
+}
+
+bool ColumnWriter::setRowGroupSize(const unsigned int n)
+{
+   bool ok = false;
+   if (n > 0 && !isOpen()) {
+      rowGroupSize = n;
+      ok = true;
+   }
+   return ok;
+}
+
+bool ColumnWriter::setSlotRowGroupSize(const Basic::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int n = msg->getInt();
+      if (n > 0) ok = setRowGroupSize( static_cast<unsigned int>(n) );
+      if (!ok) {
+         std::cerr << "ColumnWriter::setSlotRowGroupSize(): invalid row group size: " << n << std::endl;
+      }
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// getSlotByIndex()
+//------------------------------------------------------------------------------
+Basic::Object* ColumnWriter::getSlotByIndex(const int si)
+{
+   return BaseClass::getSlotByIndex(si);
+}
+
+//------------------------------------------------------------------------------
+// serialize
+//------------------------------------------------------------------------------
+std::ostream& ColumnWriter::serialize(std::ostream& sout, const int i, const bool slotsOnly) const
+{
+    int j = 0;
+    if ( !slotsOnly ) {
+        sout << "( " << getFactoryName() << std::endl;
+        j = 4;
+    }
+
+    if (filename != nullptr && filename->len() > 0) {
+        indent(sout,i+j);
+        sout << "filename: \"" << *filename << "\""<< std::endl;
+    }
+
+    if (pathname != nullptr && pathname->len() > 0) {
+        indent(sout,i+j);
+        sout << "pathname: \"" << *pathname << "\"" << std::endl;
+    }
+
+    indent(sout,i+j);
+    sout << "rowGroupSize: " << rowGroupSize << std::endl;
+
+    if ( !slotsOnly ) {
+        indent(sout,i);
+        sout << ")" << std::endl;
+    }
+
+    return sout;
+}
+
+} // End Recorder namespace
+} // End Eaagles namespace
@@ -1,5 +1,6 @@
 
 #include "openeaagles/recorder/DataRecordHandle.h"
+#include "openeaagles/recorder/RecordArena.h"
 #include "openeaagles/recorder/protobuf/DataRecord.pb.h"
 
 namespace Eaagles {
@@ -16,23 +17,33 @@ DataRecordHandle::DataRecordHandle()
 {
    STANDARD_CONSTRUCTOR()
    record = nullptr;
+   arena = nullptr;
 }
 
 //------------------------------------------------------------------------------
 // Constructor
 //------------------------------------------------------------------------------
-DataRecordHandle::DataRecordHandle(Pb::DataRecord* const r) : record(r)
+DataRecordHandle::DataRecordHandle(Pb::DataRecord* const r) : record(r), arena(nullptr)
 {
    STANDARD_CONSTRUCTOR()
 }
 
+DataRecordHandle::DataRecordHandle(Pb::DataRecord* const r, RecordArena* const a) : record(r), arena(a)
+{
+   STANDARD_CONSTRUCTOR()
+   if (arena != nullptr) arena->ref();
+}
+
 //------------------------------------------------------------------------------
 // copyData() -- copy member data
 //------------------------------------------------------------------------------
 void DataRecordHandle::copyData(const DataRecordHandle& org, const bool cc)
 {
    BaseClass::copyData(org);
-   if (cc) record = new Pb::DataRecord();
+   if (cc) {
+      record = new Pb::DataRecord();
+      arena = nullptr;
+   }
 
    // Copy the record
    *record = *org.record;
@@ -41,6 +52,12 @@ void DataRecordHandle::copyData(const DataRecordHandle& org, const bool cc)
 // deleteData() -- delete member data
 void DataRecordHandle::deleteData()
 {
+   if (arena != nullptr) {
+      // the record is released with its arena
+      arena->unref();
+      arena = nullptr;
+      record = nullptr;
+   }
    if (record != nullptr) { delete record;  record = nullptr; }
 }
 
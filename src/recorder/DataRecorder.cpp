@@ -6,6 +6,7 @@
 
 #include "openeaagles/recorder/OutputHandler.h"
 #include "openeaagles/recorder/DataRecordHandle.h"
+#include "openeaagles/recorder/RecordArena.h"
 #include "openeaagles/recorder/protobuf/DataRecord.pb.h"
 
 #include "openeaagles/simulation/Antenna.h"
@@ -46,6 +47,7 @@ BEGIN_SLOTTABLE(DataRecorder)
    "day",               // 8) Day of the month (1 .. 31))
    "month",             // 9) Month (1 .. 12)
    "year",              // 10) Year (e.g., 2010 or 10)
+   "recordsPerArena",   // 11) Number of data records per arena (zero for heap allocation)
 END_SLOTTABLE(DataRecorder)
 
 BEGIN_SLOT_MAP(DataRecorder)
@@ -59,6 +61,7 @@ BEGIN_SLOT_MAP(DataRecorder)
    ON_SLOT( 8, setSlotDay,         Basic::Number)
    ON_SLOT( 9, setSlotMonth,       Basic::Number)
    ON_SLOT( 10, setSlotYear,       Basic::Number)
+   ON_SLOT( 11, setSlotRecordsPerArena, Basic::Number)
 END_SLOT_MAP()
 
 
@@ -100,6 +103,14 @@ void DataRecorder::initData()
    outputHandler = nullptr;
    setFirstPass(true);
 
+   arena = nullptr;
+   for (unsigned int i = 0; i < MAX_RETIRED_ARENAS; i++) {
+      retired[i] = nullptr;
+   }
+   numRetired = 0;
+   recordsPerArena = 1000;
+   arenaLock = 0;
+
    eventName = "";
    application = "";
    caseNum = 0;
@@ -134,6 +145,10 @@ void DataRecorder::copyData(const DataRecorder& org, const bool cc)
    day = org.day;
    month = org.month;
    year = org.year;
+
+   // Don't copy the arenas
+   clearArenas();
+   recordsPerArena = org.recordsPerArena;
 }
 
 //------------------------------------------------------------------------------
@@ -142,6 +157,7 @@ void DataRecorder::copyData(const DataRecorder& org, const bool cc)
 void DataRecorder::deleteData()
 {
    setOutputHandler(nullptr);
+   clearArenas();
 }
 
 
@@ -158,7 +174,7 @@ void DataRecorder::processRecords()
 //------------------------------------------------------------------------------
 bool DataRecorder::processUnhandledId(const unsigned int id)
 {
-   Pb::DataRecord* msg = new Pb::DataRecord();
+   Pb::DataRecord* msg = newDataRecord();
 
    // Record the unknown ID
    Pb::UnknownIdMsg* unknownIdMsg = msg->mutable_unknown_id_msg();
@@ -182,7 +198,7 @@ void DataRecorder::reset()
 {
    BaseClass::reset();
 
-   Pb::DataRecord* msg = new Pb::DataRecord();
+   Pb::DataRecord* msg = newDataRecord();
    timeStamp(msg);
    msg->set_id( REID_RESET_EVENT );
    sendDataRecord(msg);
@@ -197,7 +213,7 @@ bool DataRecorder::shutdownNotification()
    if (outputHandler != nullptr) {
 
       // Send an end-of-data message
-      Pb::DataRecord* msg = new Pb::DataRecord();
+      Pb::DataRecord* msg = newDataRecord();
       timeStamp(msg);
       msg->set_id( REID_END_OF_DATA );
       sendDataRecord(msg);
@@ -220,7 +236,7 @@ bool DataRecorder::shutdownNotification()
 //------------------------------------------------------------------------------
 bool DataRecorder::recordMarker(const Basic::Object* objs[4], const double values[4])
 {
-   Pb::DataRecord* msg = new Pb::DataRecord();
+   Pb::DataRecord* msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -245,7 +261,7 @@ bool DataRecorder::recordMarker(const Basic::Object* objs[4], const double value
 //------------------------------------------------------------------------------
 bool DataRecorder::recordAI(const Basic::Object* objs[4], const double values[4])
 {
-   Pb::DataRecord* msg = new Pb::DataRecord();
+   Pb::DataRecord* msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -272,7 +288,7 @@ bool DataRecorder::recordAI(const Basic::Object* objs[4], const double values[4]
 //------------------------------------------------------------------------------
 bool DataRecorder::recordDI(const Basic::Object* objs[4], const double values[4])
 {
-   Pb::DataRecord* msg = new Pb::DataRecord();
+   Pb::DataRecord* msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -300,7 +316,7 @@ bool DataRecorder::recordNewPlayer(const Basic::Object* objs[4], const double va
    const Simulation::Player* player = dynamic_cast<const Simulation::Player*>( objs[0] );
    if (player == nullptr) return false;
 
-   Pb::DataRecord* msg = new Pb::DataRecord();
+   Pb::DataRecord* msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -327,7 +343,7 @@ bool DataRecorder::recordPlayerRemoved(const Basic::Object* objs[4], const doubl
    const Simulation::Player* player = dynamic_cast<const Simulation::Player*>( objs[0] );
    if (player == nullptr) return false;
 
-   Pb::DataRecord* msg = new Pb::DataRecord();
+   Pb::DataRecord* msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -354,7 +370,7 @@ bool DataRecorder::recordPlayerData(const Basic::Object* objs[4], const double v
    const Simulation::Player* player = dynamic_cast<const Simulation::Player*>( objs[0] );
    if (player == nullptr) return false;
 
-   Pb::DataRecord* msg = new Pb::DataRecord();
+   Pb::DataRecord* msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -388,7 +404,7 @@ bool DataRecorder::recordPlayerDamaged(const Basic::Object* objs[4], const doubl
    const Simulation::Player* player = dynamic_cast<const Simulation::Player*>( objs[0] );
    if (player == nullptr) return false;
 
-   Pb::DataRecord* msg = new Pb::DataRecord();
+   Pb::DataRecord* msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -415,7 +431,7 @@ bool DataRecorder::recordPlayerCollision(const Basic::Object* objs[4], const dou
    const Simulation::Player* player = dynamic_cast<const Simulation::Player*>( objs[0] );
    if (player == nullptr) return false;
 
-   Pb::DataRecord* msg = new Pb::DataRecord();
+   Pb::DataRecord* msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -447,7 +463,7 @@ bool DataRecorder::recordPlayerCrash(const Basic::Object* objs[4], const double
    const Simulation::Player* player = dynamic_cast<const Simulation::Player*>( objs[0] );
    if (player == nullptr) return false;
 
-   Pb::DataRecord* msg = new Pb::DataRecord();
+   Pb::DataRecord* msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -474,7 +490,7 @@ bool DataRecorder::recordPlayerKilled(const Basic::Object* objs[4], const double
    const Simulation::Player* player = dynamic_cast<const Simulation::Player*>( objs[0] );
    if (player == nullptr) return false;
 
-   Pb::DataRecord* msg = new Pb::DataRecord();
+   Pb::DataRecord* msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -507,7 +523,7 @@ bool DataRecorder::recordWeaponReleased(const Basic::Object* objs[4], const doub
    const Simulation::Player* wpn = dynamic_cast<const Simulation::Player*>( objs[0] );
    if (wpn == nullptr) return false;
 
-   Pb::DataRecord* msg = new Pb::DataRecord();
+   Pb::DataRecord* msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -546,7 +562,7 @@ bool DataRecorder::recordWeaponHung(const Basic::Object* objs[4], const double v
    const Simulation::Player* wpn = dynamic_cast<const Simulation::Player*>( objs[0] );
    if (wpn == nullptr) return false;
 
-   Pb::DataRecord* msg = new Pb::DataRecord();
+   Pb::DataRecord* msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -589,7 +605,7 @@ bool DataRecorder::recordWeaponDetonation(const Basic::Object* objs[4], const do
    const unsigned int detType =  static_cast<unsigned int>(values[0]);
    const double missDist = values[1];
 
-   Pb::DataRecord* msg = new Pb::DataRecord();
+   Pb::DataRecord* msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -666,7 +682,7 @@ bool DataRecorder::recordGunFired(const Basic::Object* objs[4], const double val
    if (shooter == nullptr) return false;
 
    const unsigned int rounds = static_cast<unsigned int>(values[0]);
-   Pb::DataRecord* msg = new Pb::DataRecord();
+   Pb::DataRecord* msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -696,7 +712,7 @@ bool DataRecorder::recordNewTrack(const Basic::Object* objs[4], const double val
    if (player == nullptr || newTrack == nullptr) return false;
 
    // message
-   Pb::DataRecord* msg = new Pb::DataRecord();
+   Pb::DataRecord* msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -752,7 +768,7 @@ bool DataRecorder::recordTrackRemoved(const Basic::Object* objs[4], const double
    if (player == nullptr || track == nullptr) return false;
 
    // message
-   Pb::DataRecord* msg = new Pb::DataRecord();
+   Pb::DataRecord* msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -785,7 +801,7 @@ bool DataRecorder::recordTrackData(const Basic::Object* objs[4], const double va
    if (player == nullptr || trackData == nullptr) return false;
 
    // message
-   Pb::DataRecord* msg = new Pb::DataRecord();
+   Pb::DataRecord* msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -1032,12 +1048,105 @@ void DataRecorder::genEmissionData( Pb::EmissionData* const emMsg, const Simulat
 }
 
 
+//------------------------------------------------------------------------------
+// Allocate a new DataRecord from the current arena, or from the heap
+//------------------------------------------------------------------------------
+Pb::DataRecord* DataRecorder::newDataRecord()
+{
+   Pb::DataRecord* msg = nullptr;
+
+   if (recordsPerArena > 0 && RecordArena::isSupported()) {
+      lcLock(arenaLock);
+      if (arena == nullptr || arena->getNumRecords() >= recordsPerArena) retireArena();
+      if (arena != nullptr) {
+         msg = arena->createRecord();
+         arena->setNumPending(arena->getNumPending() + 1);
+      }
+      lcUnlock(arenaLock);
+   }
+
+   if (msg == nullptr) msg = new Pb::DataRecord();
+   return msg;
+}
+
+//------------------------------------------------------------------------------
+// Start a new arena (the arena lock is held).  The current arena is dropped
+// if it doesn't have any pending records, because its handles will release
+// it, or it's retired until its pending records have been sent.
+//------------------------------------------------------------------------------
+void DataRecorder::retireArena()
+{
+   // Drop the retired arenas that no longer have pending records
+   unsigned int n = 0;
+   for (unsigned int i = 0; i < numRetired; i++) {
+      if (retired[i]->getNumPending() == 0) retired[i]->unref();
+      else retired[n++] = retired[i];
+   }
+   for (unsigned int i = n; i < numRetired; i++) {
+      retired[i] = nullptr;
+   }
+   numRetired = n;
+
+   if (arena != nullptr) {
+      if (arena->getNumPending() == 0) arena->unref();
+      else if (numRetired < MAX_RETIRED_ARENAS) retired[numRetired++] = arena;
+      else return;   // No room; keep using the current arena
+   }
+
+   arena = new RecordArena(ARENA_BLOCK_SIZE);
+}
+
+//------------------------------------------------------------------------------
+// Returns the arena that the record was allocated from (ref()'d), or zero
+// if it was allocated on the heap, and removes the record from the arena's
+// pending records.
+//------------------------------------------------------------------------------
+RecordArena* DataRecorder::releaseArena(const Pb::DataRecord* const msg)
+{
+   RecordArena* owner = nullptr;
+
+   if (RecordArena::isSupported()) {
+      lcLock(arenaLock);
+      if (arena != nullptr && arena->isOwner(msg)) owner = arena;
+      for (unsigned int i = 0; i < numRetired && owner == nullptr; i++) {
+         if (retired[i]->isOwner(msg)) owner = retired[i];
+      }
+      if (owner != nullptr) {
+         owner->setNumPending(owner->getNumPending() - 1);
+         owner->ref();
+      }
+      lcUnlock(arenaLock);
+   }
+
+   return owner;
+}
+
+//------------------------------------------------------------------------------
+// Drop all of our arenas; they're released by their records' handles
+//------------------------------------------------------------------------------
+void DataRecorder::clearArenas()
+{
+   lcLock(arenaLock);
+   if (arena != nullptr) { arena->unref(); arena = nullptr; }
+   for (unsigned int i = 0; i < numRetired; i++) {
+      retired[i]->unref();
+      retired[i] = nullptr;
+   }
+   numRetired = 0;
+   lcUnlock(arenaLock);
+}
+
 //------------------------------------------------------------------------------
 // Time stamp and send the DataRecord to our output handler
 //------------------------------------------------------------------------------
 void DataRecorder::sendDataRecord(Pb::DataRecord* const msg)
 {
-   if (msg != nullptr && outputHandler != nullptr) {
+   if (msg == nullptr) return;
+
+   // The arena that the record was allocated from, if any
+   RecordArena* const owner = releaseArena(msg);
+
+   if (outputHandler != nullptr) {
 
       // If first pass, create and send a FILE ID msg
       if (isFirstPass()) {
@@ -1072,10 +1181,16 @@ void DataRecorder::sendDataRecord(Pb::DataRecord* const msg)
       }
 
       // Create a handle and send the message to be processed
-      DataRecordHandle* h = new DataRecordHandle(msg);
+      DataRecordHandle* h = new DataRecordHandle(msg, owner);
       outputHandler->addToQueue(h);
       h->unref();
    }
+   else if (owner == nullptr) {
+      // No one to send it to
+      delete msg;
+   }
+
+   if (owner != nullptr) owner->unref();
 }
 
 //------------------------------------------------------------------------------
@@ -1110,6 +1225,12 @@ void DataRecorder::setFirstPass(const bool f)
    firstPass = f;
 }
 
+bool DataRecorder::setRecordsPerArena(const unsigned int n)
+{
+   recordsPerArena = n;
+   return true;
+}
+
 bool DataRecorder::setOutputHandler(OutputHandler* const msg)
 {
    if (outputHandler != nullptr) outputHandler->unref();
@@ -1209,6 +1330,22 @@ bool DataRecorder::setSlotYear(Basic::Number* const msg)
    return ok;
 }
 
+bool DataRecorder::setSlotRecordsPerArena(const Basic::Number* const msg)
+{
+   bool ok = false;
+
+   if (msg != nullptr) {
+      const int n = msg->getInt();
+      if (n >= 0) {
+         ok = setRecordsPerArena( static_cast<unsigned int>(n) );
+      }
+      else {
+         std::cerr << "DataRecorder::setSlotRecordsPerArena(): invalid number of records: " << n << std::endl;
+      }
+   }
+   return ok;
+}
+
 //------------------------------------------------------------------------------
 // getSlotByIndex() for Component
 //------------------------------------------------------------------------------
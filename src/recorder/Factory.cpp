@@ -5,10 +5,13 @@
 
 #include "openeaagles/basic/Object.h"
 
+#include "openeaagles/recorder/ColumnReader.h"
+#include "openeaagles/recorder/ColumnWriter.h"
 #include "openeaagles/recorder/DataRecorder.h"
 #include "openeaagles/recorder/FileWriter.h"
 #include "openeaagles/recorder/FileReader.h"
 #include "openeaagles/recorder/OutputHandler.h"
+#include "openeaagles/recorder/ParallelReader.h"
 #include "openeaagles/recorder/NetInput.h"
 #include "openeaagles/recorder/NetOutput.h"
 #include "openeaagles/recorder/TabPrinter.h"
@@ -33,6 +36,15 @@ Basic::Object* Factory::createObj(const char* name)
     else if ( std::strcmp(name, FileReader::getFactoryName()) == 0 ) {
         obj = new FileReader();
     }
+    else if ( std::strcmp(name, ParallelReader::getFactoryName()) == 0 ) {
+        obj = new ParallelReader();
+    }
+    else if ( std::strcmp(name, ColumnWriter::getFactoryName()) == 0 ) {
+        obj = new ColumnWriter();
+    }
+    else if ( std::strcmp(name, ColumnReader::getFactoryName()) == 0 ) {
+        obj = new ColumnReader();
+    }
     else if ( std::strcmp(name, NetInput::getFactoryName()) == 0 ) {
         obj = new NetInput();
     }
@@ -2,7 +2,9 @@
 #include "openeaagles/recorder/FileReader.h"
 #include "openeaagles/recorder/protobuf/DataRecord.pb.h"
 #include "openeaagles/recorder/DataRecordHandle.h"
+#include "openeaagles/recorder/RecordIndex.h"
 #include "openeaagles/basic/String.h"
+#include "openeaagles/basic/units/Times.h"
 #include <fstream>
 #include <cstdlib>
 
@@ -20,16 +22,20 @@ namespace Recorder {
 //==============================================================================
 IMPLEMENT_SUBCLASS(FileReader,"RecorderFileReader")
 
+const double FileReader::DEFAULT_INDEX_INTERVAL = 1.0;
+
 // Slot table for this form type
 BEGIN_SLOTTABLE(FileReader)
     "filename",         // 1) Data file name
     "pathname",         // 2) Path to the data file directory (optional)
+    "startTime",        // 3) Exec time of the first record to read (optional)
 END_SLOTTABLE(FileReader)
 
 // Map slot table to handles
 BEGIN_SLOT_MAP(FileReader)
     ON_SLOT( 1, setFilename, Basic::String)
     ON_SLOT( 2, setPathName, Basic::String)
+    ON_SLOT( 3, setSlotStartTime, Basic::Time)
 END_SLOT_MAP()
 
 //------------------------------------------------------------------------------
@@ -44,6 +50,14 @@ FileReader::FileReader()
 void FileReader::initData()
 {
    ibuf = new char[MAX_INPUT_BUFFER_SIZE];
+   ibufSize = MAX_INPUT_BUFFER_SIZE;
+   version = 1;
+   dataOffset = 0;
+   index = nullptr;
+   indexFilename.clear();
+   scanRecord = nullptr;
+   startTime = 0;
+   startTimeFlg = false;
    sin = nullptr;
    filename = nullptr;
    pathname = nullptr;
@@ -71,6 +85,10 @@ void FileReader::copyData(const FileReader& org, const bool cc)
    fileOpened = false;
    fileFailed = false;
    firstPassFlg = true;
+
+   if (index != nullptr) { index->unref(); index = nullptr; }
+   startTime = org.startTime;
+   startTimeFlg = org.startTimeFlg;
 }
 
 //------------------------------------------------------------------------------
@@ -88,6 +106,10 @@ void FileReader::deleteData()
    setPathName(nullptr);
 
    if (ibuf != nullptr) { delete[] ibuf; ibuf = nullptr; }
+   ibufSize = 0;
+
+   if (index != nullptr) { index->unref(); index = nullptr; }
+   if (scanRecord != nullptr) { delete scanRecord; scanRecord = nullptr; }
 }
 
 
@@ -104,6 +126,11 @@ bool FileReader::isFailed() const
    return fileFailed || (sin != nullptr && sin->fail());
 }
 
+unsigned int FileReader::getVersion() const
+{
+   return version;
+}
+
 
 //------------------------------------------------------------------------------
 // Open the data file
@@ -181,6 +208,28 @@ bool FileReader::openFile()
             tFailed = true;
          }
 
+         //---
+         // Indexed file header?  Otherwise, it's a sequential file
+         //---
+         else {
+            char header[RecordIndex::HEADER_SIZE];
+            sin->read(header, RecordIndex::HEADER_SIZE);
+            if (!sin->fail() && RecordIndex::isHeader(header)) {
+               version = RecordIndex::VERSION;
+               dataOffset = RecordIndex::HEADER_SIZE;
+            }
+            else {
+               version = 1;
+               dataOffset = 0;
+            }
+            sin->clear();
+            sin->seekg(static_cast<std::streamoff>(dataOffset), std::ios_base::beg);
+
+            // We'll need a new index
+            if (index != nullptr) { index->unref(); index = nullptr; }
+            indexFilename = RecordIndex::getIndexFilename(fullname);
+         }
+
       }
 
       delete[] fullname;
@@ -217,43 +266,109 @@ const DataRecordHandle* FileReader::readRecordImp()
          openFile();
       }
       firstPassFlg = false;
+
+      // Start time?
+      if (startTimeFlg && isOpen()) {
+         double t = startTime;
+         double first = 0;
+         double last = 0;
+         if (t < 0 && getTimeSpan(&first, &last)) t += last;
+         seekTime(t);
+      }
+   }
+
+   // ---
+   // Read the serialized DataRecord from the file, parse it as a DataRecord
+   // and put it into a Handle.
+   // ---
+   const unsigned int n = readData();
+   if (n > 0) {
+
+      // Parse the DataRecord
+      Pb::DataRecord* dataRecord = new Pb::DataRecord();
+      bool ok = dataRecord->ParseFromArray(ibuf, n);
+
+      // Create a handle for the DataRecord (it now has ownership)
+      if (ok) {
+         handle = new DataRecordHandle(dataRecord);
+      }
+
+      // parsing error
+      else {
+         if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+            std::cerr << "FileReader::readRecord() -- ParseFromArray() error" << std::endl;
+         }
+         delete dataRecord;
+         dataRecord = nullptr;
+      }
    }
 
+   return handle;
+}
+
+//------------------------------------------------------------------------------
+// Reads the next serialized DataRecord into the input buffer, and returns its
+// size, or zero at the end of the records, or on error.
+//------------------------------------------------------------------------------
+unsigned int FileReader::readData()
+{
+   // Number of bytes in the next serialized DataRecord
+   unsigned int n = 0;
 
    // When the file is open and ready ...
    if ( isOpen() && !isFailed() && !sin->eof() ) {
 
-      // Number of bytes in the next serialized DataRecord
-      unsigned int n = 0;
-
       // ---
       // Read the size of the next serialized DataRecord
       // ---
-      char nbuff[8];
-      sin->read(nbuff, 4);
-
-      // Check for error or eof
-      if ( sin->eof() || sin->fail() ) {
-         fileFailed = sin->fail();
-         if (fileFailed && isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
-            std::cerr << "FileReader::readRecord() -- error reading data record size" << std::endl;
+      if (version >= RecordIndex::VERSION) {
+         // Binary varint; a zero size is the end of the records
+         unsigned long long size = 0;
+         if (RecordIndex::getVarint(*sin, &size) && size < 0x7fffffff) {
+            n = static_cast<unsigned int>(size);
+
+            // Skip the index at the end of the records
+            if (n == 0) sin->seekg(0, std::ios_base::end);
+         }
+         else if (!sin->eof()) {
+            if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+               std::cerr << "FileReader::readRecord() -- error reading data record size" << std::endl;
+            }
+            fileFailed = true;
          }
       }
-
-      // Ok then get the size of the message from the buffer
       else {
-         nbuff[4] = '\0';
-         n = std::atoi(nbuff);
-      }
+         // Ascii string with leading spaces
+         char nbuff[8];
+         sin->read(nbuff, 4);
 
+         // Check for error or eof (a clean end of file isn't an error)
+         if ( sin->eof() || sin->fail() ) {
+            fileFailed = (sin->fail() && !(sin->eof() && sin->gcount() == 0));
+            if (fileFailed && isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+               std::cerr << "FileReader::readRecord() -- error reading data record size" << std::endl;
+            }
+         }
+
+         // Ok then get the size of the message from the buffer
+         else {
+            nbuff[4] = '\0';
+            n = std::atoi(nbuff);
+         }
+      }
 
       // ---
-      // Read the serialized DataRecord from the file, parse it as a DataRecord
-      // and put it into a Handle.
+      // Read the serialized DataRecord into ibuf
       // ---
       if (n > 0) {
 
-         // Read message into ibuf
+         // Make sure it fits
+         if (n > ibufSize) {
+            delete[] ibuf;
+            ibufSize = n;
+            ibuf = new char[ibufSize];
+         }
+
          sin->read(ibuf, n);
 
          // Check for error or eof
@@ -262,36 +377,244 @@ const DataRecordHandle* FileReader::readRecordImp()
                std::cerr << "FileReader::readRecord() -- error reading data record" << std::endl;
             }
             fileFailed = true;
+            n = 0;
          }
+      }
 
-         // Ok, create the DataRecord with handle
-         else {
+   }
+
+   return n;
+}
 
-            // Parse the DataRecord
-            std::string wireFormat(ibuf, n);
-            Pb::DataRecord* dataRecord = new Pb::DataRecord();
-            bool ok = dataRecord->ParseFromString(wireFormat);
+//------------------------------------------------------------------------------
+// Seek to the first record at or after the exec time 'execTime'
+//------------------------------------------------------------------------------
+bool FileReader::seekTime(const double execTime)
+{
+   bool ok = false;
+   if (loadIndex()) {
+      const std::streamoff pos = sin->tellg();
+
+      // Scan the interval that contains 'execTime' ...
+      const int i = index->findInterval(execTime);
+      const int j = index->findNextInterval(i);
+      const unsigned long long start = (i >= 0 ? index->getEntry(i)->offset : dataOffset);
+      const unsigned long long end = (j >= 0 ? index->getEntry(j)->offset : 0);
+      ok = scanRecords(start, end, ANY_ID, execTime);
+
+      // ... otherwise, it's the start of the next interval
+      if (!ok && j >= 0) {
+         seekOffset(index->getEntry(j)->offset);
+         ok = true;
+      }
 
-            // Create a handle for the DataRecord (it now has ownership)
-            if (ok) {
-               handle = new DataRecordHandle(dataRecord);
-            }
+      // Not found; back to where we were
+      if (!ok) seekOffset(static_cast<unsigned long long>(pos));
+   }
+   return ok;
+}
 
-            // parsing error
-            else if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
-               std::cerr << "FileReader::readRecord() -- ParseFromString() error" << std::endl;
-               delete dataRecord;
-               dataRecord = nullptr;
-            }
+//------------------------------------------------------------------------------
+// Seek to the first record with id 'id' at or after the exec time 'execTime'
+//------------------------------------------------------------------------------
+bool FileReader::seekRecord(const unsigned int id, const double execTime)
+{
+   bool ok = false;
+   if (loadIndex()) {
+      const std::streamoff pos = sin->tellg();
+
+      // Scan the interval that contains 'execTime' ...
+      const int i = index->findInterval(execTime);
+      const int j = index->findNextInterval(i);
+      const unsigned long long start = (i >= 0 ? index->getEntry(i)->offset : dataOffset);
+      const unsigned long long end = (j >= 0 ? index->getEntry(j)->offset : 0);
+      ok = scanRecords(start, end, id, execTime);
+
+      // ... otherwise, it's the first indexed record of this id in a later interval
+      if (!ok) {
+         const int k = index->findRecord(id, execTime);
+         if (k >= 0) {
+            seekOffset(index->getEntry(k)->offset);
+            ok = true;
+         }
+      }
+
+      // Not found; back to where we were
+      if (!ok) seekOffset(static_cast<unsigned long long>(pos));
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Exec times of the first and last records
+//------------------------------------------------------------------------------
+bool FileReader::getTimeSpan(double* const first, double* const last)
+{
+   bool ok = false;
+   if (loadIndex() && index->getNumEntries() > 0) {
+      if (first != nullptr) *first = index->getEntry(0)->execTime;
+      if (last != nullptr) {
+         // The last indexed record isn't the last record, so read the records
+         // from the last index entry to the end of the records
+         const RecordIndex::Entry* const e = index->getEntry(index->getNumEntries() - 1);
+         const std::streamoff pos = sin->tellg();
+         if (scanRecord == nullptr) scanRecord = new Pb::DataRecord();
+
+         double t = e->execTime;
+         seekOffset(e->offset);
+         unsigned int n = readData();
+         while (n > 0) {
+            if (scanRecord->ParseFromArray(ibuf, n)) t = scanRecord->time().exec_time();
+            n = readData();
          }
+         *last = t;
 
+         // Back to where we were
+         seekOffset(static_cast<unsigned long long>(pos));
       }
+      ok = true;
+   }
+   return ok;
+}
 
+//------------------------------------------------------------------------------
+// The file's index
+//------------------------------------------------------------------------------
+const RecordIndex* FileReader::getIndex()
+{
+   return (loadIndex() ? index : nullptr);
+}
+
+//------------------------------------------------------------------------------
+// File offset of the next record
+//------------------------------------------------------------------------------
+unsigned long long FileReader::getOffset() const
+{
+   unsigned long long offset = 0;
+   if (isOpen()) {
+      const std::streamoff pos = sin->tellg();
+      if (pos > 0) offset = static_cast<unsigned long long>(pos);
    }
+   return offset;
+}
 
-   return handle;
+//------------------------------------------------------------------------------
+// Positions the file at the record at file offset 'offset'
+//------------------------------------------------------------------------------
+bool FileReader::setOffset(const unsigned long long offset)
+{
+   if ( !isOpen() && !isFailed() ) {
+      openFile();
+   }
+   firstPassFlg = false;
+   if ( !isOpen() ) return false;
+
+   seekOffset(offset);
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Loads the file's index, or builds it by reading the whole file
+//------------------------------------------------------------------------------
+bool FileReader::loadIndex()
+{
+   if (index != nullptr) return true;
+
+   if ( !isOpen() && !isFailed() ) {
+      openFile();
+      firstPassFlg = false;
+   }
+   if ( !isOpen() ) return false;
+
+   const std::streamoff pos = sin->tellg();
+   index = new RecordIndex();
+
+   // Indexed file with its index
+   bool ok = (version >= RecordIndex::VERSION && index->read(*sin));
+
+   // Indexed file that wasn't closed: use the blocks of its index file, and
+   // read the records after the last block
+   unsigned long long offset = dataOffset;
+   if (!ok && version >= RecordIndex::VERSION && !indexFilename.empty()) {
+      std::ifstream isin(indexFilename.c_str(), std::ios_base::in | std::ios_base::binary);
+      unsigned long long end = 0;
+      sin->clear();
+      sin->seekg(0, std::ios_base::end);
+      const std::streamoff size = sin->tellg();
+      if (isin.is_open() && index->readBlocks(isin, &end) && end >= dataOffset && size >= 0 && end <= static_cast<unsigned long long>(size)) {
+         if (isMessageEnabled(MSG_INFO)) {
+            std::cout << "FileReader::loadIndex(): no index; using the index file, and reading the records after it" << std::endl;
+         }
+         offset = end;
+      }
+      else index->clear();
+   }
+
+   // Otherwise, read the whole file (or the records after the index file's blocks)
+   if (!ok) {
+      if (offset == dataOffset && isMessageEnabled(MSG_INFO)) {
+         std::cout << "FileReader::loadIndex(): no index; reading the data file to build one" << std::endl;
+      }
+      if (scanRecord == nullptr) scanRecord = new Pb::DataRecord();
+
+      seekOffset(offset);
+      unsigned int n = readData();
+      while (n > 0) {
+         if (scanRecord->ParseFromArray(ibuf, n)) {
+            const Pb::Time& time = scanRecord->time();
+            index->addRecord(time.sim_time(), time.exec_time(), scanRecord->id(), offset, DEFAULT_INDEX_INTERVAL);
+         }
+         offset = static_cast<unsigned long long>(sin->tellg());
+         n = readData();
+      }
+      ok = true;
+   }
+
+   // Back to where we were
+   seekOffset(static_cast<unsigned long long>(pos));
+
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Scans the records from file offset 'start' up to 'end' (or to the end of
+// the records, if 'end' is zero) for the first record with id 'id' (or any id)
+// at or after 'execTime', and leaves the file positioned at that record.
+//------------------------------------------------------------------------------
+bool FileReader::scanRecords(
+      const unsigned long long start,
+      const unsigned long long end,
+      const unsigned int id,
+      const double execTime)
+{
+   if (scanRecord == nullptr) scanRecord = new Pb::DataRecord();
+
+   seekOffset(start);
+
+   bool found = false;
+   unsigned long long offset = start;
+   while (!found && (end == 0 || offset < end)) {
+      const unsigned int n = readData();
+      if (n == 0) break;
+      if (scanRecord->ParseFromArray(ibuf, n)) {
+         found = (scanRecord->time().exec_time() >= execTime) && (id == ANY_ID || scanRecord->id() == id);
+      }
+      if (found) seekOffset(offset);
+      else offset = static_cast<unsigned long long>(sin->tellg());
+   }
+
+   return found;
 }
 
+//------------------------------------------------------------------------------
+// Positions the file at 'offset'
+//------------------------------------------------------------------------------
+void FileReader::seekOffset(const unsigned long long offset)
+{
+   fileFailed = false;
+   sin->clear();
+   sin->seekg(static_cast<std::streamoff>(offset), std::ios_base::beg);
+}
 
 //------------------------------------------------------------------------------
 // Set functions
@@ -312,6 +635,22 @@ bool FileReader::setPathName(const Basic::String* const msg)
    return true;
 }
 
+bool FileReader::setStartTime(const double sec)
+{
+   startTime = sec;
+   startTimeFlg = true;
+   return true;
+}
+
+bool FileReader::setSlotStartTime(const Basic::Time* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setStartTime( Basic::Seconds::convertStatic(*msg) );
+   }
+   return ok;
+}
+
 //------------------------------------------------------------------------------
 // getSlotByIndex() for Component
 //------------------------------------------------------------------------------
@@ -344,6 +683,12 @@ std::ostream& FileReader::serialize(std::ostream& sout, const int i, const bool
       sout << "pathname: \"" << *pathname << "\"" << std::endl;
    }
 
+   // Start time
+   if (startTimeFlg) {
+      indent(sout,i+j);
+      sout << "startTime: ( Seconds " << startTime << " )" << std::endl;
+   }
+
    if ( !slotsOnly ) {
       indent(sout,i);
       sout << ")" << std::endl;
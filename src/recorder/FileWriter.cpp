@@ -2,9 +2,13 @@
 #include "openeaagles/recorder/FileWriter.h"
 #include "openeaagles/recorder/protobuf/DataRecord.pb.h"
 #include "openeaagles/recorder/DataRecordHandle.h"
+#include "openeaagles/recorder/RecordIndex.h"
 
+#include "openeaagles/basic/Number.h"
 #include "openeaagles/basic/String.h"
+#include "openeaagles/basic/units/Times.h"
 #include <fstream>
+#include <cstdio>
 #include <cstring>
 
 // Disable all deprecation warnings for now.  Until we fix them,
@@ -25,12 +29,20 @@ IMPLEMENT_SUBCLASS(FileWriter,"RecorderFileWriter")
 BEGIN_SLOTTABLE(FileWriter)
     "filename",         // 1) Data file name (required)
     "pathname",         // 2) Path to the data file directory (optional)
+    "bufferSize",       // 3) Size of the write buffer (bytes)
+    "version",          // 4) Data file version
+    "indexInterval",    // 5) Exec time between index intervals
+    "indexFileInterval",// 6) Exec time between index file blocks
 END_SLOTTABLE(FileWriter)
 
 // Map slot table to handles
 BEGIN_SLOT_MAP(FileWriter)
     ON_SLOT( 1, setFilename, Basic::String)
     ON_SLOT( 2, setPathName, Basic::String)
+    ON_SLOT( 3, setSlotBufferSize, Basic::Number)
+    ON_SLOT( 4, setSlotVersion, Basic::Number)
+    ON_SLOT( 5, setSlotIndexInterval, Basic::Time)
+    ON_SLOT( 6, setSlotIndexFileInterval, Basic::Time)
 END_SLOT_MAP()
 
 //------------------------------------------------------------------------------
@@ -51,6 +63,20 @@ void FileWriter::initData()
    fileOpened = false;
    fileFailed = false;
    eodFlag    = false;
+
+   buffer = nullptr;
+   bufferSize = DEFAULT_BUFFER_SIZE;
+   bufferLen = 0;
+   fileOffset = 0;
+
+   version = RecordIndex::VERSION;
+   indexInterval = 1.0;
+   index = nullptr;
+
+   isout = nullptr;
+   indexFileInterval = 10.0;
+   indexFileTime = -1.0;
+   indexFileEntries = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -63,13 +89,21 @@ void FileWriter::copyData(const FileWriter& org, const bool cc)
 
    setFilename(org.filename);
    setPathName(org.pathname);
+   setBufferSize(org.bufferSize);
+   setVersion(org.version);
+   setIndexInterval(org.indexInterval);
+   setIndexFileInterval(org.indexFileInterval);
 
    // Need to re-open the file
    if (sout != nullptr) {
-      if (isOpen()) sout->close();
+      if (isOpen()) {
+         flushBuffer();
+         sout->close();
+      }
       delete sout;
    }
    sout = nullptr;
+   closeIndexFile();
    fileOpened = false;
    fileFailed = false;
    eodFlag    = false;
@@ -82,11 +116,23 @@ void FileWriter::copyData(const FileWriter& org, const bool cc)
 void FileWriter::deleteData()
 {
    if (sout != nullptr) {
-      if (isOpen()) sout->close();
+      if (isOpen()) {
+         flushBuffer();
+         sout->close();
+      }
       delete sout;
    }
    sout = nullptr;
 
+   // The data file wasn't closed with its index, so keep the index file
+   closeIndexFile();
+   if (isout != nullptr) { delete isout; isout = nullptr; }
+
+   if (buffer != nullptr) { delete[] buffer; buffer = nullptr; }
+   bufferLen = 0;
+
+   if (index != nullptr) { index->unref(); index = nullptr; }
+
    setFilename(nullptr);
    setPathName(nullptr);
 }
@@ -97,10 +143,14 @@ void FileWriter::deleteData()
 //------------------------------------------------------------------------------
 bool FileWriter::shutdownNotification()
 {
+   // Our base class stops the writer thread and processes the
+   // records that are left in the queue, so it goes first
+   const bool ok = BaseClass::shutdownNotification();
+
    // Close the file, if it's still open
    if (isOpen()) closeFile();
 
-   return BaseClass::shutdownNotification();
+   return ok;
 }
 
 
@@ -134,6 +184,30 @@ const char* FileWriter::getFilename() const
    return p;
 }
 
+// Size of the write buffer (bytes)
+unsigned int FileWriter::getBufferSize() const
+{
+   return bufferSize;
+}
+
+// Data file version
+unsigned int FileWriter::getVersion() const
+{
+   return version;
+}
+
+// Exec time between index intervals (sec)
+double FileWriter::getIndexInterval() const
+{
+   return indexInterval;
+}
+
+// Exec time between index file blocks (sec)
+double FileWriter::getIndexFileInterval() const
+{
+   return indexFileInterval;
+}
+
 // Path to file
 const char* FileWriter::getPathname() const
 {
@@ -256,6 +330,23 @@ bool FileWriter::openFile()
 
    fileOpened = tOpened;
    fileFailed = tFailed;
+
+   //---
+   // Start a new index and write the header of an indexed file
+   //---
+   fileOffset = 0;
+   bufferLen = 0;
+   if (fileOpened && version >= RecordIndex::VERSION) {
+      if (index == nullptr) index = new RecordIndex();
+      index->clear();
+
+      char header[RecordIndex::HEADER_SIZE];
+      RecordIndex::encodeHeader(header);
+      writeData(header, RecordIndex::HEADER_SIZE);
+
+      openIndexFile();
+   }
+
    return fileOpened;
 }
 
@@ -294,11 +385,21 @@ void FileWriter::closeFile()
          handle = nullptr;
       }
 
-      // now close the file
+      // write the index of an indexed file
+      if (version >= RecordIndex::VERSION) writeIndex();
+
+      // now flush our buffer and close the file
+      flushBuffer();
       sout->close();
       fileOpened = false;
       fileFailed = false;
 
+      // the data file has its own index, so we're done with the index file
+      if (isout != nullptr && isout->is_open()) {
+         closeIndexFile();
+         std::remove( RecordIndex::getIndexFilename(fullFilename).c_str() );
+      }
+
    }
 }
 
@@ -324,12 +425,41 @@ void FileWriter::processRecordImp(const DataRecordHandle* const handle)
       // The DataRecord to be sent
       const Pb::DataRecord* dataRecord = handle->getRecord();
 
-      // Serialize the DataRecord
-      std::string wireFormat;
+      // Serialize the DataRecord (reusing our string's memory)
       bool ok = dataRecord->SerializeToString(&wireFormat);
 
-      // Write the serialized DataRecord with its length to the file
-      if (ok) {
+      // Write the serialized DataRecord with its length to the file (indexed file)
+      if (ok && version >= RecordIndex::VERSION) {
+         const unsigned int n = static_cast<unsigned int>(wireFormat.length());
+
+         // Index the record, then write its size as a varint
+         const Pb::Time& time = dataRecord->time();
+         if (index != nullptr) {
+            index->addRecord(time.sim_time(), time.exec_time(), dataRecord->id(), fileOffset, indexInterval);
+         }
+         char nbuff[RecordIndex::MAX_VARINT_SIZE];
+         writeData(nbuff, RecordIndex::putVarint(nbuff, n));
+
+         // Write the serialized DataRecord
+         writeData( wireFormat.c_str(), n );
+
+         // Time for the next index file block?
+         if (indexFileTime < 0) indexFileTime = time.exec_time();
+         else if (time.exec_time() >= (indexFileTime + indexFileInterval)) {
+            indexFileTime = time.exec_time();
+            writeIndexBlock();
+         }
+      }
+
+      // Write the serialized DataRecord with its length to the file (sequential file)
+      else if (ok && wireFormat.length() > 9999) {
+         if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+            std::cerr << "FileWriter::processRecordImp() -- data record is too large for a version 1 file: ";
+            std::cerr << wireFormat.length() << " bytes" << std::endl;
+         }
+      }
+
+      else if (ok) {
          unsigned int n = wireFormat.length();
 
          // Convert size to an integer string
@@ -348,10 +478,10 @@ void FileWriter::processRecordImp(const DataRecordHandle* const handle)
          }
 
          // Write the size of the serialized DataRecord as an ascii string
-         sout->write(nbuff, 4);
+         writeData(nbuff, 4);
 
          // Write the serialized DataRecord
-         sout->write( wireFormat.c_str(), n );
+         writeData( wireFormat.c_str(), n );
       }
 
       else if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
@@ -374,6 +504,109 @@ void FileWriter::processRecordImp(const DataRecordHandle* const handle)
 }
 
 
+//------------------------------------------------------------------------------
+// Adds data to the write buffer; the buffer is written to the file when it's
+// full.  Without a buffer, or if the data is larger than the buffer, the
+// data is written directly to the file.
+//------------------------------------------------------------------------------
+void FileWriter::writeData(const char* const data, const unsigned int n)
+{
+   if (bufferSize > 0 && buffer == nullptr) {
+      buffer = new char[bufferSize];
+      bufferLen = 0;
+   }
+
+   if (bufferLen + n > bufferSize) flushBuffer();
+
+   if (buffer == nullptr || n > bufferSize) sout->write(data, n);
+   else {
+      std::memcpy(&buffer[bufferLen], data, n);
+      bufferLen += n;
+   }
+   fileOffset += n;
+}
+
+//------------------------------------------------------------------------------
+// Writes the end of records marker, the index and the trailer
+//------------------------------------------------------------------------------
+void FileWriter::writeIndex()
+{
+   // End of records (a zero size)
+   char marker[RecordIndex::MAX_VARINT_SIZE];
+   writeData(marker, RecordIndex::putVarint(marker, 0));
+
+   // Index and trailer
+   if (index == nullptr) index = new RecordIndex();
+   char* ibuff = new char[index->getNumEntries() * RecordIndex::ENTRY_SIZE + RecordIndex::TRAILER_SIZE];
+   const unsigned int len = index->encode(ibuff, fileOffset);
+   writeData(ibuff, len);
+   delete[] ibuff;
+}
+
+//------------------------------------------------------------------------------
+// Opens (creates) the index file of the data file that's just been opened
+//------------------------------------------------------------------------------
+void FileWriter::openIndexFile()
+{
+   closeIndexFile();
+   indexFileTime = -1.0;
+   indexFileEntries = 0;
+
+   if (indexFileInterval > 0 && fullFilename != nullptr) {
+      if (isout == nullptr) isout = new std::ofstream();
+
+      const std::string name = RecordIndex::getIndexFilename(fullFilename);
+      isout->open(name.c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+      if (isout->fail()) {
+         if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
+            std::cerr << "FileWriter::openIndexFile(): Failed to open index file: " << name << std::endl;
+         }
+         isout->close();
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Appends a block of the index entries added since the last block to the
+// index file.  The records are written to the data file first, so the block
+// never indexes records that aren't in the data file.
+//------------------------------------------------------------------------------
+void FileWriter::writeIndexBlock()
+{
+   if (isout != nullptr && isout->is_open() && index != nullptr) {
+      flushBuffer();
+      sout->flush();
+
+      const unsigned int n = index->getNumEntries() - indexFileEntries;
+      char* ibuff = new char[n * RecordIndex::ENTRY_SIZE + RecordIndex::BLOCK_HEADER_SIZE + RecordIndex::TRAILER_SIZE];
+      const unsigned int len = index->encodeBlock(ibuff, indexFileEntries, fileOffset);
+      isout->write(ibuff, len);
+      isout->flush();
+      delete[] ibuff;
+
+      indexFileEntries = index->getNumEntries();
+   }
+}
+
+//------------------------------------------------------------------------------
+// Closes the index file
+//------------------------------------------------------------------------------
+void FileWriter::closeIndexFile()
+{
+   if (isout != nullptr && isout->is_open()) isout->close();
+}
+
+//------------------------------------------------------------------------------
+// Writes the contents of the write buffer to the file
+//------------------------------------------------------------------------------
+void FileWriter::flushBuffer()
+{
+   if (bufferLen > 0) {
+      if (sout != nullptr) sout->write(buffer, bufferLen);
+      bufferLen = 0;
+   }
+}
+
 //------------------------------------------------------------------------------
 // Set functions
 //------------------------------------------------------------------------------
@@ -407,6 +640,98 @@ bool FileWriter::setPathName(const Basic::String* const msg)
    return true;
 }
 
+bool FileWriter::setBufferSize(const unsigned int size)
+{
+   // Write out what we have, and let writeData() allocate the new buffer
+   flushBuffer();
+   if (buffer != nullptr) { delete[] buffer; buffer = nullptr; }
+   bufferSize = size;
+
+   return true;
+}
+
+bool FileWriter::setVersion(const unsigned int v)
+{
+   bool ok = false;
+   if (v >= 1 && v <= RecordIndex::VERSION) {
+      version = v;
+      ok = true;
+   }
+   return ok;
+}
+
+bool FileWriter::setIndexInterval(const double sec)
+{
+   bool ok = false;
+   if (sec > 0) {
+      indexInterval = sec;
+      ok = true;
+   }
+   return ok;
+}
+
+bool FileWriter::setIndexFileInterval(const double sec)
+{
+   bool ok = false;
+   if (sec >= 0) {
+      indexFileInterval = sec;
+      ok = true;
+   }
+   return ok;
+}
+
+bool FileWriter::setSlotVersion(const Basic::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int v = msg->getInt();
+      if (v >= 0) ok = setVersion( static_cast<unsigned int>(v) );
+      if (!ok) {
+         std::cerr << "FileWriter::setSlotVersion(): invalid version: " << v << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool FileWriter::setSlotIndexInterval(const Basic::Time* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setIndexInterval( Basic::Seconds::convertStatic(*msg) );
+      if (!ok) {
+         std::cerr << "FileWriter::setSlotIndexInterval(): invalid time; must be greater than zero" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool FileWriter::setSlotIndexFileInterval(const Basic::Time* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setIndexFileInterval( Basic::Seconds::convertStatic(*msg) );
+      if (!ok) {
+         std::cerr << "FileWriter::setSlotIndexFileInterval(): invalid time; must not be negative" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool FileWriter::setSlotBufferSize(const Basic::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int size = msg->getInt();
+      if (size >= 0) {
+         ok = setBufferSize( static_cast<unsigned int>(size) );
+      }
+      else {
+         std::cerr << "FileWriter::setSlotBufferSize(): invalid buffer size: " << size << std::endl;
+      }
+   }
+   return ok;
+}
+
 //------------------------------------------------------------------------------
 // getSlotByIndex() for Component
 //------------------------------------------------------------------------------
@@ -439,6 +764,20 @@ std::ostream& FileWriter::serialize(std::ostream& sout, const int i, const bool
         sout << "pathname: \"" << *pathname << "\"" << std::endl;
     }
 
+    // Write buffer size
+    indent(sout,i+j);
+    sout << "bufferSize: " << bufferSize << std::endl;
+
+    // Data file version and index interval
+    indent(sout,i+j);
+    sout << "version: " << version << std::endl;
+
+    indent(sout,i+j);
+    sout << "indexInterval: ( Seconds " << indexInterval << " )" << std::endl;
+
+    indent(sout,i+j);
+    sout << "indexFileInterval: ( Seconds " << indexFileInterval << " )" << std::endl;
+
     if ( !slotsOnly ) {
         indent(sout,i);
         sout << ")" << std::endl;
@@ -3,19 +3,44 @@
 #include "openeaagles/recorder/DataRecordHandle.h"
 #include "openeaagles/recorder/protobuf/DataRecord.pb.h"
 
+#include "openeaagles/basic/Number.h"
 #include "openeaagles/basic/Pair.h"
 #include "openeaagles/basic/PairStream.h"
+#include "openeaagles/basic/Thread.h"
 
 namespace Eaagles {
 namespace Recorder {
 
+// ---
+// Writer thread
+// ---
+class WriterThread : public Basic::ThreadPeriodicTask {
+   DECLARE_SUBCLASS(WriterThread,Basic::ThreadPeriodicTask)
+   public: WriterThread(Basic::Component* const parent, const LCreal priority, const LCreal rate);
+   private: virtual unsigned long userFunc(const LCreal dt);
+};
+
 //==============================================================================
 // Class OutputHandler
 //==============================================================================
 IMPLEMENT_SUBCLASS(OutputHandler,"RecorderOutputHandler")
-EMPTY_SLOTTABLE(OutputHandler)
 EMPTY_SERIALIZER(OutputHandler)
 
+const LCreal OutputHandler::DEFAULT_WRITER_PRI = 0.5;
+
+//------------------------------------------------------------------------------
+// Slot table
+//------------------------------------------------------------------------------
+BEGIN_SLOTTABLE(OutputHandler)
+   "writerRate",        // 1) Writer thread rate (Hz) (default: no writer thread)
+   "writerPriority",    // 2) Writer thread priority (0.0 to 1.0)
+END_SLOTTABLE(OutputHandler)
+
+BEGIN_SLOT_MAP(OutputHandler)
+   ON_SLOT( 1, setSlotWriterRate,     Basic::Number)
+   ON_SLOT( 2, setSlotWriterPriority, Basic::Number)
+END_SLOT_MAP()
+
 //------------------------------------------------------------------------------
 // Constructor
 //------------------------------------------------------------------------------
@@ -27,7 +52,22 @@ OutputHandler::OutputHandler():semaphore(0)
 
 void OutputHandler::initData()
 {
+   ring = new QueueSlot[QUEUE_SIZE];
+   for (unsigned int i = 0; i < QUEUE_SIZE; i++) {
+      ring[i].seq.store(i, std::memory_order_relaxed);
+      ring[i].handle = nullptr;
+   }
+   ringHead.store(0);
+   ringTail = 0;
+
+   numOverflow.store(0);
    semaphore = 0;
+   consumer = 0;
+
+   writerRate = 0;
+   writerPriority = DEFAULT_WRITER_PRI;
+   writer = nullptr;
+   writerStopped.store(false);
 }
 
 //------------------------------------------------------------------------------
@@ -39,9 +79,10 @@ void OutputHandler::copyData(const OutputHandler& org, const bool cc)
    if (cc) initData();
 
    // Don't copy the queue
-   lcLock(semaphore);
-   queue.clear();
-   lcUnlock(semaphore);
+   emptyQueue(false);
+
+   writerRate = org.writerRate;
+   writerPriority = org.writerPriority;
 }
 
 //------------------------------------------------------------------------------
@@ -50,9 +91,14 @@ void OutputHandler::copyData(const OutputHandler& org, const bool cc)
 void OutputHandler::deleteData()
 {
    // clear the queue
-   lcLock(semaphore);
-   queue.clear();
-   lcUnlock(semaphore);
+   emptyQueue(false);
+
+   if (ring != nullptr) {
+      delete[] ring;
+      ring = nullptr;
+   }
+
+   writer = nullptr;
 }
 
 
@@ -61,6 +107,10 @@ void OutputHandler::deleteData()
 //------------------------------------------------------------------------------
 bool OutputHandler::shutdownNotification()
 {
+   // Stop our writer thread and process what's left in the queue
+   stopWriterThread();
+   emptyQueue(true);
+
    // Pass the shutdown notification to our subcomponent recorders
    Basic::PairStream* subcomponents = getComponents();
    if (subcomponents != nullptr) {
@@ -114,10 +164,22 @@ void OutputHandler::processRecord(const DataRecordHandle* const dataRecord)
 void OutputHandler::addToQueue(const DataRecordHandle* const dataRecord)
 {
    if (dataRecord != nullptr) {
-      lcLock( semaphore );
-      // const cast away to put into the queue
-      queue.put( const_cast<DataRecordHandle*>(static_cast<const DataRecordHandle*>(dataRecord)) );
-      lcUnlock( semaphore );
+      dataRecord->ref();
+
+      // Use the ring buffer unless we've already overflowed it
+      bool ok = false;
+      if (numOverflow.load(std::memory_order_acquire) == 0) {
+         ok = putQueue(dataRecord);
+      }
+
+      if (!ok) {
+         lcLock( semaphore );
+         // const cast away to put into the queue
+         queue.put( const_cast<DataRecordHandle*>(static_cast<const DataRecordHandle*>(dataRecord)) );
+         numOverflow.fetch_add(1, std::memory_order_release);
+         lcUnlock( semaphore );
+         dataRecord->unref();    // the list has its own reference
+      }
    }
 }
 
@@ -127,24 +189,200 @@ void OutputHandler::addToQueue(const DataRecordHandle* const dataRecord)
 //------------------------------------------------------------------------------
 void OutputHandler::processQueue()
 {
-   // Get the first record from the queue
-   lcLock( semaphore );
-   const DataRecordHandle* dataRecord = static_cast<const DataRecordHandle*>(queue.get());
-   lcUnlock( semaphore );
+   // When we have a writer thread, it's the one that processes the queue
+   if (writerRate > 0 && !writerStopped.load() && !isShutdown()) {
+      if (writer != nullptr || createWriterThread()) return;
+   }
+
+   emptyQueue(true);
+}
+
+
+//------------------------------------------------------------------------------
+// Puts a data record into the ring buffer; returns false if the ring is full
+//------------------------------------------------------------------------------
+bool OutputHandler::putQueue(const DataRecordHandle* const dataRecord)
+{
+   if (ring == nullptr) return false;
+
+   unsigned int pos = ringHead.load(std::memory_order_relaxed);
+   for (;;) {
+      QueueSlot* const slot = &ring[pos & (QUEUE_SIZE - 1)];
+      const unsigned int seq = slot->seq.load(std::memory_order_acquire);
+      const int dif = static_cast<int>(seq - pos);
+      if (dif == 0) {
+         // The slot is free; try to claim it
+         if (ringHead.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+            slot->handle = dataRecord;
+            slot->seq.store(pos + 1, std::memory_order_release);
+            return true;
+         }
+      }
+      else if (dif < 0) {
+         // The ring is full
+         return false;
+      }
+      else {
+         // Another producer claimed this slot
+         pos = ringHead.load(std::memory_order_relaxed);
+      }
+   }
+}
+
+
+//------------------------------------------------------------------------------
+// Gets the next data record from the ring buffer, or from the overflow queue
+// once the ring is empty.  Consumer only (i.e., hold the 'consumer' lock)
+//------------------------------------------------------------------------------
+const DataRecordHandle* OutputHandler::getQueue()
+{
+   const DataRecordHandle* dataRecord = nullptr;
+
+   if (ring != nullptr) {
+      QueueSlot* const slot = &ring[ringTail & (QUEUE_SIZE - 1)];
+      const unsigned int seq = slot->seq.load(std::memory_order_acquire);
+      if (seq == ringTail + 1) {
+         dataRecord = slot->handle;
+         slot->handle = nullptr;
+         slot->seq.store(ringTail + QUEUE_SIZE, std::memory_order_release);
+         ringTail++;
+      }
+   }
+
+   if (dataRecord == nullptr && numOverflow.load(std::memory_order_acquire) > 0) {
+      lcLock( semaphore );
+      dataRecord = static_cast<const DataRecordHandle*>(queue.get());
+      if (dataRecord != nullptr) numOverflow.fetch_sub(1, std::memory_order_release);
+      lcUnlock( semaphore );
+   }
+
+   return dataRecord;
+}
+
+
+//------------------------------------------------------------------------------
+// Empties the queue, and process the data records if 'process' is true.
+//------------------------------------------------------------------------------
+void OutputHandler::emptyQueue(const bool process)
+{
+   lcLock( consumer );
+   drainQueue(process);
+   lcUnlock( consumer );
+}
+
+//------------------------------------------------------------------------------
+// Writer thread's pass: process the queue, unless we've been stopped
+//------------------------------------------------------------------------------
+void OutputHandler::writeQueue()
+{
+   lcLock( consumer );
+   if (!writerStopped.load()) drainQueue(true);
+   lcUnlock( consumer );
+}
 
+//------------------------------------------------------------------------------
+// Gets (and processes) records until the queue is empty.
+// Consumer only (i.e., hold the 'consumer' lock)
+//------------------------------------------------------------------------------
+void OutputHandler::drainQueue(const bool process)
+{
    // While we have records ...
+   const DataRecordHandle* dataRecord = getQueue();
    while (dataRecord != nullptr) {
       // process this record,
-      processRecord(dataRecord);
+      if (process) processRecord(dataRecord);
       dataRecord->unref();
 
       // and get the next one from the queue
-      lcLock( semaphore );
-      dataRecord = static_cast<const DataRecordHandle*>(queue.get());
-      lcUnlock( semaphore );
+      dataRecord = getQueue();
+   }
+}
+
+
+//------------------------------------------------------------------------------
+// Create (and start) the writer thread
+//------------------------------------------------------------------------------
+bool OutputHandler::createWriterThread()
+{
+   if (writer == nullptr) {
+      writer = new WriterThread(this, getWriterPriority(), getWriterRate());
+      writer->unref(); // 'writer' is a safe_ptr<>
+
+      bool ok = writer->create();
+      if (!ok) {
+         writer = nullptr;
+         writerRate = 0;   // We'll process the queue ourselves
+         if (isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "OutputHandler::createWriterThread(): ERROR, failed to create the thread!" << std::endl;
+         }
+      }
+   }
+   return (writer != nullptr);
+}
+
+
+//------------------------------------------------------------------------------
+// Stop the writer thread; returns after the thread's current pass is done
+//------------------------------------------------------------------------------
+void OutputHandler::stopWriterThread()
+{
+   writerStopped.store(true);
+
+   // The writer holds the consumer lock while it's processing the queue
+   lcLock( consumer );
+   lcUnlock( consumer );
+}
+
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+bool OutputHandler::setWriterRate(const LCreal hz)
+{
+   bool ok = false;
+   if (hz >= 0 && writer == nullptr) {
+      writerRate = hz;
+      ok = true;
    }
+   return ok;
 }
 
+bool OutputHandler::setWriterPriority(const LCreal pri)
+{
+   bool ok = false;
+   if (pri >= 0 && pri <= 1.0f) {
+      writerPriority = pri;
+      ok = true;
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+bool OutputHandler::setSlotWriterRate(const Basic::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setWriterRate( msg->getReal() );
+      if (!ok) {
+         std::cerr << "OutputHandler::setSlotWriterRate(): invalid rate: " << msg->getReal() << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool OutputHandler::setSlotWriterPriority(const Basic::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setWriterPriority( msg->getReal() );
+      if (!ok) {
+         std::cerr << "OutputHandler::setSlotWriterPriority(): invalid priority: " << msg->getReal() << std::endl;
+      }
+   }
+   return ok;
+}
 
 //------------------------------------------------------------------------------
 // processRecordImp() stub
@@ -177,5 +415,35 @@ void OutputHandler::processComponents(
    BaseClass::processComponents(list,typeid(OutputHandler),add,remove);
 }
 
+//------------------------------------------------------------------------------
+// getSlotByIndex()
+//------------------------------------------------------------------------------
+Basic::Object* OutputHandler::getSlotByIndex(const int si)
+{
+   return BaseClass::getSlotByIndex(si);
+}
+
+//==============================================================================
+// Writer thread
+//==============================================================================
+IMPLEMENT_SUBCLASS(WriterThread,"RecorderWriterThread")
+EMPTY_SLOTTABLE(WriterThread)
+EMPTY_COPYDATA(WriterThread)
+EMPTY_DELETEDATA(WriterThread)
+EMPTY_SERIALIZER(WriterThread)
+
+WriterThread::WriterThread(Basic::Component* const parent, const LCreal priority, const LCreal rate)
+      : Basic::ThreadPeriodicTask(parent, priority, rate)
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+unsigned long WriterThread::userFunc(const LCreal)
+{
+   OutputHandler* handler = static_cast<OutputHandler*>(getParent());
+   handler->writeQueue();
+   return 0;
+}
+
 } // End Recorder namespace
 } // End Eaagles namespace
@@ -0,0 +1,752 @@
+#include "openeaagles/recorder/ParallelReader.h"
+#include "openeaagles/recorder/DataRecordHandle.h"
+#include "openeaagles/recorder/FileReader.h"
+#include "openeaagles/recorder/PrintSelected.h"
+#include "openeaagles/recorder/RecordIndex.h"
+#include "openeaagles/recorder/protobuf/DataRecord.pb.h"
+
+#include "openeaagles/basic/Number.h"
+#include "openeaagles/basic/Pair.h"
+#include "openeaagles/basic/PairStream.h"
+#include "openeaagles/basic/PhaseBarrier.h"
+#include "openeaagles/basic/Thread.h"
+#include "openeaagles/basic/WorkStealingExecutor.h"
+#include "openeaagles/basic/units/Times.h"
+
+namespace Eaagles {
+namespace Recorder {
+
+// ---
+// Reader pool thread
+// ---
+class ParallelReaderThread : public Basic::ThreadSyncTask {
+   DECLARE_SUBCLASS(ParallelReaderThread, Basic::ThreadSyncTask)
+public:
+   ParallelReaderThread(Basic::Component* const parent, const LCreal priority, Basic::PhaseBarrier* const barrier, const unsigned int worker);
+
+private:
+   // ThreadSyncTask class function -- our userFunc()
+   virtual unsigned long userFunc();
+
+private:
+   unsigned int worker0;   // Our executor worker index
+};
+
+//==============================================================================
+// Class ParallelReader
+//==============================================================================
+IMPLEMENT_SUBCLASS(ParallelReader,"RecorderParallelReader")
+EMPTY_SERIALIZER(ParallelReader)
+
+const LCreal ParallelReader::DEFAULT_THREAD_PRI = 0.5;
+
+// Slot table for this form type
+BEGIN_SLOTTABLE(ParallelReader)
+    "files",            // 1) Data files (FileReader)
+    "selections",       // 2) Record selections (PrintSelected)
+    "numThreads",       // 3) Number of threads
+    "chunkSize",        // 4) Approx size of each file chunk (bytes)
+    "startTime",        // 5) Exec time of the first record
+    "endTime",          // 6) Exec time of the last record
+END_SLOTTABLE(ParallelReader)
+
+// Map slot table to handles
+BEGIN_SLOT_MAP(ParallelReader)
+    ON_SLOT( 1, setSlotFiles,       Basic::PairStream)
+    ON_SLOT( 2, setSlotSelections,  Basic::PairStream)
+    ON_SLOT( 3, setSlotNumThreads,  Basic::Number)
+    ON_SLOT( 4, setSlotChunkSize,   Basic::Number)
+    ON_SLOT( 5, setSlotStartTime,   Basic::Time)
+    ON_SLOT( 6, setSlotEndTime,     Basic::Time)
+END_SLOT_MAP()
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+ParallelReader::ParallelReader() : numRead(0), numSelected(0)
+{
+   STANDARD_CONSTRUCTOR()
+   initData();
+}
+
+void ParallelReader::initData()
+{
+   files = nullptr;
+   selections = nullptr;
+   numThreads = 0;
+   chunkSize = DEFAULT_CHUNK_SIZE;
+   startTime = 0;
+   endTime = 0;
+   startTimeFlg = false;
+   endTimeFlg = false;
+
+   fstate = nullptr;
+   numFiles = 0;
+   chunks = nullptr;
+   numChunks = 0;
+   passChunks = nullptr;
+   numPassChunks = 0;
+   selects = nullptr;
+   numSelects = 0;
+   readers = nullptr;
+   eod = nullptr;
+   prepared = false;
+
+   for (unsigned int i = 0; i < MAX_THREADS; i++) {
+      threads[i] = nullptr;
+   }
+   numWorkerThreads = 0;
+   numWorkers = 0;
+   barrier = nullptr;
+   exec = nullptr;
+
+   numRead = 0;
+   numSelected = 0;
+}
+
+//------------------------------------------------------------------------------
+// copyData() -- copy member data
+//------------------------------------------------------------------------------
+void ParallelReader::copyData(const ParallelReader& org, const bool cc)
+{
+   BaseClass::copyData(org);
+   if (cc) initData();
+
+   // Copies of the files and selections; the copy is prepared with its first read
+   if (org.files != nullptr) {
+      Basic::PairStream* copy = static_cast<Basic::PairStream*>(org.files->clone());
+      setSlotFiles(copy);
+      copy->unref();
+   }
+   else setSlotFiles(nullptr);
+
+   if (org.selections != nullptr) {
+      Basic::PairStream* copy = static_cast<Basic::PairStream*>(org.selections->clone());
+      setSlotSelections(copy);
+      copy->unref();
+   }
+   else setSlotSelections(nullptr);
+
+   numThreads = org.numThreads;
+   chunkSize = org.chunkSize;
+   startTime = org.startTime;
+   endTime = org.endTime;
+   startTimeFlg = org.startTimeFlg;
+   endTimeFlg = org.endTimeFlg;
+}
+
+//------------------------------------------------------------------------------
+// deleteData() -- delete member data
+//------------------------------------------------------------------------------
+void ParallelReader::deleteData()
+{
+   // Our threads have ended; see shutdownNotification()
+   stopThreads();
+   clearChunks();
+
+   if (exec != nullptr) { delete exec; exec = nullptr; }
+   if (barrier != nullptr) { delete barrier; barrier = nullptr; }
+
+   if (files != nullptr) { files->unref(); files = nullptr; }
+   if (selections != nullptr) { selections->unref(); selections = nullptr; }
+}
+
+//------------------------------------------------------------------------------
+// shutdownNotification() -- Shutdown the simulation
+//------------------------------------------------------------------------------
+bool ParallelReader::shutdownNotification()
+{
+   // Our threads end once they see the shutdown
+   const bool ok = BaseClass::shutdownNotification();
+   stopThreads();
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Read the next selected record, in exec time order
+//------------------------------------------------------------------------------
+const DataRecordHandle* ParallelReader::readRecordImp()
+{
+   if (!prepared) prepare();
+
+   const DataRecordHandle* handle = nullptr;
+
+   bool finished = false;
+   while (!finished) {
+
+      // Find the file with the earliest record, and check for
+      // files that need more of their chunks parsed.
+      bool parse = false;
+      FileState* best = nullptr;
+      double bestTime = 0;
+      for (unsigned int f = 0; f < numFiles; f++) {
+         FileState* fs = &fstate[f];
+
+         // Done with the current chunk?
+         while (fs->curChunk < fs->nextChunk && fs->curRecord >= chunks[fs->curChunk].numRecords) {
+            Chunk* chunk = &chunks[fs->curChunk];
+            if (chunk->eod != nullptr && eod == nullptr) {
+               eod = chunk->eod;
+               chunk->eod = nullptr;
+            }
+            releaseChunk(chunk, chunk->numRecords);
+            fs->curChunk++;
+            fs->curRecord = 0;
+         }
+
+         if (fs->curChunk < fs->nextChunk) {
+            const Pb::DataRecord* rec = chunks[fs->curChunk].records[fs->curRecord]->getRecord();
+            const double t = rec->time().exec_time();
+            if (best == nullptr || t < bestTime) {
+               best = fs;
+               bestTime = t;
+            }
+         }
+         else if (fs->nextChunk < fs->endChunk) {
+            parse = true;
+         }
+      }
+
+      // We can't pick the earliest record until all of the files have one
+      // ready, or have none left; otherwise, we're done for this record.
+      if (parse) decodePass();
+      else {
+         if (best != nullptr) {
+            handle = chunks[best->curChunk].records[best->curRecord];
+            chunks[best->curChunk].records[best->curRecord] = nullptr;
+            best->curRecord++;
+         }
+         else {
+            // After the last record, the end of data
+            handle = eod;
+            eod = nullptr;
+         }
+         finished = true;
+      }
+   }
+
+   return handle;
+}
+
+//------------------------------------------------------------------------------
+// Opens the files, divides them into chunks and creates our threads
+//------------------------------------------------------------------------------
+bool ParallelReader::prepare()
+{
+   prepared = true;
+
+   // ---
+   // Our data files and their indexes
+   // ---
+   unsigned int maxChunks = 0;
+   if (files != nullptr) {
+      fstate = new FileState[files->entries()];
+      for (const Basic::List::Item* item = files->getFirstItem(); item != nullptr; item = item->getNext()) {
+         const Basic::Pair* pair = static_cast<const Basic::Pair*>(item->getValue());
+         FileReader* p = dynamic_cast<FileReader*>(const_cast<Basic::Object*>(pair->object()));
+         if (p != nullptr) {
+            const RecordIndex* index = p->getIndex();
+            if (index != nullptr) maxChunks += index->getNumEntries();
+            else if (isMessageEnabled(MSG_ERROR)) {
+               std::cerr << "ParallelReader::prepare(): unable to read data file: " << *pair->slot() << std::endl;
+            }
+            fstate[numFiles].source = p;
+            numFiles++;
+         }
+      }
+   }
+
+   // ---
+   // Divide the files into chunks at their index intervals
+   // ---
+   chunks = new Chunk[maxChunks > 0 ? maxChunks : 1];
+   numChunks = 0;
+   for (unsigned int f = 0; f < numFiles; f++) {
+      FileState* fs = &fstate[f];
+      fs->firstChunk = numChunks;
+      const RecordIndex* index = fs->source->getIndex();
+      if (index != nullptr) addChunks(f, index);
+      fs->endChunk = numChunks;
+      fs->nextChunk = fs->firstChunk;
+      fs->curChunk = fs->firstChunk;
+      fs->curRecord = 0;
+   }
+   passChunks = new unsigned int[numChunks > 0 ? numChunks : 1];
+   numPassChunks = 0;
+
+   // ---
+   // Our record selections
+   // ---
+   if (selections != nullptr) {
+      selects = new const PrintSelected*[selections->entries()];
+      for (const Basic::List::Item* item = selections->getFirstItem(); item != nullptr; item = item->getNext()) {
+         const Basic::Pair* pair = static_cast<const Basic::Pair*>(item->getValue());
+         const PrintSelected* p = dynamic_cast<const PrintSelected*>(pair->object());
+         if (p != nullptr) selects[numSelects++] = p;
+      }
+   }
+
+   // ---
+   // Our threads, and each worker's readers (clones of the data files)
+   // ---
+   createThreads();
+
+   readers = new FileReader*[numWorkers * numFiles > 0 ? numWorkers * numFiles : 1];
+   for (unsigned int w = 0; w < numWorkers; w++) {
+      for (unsigned int f = 0; f < numFiles; f++) {
+         readers[w * numFiles + f] = static_cast<FileReader*>(fstate[f].source->clone());
+      }
+   }
+
+   if (isMessageEnabled(MSG_INFO)) {
+      std::cout << "ParallelReader::prepare(): " << numFiles << " files; " << numChunks << " chunks; ";
+      std::cout << numWorkers << " workers" << std::endl;
+   }
+
+   return (numChunks > 0);
+}
+
+//------------------------------------------------------------------------------
+// Adds the chunks of file 'file'; each chunk is one or more whole index
+// intervals of, at least, 'chunkSize' bytes (except the last chunk)
+//------------------------------------------------------------------------------
+void ParallelReader::addChunks(const unsigned int file, const RecordIndex* const index)
+{
+   const int n = static_cast<int>(index->getNumEntries());
+
+   // The first interval
+   int i = 0;
+   while (i < n && (index->getEntry(i)->flags & RecordIndex::INTERVAL_START) == 0) i++;
+
+   while (i < n) {
+      const RecordIndex::Entry* first = index->getEntry(i);
+
+      // Add intervals until the chunk is big enough
+      int j = index->findNextInterval(i);
+      while (j >= 0 && (index->getEntry(j)->offset - first->offset) < chunkSize) {
+         j = index->findNextInterval(j);
+      }
+      const RecordIndex::Entry* next = (j >= 0 ? index->getEntry(j) : nullptr);
+
+      // Skip the chunks that are outside of the start and end times
+      bool skip = false;
+      if (endTimeFlg && first->execTime > endTime) skip = true;
+      if (startTimeFlg && next != nullptr && next->execTime < startTime) skip = true;
+
+      if (!skip) {
+         Chunk* chunk = &chunks[numChunks++];
+         chunk->file = file;
+         chunk->start = first->offset;
+         chunk->end = (next != nullptr ? next->offset : 0);
+         chunk->records = nullptr;
+         chunk->numRecords = 0;
+         chunk->maxRecords = 0;
+         chunk->eod = nullptr;
+      }
+
+      i = (j >= 0 ? j : n);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Parses the next chunks of each file, using all of the workers
+//------------------------------------------------------------------------------
+void ParallelReader::decodePass()
+{
+   // Files with chunks left to parse
+   unsigned int active = 0;
+   for (unsigned int f = 0; f < numFiles; f++) {
+      if (fstate[f].nextChunk < fstate[f].endChunk) active++;
+   }
+   if (active == 0) return;
+
+   // Share this pass's chunks among the files; files that still have
+   // enough parsed chunks get fewer (or none).
+   unsigned int perFile = (numWorkers * CHUNKS_PER_THREAD + active - 1) / active;
+   if (perFile == 0) perFile = 1;
+
+   numPassChunks = 0;
+   for (unsigned int f = 0; f < numFiles; f++) {
+      FileState* fs = &fstate[f];
+      while (fs->nextChunk < fs->endChunk && (fs->nextChunk - fs->curChunk) < perFile) {
+         passChunks[numPassChunks++] = fs->nextChunk++;
+      }
+   }
+
+   // Parse them
+   exec->beginPass(numPassChunks);
+   if (numWorkerThreads > 0) barrier->release();
+
+   // we're the last worker (and we'll steal all of the chunks if our threads have ended)
+   decodeChunks(numWorkers - 1);
+
+   // Now wait for the other thread(s) to complete
+   if (numWorkerThreads > 0) barrier->waitForCompleted();
+   exec->endPass();
+}
+
+//------------------------------------------------------------------------------
+// Parses and selects the records of the chunks that are assigned to 'worker'
+//------------------------------------------------------------------------------
+void ParallelReader::decodeChunks(const unsigned int worker)
+{
+   unsigned int begin = 0;
+   unsigned int end = 0;
+
+   exec->beginWork(worker);
+   while (exec->nextChunk(worker, &begin, &end)) {
+      for (unsigned int i = begin; i < end; i++) {
+         Chunk* chunk = &chunks[passChunks[i]];
+         decodeChunk(chunk, readers[worker * numFiles + chunk->file]);
+      }
+   }
+   exec->endWork(worker);
+}
+
+//------------------------------------------------------------------------------
+// Reads the records of one chunk, and keeps the selected records
+//------------------------------------------------------------------------------
+void ParallelReader::decodeChunk(Chunk* const chunk, FileReader* const reader)
+{
+   unsigned long nr = 0;
+   unsigned long ns = 0;
+
+   if (reader->setOffset(chunk->start)) {
+      while (chunk->end == 0 || reader->getOffset() < chunk->end) {
+         const DataRecordHandle* handle = reader->readRecord();
+         if (handle == nullptr) break;
+         nr++;
+
+         if (!isRecordSelected(handle->getRecord())) {
+            handle->unref();
+         }
+         else if (handle->getRecord()->id() == REID_END_OF_DATA) {
+            // Kept separately, and only one is returned after all of the files
+            if (chunk->eod != nullptr) chunk->eod->unref();
+            chunk->eod = handle;
+         }
+         else {
+            // Make sure it fits
+            if (chunk->numRecords >= chunk->maxRecords) {
+               const unsigned int max = (chunk->maxRecords > 0 ? chunk->maxRecords * 2 : 64);
+               const DataRecordHandle** records = new const DataRecordHandle*[max];
+               for (unsigned int i = 0; i < chunk->numRecords; i++) {
+                  records[i] = chunk->records[i];
+               }
+               if (chunk->records != nullptr) delete[] chunk->records;
+               chunk->records = records;
+               chunk->maxRecords = max;
+            }
+            chunk->records[chunk->numRecords++] = handle;
+            ns++;
+         }
+      }
+   }
+
+   numRead += nr;
+   numSelected += ns;
+}
+
+//------------------------------------------------------------------------------
+// Releases a chunk's selected records, starting with record 'first'
+//------------------------------------------------------------------------------
+void ParallelReader::releaseChunk(Chunk* const chunk, const unsigned int first)
+{
+   for (unsigned int i = first; i < chunk->numRecords; i++) {
+      if (chunk->records[i] != nullptr) chunk->records[i]->unref();
+   }
+   if (chunk->records != nullptr) delete[] chunk->records;
+   chunk->records = nullptr;
+   chunk->numRecords = 0;
+   chunk->maxRecords = 0;
+   if (chunk->eod != nullptr) { chunk->eod->unref(); chunk->eod = nullptr; }
+}
+
+//------------------------------------------------------------------------------
+// Releases the files, chunks, selections and readers
+//------------------------------------------------------------------------------
+void ParallelReader::clearChunks()
+{
+   for (unsigned int f = 0; f < numFiles; f++) {
+      FileState* fs = &fstate[f];
+      for (unsigned int c = fs->curChunk; c < fs->nextChunk; c++) {
+         releaseChunk(&chunks[c], (c == fs->curChunk ? fs->curRecord : 0));
+      }
+   }
+
+   if (readers != nullptr) {
+      const unsigned int n = numWorkers * numFiles;
+      for (unsigned int i = 0; i < n; i++) {
+         readers[i]->unref();
+      }
+      delete[] readers;
+      readers = nullptr;
+   }
+
+   if (fstate != nullptr) { delete[] fstate; fstate = nullptr; }
+   numFiles = 0;
+   if (chunks != nullptr) { delete[] chunks; chunks = nullptr; }
+   numChunks = 0;
+   if (passChunks != nullptr) { delete[] passChunks; passChunks = nullptr; }
+   numPassChunks = 0;
+   if (selects != nullptr) { delete[] selects; selects = nullptr; }
+   numSelects = 0;
+   if (eod != nullptr) { eod->unref(); eod = nullptr; }
+   prepared = false;
+}
+
+//------------------------------------------------------------------------------
+// Creates our threads; the reader's thread is the last worker
+//------------------------------------------------------------------------------
+void ParallelReader::createThreads()
+{
+   unsigned int n = numThreads;
+   if (n == 0) n = Basic::Thread::getNumProcessors();
+   if (n > MAX_THREADS) n = MAX_THREADS;
+
+   if (n > 1) {
+      // The pool's phase barrier; the threads are created with it
+      barrier = new Basic::PhaseBarrier(0);
+
+      for (unsigned int i = 0; i < (n-1); i++) {
+         threads[numWorkerThreads] = new ParallelReaderThread(this, DEFAULT_THREAD_PRI, barrier, numWorkerThreads);
+         bool ok = threads[numWorkerThreads]->create();
+         if (ok) {
+            numWorkerThreads++;
+         }
+         else {
+            threads[numWorkerThreads]->unref();
+            threads[numWorkerThreads] = nullptr;
+            if (isMessageEnabled(MSG_ERROR)) {
+               std::cerr << "ParallelReader::createThreads(): ERROR, failed to create a reader thread!" << std::endl;
+            }
+         }
+      }
+      barrier->setNumWorkers(numWorkerThreads);
+   }
+
+   numWorkers = numWorkerThreads + 1;
+   exec = new Basic::WorkStealingExecutor(numWorkers);
+   exec->setChunkSize(1);
+}
+
+//------------------------------------------------------------------------------
+// Ends our threads; called after we've been shutdown
+//------------------------------------------------------------------------------
+void ParallelReader::stopThreads()
+{
+   if (numWorkerThreads > 0) {
+      // Release our threads, which will see the shutdown and end.  Threads
+      // that have already seen it won't arrive at the barrier, so we wait
+      // for them to end instead.  The threads hold references to themselves
+      // (and to us) until they've ended, so the barrier is deleted with us.
+      barrier->release();
+
+      for (unsigned int i = 0; i < numWorkerThreads; i++) {
+         while (!threads[i]->isTerminated()) lcSleep(1);
+         threads[i]->unref();
+         threads[i] = nullptr;
+      }
+      numWorkerThreads = 0;
+   }
+}
+
+//------------------------------------------------------------------------------
+// True if the record is within our times, its id is enabled and it's selected
+//------------------------------------------------------------------------------
+bool ParallelReader::isRecordSelected(const Pb::DataRecord* const dataRecord) const
+{
+   if (dataRecord == nullptr) return false;
+
+   const double t = dataRecord->time().exec_time();
+   bool ok = (!startTimeFlg || t >= startTime) && (!endTimeFlg || t <= endTime) && isDataEnabled(dataRecord->id());
+
+   if (ok && numSelects > 0) {
+      ok = false;
+      for (unsigned int i = 0; i < numSelects && !ok; i++) {
+         ok = selects[i]->isSelected(dataRecord);
+      }
+   }
+
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+bool ParallelReader::setNumThreads(const unsigned int n)
+{
+   bool ok = false;
+   if (!prepared && n <= MAX_THREADS) {
+      numThreads = n;
+      ok = true;
+   }
+   return ok;
+}
+
+bool ParallelReader::setChunkSize(const unsigned int n)
+{
+   bool ok = false;
+   if (!prepared) {
+      chunkSize = n;
+      ok = true;
+   }
+   return ok;
+}
+
+bool ParallelReader::setStartTime(const double sec)
+{
+   bool ok = false;
+   if (!prepared) {
+      startTime = sec;
+      startTimeFlg = true;
+      ok = true;
+   }
+   return ok;
+}
+
+bool ParallelReader::setEndTime(const double sec)
+{
+   bool ok = false;
+   if (!prepared) {
+      endTime = sec;
+      endTimeFlg = true;
+      ok = true;
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+bool ParallelReader::setSlotFiles(const Basic::PairStream* const msg)
+{
+   if (prepared) return false;
+
+   bool ok = true;
+   if (msg != nullptr) {
+      // Make sure that they're all data file readers
+      for (const Basic::List::Item* item = msg->getFirstItem(); item != nullptr; item = item->getNext()) {
+         const Basic::Pair* pair = static_cast<const Basic::Pair*>(item->getValue());
+         if (dynamic_cast<const FileReader*>(pair->object()) == nullptr) {
+            if (isMessageEnabled(MSG_ERROR)) {
+               std::cerr << "ParallelReader::setSlotFiles(): " << *pair->slot() << " is not a RecorderFileReader" << std::endl;
+            }
+            ok = false;
+         }
+      }
+   }
+
+   if (ok) {
+      if (files != nullptr) files->unref();
+      files = const_cast<Basic::PairStream*>(msg);
+      if (files != nullptr) files->ref();
+   }
+   return ok;
+}
+
+bool ParallelReader::setSlotSelections(const Basic::PairStream* const msg)
+{
+   if (prepared) return false;
+
+   bool ok = true;
+   if (msg != nullptr) {
+      // Make sure that they're all PrintSelected
+      for (const Basic::List::Item* item = msg->getFirstItem(); item != nullptr; item = item->getNext()) {
+         const Basic::Pair* pair = static_cast<const Basic::Pair*>(item->getValue());
+         if (dynamic_cast<const PrintSelected*>(pair->object()) == nullptr) {
+            if (isMessageEnabled(MSG_ERROR)) {
+               std::cerr << "ParallelReader::setSlotSelections(): " << *pair->slot() << " is not a PrintSelected" << std::endl;
+            }
+            ok = false;
+         }
+      }
+   }
+
+   if (ok) {
+      if (selections != nullptr) selections->unref();
+      selections = const_cast<Basic::PairStream*>(msg);
+      if (selections != nullptr) selections->ref();
+   }
+   return ok;
+}
+
+bool ParallelReader::setSlotNumThreads(const Basic::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int n = msg->getInt();
+      if (n >= 0) ok = setNumThreads( static_cast<unsigned int>(n) );
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "ParallelReader::setSlotNumThreads(): invalid number of threads: " << n;
+         std::cerr << "; use [ 0 .. " << MAX_THREADS << " ]" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool ParallelReader::setSlotChunkSize(const Basic::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int n = msg->getInt();
+      if (n >= 0) ok = setChunkSize( static_cast<unsigned int>(n) );
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "ParallelReader::setSlotChunkSize(): invalid chunk size: " << n << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool ParallelReader::setSlotStartTime(const Basic::Time* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setStartTime( Basic::Seconds::convertStatic(*msg) );
+   }
+   return ok;
+}
+
+bool ParallelReader::setSlotEndTime(const Basic::Time* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setEndTime( Basic::Seconds::convertStatic(*msg) );
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// getSlotByIndex() for Component
+//------------------------------------------------------------------------------
+Basic::Object* ParallelReader::getSlotByIndex(const int si)
+{
+   return BaseClass::getSlotByIndex(si);
+}
+
+//==============================================================================
+// Reader pool thread
+//==============================================================================
+IMPLEMENT_SUBCLASS(ParallelReaderThread,"RecorderParallelReaderThread")
+EMPTY_SLOTTABLE(ParallelReaderThread)
+EMPTY_COPYDATA(ParallelReaderThread)
+EMPTY_DELETEDATA(ParallelReaderThread)
+EMPTY_SERIALIZER(ParallelReaderThread)
+
+ParallelReaderThread::ParallelReaderThread(Basic::Component* const parent, const LCreal priority, Basic::PhaseBarrier* const barrier, const unsigned int worker)
+      : Basic::ThreadSyncTask(parent, priority, barrier, worker)
+{
+   STANDARD_CONSTRUCTOR()
+
+   worker0 = worker;
+}
+
+unsigned long ParallelReaderThread::userFunc()
+{
+   ParallelReader* reader = static_cast<ParallelReader*>(getParent());
+   reader->decodeChunks(worker0);
+   return 0;
+}
+
+} // End Recorder namespace
+} // End Eaagles namespace
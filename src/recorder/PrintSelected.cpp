@@ -22,6 +22,29 @@
 namespace Eaagles {
 namespace Recorder {
 
+//------------------------------------------------------------------------------
+// DataRecord's event message field for each message token
+//------------------------------------------------------------------------------
+static const struct {
+   unsigned int token;
+   const char* field;
+} eventFields[] = {
+   { REID_FILE_ID,            "file_id_msg" },
+   { REID_NEW_PLAYER,         "new_player_event_msg" },
+   { REID_PLAYER_REMOVED,     "player_removed_event_msg" },
+   { REID_PLAYER_DATA,        "player_data_msg" },
+   { REID_PLAYER_DAMAGED,     "player_damaged_event_msg" },
+   { REID_PLAYER_COLLISION,   "player_collision_event_msg" },
+   { REID_PLAYER_CRASH,       "player_crash_event_msg" },
+   { REID_PLAYER_KILLED,      "player_killed_event_msg" },
+   { REID_WEAPON_RELEASED,    "weapon_release_event_msg" },
+   { REID_WEAPON_HUNG,        "weapon_hung_event_msg" },
+   { REID_WEAPON_DETONATION,  "weapon_detonation_event_msg" },
+   { REID_GUN_FIRED,          "gun_fired_event_msg" },
+   { REID_NEW_TRACK,          "new_track_event_msg" },
+   { REID_TRACK_REMOVED,      "track_removed_event_msg" },
+   { REID_TRACK_DATA,         "track_data_msg" }
+};
 
 //==============================================================================
 // Class PrintSelected
@@ -78,6 +101,11 @@ void PrintSelected::initData()
    foundSelected = false;
    printHeader = false;
    timeOnly = false;
+
+   eventField = nullptr;
+   numTimePaths = 0;
+   numEventPaths = 0;
+   pathLimitWarned = false;
 }
 
 //------------------------------------------------------------------------------
@@ -98,6 +126,8 @@ void PrintSelected::copyData(const PrintSelected& org, const bool cc)
    foundSelected = org.foundSelected;
    printHeader = org.printHeader;
    timeOnly = org.timeOnly;
+
+   compileConditions();
 }
 
 //------------------------------------------------------------------------------
@@ -114,8 +144,7 @@ bool PrintSelected::setSlotMsgToken(const Basic::Number* const msg)
 {
    bool ok = false;
    if (msg != nullptr) {
-      ok = true;
-      msgToken = msg->getInt();
+      ok = setMsgToken( msg->getInt() );
    }
    return ok;
 }
@@ -124,8 +153,7 @@ bool PrintSelected::setSlotFieldName(const Basic::String* const msg)
 {
    bool ok = false;
    if (msg != nullptr) {
-      ok = true;
-      fieldNameStr.assign( msg->getString() );
+      ok = setFieldOfInterest( msg->getString() );
    }
    return ok;
 
@@ -459,113 +487,223 @@ void PrintSelected::processRecordImp(const DataRecordHandle* const handle)
 }
 
 //------------------------------------------------------------------------------
-// processMessage(): Recursive function to go through all messages
+// isSelected(): True if the data record matches the selection criteria
+//------------------------------------------------------------------------------
+bool PrintSelected::isSelected(const Pb::DataRecord* const dataRecord) const
+{
+   if (dataRecord == nullptr) return false;
+
+   // Time conditions
+   bool found = matchPaths(&dataRecord->time(), timePaths, numTimePaths);
+
+   // Print ALL messages that match the time conditions
+   if (timeOnly) return found;
+
+   // Event message conditions
+   if (!found && eventField != nullptr) {
+      const google::protobuf::Reflection* reflection = dataRecord->GetReflection();
+      found = matchPaths(&reflection->GetMessage(*dataRecord, eventField), eventPaths, numEventPaths);
+   }
+
+   return (found && dataRecord->id() == msgToken);
+}
+
+//------------------------------------------------------------------------------
+// processMessage(): Checks the message's fields against the compiled condition
 //---------------------------------------------------------------------------
 void PrintSelected::processMessage(const google::protobuf::Message* const msg)
 {
-   const google::protobuf::Message& root = *msg;
    const google::protobuf::Descriptor* descriptor = msg->GetDescriptor();
-   const google::protobuf::Reflection* reflection = msg->GetReflection();
 
-   int fieldCount = descriptor->field_count();
-   const google::protobuf::FieldDescriptor* fieldDescriptor = nullptr;
+   bool found = false;
+   if (descriptor == Pb::Time::descriptor()) {
+      found = matchPaths(msg, timePaths, numTimePaths);
+   }
+   else if (eventField != nullptr && descriptor == eventField->message_type()) {
+      found = matchPaths(msg, eventPaths, numEventPaths);
+   }
+   else {
+      // Not one of our compiled messages
+      FieldPath paths[MAX_PATHS];
+      FieldPath path;
+      path.depth = 0;
+      const unsigned int n = compileMessage(descriptor, paths, 0, &path);
+      found = matchPaths(msg, paths, n);
+   }
 
-   // look at fields to find a match with the slot condition
-   if (fieldCount > 0) {
-      // Look at each field in this message
-      for (int i = 0; i < fieldCount; i++) {
+   if (found) foundSelected = true;
+}
 
-         // Get field descriptor (includes messages)
-         fieldDescriptor = descriptor->field(i);
+//------------------------------------------------------------------------------
+// compileConditions(): Finds the paths to the fields named 'fieldNameStr' in
+// the time message and in the event message of the 'msgToken' records
+//------------------------------------------------------------------------------
+void PrintSelected::compileConditions()
+{
+   FieldPath path;
 
-         // what type is this field?
-         google::protobuf::FieldDescriptor::CppType cppType = fieldDescriptor->cpp_type();
+   path.depth = 0;
+   numTimePaths = compileMessage(Pb::Time::descriptor(), timePaths, 0, &path);
 
-         // If this field is a message, then call this again
-         if (cppType == google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
-            // Get sub message
-            const google::protobuf::Message& sub_message = reflection->GetMessage(root, fieldDescriptor);
-            processMessage(&sub_message);
+   eventField = nullptr;
+   numEventPaths = 0;
+   const unsigned int nEvents = sizeof(eventFields) / sizeof(eventFields[0]);
+   for (unsigned int i = 0; i < nEvents && eventField == nullptr; i++) {
+      if (eventFields[i].token == msgToken) {
+         eventField = Pb::DataRecord::descriptor()->FindFieldByName(eventFields[i].field);
+      }
+   }
+   if (eventField != nullptr) {
+      path.depth = 0;
+      numEventPaths = compileMessage(eventField->message_type(), eventPaths, 0, &path);
+   }
+}
+
+//------------------------------------------------------------------------------
+// compileMessage(): Recursive function that adds the paths, from the message
+// 'descriptor' to each of its fields named 'fieldNameStr', to 'paths', which
+// already contains 'n' paths.  Returns the new number of paths.  Fields past
+// the MAX_PATHS and MAX_PATH_DEPTH limits aren't checked, and we warn (once).
+//------------------------------------------------------------------------------
+unsigned int PrintSelected::compileMessage(
+      const google::protobuf::Descriptor* const descriptor,
+      FieldPath* const paths,
+      const unsigned int n,
+      FieldPath* const path) const
+{
+   unsigned int num = n;
+   if (fieldNameStr.empty()) return num;
+
+   if (path->depth >= MAX_PATH_DEPTH) {
+      if (!pathLimitWarned && isMessageEnabled(MSG_WARNING)) {
+         std::cerr << "PrintSelected::compileMessage(): messages embedded deeper than " << MAX_PATH_DEPTH;
+         std::cerr << " levels aren't searched for field " << fieldNameStr << std::endl;
+         pathLimitWarned = true;
+      }
+      return num;
+   }
+
+   const int fieldCount = descriptor->field_count();
+   for (int i = 0; i < fieldCount; i++) {
+      const google::protobuf::FieldDescriptor* fieldDescriptor = descriptor->field(i);
+      if (fieldDescriptor->is_repeated()) continue;
+
+      path->fields[path->depth] = fieldDescriptor;
+
+      // If this field is a message, then look at its fields
+      if (fieldDescriptor->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
+         path->depth++;
+         num = compileMessage(fieldDescriptor->message_type(), paths, num, path);
+         path->depth--;
+      }
+
+      // Otherwise, check the field's name
+      else if (fieldDescriptor->full_name() == fieldNameStr) {
+         if (num < MAX_PATHS) {
+            paths[num] = *path;
+            paths[num].depth = path->depth + 1;
+            num++;
          }
-         else {
-            // field is not a message. Check File name for match
-            if (fieldDescriptor->full_name() == fieldNameStr) {
-
-               // This is the right field. Now check the value, based on type
-               if (cppType == google::protobuf::FieldDescriptor::CPPTYPE_STRING) {
-                  std::string str = reflection->GetString(root, fieldDescriptor);
-                  std::string matchStr = getCompareToStr();
-                  if (str == matchStr) {
-                     // Found it!
-                     foundSelected = true;
-                  }
-               }
-               else if (cppType == google::protobuf::FieldDescriptor::CPPTYPE_INT32) {
-                  int num = reflection->GetInt32(root, fieldDescriptor);
-                  if (((condition == EQ) && (num == getCompareToNum())) ||
-                     ((condition == GT) && (num > getCompareToNum())) ||
-                     ((condition == LT) && (num < getCompareToNum()))) {
-                      // Found it!
-                     foundSelected = true;
-                  }
-               }
-               else if (cppType == google::protobuf::FieldDescriptor::CPPTYPE_INT64) {
-                  long long num = reflection->GetInt64(root, fieldDescriptor);
-                  if (((condition == EQ) && (num == getCompareToNum())) ||
-                     ((condition == GT) && (num > getCompareToNum())) ||
-                     ((condition == LT) && (num < getCompareToNum()))) {
-                      // Found it!
-                     foundSelected = true;
-                  }
-               }
-               else if (cppType == google::protobuf::FieldDescriptor::CPPTYPE_UINT32) {
-                  unsigned int num = reflection->GetUInt32(root, fieldDescriptor);
-                  if (((condition == EQ) && (num == getCompareToNum())) ||
-                     ((condition == GT) && (static_cast<int>(num) > getCompareToNum())) ||
-                     ((condition == LT) && (static_cast<int>(num) < getCompareToNum()))) {
-                      // Found it!
-                     foundSelected = true;
-                  }
-               }
-               else if (cppType == google::protobuf::FieldDescriptor::CPPTYPE_FLOAT) {
-                  double num = static_cast<double>(reflection->GetFloat(root, fieldDescriptor));
-                  if ( ((condition == EQ) && equal(num, getCompareToDbl())) ||
-                     ((condition == GT) && (num > getCompareToDbl())) ||
-                     ((condition == LT) && (num < getCompareToDbl()))) {
-                      // Found it!
-                     foundSelected = true;
-                  }
-               }
-               else if (cppType == google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE) {
-                  double num = reflection->GetDouble(root, fieldDescriptor);
-                  if ( ((condition == EQ) && equal(num, getCompareToDbl())) ||
-                     ((condition == GT) && (num > getCompareToDbl())) ||
-                     ((condition == LT) && (num < getCompareToDbl()))) {
-                      // Found it!
-                     foundSelected = true;
-                  }
-               }
-               else if (cppType == google::protobuf::FieldDescriptor::CPPTYPE_BOOL) {
-                  bool num = reflection->GetBool(root, fieldDescriptor);
-                  if (num == getCompareToBool()) {
-                      // Found it!
-                     foundSelected = true;
-                  }
-               }
-               else if (cppType == google::protobuf::FieldDescriptor::CPPTYPE_ENUM) {
-                  const google::protobuf::EnumValueDescriptor* enumVal = reflection->GetEnum(root, fieldDescriptor);
-                  int enumIndex = enumVal->index();
-                  if (((condition == EQ) && (enumIndex == getCompareToNum())) ||
-                     ((condition == GT) && (enumIndex > getCompareToNum())) ||
-                     ((condition == LT) && (enumIndex < getCompareToNum()))) {
-                      // Found it!
-                     foundSelected = true;
-                  }
-               }
-            }
+         else if (!pathLimitWarned && isMessageEnabled(MSG_WARNING)) {
+            std::cerr << "PrintSelected::compileMessage(): more than " << MAX_PATHS;
+            std::cerr << " fields match " << fieldNameStr << "; only the first " << MAX_PATHS << " are checked" << std::endl;
+            pathLimitWarned = true;
          }
       }
    }
+   return num;
+}
+
+//------------------------------------------------------------------------------
+// matchPaths(): True if any of the 'n' fields given by 'paths' matches the condition
+//---------------------------------------------------------------------------
+bool PrintSelected::matchPaths(
+      const google::protobuf::Message* const msg,
+      const FieldPath* const paths,
+      const unsigned int n) const
+{
+   bool found = false;
+   for (unsigned int i = 0; i < n && !found; i++) {
+      // Follow the embedded messages down to the field's message
+      const google::protobuf::Message* sub = msg;
+      const unsigned int last = paths[i].depth - 1;
+      for (unsigned int j = 0; j < last; j++) {
+         sub = &sub->GetReflection()->GetMessage(*sub, paths[i].fields[j]);
+      }
+      found = matchField(*sub, paths[i].fields[last]);
+   }
+   return found;
+}
+
+//------------------------------------------------------------------------------
+// matchField(): True if the value of the field matches the condition
+//---------------------------------------------------------------------------
+bool PrintSelected::matchField(
+      const google::protobuf::Message& root,
+      const google::protobuf::FieldDescriptor* const fieldDescriptor) const
+{
+   const google::protobuf::Reflection* reflection = root.GetReflection();
+   bool found = false;
+
+   // Check the value, based on type
+   switch (fieldDescriptor->cpp_type()) {
+      case google::protobuf::FieldDescriptor::CPPTYPE_STRING: {
+         const std::string str = reflection->GetString(root, fieldDescriptor);
+         found = (str == compareStr);
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_INT32: {
+         int num = reflection->GetInt32(root, fieldDescriptor);
+         found = ((condition == EQ) && (num == compareValI)) ||
+                 ((condition == GT) && (num > compareValI)) ||
+                 ((condition == LT) && (num < compareValI));
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_INT64: {
+         long long num = reflection->GetInt64(root, fieldDescriptor);
+         found = ((condition == EQ) && (num == compareValI)) ||
+                 ((condition == GT) && (num > compareValI)) ||
+                 ((condition == LT) && (num < compareValI));
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_UINT32: {
+         unsigned int num = reflection->GetUInt32(root, fieldDescriptor);
+         found = ((condition == EQ) && (num == static_cast<unsigned int>(compareValI))) ||
+                 ((condition == GT) && (static_cast<int>(num) > compareValI)) ||
+                 ((condition == LT) && (static_cast<int>(num) < compareValI));
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT: {
+         double num = static_cast<double>(reflection->GetFloat(root, fieldDescriptor));
+         found = ((condition == EQ) && equal(num, compareValD)) ||
+                 ((condition == GT) && (num > compareValD)) ||
+                 ((condition == LT) && (num < compareValD));
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE: {
+         double num = reflection->GetDouble(root, fieldDescriptor);
+         found = ((condition == EQ) && equal(num, compareValD)) ||
+                 ((condition == GT) && (num > compareValD)) ||
+                 ((condition == LT) && (num < compareValD));
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_BOOL: {
+         bool num = reflection->GetBool(root, fieldDescriptor);
+         found = (num == getCompareToBool());
+         break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_ENUM: {
+         const google::protobuf::EnumValueDescriptor* enumVal = reflection->GetEnum(root, fieldDescriptor);
+         int enumIndex = enumVal->index();
+         found = ((condition == EQ) && (enumIndex == compareValI)) ||
+                 ((condition == GT) && (enumIndex > compareValI)) ||
+                 ((condition == LT) && (enumIndex < compareValI));
+         break;
+      }
+      default: break;
+   }
+
+   return found;
 }
 
 //------------------------------------------------------------------------------
@@ -686,6 +824,7 @@ void PrintSelected::printMessage(std::ostream& soutFields, std::ostream& soutVal
 bool PrintSelected::setMsgToken(const unsigned int token)
 {
    msgToken = token;
+   compileConditions();
    return true;
 }
 
@@ -695,6 +834,7 @@ bool PrintSelected::setMsgToken(const unsigned int token)
 bool PrintSelected::setFieldOfInterest(const std::string& field )
 {
    fieldNameStr = field;
+   compileConditions();
    return true;
 }
 
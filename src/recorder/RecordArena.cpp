@@ -0,0 +1,111 @@
+
+#include "openeaagles/recorder/RecordArena.h"
+#include "openeaagles/recorder/protobuf/DataRecord.pb.h"
+
+#if GOOGLE_PROTOBUF_VERSION >= 3014000
+#include <google/protobuf/arena.h>
+#define EAAGLES_RECORDER_ARENA
+#endif
+
+namespace Eaagles {
+namespace Recorder {
+
+IMPLEMENT_SUBCLASS(RecordArena,"RecordArena")
+EMPTY_SLOTTABLE(RecordArena)
+EMPTY_SERIALIZER(RecordArena)
+
+//------------------------------------------------------------------------------
+// Constructors
+//------------------------------------------------------------------------------
+RecordArena::RecordArena()
+{
+   STANDARD_CONSTRUCTOR()
+   initData();
+}
+
+RecordArena::RecordArena(const unsigned int size)
+{
+   STANDARD_CONSTRUCTOR()
+   initData();
+   blockSize = size;
+}
+
+void RecordArena::initData()
+{
+   arena = nullptr;
+   blockSize = 0;
+   numRecords = 0;
+   numPending = 0;
+}
+
+//------------------------------------------------------------------------------
+// copyData() -- copy member data
+//------------------------------------------------------------------------------
+void RecordArena::copyData(const RecordArena& org, const bool cc)
+{
+   BaseClass::copyData(org);
+   if (cc) initData();
+
+   // Records are not copied; we'll start our own arena
+   blockSize = org.blockSize;
+}
+
+// deleteData() -- delete member data
+void RecordArena::deleteData()
+{
+#ifdef EAAGLES_RECORDER_ARENA
+   if (arena != nullptr) { delete arena;  arena = nullptr; }
+#endif
+}
+
+//------------------------------------------------------------------------------
+// True if arena allocation is supported by this protocol buffers version
+//------------------------------------------------------------------------------
+bool RecordArena::isSupported()
+{
+#ifdef EAAGLES_RECORDER_ARENA
+   return true;
+#else
+   return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Creates a new, empty data record
+//------------------------------------------------------------------------------
+Pb::DataRecord* RecordArena::createRecord()
+{
+   Pb::DataRecord* record = nullptr;
+
+#ifdef EAAGLES_RECORDER_ARENA
+   if (arena == nullptr) {
+      google::protobuf::ArenaOptions options;
+      if (blockSize > 0) {
+         options.start_block_size = blockSize;
+         options.max_block_size = blockSize;
+      }
+      arena = new google::protobuf::Arena(options);
+   }
+   record = google::protobuf::Arena::CreateMessage<Pb::DataRecord>(arena);
+#else
+   record = new Pb::DataRecord();
+#endif
+
+   numRecords++;
+   return record;
+}
+
+//------------------------------------------------------------------------------
+// True if the data record was allocated from this arena
+//------------------------------------------------------------------------------
+bool RecordArena::isOwner(const Pb::DataRecord* const record) const
+{
+#ifdef EAAGLES_RECORDER_ARENA
+   return (record != nullptr && arena != nullptr && record->GetArena() == arena);
+#else
+   return false;
+#endif
+}
+
+} // End Recorder namespace
+} // End Eaagles namespace
@@ -0,0 +1,471 @@
+
+#include "openeaagles/recorder/RecordIndex.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Eaagles {
+namespace Recorder {
+
+IMPLEMENT_SUBCLASS(RecordIndex,"RecordIndex")
+EMPTY_SLOTTABLE(RecordIndex)
+EMPTY_SERIALIZER(RecordIndex)
+
+// File magic numbers
+static const char HEADER_MAGIC[4] = { 'O', 'E', 'D', 'R' };
+static const char TRAILER_MAGIC[4] = { 'O', 'E', 'D', 'X' };
+static const char BLOCK_MAGIC[4] = { 'O', 'E', 'D', 'B' };
+
+// Index file name suffix
+static const char INDEX_FILE_SUFFIX[] = ".idx";
+
+//------------------------------------------------------------------------------
+// Little-endian encoding
+//------------------------------------------------------------------------------
+static void putLE(char* const p, const unsigned long long v, const unsigned int n)
+{
+   for (unsigned int i = 0; i < n; i++) {
+      p[i] = static_cast<char>( (v >> (8*i)) & 0xff );
+   }
+}
+
+static unsigned long long getLE(const char* const p, const unsigned int n)
+{
+   unsigned long long v = 0;
+   for (unsigned int i = 0; i < n; i++) {
+      v |= static_cast<unsigned long long>( static_cast<unsigned char>(p[i]) ) << (8*i);
+   }
+   return v;
+}
+
+static void putDouble(char* const p, const double d)
+{
+   unsigned long long v = 0;
+   std::memcpy(&v, &d, sizeof(v));
+   putLE(p, v, 8);
+}
+
+static double getDouble(const char* const p)
+{
+   const unsigned long long v = getLE(p, 8);
+   double d = 0;
+   std::memcpy(&d, &v, sizeof(d));
+   return d;
+}
+
+//------------------------------------------------------------------------------
+// Index entries
+//------------------------------------------------------------------------------
+static void encodeEntry(char* const p, const RecordIndex::Entry& entry)
+{
+   putDouble(&p[0], entry.simTime);
+   putDouble(&p[8], entry.execTime);
+   putLE(&p[16], entry.offset, 8);
+   putLE(&p[24], entry.id, 4);
+   putLE(&p[28], entry.flags, 4);
+}
+
+static void decodeEntry(const char* const p, RecordIndex::Entry* const entry)
+{
+   entry->simTime = getDouble(&p[0]);
+   entry->execTime = getDouble(&p[8]);
+   entry->offset = getLE(&p[16], 8);
+   entry->id = static_cast<unsigned int>( getLE(&p[24], 4) );
+   entry->flags = static_cast<unsigned int>( getLE(&p[28], 4) );
+}
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+RecordIndex::RecordIndex()
+{
+   STANDARD_CONSTRUCTOR()
+   initData();
+}
+
+void RecordIndex::initData()
+{
+   entries = nullptr;
+   numEntries = 0;
+   maxEntries = 0;
+
+   byId = nullptr;
+   byIdValid = false;
+
+   intervalTime = 0;
+   intervalStarted = false;
+   for (unsigned int i = 0; i < MAX_INTERVAL_IDS; i++) {
+      intervalIds[i] = 0;
+   }
+   numIntervalIds = 0;
+}
+
+//------------------------------------------------------------------------------
+// copyData() -- copy member data
+//------------------------------------------------------------------------------
+void RecordIndex::copyData(const RecordIndex& org, const bool cc)
+{
+   BaseClass::copyData(org);
+   if (cc) initData();
+
+   clear();
+   for (unsigned int i = 0; i < org.numEntries; i++) {
+      add(org.entries[i]);
+   }
+}
+
+// deleteData() -- delete member data
+void RecordIndex::deleteData()
+{
+   if (entries != nullptr) { delete[] entries; entries = nullptr; }
+   if (byId != nullptr) { delete[] byId; byId = nullptr; }
+   numEntries = 0;
+   maxEntries = 0;
+   byIdValid = false;
+}
+
+//------------------------------------------------------------------------------
+// Entries
+//------------------------------------------------------------------------------
+const RecordIndex::Entry* RecordIndex::getEntry(const unsigned int idx) const
+{
+   const Entry* p = nullptr;
+   if (idx < numEntries) p = &entries[idx];
+   return p;
+}
+
+void RecordIndex::add(const Entry& entry)
+{
+   // Grow the array as needed
+   if (numEntries >= maxEntries) {
+      const unsigned int n = (maxEntries > 0 ? maxEntries * 2 : 1024);
+      Entry* tmp = new Entry[n];
+      if (entries != nullptr) {
+         std::memcpy(tmp, entries, numEntries * sizeof(Entry));
+         delete[] entries;
+      }
+      entries = tmp;
+      maxEntries = n;
+   }
+
+   entries[numEntries++] = entry;
+   byIdValid = false;
+}
+
+void RecordIndex::clear()
+{
+   numEntries = 0;
+   byIdValid = false;
+   intervalStarted = false;
+   numIntervalIds = 0;
+}
+
+//------------------------------------------------------------------------------
+// Indexes the first record of each interval, and the first record of each
+// record id within the interval
+//------------------------------------------------------------------------------
+bool RecordIndex::addRecord(
+      const double simTime,
+      const double execTime,
+      const unsigned int id,
+      const unsigned long long offset,
+      const double interval
+   )
+{
+   // Keep the index in time order (e.g., the FileWriter's own end of data record has a zero time)
+   if (numEntries > 0 && execTime < entries[numEntries - 1].execTime) return false;
+
+   Entry entry;
+   entry.simTime = simTime;
+   entry.execTime = execTime;
+   entry.offset = offset;
+   entry.id = id;
+   entry.flags = 0;
+
+   // Start a new interval?
+   if (!intervalStarted || execTime >= (intervalTime + interval)) {
+      intervalStarted = true;
+      intervalTime = execTime;
+      numIntervalIds = 0;
+      entry.flags = INTERVAL_START;
+   }
+
+   // First record of this id in this interval?
+   bool found = false;
+   for (unsigned int i = 0; i < numIntervalIds && !found; i++) {
+      found = (intervalIds[i] == id);
+   }
+
+   if (!found) {
+      if (numIntervalIds < MAX_INTERVAL_IDS) intervalIds[numIntervalIds++] = id;
+      add(entry);
+   }
+   return !found;
+}
+
+//------------------------------------------------------------------------------
+// Index of the last interval start entry with an exec time before 'execTime'
+//------------------------------------------------------------------------------
+int RecordIndex::findInterval(const double execTime) const
+{
+   // Binary search for the first entry at or after 'execTime' ...
+   const Entry* p = std::lower_bound(entries, entries + numEntries, execTime,
+      [](const Entry& e, const double t) { return e.execTime < t; } );
+
+   // ... then back up to the interval start
+   int idx = static_cast<int>(p - entries) - 1;
+   while (idx >= 0 && (entries[idx].flags & INTERVAL_START) == 0) {
+      idx--;
+   }
+   return idx;
+}
+
+//------------------------------------------------------------------------------
+// Index of the next interval start entry after entry 'idx'
+//------------------------------------------------------------------------------
+int RecordIndex::findNextInterval(const int idx) const
+{
+   for (unsigned int i = (idx >= 0 ? idx + 1 : 0); i < numEntries; i++) {
+      if ((entries[i].flags & INTERVAL_START) != 0) return static_cast<int>(i);
+   }
+   return -1;
+}
+
+//------------------------------------------------------------------------------
+// Index of the first entry for record 'id' at or after 'execTime'
+//------------------------------------------------------------------------------
+int RecordIndex::findRecord(const unsigned int id, const double execTime) const
+{
+   if (!byIdValid) sortById();
+
+   const Entry* const e = entries;
+   const unsigned int* p = std::lower_bound(byId, byId + numEntries, 0u,
+      [e, id, execTime](const unsigned int i, const unsigned int) {
+         return (e[i].id < id) || (e[i].id == id && e[i].execTime < execTime);
+      } );
+
+   int idx = -1;
+   if (p != byId + numEntries && entries[*p].id == id) idx = static_cast<int>(*p);
+   return idx;
+}
+
+// Sort the entry indices by record id; stable, so each id stays in file order
+void RecordIndex::sortById() const
+{
+   if (byId != nullptr) delete[] byId;
+   byId = new unsigned int[numEntries > 0 ? numEntries : 1];
+   for (unsigned int i = 0; i < numEntries; i++) {
+      byId[i] = i;
+   }
+
+   const Entry* const e = entries;
+   std::stable_sort(byId, byId + numEntries,
+      [e](const unsigned int a, const unsigned int b) { return e[a].id < e[b].id; } );
+
+   byIdValid = true;
+}
+
+//------------------------------------------------------------------------------
+// Encodes the index entries and the trailer
+//------------------------------------------------------------------------------
+unsigned int RecordIndex::encode(char* const buffer, const unsigned long long offset) const
+{
+   char* p = buffer;
+   for (unsigned int i = 0; i < numEntries; i++) {
+      encodeEntry(p, entries[i]);
+      p += ENTRY_SIZE;
+   }
+
+   putLE(&p[0], offset, 8);
+   putLE(&p[8], numEntries, 4);
+   std::memcpy(&p[12], TRAILER_MAGIC, 4);
+   p += TRAILER_SIZE;
+
+   return static_cast<unsigned int>(p - buffer);
+}
+
+//------------------------------------------------------------------------------
+// Reads the index from the end of an indexed data file
+//------------------------------------------------------------------------------
+bool RecordIndex::read(std::istream& sin)
+{
+   clear();
+
+   // The trailer
+   char trailer[TRAILER_SIZE];
+   sin.clear();
+   sin.seekg(0, std::ios_base::end);
+   const long long size = static_cast<long long>(sin.tellg());
+   if (size < static_cast<long long>(HEADER_SIZE + TRAILER_SIZE)) return false;
+   sin.seekg(size - TRAILER_SIZE, std::ios_base::beg);
+   sin.read(trailer, TRAILER_SIZE);
+   if (sin.fail() || std::memcmp(&trailer[12], TRAILER_MAGIC, 4) != 0) {
+      sin.clear();
+      return false;
+   }
+
+   const unsigned long long offset = getLE(&trailer[0], 8);
+   const unsigned int n = static_cast<unsigned int>( getLE(&trailer[8], 4) );
+   if (offset + static_cast<unsigned long long>(n) * ENTRY_SIZE + TRAILER_SIZE != static_cast<unsigned long long>(size)) {
+      return false;
+   }
+
+   // The entries
+   sin.seekg(static_cast<std::streamoff>(offset), std::ios_base::beg);
+   char buff[ENTRY_SIZE];
+   bool ok = true;
+   for (unsigned int i = 0; i < n && ok; i++) {
+      sin.read(buff, ENTRY_SIZE);
+      ok = !sin.fail();
+      if (ok) {
+         Entry entry;
+         decodeEntry(buff, &entry);
+         add(entry);
+      }
+   }
+
+   sin.clear();
+   if (!ok) clear();
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Encodes an index file block of the entries from entry 'first' on
+//------------------------------------------------------------------------------
+unsigned int RecordIndex::encodeBlock(char* const buffer, const unsigned int first, const unsigned long long offset) const
+{
+   const unsigned int n = (first < numEntries ? numEntries - first : 0);
+
+   char* p = buffer;
+   putLE(&p[0], n, 4);
+   std::memcpy(&p[4], BLOCK_MAGIC, 4);
+   p += BLOCK_HEADER_SIZE;
+
+   for (unsigned int i = 0; i < n; i++) {
+      encodeEntry(p, entries[first + i]);
+      p += ENTRY_SIZE;
+   }
+
+   putLE(&p[0], offset, 8);
+   putLE(&p[8], n, 4);
+   std::memcpy(&p[12], BLOCK_MAGIC, 4);
+   p += TRAILER_SIZE;
+
+   return static_cast<unsigned int>(p - buffer);
+}
+
+//------------------------------------------------------------------------------
+// Reads the complete blocks of an index file.  The blocks are appended while
+// the data file is written, so the last block may be incomplete, and is
+// ignored, if the writer didn't close the data file.
+//------------------------------------------------------------------------------
+bool RecordIndex::readBlocks(std::istream& sin, unsigned long long* const offset)
+{
+   clear();
+
+   bool found = false;
+   bool ok = true;
+   while (ok) {
+      // Block header
+      char header[BLOCK_HEADER_SIZE];
+      sin.read(header, BLOCK_HEADER_SIZE);
+      ok = !sin.fail() && std::memcmp(&header[4], BLOCK_MAGIC, 4) == 0;
+      const unsigned int n = (ok ? static_cast<unsigned int>( getLE(&header[0], 4) ) : 0);
+
+      // Entries
+      const unsigned int first = numEntries;
+      char buff[ENTRY_SIZE];
+      for (unsigned int i = 0; i < n && ok; i++) {
+         sin.read(buff, ENTRY_SIZE);
+         ok = !sin.fail();
+         if (ok) {
+            Entry entry;
+            decodeEntry(buff, &entry);
+            add(entry);
+         }
+      }
+
+      // Block trailer
+      char trailer[TRAILER_SIZE];
+      if (ok) {
+         sin.read(trailer, TRAILER_SIZE);
+         ok = !sin.fail() && getLE(&trailer[8], 4) == n && std::memcmp(&trailer[12], BLOCK_MAGIC, 4) == 0;
+      }
+
+      if (ok) {
+         *offset = getLE(&trailer[0], 8);
+         found = true;
+      }
+      else {
+         // Drop the incomplete block's entries
+         numEntries = first;
+         byIdValid = false;
+      }
+   }
+
+   sin.clear();
+   return found;
+}
+
+//------------------------------------------------------------------------------
+// Name of the index file of a data file
+//------------------------------------------------------------------------------
+std::string RecordIndex::getIndexFilename(const char* const dataFilename)
+{
+   std::string name;
+   if (dataFilename != nullptr) {
+      name = dataFilename;
+      name += INDEX_FILE_SUFFIX;
+   }
+   return name;
+}
+
+//------------------------------------------------------------------------------
+// File header
+//------------------------------------------------------------------------------
+void RecordIndex::encodeHeader(char* const buffer)
+{
+   std::memcpy(buffer, HEADER_MAGIC, 4);
+   buffer[4] = static_cast<char>(VERSION);
+   buffer[5] = 0;
+   buffer[6] = 0;
+   buffer[7] = 0;
+}
+
+bool RecordIndex::isHeader(const char* const buffer)
+{
+   return (std::memcmp(buffer, HEADER_MAGIC, 4) == 0 && static_cast<unsigned char>(buffer[4]) == VERSION);
+}
+
+//------------------------------------------------------------------------------
+// Base 128 varints
+//------------------------------------------------------------------------------
+unsigned int RecordIndex::putVarint(char* const buffer, const unsigned long long value)
+{
+   unsigned long long v = value;
+   unsigned int n = 0;
+   while (v >= 0x80) {
+      buffer[n++] = static_cast<char>( (v & 0x7f) | 0x80 );
+      v >>= 7;
+   }
+   buffer[n++] = static_cast<char>(v);
+   return n;
+}
+
+bool RecordIndex::getVarint(std::istream& sin, unsigned long long* const value)
+{
+   unsigned long long v = 0;
+   for (unsigned int i = 0; i < MAX_VARINT_SIZE; i++) {
+      const int c = sin.get();
+      if (c == std::char_traits<char>::eof()) return false;
+      v |= static_cast<unsigned long long>(c & 0x7f) << (7*i);
+      if ((c & 0x80) == 0) {
+         *value = v;
+         return true;
+      }
+   }
+   return false;
+}
+
+} // End Recorder namespace
+} // End Eaagles namespace
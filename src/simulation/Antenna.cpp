@@ -57,18 +57,14 @@ END_EVENT_HANDLER()
 //------------------------------------------------------------------------------
 // constructor(s)
 //------------------------------------------------------------------------------
-Antenna::Antenna() : freeEmStack(MAX_EMISSIONS), freeEmLock(0),
-                     inUseEmQueue(MAX_EMISSIONS), inUseEmLock(0),
-                     sys(nullptr), gainPattern(nullptr)
+Antenna::Antenna() : sys(nullptr), gainPattern(nullptr)
 {
    STANDARD_CONSTRUCTOR()
 
    initData();
 }
 
-Antenna::Antenna(const Antenna& org) : freeEmStack(MAX_EMISSIONS), freeEmLock(0),
-                                       inUseEmQueue(MAX_EMISSIONS), inUseEmLock(0),
-                                       sys(nullptr), gainPattern(nullptr)
+Antenna::Antenna(const Antenna& org) : sys(nullptr), gainPattern(nullptr)
 {
     STANDARD_CONSTRUCTOR()
     copyData(org,true);
@@ -95,6 +91,11 @@ void Antenna::initData()
    gainPattern = nullptr;
    sys = nullptr;
 
+   freeEms = new Emission*[MAX_EMISSIONS];
+   numFreeEms = 0;
+   inUseEms = new Emission*[MAX_EMISSIONS];
+   numInUseEms = 0;
+
    gain = 1.0;
    polar = NONE;
    threshold = 0.0;
@@ -135,6 +136,15 @@ void Antenna::deleteData()
    setSlotGainPattern(nullptr);
 
    clearQueues();
+
+   if (freeEms != nullptr) {
+      delete[] freeEms;
+      freeEms = nullptr;
+   }
+   if (inUseEms != nullptr) {
+      delete[] inUseEms;
+      inUseEms = nullptr;
+   }
 }
 
 
@@ -167,35 +177,50 @@ void Antenna::process(const LCreal dt)
 
    // ---
    // Recycle emissions ...
-   // Update emission queues: from 'in-use' to 'free'
    // ---
-   if (recycle) {
-      unsigned int n = inUseEmQueue.entries();
-
-      for (unsigned int i = 0; i < n; i++) {
-
-         lcLock(inUseEmLock);
-         Emission* em = inUseEmQueue.get();
-         lcUnlock(inUseEmLock);
-
-         if (em != nullptr && em->getRefCount() > 1) {
-            // Others are still referencing the emission, put back on in-use queue
-            lcLock(inUseEmLock);
-            inUseEmQueue.put(em);
-            lcUnlock(inUseEmLock);
-         }
+   if (recycle) recycleEmissions();
+}
 
-         else if (em != nullptr && em->getRefCount() <= 1) {
-            // No one else is referencing the emission, push to the free stack
-            em->clear();
-            lcLock(freeEmLock);
-            if (freeEmStack.isNotFull()) freeEmStack.push(em);
-            else em->unref();
-            lcUnlock(freeEmLock);
-         }
+//------------------------------------------------------------------------------
+// recycleEmissions() -- moves the in-use emissions that are no longer
+// referenced by others to the free list, and compacts the in-use list.  The
+// free emissions are cleared so that they don't keep their ownship, target
+// and data message referenced while they're in the pool.
+//------------------------------------------------------------------------------
+void Antenna::recycleEmissions()
+{
+   unsigned int n = 0;
+   for (unsigned int i = 0; i < numInUseEms; i++) {
+      Emission* const em = inUseEms[i];
+      if (em->getRefCount() > 1) {
+         // Others are still referencing the emission, keep it in-use
+         inUseEms[n++] = em;
+      }
+      else {
+         // No one else is referencing the emission, push to the free list
+         em->clear();
+         if (numFreeEms < MAX_EMISSIONS) freeEms[numFreeEms++] = em;
+         else em->unref();
       }
    }
+   numInUseEms = n;
+}
 
+//------------------------------------------------------------------------------
+// getFreeEmission() -- returns a free emission packet from the pool, or a
+// clone of the template emission, 'xmit', if the pool is empty (pre-ref())
+//------------------------------------------------------------------------------
+Emission* Antenna::getFreeEmission(const Emission* const xmit)
+{
+   Emission* em = nullptr;
+   if (recycle && numFreeEms > 0) {
+      em = freeEms[--numFreeEms];
+      *em = *xmit;
+   }
+   else {
+      em = xmit->clone();
+   }
+   return em;
 }
 
 
@@ -215,21 +240,13 @@ bool Antenna::setSystem(RfSystem* const s)
 //------------------------------------------------------------------------------
 void Antenna::clearQueues()
 {
-   lcLock(freeEmLock);
-   Emission* em = freeEmStack.pop();
-   while (em != nullptr) {
-      em->unref();
-      em = freeEmStack.pop();
+   while (numFreeEms > 0) {
+      freeEms[--numFreeEms]->unref();
    }
-   lcUnlock(freeEmLock);
 
-   lcLock(inUseEmLock);
-   em = inUseEmQueue.get();
-   while (em != nullptr) {
-      em->unref();
-      em = inUseEmQueue.get();
+   while (numInUseEms > 0) {
+      inUseEms[--numInUseEms]->unref();
    }
-   lcUnlock(inUseEmLock);
 }
 
 //------------------------------------------------------------------------------
@@ -522,32 +539,20 @@ void Antenna::rfTransmit(Emission* const xmit)
       // ---
       // Send emission packets to the targets
       // ---
+      const LCreal gimbalAz = static_cast<LCreal>(getAzimuth());
+      const LCreal gimbalEl = static_cast<LCreal>(getElevation());
+      const Polarization polarization = getPolarization();
+      const bool localOnly = isLocalPlayersOfInterestOnly();
+
       for (unsigned int i = 0; i < ntgts; i++) {
 
          // Only of power exceeds an optional threshold
          if (erp[i] > threshold) {
 
-            // Get a free emission packet
-            Emission* em(nullptr);
-            if (recycle) {
-               lcLock(freeEmLock);
-               em = freeEmStack.pop();
-               lcUnlock(freeEmLock);
-            }
-
-            bool cloned = false;
-            if (em == nullptr) {
-               // Otherwise, clone a new one
-               em = xmit->clone();
-               cloned = true;
-            }
-
-            // Send the emission to the other player
+            // a) Get a free emission packet with a copy of the template emission
+            Emission* const em = getFreeEmission(xmit);
             if (em != nullptr) {
 
-               // a) Copy the template emission
-               if (!cloned) *em = *xmit;
-
                // b) Set target unique data
                em->setGimbal(this);
                em->setOwnship(ownship);
@@ -558,33 +563,19 @@ void Antenna::rfTransmit(Emission* const xmit)
                em->setRangeRate( static_cast<LCreal>(rngRates[i]) );
                em->setTarget(targets[i]);
 
-               em->setGimbalAzimuth( static_cast<LCreal>(getAzimuth()) );
-               em->setGimbalElevation( static_cast<LCreal>(getElevation()) );
+               em->setGimbalAzimuth(gimbalAz);
+               em->setGimbalElevation(gimbalEl);
                em->setPower( static_cast<LCreal>(erp[i]) );
                em->setGain( static_cast<LCreal>(aeGain[i]) );
-               em->setPolarization(getPolarization());
-               em->setLocalPlayersOnly( isLocalPlayersOfInterestOnly() );
+               em->setPolarization(polarization);
+               em->setLocalPlayersOnly(localOnly);
 
                // c) Send the emission to the target
                targets[i]->event(RF_EMISSION, em);
 
-               // d) Recycle the emission
-               bool recycled = false;
-               if (recycle) {
-                  lcLock(inUseEmLock);
-                  if (inUseEmQueue.isNotFull()) {
-                     // Store for future reference
-                     inUseEmQueue.put(em);
-                     recycled = true;
-                  }
-                  lcUnlock(inUseEmLock);
-               }
-
-               // or just forget it
-               else {
-                  em->unref();
-              }
-
+               // d) Hold the emission on the in-use list for recycling, or just forget it
+               if (recycle && numInUseEms < MAX_EMISSIONS) inUseEms[numInUseEms++] = em;
+               else em->unref();
             }
             else {
                // When we couldn't get a free emission packet
@@ -4,6 +4,7 @@
 #include "openeaagles/simulation/CollisionDetect.h"
 
 #include "openeaagles/simulation/Player.h"
+#include "openeaagles/simulation/PlayerSnapshot.h"
 #include "openeaagles/simulation/Simulation.h"
 #include "openeaagles/basic/Number.h"
 #include "openeaagles/basic/Pair.h"
@@ -208,43 +209,38 @@ void CollisionDetect::updateData(const LCreal dt)
    }
 
    // ---
-   // Scan the player list ---
+   // Scan the simulation's player snapshot ---
    // ---
-   Basic::PairStream* plist = sim->getPlayers();
-   if (plist != nullptr) {
+   const PlayerSnapshot* snapshot = sim->getPlayerSnapshot();
+   if (snapshot != nullptr) {
 
-      Basic::List::Item* item = plist->getFirstItem();
-      bool finished = false;
-      while ( item != nullptr && !finished ) {
+      const unsigned int n = snapshot->getNumPlayers();
+      Player* const* tgts = snapshot->getPlayers();
+      const unsigned int* types = snapshot->getMajorTypes();
+      const unsigned char* modes = snapshot->getModes();
+      const unsigned char* flags = snapshot->getFlags();
 
-         // Get the pointer to the target player
-         Basic::Pair* pair = static_cast<Basic::Pair*>(item->getValue());
-         Player* target = static_cast<Player*>(pair->object());
+      // Target position vectors (ECEF or local gaming area NED)
+      const double* tx = (usingEcefFlg ? snapshot->getGeocPosX() : snapshot->getPosX());
+      const double* ty = (usingEcefFlg ? snapshot->getGeocPosY() : snapshot->getPosY());
+      const double* tz = (usingEcefFlg ? snapshot->getGeocPosZ() : snapshot->getPosZ());
+
+      for (unsigned int i = 0; i < n; i++) {
 
          // Did we complete the local only players?
-         finished = localOnly && target->isNetworkedPlayer();
+         if (localOnly && (flags[i] & PlayerSnapshot::NETWORKED) != 0) break;
 
          // We should process this target if ...
          bool processTgt =
-            !finished &&                                       // we're not finished AND
-            target != ownship &&                               // its not our ownship AND
-            target->isActive() &&                              // the target is active AND
-            target->isMajorType(playerTypes) &&                // the target is one of the selected types AND
-            (usingEcefFlg || target->isPositionVectorValid()); // we're using ECEF or the target's gaming area position is valid
+            tgts[i] != ownship &&                              // its not our ownship AND
+            modes[i] == Player::ACTIVE &&                      // the target is active AND
+            (types[i] & playerTypes) != 0 &&                   // the target is one of the selected types AND
+            (usingEcefFlg || (flags[i] & PlayerSnapshot::POS_VEC_VALID) != 0); // we're using ECEF or the target's gaming area position is valid
 
          if ( processTgt ) {
 
-            // Target position vector (ECEF or local gaming area NED)
-            osg::Vec3d tgtPos;
-            if (usingEcefFlg) {
-               tgtPos = target->getGeocPosition();
-            }
-            else {
-               tgtPos = target->getPosition();
-            }
-
             // Target Line-Of-Sight (LOS) vector
-            osg::Vec3d los = (tgtPos - ownPos);
+            osg::Vec3d los( (tx[i] - ownPos[0]), (ty[i] - ownPos[1]), (tz[i] - ownPos[2]) );
 
             // Normalized and compute length:
             const double range = los.normalize();
@@ -281,17 +277,14 @@ void CollisionDetect::updateData(const LCreal dt)
                   // If we are here then we have a target player that's active,
                   // the correct type, in-range and within our max FOV ...
                   // so update our POI list with it.
-                  updatePoiList(target);
+                  updatePoiList(tgts[i]);
                }
             }
          }
-
-         // Next player ...
-         item = item->getNext();
       }
 
-      // Unref the player list
-      plist->unref();
+      // Unref the snapshot
+      snapshot->unref();
    }
 
    // ---
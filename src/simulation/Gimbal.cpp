@@ -186,6 +186,10 @@ void Gimbal::initData()
    maxPlayers = 200;
 
    tdb = nullptr;
+
+   poiCands = nullptr;
+   poiWork = nullptr;
+   poiArraySize = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -232,6 +236,10 @@ void Gimbal::copyData(const Gimbal& org, const bool cc)
 void Gimbal::deleteData()
 {
    tdb = nullptr;
+
+   if (poiCands != nullptr) { delete[] poiCands; poiCands = nullptr; }
+   if (poiWork != nullptr)  { delete[] poiWork;  poiWork = nullptr; }
+   poiArraySize = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -1368,6 +1376,23 @@ unsigned int Gimbal::processPlayersOfInterest(Basic::PairStream* const poi)
    return ntgts;
 }
 
+//------------------------------------------------------------------------------
+// getPoiCandidateArrays() -- Arrays for the Tdb's player spatial index
+// queries; grown as needed, but never shrunk
+//------------------------------------------------------------------------------
+Player** Gimbal::getPoiCandidateArrays(const unsigned int n, unsigned int** const work) const
+{
+   if (n > poiArraySize) {
+      if (poiCands != nullptr) delete[] poiCands;
+      if (poiWork != nullptr) delete[] poiWork;
+      poiCands = new Player*[n];
+      poiWork = new unsigned int[n];
+      poiArraySize = n;
+   }
+   if (work != nullptr) *work = poiWork;
+   return poiCands;
+}
+
 //------------------------------------------------------------------------------
 // Returns the current TDB (pre-ref())
 //------------------------------------------------------------------------------
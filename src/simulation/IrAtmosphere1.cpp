@@ -11,6 +11,7 @@
 #include "openeaagles/basic/List.h"
 #include "openeaagles/basic/functors/Tables.h"
 #include "openeaagles/basic/Number.h"
+#include "openeaagles/basic/util/lfi.h"
 
 #include "openeaagles/basic/Nav.h"
 #include "openeaagles/basic/units/Distances.h"
@@ -26,6 +27,7 @@ BEGIN_SLOTTABLE(IrAtmosphere1)
    "solarRadiationTable",      // The tables containing solar radiation tables
    "backgroundRadiationTable", // The background radiation table
    "transmissivityTable",      // The tables containing transmissivity data
+   "precompute",               // Precompute the tables at each waveband center on reset
 END_SLOTTABLE(IrAtmosphere1)
 
 // slot map
@@ -33,8 +35,30 @@ BEGIN_SLOT_MAP(IrAtmosphere1)
    ON_SLOT(1,setSlotSolarRadiationTable,Basic::Table2)
    ON_SLOT(2,setSlotBackgroundRadiationTable,Basic::Table3)
    ON_SLOT(3,setSlotTransmissivityTable,Basic::Table4)
+   ON_SLOT(4,setSlotPrecompute,Basic::Number)
 END_SLOT_MAP()
 
+//------------------------------------------------------------------------------
+// linear interpolation from 'a1' to 'a2'; same as the Basic::lfi functions
+//------------------------------------------------------------------------------
+static inline LCreal lerp(const LCreal m, const LCreal a1, const LCreal a2)
+{
+   return m * (a2 - a1) + a1;
+}
+
+//------------------------------------------------------------------------------
+// Number of cells, and the center of cell 'k' (or the only breakpoint), of a breakpoint table
+//------------------------------------------------------------------------------
+static unsigned int numCells(const unsigned int n)
+{
+   return (n > 1 ? n - 1 : 1);
+}
+
+static LCreal cellCenter(const LCreal* const d, const unsigned int n, const unsigned int k)
+{
+   return (n > 1 ? (d[k] + d[k + 1]) / 2.0f : d[0]);
+}
+
 //------------------------------------------------------------------------------
 // Constructor
 //------------------------------------------------------------------------------
@@ -42,17 +66,41 @@ IrAtmosphere1::IrAtmosphere1()
 {
    STANDARD_CONSTRUCTOR()
 
+   initData();
+}
+
+void IrAtmosphere1::initData()
+{
    solarRadiationTable = nullptr;
    backgroundRadiationTable = nullptr;
    transmissivityTable = nullptr;
+
+   precomputeFlg = false;
+   gridValid = false;
+   gridNumBands = 0;
+   bandLower = nullptr;
+   bandUpper = nullptr;
+   bandFraction = nullptr;
+   solarGrid = nullptr;
+   backgroundGrid = nullptr;
+   transGrid = nullptr;
+   gridMaxErr = 0.0;
 }
 
 //------------------------------------------------------------------------------
 // copyData() -- copy this object's data
 //------------------------------------------------------------------------------
-void IrAtmosphere1::copyData(const IrAtmosphere1& org, const bool)
+void IrAtmosphere1::copyData(const IrAtmosphere1& org, const bool cc)
 {
    BaseClass::copyData(org);
+   if (cc) initData();
+
+   // The grids are rebuilt by our reset()
+   clearGrids();
+   setSlotSolarRadiationTable(org.solarRadiationTable);
+   setSlotBackgroundRadiationTable(org.backgroundRadiationTable);
+   setSlotTransmissivityTable(org.transmissivityTable);
+   precomputeFlg = org.precomputeFlg;
 }
 
 //------------------------------------------------------------------------------
@@ -60,6 +108,8 @@ void IrAtmosphere1::copyData(const IrAtmosphere1& org, const bool)
 //------------------------------------------------------------------------------
 void IrAtmosphere1::deleteData()
 {
+   clearGrids();
+
    if (solarRadiationTable != nullptr) {
       solarRadiationTable->unref();
       solarRadiationTable = nullptr;
@@ -76,6 +126,15 @@ void IrAtmosphere1::deleteData()
    }
 }
 
+//------------------------------------------------------------------------------
+// reset() -- build the grids, if enabled
+//------------------------------------------------------------------------------
+void IrAtmosphere1::reset()
+{
+   BaseClass::reset();
+   if (precomputeFlg && !gridValid) buildGrids();
+}
+
 //------------------------------------------------------------------------------
 // Slot functions
 //------------------------------------------------------------------------------
@@ -88,6 +147,7 @@ bool IrAtmosphere1::setSlotSolarRadiationTable(const Basic::Table2* const tbl)
       if (solarRadiationTable != nullptr) solarRadiationTable->unref();
       tbl->ref();
       solarRadiationTable = tbl;
+      clearGrids();
       ok = true;
    }
    return ok;
@@ -100,6 +160,7 @@ bool IrAtmosphere1::setSlotBackgroundRadiationTable(const Basic::Table3* const t
       if (backgroundRadiationTable != nullptr) backgroundRadiationTable->unref();
       tbl->ref();
       backgroundRadiationTable = tbl;
+      clearGrids();
       ok = true;
    }
    return ok;
@@ -112,11 +173,290 @@ bool IrAtmosphere1::setSlotTransmissivityTable(const Basic::Table4* const tbl)
       if (transmissivityTable != nullptr) transmissivityTable->unref();
       tbl->ref();
       transmissivityTable = tbl;
+      clearGrids();
       ok = true;
    }
    return ok;
 }
 
+bool IrAtmosphere1::setSlotPrecompute(const Basic::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setPrecomputeEnabled( msg->getBoolean() );
+   }
+   return ok;
+}
+
+bool IrAtmosphere1::setSlotWaveBands(const Basic::Table1* const tbl)
+{
+   clearGrids();
+   return BaseClass::setSlotWaveBands(tbl);
+}
+
+bool IrAtmosphere1::setPrecomputeEnabled(const bool flg)
+{
+   precomputeFlg = flg;
+   if (!precomputeFlg) clearGrids();
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// buildGrids() -- interpolate the tables at each waveband center
+//------------------------------------------------------------------------------
+bool IrAtmosphere1::buildGrids()
+{
+   clearGrids();
+
+   const unsigned int nb = getNumWaveBands();
+   if (nb == 0 || solarRadiationTable == nullptr || backgroundRadiationTable == nullptr || transmissivityTable == nullptr) return false;
+   if (!solarRadiationTable->isValid() || !backgroundRadiationTable->isValid() || !transmissivityTable->isValid()) return false;
+
+   const LCreal* centerWavelengths = getWaveBandCenters();
+   const LCreal* widths = getWaveBandWidths();
+
+   // Waveband limits and fractions, computed the same as calculateAtmosphereContribution()
+   gridNumBands = nb;
+   bandLower = new LCreal[nb];
+   bandUpper = new LCreal[nb];
+   bandFraction = new LCreal[nb];
+   for (unsigned int i = 0; i < nb; i++) {
+      bandLower[i] = centerWavelengths[i] - (widths[i] / 2.0f);
+      bandUpper[i] = bandLower[i] + widths[i];
+      bandFraction[i] = (bandUpper[i] - bandLower[i]) / ((centerWavelengths[nb - 1] + (widths[nb - 1] / 2.0f))-(centerWavelengths[0] - (widths[0] / 2.0f)));
+   }
+
+   // Solar radiation by [target altitude][band], at the band centers
+   {
+      const Basic::Table2* tbl = solarRadiationTable;
+      const unsigned int nx = tbl->getNumXPoints();
+      const unsigned int ny = tbl->getNumYPoints();
+      solarGrid = new LCreal[ny * nb];
+      for (unsigned int k = 0; k < ny; k++) {
+         const LCreal* row = &tbl->getDataTable()[nx * k];
+         for (unsigned int i = 0; i < nb; i++) {
+            solarGrid[k * nb + i] = Basic::lfi::lfi_1D(centerWavelengths[i], tbl->getXData(), nx, row, tbl->isExtrapolationEnabled());
+         }
+      }
+   }
+
+   // Background radiation by [view angle][seeker altitude][band], at the band centers
+   {
+      const Basic::Table3* tbl = backgroundRadiationTable;
+      const unsigned int nx = tbl->getNumXPoints();
+      const unsigned int nyz = tbl->getNumYPoints() * tbl->getNumZPoints();
+      backgroundGrid = new LCreal[nyz * nb];
+      for (unsigned int k = 0; k < nyz; k++) {
+         const LCreal* row = &tbl->getDataTable()[nx * k];
+         for (unsigned int i = 0; i < nb; i++) {
+            const LCreal wavebandCenter = (bandUpper[i] + bandLower[i]) / 2.0;
+            backgroundGrid[k * nb + i] = Basic::lfi::lfi_1D(wavebandCenter, tbl->getXData(), nx, row, tbl->isExtrapolationEnabled());
+         }
+      }
+   }
+
+   // Transmissivity by [range][target altitude][seeker altitude][band], at the band centers
+   {
+      const Basic::Table4* tbl = transmissivityTable;
+      const unsigned int nx = tbl->getNumXPoints();
+      const unsigned int nyzw = tbl->getNumYPoints() * tbl->getNumZPoints() * tbl->getNumWPoints();
+      transGrid = new LCreal[nyzw * nb];
+      for (unsigned int k = 0; k < nyzw; k++) {
+         const LCreal* row = &tbl->getDataTable()[nx * k];
+         for (unsigned int i = 0; i < nb; i++) {
+            const LCreal wavebandCenter = (bandUpper[i] + bandLower[i]) / 2;
+            transGrid[k * nb + i] = Basic::lfi::lfi_1D(wavebandCenter, tbl->getXData(), nx, row, tbl->isExtrapolationEnabled());
+         }
+      }
+   }
+
+   gridValid = true;
+   checkGrids();
+
+   if (isMessageEnabled(MSG_INFO)) {
+      std::cout << "IrAtmosphere1::buildGrids(): " << nb << " wavebands; max difference from the tables: " << gridMaxErr << std::endl;
+   }
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// checkGrids() -- compares the grids with the tables at the center of each grid cell
+//------------------------------------------------------------------------------
+void IrAtmosphere1::checkGrids()
+{
+   gridMaxErr = 0.0;
+   if (!gridValid) return;
+
+   const LCreal* centerWavelengths = getWaveBandCenters();
+
+   // Solar radiation
+   {
+      const Basic::Table2* tbl = solarRadiationTable;
+      const unsigned int ny = tbl->getNumYPoints();
+      for (unsigned int k = 0; k < numCells(ny); k++) {
+         const LCreal alt = cellCenter(tbl->getYData(), ny, k);
+         Breakpoints bAlt;
+         findBreakpoints(&bAlt, alt, tbl->getYData(), ny, tbl->isExtrapolationEnabled());
+         for (unsigned int i = 0; i < gridNumBands; i++) {
+            const LCreal err = lcAbs(getGridSolarRadiation(i, bAlt) - getSolarRadiation(centerWavelengths[i], alt));
+            if (err > gridMaxErr) gridMaxErr = err;
+         }
+      }
+   }
+
+   // Background radiation
+   {
+      const Basic::Table3* tbl = backgroundRadiationTable;
+      const unsigned int ny = tbl->getNumYPoints();
+      const unsigned int nz = tbl->getNumZPoints();
+      for (unsigned int l = 0; l < numCells(nz); l++) {
+         const LCreal angle = cellCenter(tbl->getZData(), nz, l);
+         Breakpoints bAngle;
+         findBreakpoints(&bAngle, angle, tbl->getZData(), nz, tbl->isExtrapolationEnabled());
+         for (unsigned int k = 0; k < numCells(ny); k++) {
+            const LCreal alt = cellCenter(tbl->getYData(), ny, k);
+            Breakpoints bAlt;
+            findBreakpoints(&bAlt, alt, tbl->getYData(), ny, tbl->isExtrapolationEnabled());
+            for (unsigned int i = 0; i < gridNumBands; i++) {
+               const LCreal err = lcAbs(getGridBackgroundRadiation(i, bAlt, bAngle) - getBackgroundRadiation(bandLower[i], bandUpper[i], alt, angle));
+               if (err > gridMaxErr) gridMaxErr = err;
+            }
+         }
+      }
+   }
+
+   // Transmissivity
+   {
+      const Basic::Table4* tbl = transmissivityTable;
+      const unsigned int ny = tbl->getNumYPoints();
+      const unsigned int nz = tbl->getNumZPoints();
+      const unsigned int nw = tbl->getNumWPoints();
+      for (unsigned int m = 0; m < numCells(nw); m++) {
+         const LCreal range = cellCenter(tbl->getWData(), nw, m);
+         Breakpoints bRange;
+         findBreakpoints(&bRange, range, tbl->getWData(), nw, tbl->isExtrapolationEnabled());
+         for (unsigned int l = 0; l < numCells(nz); l++) {
+            const LCreal targetAlt = cellCenter(tbl->getZData(), nz, l);
+            Breakpoints bTargetAlt;
+            findBreakpoints(&bTargetAlt, targetAlt, tbl->getZData(), nz, tbl->isExtrapolationEnabled());
+            for (unsigned int k = 0; k < numCells(ny); k++) {
+               const LCreal seekerAlt = cellCenter(tbl->getYData(), ny, k);
+               Breakpoints bSeekerAlt;
+               findBreakpoints(&bSeekerAlt, seekerAlt, tbl->getYData(), ny, tbl->isExtrapolationEnabled());
+               for (unsigned int i = 0; i < gridNumBands; i++) {
+                  const LCreal trans = getTransmissivity(bandLower[i], bandUpper[i], seekerAlt, targetAlt, range);
+                  const LCreal err = lcAbs(getGridTransmissivity(i, bSeekerAlt, bTargetAlt, bRange) - trans);
+                  if (err > gridMaxErr) gridMaxErr = err;
+               }
+            }
+         }
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// clearGrids() -- free the grids
+//------------------------------------------------------------------------------
+void IrAtmosphere1::clearGrids()
+{
+   if (bandLower != nullptr)      { delete[] bandLower;      bandLower = nullptr; }
+   if (bandUpper != nullptr)      { delete[] bandUpper;      bandUpper = nullptr; }
+   if (bandFraction != nullptr)   { delete[] bandFraction;   bandFraction = nullptr; }
+   if (solarGrid != nullptr)      { delete[] solarGrid;      solarGrid = nullptr; }
+   if (backgroundGrid != nullptr) { delete[] backgroundGrid; backgroundGrid = nullptr; }
+   if (transGrid != nullptr)      { delete[] transGrid;      transGrid = nullptr; }
+   gridNumBands = 0;
+   gridValid = false;
+   gridMaxErr = 0.0;
+}
+
+//------------------------------------------------------------------------------
+// findBreakpoints() -- finds the breakpoints and the interpolation fraction
+// of 'x' the same way as Basic::lfi::lfi_1D(); if 'x' is clamped to an end
+// point then both breakpoints are the end point and the fraction is zero.
+//------------------------------------------------------------------------------
+void IrAtmosphere1::findBreakpoints(Breakpoints* const bp, const LCreal x, const LCreal* const xData, const unsigned int nx, const bool eFlg)
+{
+   bp->i1 = 0;
+   bp->i2 = 0;
+   bp->m = 0.0;
+   if (nx == 1) return;
+
+   // Check increasing vs decreasing order of the breakpoints
+   unsigned int low = 0;
+   unsigned int high = nx - 1;
+   int delta = 1;
+   if (xData[1] < xData[0]) {
+      low = nx - 1;
+      high = 0;
+      delta = -1;
+   }
+
+   // Find the breakpoints with endpoint checks
+   unsigned int x2 = 0;
+   if (x <= xData[low]) {
+      x2 = low + delta;
+      if (!eFlg) { bp->i1 = low; bp->i2 = low; return; }
+   }
+   else if (x >= xData[high]) {
+      x2 = high;
+      if (!eFlg) { bp->i1 = high; bp->i2 = high; return; }
+   }
+   else {
+      x2 = low + delta;
+      while (x > xData[x2]) { x2 += delta; }
+   }
+
+   const unsigned int x1 = x2 - delta;
+   bp->i1 = x1;
+   bp->i2 = x2;
+   bp->m = (x - xData[x1]) / (xData[x2] - xData[x1]);
+}
+
+//------------------------------------------------------------------------------
+// Grid interpolation, in the same order as the tables' lfi() functions
+//------------------------------------------------------------------------------
+
+LCreal IrAtmosphere1::getGridSolarRadiation(const unsigned int band, const Breakpoints& alt) const
+{
+   const LCreal* const g = &solarGrid[band];
+   const unsigned int nb = gridNumBands;
+   return lerp(alt.m, g[alt.i1 * nb], g[alt.i2 * nb]);
+}
+
+LCreal IrAtmosphere1::getGridBackgroundRadiation(const unsigned int band, const Breakpoints& alt, const Breakpoints& angle) const
+{
+   const LCreal* const g = &backgroundGrid[band];
+   const unsigned int nb = gridNumBands;
+   const unsigned int ny = backgroundRadiationTable->getNumYPoints();
+   const unsigned int r1 = angle.i1 * ny;
+   const unsigned int r2 = angle.i2 * ny;
+   const LCreal a1 = lerp(alt.m, g[(r1 + alt.i1) * nb], g[(r1 + alt.i2) * nb]);
+   const LCreal a2 = lerp(alt.m, g[(r2 + alt.i1) * nb], g[(r2 + alt.i2) * nb]);
+   return lerp(angle.m, a1, a2);
+}
+
+LCreal IrAtmosphere1::getGridTransmissivity(const unsigned int band, const Breakpoints& seekerAlt, const Breakpoints& targetAlt, const Breakpoints& range) const
+{
+   const LCreal* const g = &transGrid[band];
+   const unsigned int nb = gridNumBands;
+   const unsigned int ny = transmissivityTable->getNumYPoints();
+   const unsigned int nz = transmissivityTable->getNumZPoints();
+   const unsigned int r11 = (range.i1 * nz + targetAlt.i1) * ny;
+   const unsigned int r21 = (range.i1 * nz + targetAlt.i2) * ny;
+   const unsigned int r12 = (range.i2 * nz + targetAlt.i1) * ny;
+   const unsigned int r22 = (range.i2 * nz + targetAlt.i2) * ny;
+
+   const LCreal a11 = lerp(seekerAlt.m, g[(r11 + seekerAlt.i1) * nb], g[(r11 + seekerAlt.i2) * nb]);
+   const LCreal a21 = lerp(seekerAlt.m, g[(r21 + seekerAlt.i1) * nb], g[(r21 + seekerAlt.i2) * nb]);
+   const LCreal a12 = lerp(seekerAlt.m, g[(r12 + seekerAlt.i1) * nb], g[(r12 + seekerAlt.i2) * nb]);
+   const LCreal a22 = lerp(seekerAlt.m, g[(r22 + seekerAlt.i1) * nb], g[(r22 + seekerAlt.i2) * nb]);
+
+   const LCreal a1 = lerp(targetAlt.m, a11, a21);
+   const LCreal a2 = lerp(targetAlt.m, a12, a22);
+   return lerp(range.m, a1, a2);
+}
+
 
 bool IrAtmosphere1::calculateAtmosphereContribution(IrQueryMsg* const msg, LCreal* totalSignal, LCreal* totalBackground)
 {
@@ -144,6 +484,55 @@ bool IrAtmosphere1::calculateAtmosphereContribution(IrQueryMsg* const msg, LCrea
    *totalSignal = 0.0;
    *totalBackground = 0.0;
 
+   if (gridValid) {
+      // Precomputed grids: find the breakpoints once for all of the wavebands
+      const LCreal seekerAlt = static_cast<LCreal>(ownship->getAltitudeM());
+      const LCreal targetAlt = static_cast<LCreal>(target->getAltitudeM());
+
+      Breakpoints solarAlt;
+      findBreakpoints(&solarAlt, targetAlt, solarRadiationTable->getYData(), solarRadiationTable->getNumYPoints(), solarRadiationTable->isExtrapolationEnabled());
+
+      Breakpoints bgAlt;
+      Breakpoints bgAngle;
+      findBreakpoints(&bgAlt, seekerAlt, backgroundRadiationTable->getYData(), backgroundRadiationTable->getNumYPoints(), backgroundRadiationTable->isExtrapolationEnabled());
+      findBreakpoints(&bgAngle, viewingAngle, backgroundRadiationTable->getZData(), backgroundRadiationTable->getNumZPoints(), backgroundRadiationTable->isExtrapolationEnabled());
+
+      Breakpoints transSeekerAlt;
+      Breakpoints transTargetAlt;
+      Breakpoints transRange;
+      findBreakpoints(&transSeekerAlt, seekerAlt, transmissivityTable->getYData(), transmissivityTable->getNumYPoints(), transmissivityTable->isExtrapolationEnabled());
+      findBreakpoints(&transTargetAlt, targetAlt, transmissivityTable->getZData(), transmissivityTable->getNumZPoints(), transmissivityTable->isExtrapolationEnabled());
+      findBreakpoints(&transRange, range2D, transmissivityTable->getWData(), transmissivityTable->getNumWPoints(), transmissivityTable->isExtrapolationEnabled());
+
+      const LCreal lowerSensorBound = msg->getLowerWavelength();
+      const LCreal upperSensorBound = msg->getUpperWavelength();
+      const LCreal reflectance = (1.0f - msg->getEmissivity());
+      const LCreal simpleSignature = (sigArray == nullptr ? msg->getSignatureAtRange() : 0.0f);
+
+      LCreal signal = 0.0;
+      LCreal background = 0.0;
+      for (unsigned int i = 0; i < gridNumBands; i++) {
+         const LCreal lowerOverlap = getLowerEndOfWavelengthOverlap(bandLower[i], lowerSensorBound);
+         LCreal upperOverlap = getUpperEndOfWavelengthOverlap(bandUpper[i], upperSensorBound);
+         if (upperOverlap < lowerOverlap) upperOverlap = lowerOverlap;
+         const LCreal overlapRatio = (upperOverlap - lowerOverlap) / (bandUpper[i] - bandLower[i]);
+
+         const LCreal backgroundRadianceInBand = overlapRatio * getGridBackgroundRadiation(i, bgAlt, bgAngle);
+
+         LCreal radiantIntensityInBin = (sigArray == nullptr ? simpleSignature * bandFraction[i] * overlapRatio : sigArray[i*3 + 2]);
+         const LCreal solarRadiationInBin = reflectance * getGridSolarRadiation(i, solarAlt);
+         radiantIntensityInBin += (solarRadiationInBin * overlapRatio);
+
+         const LCreal transmissivity = getGridTransmissivity(i, transSeekerAlt, transTargetAlt, transRange);
+
+         signal += radiantIntensityInBin * transmissivity;
+         background += backgroundRadianceInBand * transmissivity;
+      }
+      *totalSignal = signal;
+      *totalBackground = background;
+      return true;
+   }
+
    for (unsigned int i=0; i<getNumWaveBands(); i++) {
       const LCreal lowerBandBound = centerWavelengths[i] - (widths[i] / 2.0f);
       const LCreal upperBandBound = lowerBandBound + widths[i];
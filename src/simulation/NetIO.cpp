@@ -11,6 +11,7 @@
 #include "openeaagles/simulation/Guns.h"
 #include "openeaagles/simulation/Missile.h"
 #include "openeaagles/simulation/Player.h"
+#include "openeaagles/simulation/PlayerSnapshot.h"
 #include "openeaagles/simulation/Sam.h"
 #include "openeaagles/simulation/SamVehicles.h"
 #include "openeaagles/simulation/Ships.h"
@@ -75,6 +76,8 @@ BEGIN_SLOTTABLE(NetIO)
    "maxOrientationError",  // 12: Max DR angular error
    "maxAge",               // 13: Max age (without update) of networked players
    "maxEntityRange",       // 14: Max entity range of networked players
+   "maxDrCheckInterval",   // 15: Max time between DR error checks of outgoing entities
+   "maxUpdateRate",        // 16: Max rate of DR updates of outgoing entities
 END_SLOTTABLE(NetIO)
 
 // Map slot table to handles
@@ -96,6 +99,8 @@ BEGIN_SLOT_MAP(NetIO)
    ON_SLOT(12, setSlotMaxOrientationErr,  Basic::Angle)
    ON_SLOT(13, setSlotMaxAge,             Basic::Time)
    ON_SLOT(14, setSlotMaxEntityRange,     Basic::Distance)
+   ON_SLOT(15, setSlotMaxDrCheckInterval, Basic::Time)
+   ON_SLOT(16, setSlotMaxUpdateRate,      Basic::Number)
 END_SLOT_MAP()
 
 //------------------------------------------------------------------------------
@@ -125,8 +130,17 @@ NetIO::NetIO()
    setMaxOrientationErr(NET_THRESHOLD_RAD);    //  (radians)
    setMaxAge(NET_TIMEOUT);                     //  (seconds)
 
+   maxDrCheckInterval = 0;                     // check every frame
+   maxUpdateRate = 0;                          // no limit
+   updateBudget = 0;
+   outputIdx = 0;
+   outputStartIdx = 0;
+   updateDeferred = false;
+
    nInNibs = 0;
    nOutNibs = 0;
+   initNibIndex(&inputIndex);
+   initNibIndex(&outputIndex);
 
    for (unsigned int i = 0; i < MAX_ENTITY_TYPES; i++) {
       inputEntityTypes[i] = nullptr;
@@ -167,6 +181,8 @@ void NetIO::copyData(const NetIO& org, const bool cc)
       }
       nOutputEntityTypes = 0;
 
+      initNibIndex(&inputIndex);
+      initNibIndex(&outputIndex);
    }
 
    station = nullptr;
@@ -193,9 +209,17 @@ void NetIO::copyData(const NetIO& org, const bool cc)
    setMaxPositionErr(org.maxPositionErr);
    setMaxOrientationErr(org.maxOrientationErr);
    setMaxAge(org.maxAge);
+   setMaxDrCheckInterval(org.maxDrCheckInterval);
+   setMaxUpdateRate(org.maxUpdateRate);
+   updateBudget = 0;
+   outputIdx = 0;
+   outputStartIdx = 0;
+   updateDeferred = false;
 
    nInNibs = 0;
    nOutNibs = 0;
+   clearNibIndex(&inputIndex);
+   clearNibIndex(&outputIndex);
 
    clearInputEntityTypes();
    for (unsigned int i = 0; i < org.nInputEntityTypes; i++) {
@@ -229,6 +253,9 @@ void NetIO::deleteData()
    }
    nOutNibs = 0;
 
+   freeNibIndex(&inputIndex);
+   freeNibIndex(&outputIndex);
+
    clearInputEntityTypes();
    clearOutputEntityTypes();
 
@@ -317,6 +344,26 @@ LCreal NetIO::getMaxAge(const Nib* const) const
    return maxAge;
 }
 
+// Update scheduling: reserves a DR update from this frame's budget
+bool NetIO::reserveOutputUpdate()
+{
+   bool ok = true;
+   if (maxUpdateRate > 0) {
+      if (updateBudget >= 1.0) {
+         updateBudget -= 1.0;
+      }
+      else {
+         // Over budget: defer, and start with this Nib next frame
+         if (!updateDeferred) {
+            outputStartIdx = outputIdx;
+            updateDeferred = true;
+         }
+         ok = false;
+      }
+   }
+   return ok;
+}
+
 // Federate name as String
 const Basic::String* NetIO::getFederateName() const
 {
@@ -387,6 +434,20 @@ bool NetIO::setMaxEntityRange(const LCreal v)
    return true;
 }
 
+// Sets the max time between DR error checks (sec)
+bool NetIO::setMaxDrCheckInterval(const LCreal v)
+{
+   maxDrCheckInterval = v;
+   return true;
+}
+
+// Sets the max rate of DR updates (updates/sec)
+bool NetIO::setMaxUpdateRate(const LCreal v)
+{
+   maxUpdateRate = v;
+   return true;
+}
+
 // Sets our federate name
 bool NetIO::setFederateName(const Basic::String* const msg)
 {
@@ -416,9 +477,16 @@ void NetIO::inputFrame(const LCreal)
 //------------------------------------------------------------------------------
 // outputFrame() -- output side of the network
 //------------------------------------------------------------------------------
-void NetIO::outputFrame(const LCreal)
+void NetIO::outputFrame(const LCreal dt)
 {
    if (isNetworkInitialized()) {
+      // Refill the DR update budget; unused updates aren't carried over
+      // from frame to frame, so the updates can't burst above the rate.
+      if (maxUpdateRate > 0) {
+         const LCreal maxBudget = lcMax(maxUpdateRate * dt, 1.0);
+         updateBudget = lcMin(updateBudget + maxUpdateRate * dt, maxBudget);
+      }
+
       updateOutputList();   // Update the Output-List from the simulation player list
       processOutputList();  // Create output packets from Output-List
    }
@@ -475,6 +543,7 @@ void NetIO::cleanupInputList()
                inputList[i] = inputList[i+1];
             }
             inputList[nInNibs] = nullptr;
+            eraseNibIndex(&inputIndex, nib);
 
             // 2) Destroy the NIB
             destroyInputNib(nib);
@@ -489,6 +558,7 @@ void NetIO::cleanupInputList()
                inputList[i] = inputList[i+1];
             }
             inputList[nInNibs] = nullptr;
+            eraseNibIndex(&inputIndex, nib);
 
             // 2) Destroy the NIB
             destroyInputNib(nib);
@@ -519,6 +589,7 @@ void NetIO::updateOutputList()
             if (outputList[i]->isMode(Player::DELETE_REQUEST)) {
                // Deleting this NIB
                //std::cout << "NetIO::updateOutputList() cleanup: nib = " << outputList[i] << std::endl;
+               eraseNibIndex(&outputIndex, outputList[i]);
                destroyOutputNib(outputList[i++]);
             }
             else {
@@ -536,49 +607,61 @@ void NetIO::updateOutputList()
       // --- ---
       if ( isOutputEnabled() ) {
 
-         // Get the player list pointer (pre-ref()'d)
-         Basic::PairStream* players = getSimulation()->getPlayers();
-
-         // For all players
-         bool finished = false;
-         unsigned int newCount = 0;
-         Basic::List::Item* playerItem = players->getFirstItem();
-         while (playerItem != nullptr && !finished) {
-
-            // Get player list items
-            Basic::Pair* playerPair = static_cast<Basic::Pair*>(playerItem->getValue());
-            Player* player = static_cast<Player*>(playerPair->object());
-
-            if (player->isLocalPlayer() || (isRelayEnabled() && player->getNetworkID() != getNetworkID()) )  {
-               if ( player->isActive() && player->isNetOutputEnabled()) {
-
-                  // We have (1) an active local player to output or
-                  //         (2) an active networked player to relay ...
-
-                  // Find the output NIB for this player
-                  Nib* nib = findNib(player, OUTPUT_NIB);
-                  if (nib == nullptr && newCount < MAX_NEW_OUTGOING) {
-                     // Not Found then create a new output NIB for this player
-                     nib = insertNewOutputNib( player );
-                     newCount++;
-                  }
-
-                  // Mark this NIB as checked
-                  if (nib != nullptr) {
-                     nib->setCheckedFlag(true);
+         // Get the player snapshot pointer (pre-ref()'d)
+         const PlayerSnapshot* snapshot = getSimulation()->getPlayerSnapshot();
+         if (snapshot != nullptr) {
+
+            const unsigned int n = snapshot->getNumPlayers();
+            Player* const* players = snapshot->getPlayers();
+            const unsigned char* modes = snapshot->getModes();
+            const unsigned char* flags = snapshot->getFlags();
+            const int* netIDs = snapshot->getNetworkIDs();
+
+            // For all players
+            bool finished = false;
+            unsigned int newCount = 0;
+            for (unsigned int i = 0; i < n && !finished; i++) {
+
+               const bool localPlayer = (flags[i] & PlayerSnapshot::NETWORKED) == 0;
+               if (localPlayer || (isRelayEnabled() && netIDs[i] != getNetworkID()) )  {
+                  if ( modes[i] == Player::ACTIVE && (flags[i] & PlayerSnapshot::NET_OUTPUT) != 0 ) {
+
+                     // We have (1) an active local player to output or
+                     //         (2) an active networked player to relay ...
+                     // (but check that the player is still active)
+                     Player* player = players[i];
+                     if (player->isActive()) {
+
+                        // Find the output NIB for this player
+                        Nib* nib = findNib(player, OUTPUT_NIB);
+                        if (nib == nullptr && newCount < MAX_NEW_OUTGOING) {
+                           // Not Found then create a new output NIB for this player
+                           nib = insertNewOutputNib( player );
+                           newCount++;
+                        }
+
+                        // Mark this NIB as checked
+                        if (nib != nullptr) {
+                           nib->setCheckedFlag(true);
+                        }
+                     }
                   }
                }
-            }
-            else {
-               // Finished with local players and we're not relaying
-               finished = !isRelayEnabled();
+               else {
+                  // Finished with local players and we're not relaying
+                  finished = !isRelayEnabled();
+               }
             }
 
-            // get the next player
-            playerItem = playerItem->getNext();
+            snapshot->unref();
+         }
+         else {
+            // No snapshot yet (i.e., before the first time-critical frame),
+            // so keep all of our current NIBs
+            for (unsigned int i = 0; i < nOutNibs; i++) {
+               outputList[i]->setCheckedFlag(true);
+            }
          }
-
-         players->unref();
       }
 
       // ---
@@ -603,11 +686,16 @@ void NetIO::updateOutputList()
 void NetIO::processOutputList()
 {
    // ---
-   // Send player states
+   // Send player states, starting with the first Nib that had its
+   // update deferred last frame (see "Update scheduling")
    // ---
-   for (unsigned int idx = 0; idx < getOutputListSize(); idx++) {
+   const unsigned int n = getOutputListSize();
+   const unsigned int start = (outputStartIdx < n ? outputStartIdx : 0);
+   updateDeferred = false;
+   for (unsigned int i = 0; i < n; i++) {
 
-      Nib* nib = getOutputNib(idx);
+      outputIdx = (start + i) % n;
+      Nib* nib = getOutputNib(outputIdx);
       const double curExecTime = getSimulation()->getExecTimeSec();
 
       if (nib->isEntityTypeValid()) {
@@ -821,20 +909,22 @@ bool NetIO::addNib2InputList(Nib* const nib)
 //------------------------------------------------------------------------------
 Nib* NetIO::findNib(const unsigned short playerID, const Basic::String* const federateName, const IoType ioType)
 {
-   // Define the key
-   NibKey key(playerID, federateName);
+   const NibIndex& idx = (ioType == INPUT_NIB ? inputIndex : outputIndex);
+   if (idx.nibs == nullptr || federateName == nullptr) return nullptr;
 
-   // Binary search the table for the NIB
+   // Probe the hash index, and confirm the IDs of the NIBs with our key
+   const unsigned long long key = getNibKey(playerID, federateName);
    Nib* found = nullptr;
-   if (ioType == INPUT_NIB) {
-      Nib** k =
-         static_cast<Nib**>(bsearch(&key, inputList, nInNibs, sizeof(Nib*), compareKey2Nib));
-      if (k != nullptr) found = *k;
-   }
-   else {
-      Nib** k =
-         static_cast<Nib**>(bsearch(&key, outputList, nOutNibs, sizeof(Nib*), compareKey2Nib));
-      if (k != nullptr) found = *k;
+   unsigned int h = hashNibKey(key) & idx.mask;
+   while (found == nullptr && idx.nibs[h] != nullptr) {
+      if (idx.keys[h] == key) {
+         Nib* const nib = idx.nibs[h];
+         const Basic::String* const fName = nib->getFederateName();
+         if (nib->getPlayerID() == playerID && fName != nullptr && *fName == *federateName) {
+            found = nib;
+         }
+      }
+      h = (h + 1) & idx.mask;
    }
    return found;
 }
@@ -856,6 +946,40 @@ Nib* NetIO::findNib(const Player* const player, const IoType ioType)
    return found;
 }
 
+//------------------------------------------------------------------------------
+// findNibByKey() -- find the first NIB with the key (see getNibKey())
+//------------------------------------------------------------------------------
+Nib* NetIO::findNibByKey(const unsigned long long key, const IoType ioType) const
+{
+   const NibIndex& idx = (ioType == INPUT_NIB ? inputIndex : outputIndex);
+   if (idx.nibs == nullptr) return nullptr;
+
+   Nib* found = nullptr;
+   unsigned int h = hashNibKey(key) & idx.mask;
+   while (found == nullptr && idx.nibs[h] != nullptr) {
+      if (idx.keys[h] == key) found = idx.nibs[h];
+      h = (h + 1) & idx.mask;
+   }
+   return found;
+}
+
+//------------------------------------------------------------------------------
+// getNibKey() -- packed integer key of the NIB hash index: the player ID in
+// the low 16 bits and a hash (FNV-1a) of the federate name above it.
+//------------------------------------------------------------------------------
+unsigned long long NetIO::getNibKey(const unsigned short playerID, const Basic::String* const federateName) const
+{
+   unsigned int hash = 2166136261u;
+   if (federateName != nullptr) {
+      const char* p = *federateName;
+      while (p != nullptr && *p != '\0') {
+         hash ^= static_cast<unsigned char>(*p++);
+         hash *= 16777619u;
+      }
+   }
+   return ( (static_cast<unsigned long long>(hash) << 16) | playerID );
+}
+
 //------------------------------------------------------------------------------
 // addNibToList() -- adds a NIB to the quick access table
 //------------------------------------------------------------------------------
@@ -865,36 +989,38 @@ bool NetIO::addNibToList(Nib* const nib, const IoType ioType)
    if (nib != nullptr) {
       Nib** tbl = inputList;
       int n = nInNibs;
+      NibIndex* idx = &inputIndex;
       if (ioType == OUTPUT_NIB) {
          tbl = outputList;
          n = nOutNibs;
+         idx = &outputIndex;
       }
 
       if (n < MAX_OBJECTS) {
 
-         // Put the NIB on the top of the table
-         nib->ref();
-         tbl[n] = nib;
-
          // Create a key for this new NIB
          NibKey key(nib->getPlayerID(), nib->getFederateName());
 
-         if (n > 0) {
-            // Now, 'bubble down' to its correct position
-            int idx = n-1;
-            while (idx >= 0 && compareKey2Nib(&key, &tbl[idx]) <= 0) {
-               // Swap the table entries
-               Nib* tmp = tbl[idx];
-               tbl[idx] = tbl[idx+1];
-               tbl[idx+1] = tmp;
-               idx--;
-            }
+         // Binary search for its position (in front of any equal NIBs)
+         int lo = 0;
+         int hi = n;
+         while (lo < hi) {
+            const int mid = (lo + hi) / 2;
+            if (compareKey2Nib(&key, &tbl[mid]) <= 0) hi = mid;
+            else lo = mid + 1;
          }
 
+         // Make room and insert it
+         nib->ref();
+         if (lo < n) std::memmove(&tbl[lo+1], &tbl[lo], (n - lo) * sizeof(Nib*));
+         tbl[lo] = nib;
+
          // Increment the count
          if (ioType == OUTPUT_NIB) nOutNibs++;
          else nInNibs++;
 
+         insertNibIndex(idx, nib);
+
          ok = true;
       }
    }
@@ -908,24 +1034,41 @@ void NetIO::removeNibFromList(Nib* const nib, const IoType ioType)
 {
    Nib** tbl = inputList;
    int n = nInNibs;
+   NibIndex* idx = &inputIndex;
    if (ioType == OUTPUT_NIB) {
       tbl = outputList;
       n = nOutNibs;
+      idx = &outputIndex;
    }
 
+   if (nib == nullptr || n == 0) return;
+
    int found = -1;
-   // Find the NIB
+   // Find the NIB: binary search to the first NIB with its IDs ...
+   if (nib->getFederateName() != nullptr) {
+      NibKey key(nib->getPlayerID(), nib->getFederateName());
+      int lo = 0;
+      int hi = n;
+      while (lo < hi) {
+         const int mid = (lo + hi) / 2;
+         if (compareKey2Nib(&key, &tbl[mid]) <= 0) hi = mid;
+         else lo = mid + 1;
+      }
+      for (int i = lo; i < n && found < 0 && compareKey2Nib(&key, &tbl[i]) == 0; i++) {
+         if (nib == tbl[i]) found = i;
+      }
+   }
+   // ... or, if its IDs have changed, the hard way
    for (int i = 0; i < n && found < 0; i++) {
       if (nib == tbl[i]) found = i;
    }
 
    // Shift down all items above this NIB one position
    if (found >= 0) {
+      eraseNibIndex(idx, tbl[found]);
       tbl[found]->unref();
       int n1 = (n - 1);
-      for (int i = found; i < n1; i++) {
-         tbl[i] = tbl[i+1];
-      }
+      if (found < n1) std::memmove(&tbl[found], &tbl[found+1], (n1 - found) * sizeof(Nib*));
       tbl[n-1] = nullptr;
 
       // Decrement the count
@@ -934,6 +1077,101 @@ void NetIO::removeNibFromList(Nib* const nib, const IoType ioType)
    }
 }
 
+//------------------------------------------------------------------------------
+// NIB hash index functions
+//------------------------------------------------------------------------------
+
+// Allocates an empty index that's at least twice the size of our NIB tables
+void NetIO::initNibIndex(NibIndex* const idx)
+{
+   unsigned int size = 16;
+   while (size < 2 * static_cast<unsigned int>(MAX_OBJECTS)) size *= 2;
+   idx->keys = new unsigned long long[size];
+   idx->nibs = new Nib*[size];
+   idx->mask = size - 1;
+   clearNibIndex(idx);
+}
+
+void NetIO::freeNibIndex(NibIndex* const idx)
+{
+   if (idx->keys != nullptr) { delete[] idx->keys; idx->keys = nullptr; }
+   if (idx->nibs != nullptr) { delete[] idx->nibs; idx->nibs = nullptr; }
+   idx->mask = 0;
+}
+
+void NetIO::clearNibIndex(NibIndex* const idx)
+{
+   if (idx->nibs != nullptr) {
+      for (unsigned int i = 0; i <= idx->mask; i++) {
+         idx->keys[i] = 0;
+         idx->nibs[i] = nullptr;
+      }
+   }
+}
+
+void NetIO::insertNibIndex(NibIndex* const idx, Nib* const nib)
+{
+   if (idx->nibs == nullptr) return;
+
+   const unsigned long long key = getNibKey(nib->getPlayerID(), nib->getFederateName());
+   unsigned int h = hashNibKey(key) & idx->mask;
+   while (idx->nibs[h] != nullptr) {
+      h = (h + 1) & idx->mask;
+   }
+   idx->keys[h] = key;
+   idx->nibs[h] = nib;
+}
+
+// Removes the NIB, and then shifts the following entries of its probe
+// sequence back (no tombstones)
+void NetIO::eraseNibIndex(NibIndex* const idx, Nib* const nib)
+{
+   if (idx->nibs == nullptr) return;
+
+   // Find the NIB's slot: probe from its key's home slot ...
+   const unsigned long long key = getNibKey(nib->getPlayerID(), nib->getFederateName());
+   const unsigned int mask = idx->mask;
+   int found = -1;
+   unsigned int h = hashNibKey(key) & mask;
+   while (found < 0 && idx->nibs[h] != nullptr) {
+      if (idx->nibs[h] == nib) found = h;
+      h = (h + 1) & mask;
+   }
+   // ... or, if its IDs have changed, the hard way
+   for (unsigned int i = 0; found < 0 && i <= mask; i++) {
+      if (idx->nibs[i] == nib) found = i;
+   }
+   if (found < 0) return;
+
+   unsigned int hole = found;
+   unsigned int i = (hole + 1) & mask;
+   while (idx->nibs[i] != nullptr) {
+      // Move the entry back to the hole, unless its home slot is
+      // cyclically in (hole, i]
+      const unsigned int home = hashNibKey(idx->keys[i]) & mask;
+      if ( ((i - home) & mask) >= ((i - hole) & mask) ) {
+         idx->keys[hole] = idx->keys[i];
+         idx->nibs[hole] = idx->nibs[i];
+         hole = i;
+      }
+      i = (i + 1) & mask;
+   }
+   idx->keys[hole] = 0;
+   idx->nibs[hole] = nullptr;
+}
+
+// Mixes the bits of the key (64-bit finalizer)
+unsigned int NetIO::hashNibKey(const unsigned long long key)
+{
+   unsigned long long h = key;
+   h ^= (h >> 33);
+   h *= 0xff51afd7ed558ccdULL;
+   h ^= (h >> 33);
+   h *= 0xc4ceb9fe1a85ec53ULL;
+   h ^= (h >> 33);
+   return static_cast<unsigned int>(h);
+}
+
 //------------------------------------------------------------------------------
 // bsearch callbacks: object name compare function --
 //   True types are (const NibKey* key, const Nib** nib)
@@ -1320,6 +1558,38 @@ bool NetIO::setSlotMaxEntityRange(const Basic::Distance* const msg)
    return ok;
 }
 
+// Sets the max time between DR error checks
+bool NetIO::setSlotMaxDrCheckInterval(const Basic::Time* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const LCreal time = Basic::Seconds::convertStatic( *msg );
+      if (time >= 0) {
+         ok = setMaxDrCheckInterval( time );
+      }
+      else {
+         std::cerr << "NetIO::setSlotMaxDrCheckInterval(): invalid time; must be zero or greater" << std::endl;
+      }
+   }
+   return ok;
+}
+
+// Sets the max rate of DR updates
+bool NetIO::setSlotMaxUpdateRate(const Basic::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const LCreal rate = msg->getReal();
+      if (rate >= 0) {
+         ok = setMaxUpdateRate( rate );
+      }
+      else {
+         std::cerr << "NetIO::setSlotMaxUpdateRate(): invalid rate; must be zero or greater" << std::endl;
+      }
+   }
+   return ok;
+}
+
 //------------------------------------------------------------------------------
 // getSlotByIndex()
 //------------------------------------------------------------------------------
@@ -70,6 +70,7 @@ void Nib::initData()
    drTime = 0.0;
    drPos.set(0,0,0);
    drAngles.set(0,0,0);
+   drCheckTime = 0.0;
 
    smoothVel.set(0,0,0);
    smoothTime = 0.0;
@@ -126,6 +127,7 @@ void Nib::copyData(const Nib& org, const bool cc)
    utcTime = org.utcTime;
 
    drNum = org.drNum;
+   drCheckTime = 0.0;
    drP0 = org.drP0;
    drV0 = org.drV0;
    drA0 = org.drA0;
@@ -416,6 +418,7 @@ bool Nib::setDetonationMessageSent(const bool flg)
 bool Nib::isPlayerStateUpdateRequired(const LCreal curExecTime)
 {
    enum { NO, YES, UNSURE } result = UNSURE;
+   bool drUpdate = false;     // A dead reckoning update is due (max DR time or errors)
 
    // ---
    // 1) Make sure that we have a valid player and entity type
@@ -448,7 +451,7 @@ bool Nib::isPlayerStateUpdateRequired(const LCreal curExecTime)
       // 3-b) Max DR timeout
       if (result == UNSURE) {
          if ( drTime >= getNetIO()->getMaxTimeDR(this) ) {
-            result = YES;
+            drUpdate = true;
          }
       }
 
@@ -462,8 +465,9 @@ bool Nib::isPlayerStateUpdateRequired(const LCreal curExecTime)
             result = YES;
       }
 
-      // 3-d) Check dead reckoning errors
-      if (result == UNSURE && isNotFrozen()) {
+      // 3-d) Check dead reckoning errors, but only when the next check is
+      //      due (see predictDrCheckTime() and NetIO's "Update scheduling")
+      if (result == UNSURE && !drUpdate && isNotFrozen() && playerState.getTimeExec() >= drCheckTime) {
 
          // Compute our dead reckoned position and angles, which are
          // based on our last packet sent.
@@ -471,6 +475,9 @@ bool Nib::isPlayerStateUpdateRequired(const LCreal curExecTime)
          osg::Vec3d drAngles;
          mainDeadReckoning(drTime, &drPos, &drAngles);
 
+         LCreal posMargin = -1.0;   // Position error margin (meters), or negative if not checked
+         LCreal angMargin = -1.0;   // Orientation error margin (radians), or negative if not checked
+
          // 3-d-1) Position error
          if (!player->isPositionFrozen() && !player->isAltitudeFrozen()) {
 
@@ -483,13 +490,17 @@ bool Nib::isPlayerStateUpdateRequired(const LCreal curExecTime)
             //osg::Vec3d ppos = player->getGeocPosition();
             const osg::Vec3d ppos = playerState.getGeocPosition();
             const osg::Vec3d errPos = drPos - ppos;
-            if (errPos.length2() >= maxPosErr2) {
-               result = YES;
+            const double errPos2 = errPos.length2();
+            if (errPos2 >= maxPosErr2) {
+               drUpdate = true;
+            }
+            else {
+               posMargin = static_cast<LCreal>(maxPosErr - std::sqrt(errPos2));
             }
          }
 
          // 3-d-2) Orientation error
-         if (result == UNSURE && !player->isAttitudeFrozen()) {
+         if (!drUpdate && !player->isAttitudeFrozen()) {
 
             // max angle error (radians)
             const LCreal maxAngleErr = getNetIO()->getMaxOrientationErr(this);
@@ -500,14 +511,27 @@ bool Nib::isPlayerStateUpdateRequired(const LCreal curExecTime)
 
             // Check if any angle error is greater than the max error
             errAngles[0] = lcAbs( lcAepcDeg(errAngles[0]) );
-            if (errAngles[0] >= maxAngleErr) result = YES;
+            if (errAngles[0] >= maxAngleErr) drUpdate = true;
 
             errAngles[1] = lcAbs( lcAepcDeg(errAngles[1]) );
-            if (errAngles[1] >= maxAngleErr) result = YES;
+            if (errAngles[1] >= maxAngleErr) drUpdate = true;
 
             errAngles[2] = lcAbs( lcAepcDeg(errAngles[2]) );
-            if (errAngles[2] >= maxAngleErr) result = YES;
+            if (errAngles[2] >= maxAngleErr) drUpdate = true;
+
+            if (!drUpdate) {
+               const LCreal maxErr = lcMax( errAngles[0], lcMax(errAngles[1], errAngles[2]) );
+               angMargin = maxAngleErr - maxErr;
+            }
          }
+
+         if (!drUpdate) drCheckTime = predictDrCheckTime(playerState, drTime, posMargin, angMargin);
+      }
+
+      // 3-e) Dead reckoning update, unless it's deferred because we're
+      //      over the network's output update budget (see NetIO::reserveOutputUpdate())
+      if (result == UNSURE && drUpdate && getNetIO()->reserveOutputUpdate()) {
+         result = YES;
       }
    }
 
@@ -653,9 +677,82 @@ bool Nib::isPlayerStateUpdateRequired(const LCreal curExecTime)
       }
    }
 
+   // After an update, the DR errors start over; check them next frame
+   if (result == YES) drCheckTime = 0.0;
+
    return (result == YES);
 }
 
+//------------------------------------------------------------------------------
+// predictDrCheckTime() -- predicts when the DR errors could next reach their
+// thresholds, and returns the exec time (seconds) of the next DR error check.
+//
+//    The errors are projected from the current margins (max error less the
+//    current error) using the differences between the player's and the DR
+//    model's velocities, accelerations and angular rates.  The acceleration
+//    difference is assumed to keep growing at its average rate since the last
+//    update (i.e., a constant jerk).  Since none of these really stay constant,
+//    only half of the predicted time is used, limited by the network's max DR
+//    check interval.  Returns zero (check every frame) if the interval is zero
+//    or the DR model is body based.
+//------------------------------------------------------------------------------
+LCreal Nib::predictDrCheckTime(
+      const SynchronizedState& state,  // Player's state
+      const double dT,                 // DR time (seconds)
+      const LCreal posMargin,          // Position error margin (meters), or negative if not checked
+      const LCreal angMargin           // Orientation error margin (radians), or negative if not checked
+   ) const
+{
+   const LCreal maxInterval = getNetIO()->getMaxDrCheckInterval();
+   if (maxInterval <= 0) return 0;
+
+   // DR model's (world) velocity, acceleration and angular rates at time 'dT'
+   osg::Vec3d drVel = drV0;
+   osg::Vec3d drAcc(0,0,0);
+   osg::Vec3d drAngVel(0,0,0);
+   switch (drNum) {
+      case FPW_DRM: break;
+      case RPW_DRM: drAngVel = drAV0; break;
+      case RVW_DRM: drAngVel = drAV0; drVel += drA0*dT; drAcc = drA0; break;
+      case FVW_DRM: drVel += drA0*dT; drAcc = drA0; break;
+      default: return 0;
+   }
+
+   double dtCheck = maxInterval;
+
+   // Time for the position error to grow by 'posMargin':
+   //    dv*t + da*t^2/2 + dj*t^3/6 = posMargin
+   if (posMargin >= 0) {
+      const double dv = (state.getGeocVelocity() - drVel).length();
+      const double da = (state.getGeocAcceleration() - drAcc).length();
+      const double dj = (dT > 0 ? da/dT : 0);
+
+      // the error is increasing with time, so bisect [ 0 ... 2*dtCheck ]
+      const double tmax = 2.0*dtCheck;
+      if ( (dv*tmax + da*tmax*tmax/2.0 + dj*tmax*tmax*tmax/6.0) > posMargin ) {
+         double t0 = 0;
+         double t1 = tmax;
+         for (unsigned int i = 0; i < 16; i++) {
+            const double t = 0.5*(t0 + t1);
+            if ( (dv*t + da*t*t/2.0 + dj*t*t*t/6.0) > posMargin ) t1 = t;
+            else t0 = t;
+         }
+         dtCheck = 0.5*t0;
+      }
+   }
+
+   // Time for the orientation error to grow by 'angMargin'
+   if (angMargin >= 0) {
+      const double dw = (state.getAngularVelocities() - drAngVel).length();
+      if (dw > 0) {
+         const double t = angMargin / dw;
+         if ((0.5*t) < dtCheck) dtCheck = 0.5*t;
+      }
+   }
+
+   return static_cast<LCreal>(state.getTimeExec() + dtCheck);
+}
+
 //------------------------------------------------------------------------------
 // playerState2Nib() -- Sets this NIB's player data
 //------------------------------------------------------------------------------
@@ -3491,9 +3491,10 @@ void Player::processComponents(
 void Player::updateElevation()
 {
    // Only if isTerrainElevationRequired() is false, otherwise the terrain
-   // elevation is from the OTW system.
+   // elevation is from the OTW system.  When the simulation refreshes the
+   // elevations with its batched query, there's nothing to do here.
    const Simulation* s = getSimulation();
-   if (s != nullptr && !isTerrainElevationRequired()) {
+   if (s != nullptr && !isTerrainElevationRequired() && !s->isTerrainElevationBatched()) {
       const Basic::Terrain* terrain = s->getTerrain();
       if (terrain != nullptr) {
          LCreal el = 0;
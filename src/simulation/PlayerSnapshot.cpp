@@ -0,0 +1,205 @@
+#include "openeaagles/simulation/PlayerSnapshot.h"
+
+#include "openeaagles/simulation/Player.h"
+#include "openeaagles/basic/List.h"
+#include "openeaagles/basic/PairStream.h"
+#include "openeaagles/basic/Pair.h"
+
+namespace Eaagles {
+namespace Simulation {
+
+//==============================================================================
+//  Class: PlayerSnapshot
+//==============================================================================
+
+IMPLEMENT_SUBCLASS(PlayerSnapshot,"PlayerSnapshot")
+EMPTY_SLOTTABLE(PlayerSnapshot)
+EMPTY_SERIALIZER(PlayerSnapshot)
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+PlayerSnapshot::PlayerSnapshot()
+{
+   STANDARD_CONSTRUCTOR()
+   initData();
+}
+
+void PlayerSnapshot::initData()
+{
+   playerList = nullptr;
+   numPlayers = 0;
+   capacity = 0;
+   execCounter = 0;
+   execTime = 0;
+
+   players = nullptr;
+   gPosX = nullptr;
+   gPosY = nullptr;
+   gPosZ = nullptr;
+   gVelX = nullptr;
+   gVelY = nullptr;
+   gVelZ = nullptr;
+   posX = nullptr;
+   posY = nullptr;
+   posZ = nullptr;
+   phi = nullptr;
+   theta = nullptr;
+   psi = nullptr;
+   majorTypes = nullptr;
+   modes = nullptr;
+   sides = nullptr;
+   netIDs = nullptr;
+   playerIDs = nullptr;
+   flags = nullptr;
+}
+
+//------------------------------------------------------------------------------
+// copyData() -- copy member data; the copy is rebuilt from the same list
+//------------------------------------------------------------------------------
+void PlayerSnapshot::copyData(const PlayerSnapshot& org, const bool cc)
+{
+   BaseClass::copyData(org);
+   if (cc) initData();
+
+   build(org.playerList, org.execCounter, org.execTime);
+}
+
+//------------------------------------------------------------------------------
+// deleteData() -- delete member data
+//------------------------------------------------------------------------------
+void PlayerSnapshot::deleteData()
+{
+   clear();
+   resize(0);
+}
+
+//------------------------------------------------------------------------------
+// clear() -- release our player list
+//------------------------------------------------------------------------------
+void PlayerSnapshot::clear()
+{
+   if (playerList != nullptr) { playerList->unref(); playerList = nullptr; }
+   numPlayers = 0;
+}
+
+//------------------------------------------------------------------------------
+// resize() -- (re)allocate the arrays; the old contents are not kept
+//------------------------------------------------------------------------------
+void PlayerSnapshot::resize(const unsigned int n)
+{
+   if (capacity > 0) {
+      delete[] players;    players = nullptr;
+      delete[] gPosX;      gPosX = nullptr;
+      delete[] gPosY;      gPosY = nullptr;
+      delete[] gPosZ;      gPosZ = nullptr;
+      delete[] gVelX;      gVelX = nullptr;
+      delete[] gVelY;      gVelY = nullptr;
+      delete[] gVelZ;      gVelZ = nullptr;
+      delete[] posX;       posX = nullptr;
+      delete[] posY;       posY = nullptr;
+      delete[] posZ;       posZ = nullptr;
+      delete[] phi;        phi = nullptr;
+      delete[] theta;      theta = nullptr;
+      delete[] psi;        psi = nullptr;
+      delete[] majorTypes; majorTypes = nullptr;
+      delete[] modes;      modes = nullptr;
+      delete[] sides;      sides = nullptr;
+      delete[] netIDs;     netIDs = nullptr;
+      delete[] playerIDs;  playerIDs = nullptr;
+      delete[] flags;      flags = nullptr;
+      capacity = 0;
+   }
+
+   if (n > 0) {
+      players = new Player*[n];
+      gPosX = new double[n];
+      gPosY = new double[n];
+      gPosZ = new double[n];
+      gVelX = new double[n];
+      gVelY = new double[n];
+      gVelZ = new double[n];
+      posX = new double[n];
+      posY = new double[n];
+      posZ = new double[n];
+      phi = new double[n];
+      theta = new double[n];
+      psi = new double[n];
+      majorTypes = new unsigned int[n];
+      modes = new unsigned char[n];
+      sides = new unsigned int[n];
+      netIDs = new int[n];
+      playerIDs = new unsigned short[n];
+      flags = new unsigned char[n];
+      capacity = n;
+   }
+}
+
+//------------------------------------------------------------------------------
+// build() -- copy the players' state from the player list
+//------------------------------------------------------------------------------
+bool PlayerSnapshot::build(Basic::PairStream* const list, const unsigned int ec, const double et)
+{
+   if (list != nullptr) list->ref();
+   clear();
+   playerList = list;
+   execCounter = ec;
+   execTime = et;
+
+   if (playerList == nullptr) return false;
+
+   // Grow the arrays (with some room to spare)
+   const unsigned int n = playerList->entries();
+   if (n > capacity) {
+      resize(n + (n / 4) + 16);
+   }
+
+   unsigned int i = 0;
+   const Basic::List::Item* item = playerList->getFirstItem();
+   while (item != nullptr && i < capacity) {
+      const Basic::Pair* pair = static_cast<const Basic::Pair*>(item->getValue());
+      Player* p = static_cast<Player*>(const_cast<Basic::Object*>(pair->object()));
+      players[i] = p;
+
+      const osg::Vec3d& gp = p->getGeocPosition();
+      gPosX[i] = gp[0];
+      gPosY[i] = gp[1];
+      gPosZ[i] = gp[2];
+
+      const osg::Vec3d& gv = p->getGeocVelocity();
+      gVelX[i] = gv[0];
+      gVelY[i] = gv[1];
+      gVelZ[i] = gv[2];
+
+      const osg::Vec3d& lp = p->getPosition();
+      posX[i] = lp[0];
+      posY[i] = lp[1];
+      posZ[i] = lp[2];
+
+      const osg::Vec3d& ea = p->getEulerAngles();
+      phi[i] = ea[0];
+      theta[i] = ea[1];
+      psi[i] = ea[2];
+
+      majorTypes[i] = p->getMajorType();
+      modes[i] = static_cast<unsigned char>(p->getMode());
+      sides[i] = p->getSide();
+      netIDs[i] = p->getNetworkID();
+      playerIDs[i] = p->getID();
+
+      unsigned char f = 0;
+      if (p->isNetworkedPlayer()) f |= NETWORKED;
+      if (p->isPositionVectorValid()) f |= POS_VEC_VALID;
+      if (p->isNetOutputEnabled()) f |= NET_OUTPUT;
+      flags[i] = f;
+
+      i++;
+      item = item->getNext();
+   }
+   numPlayers = i;
+
+   return true;
+}
+
+} // End Simulation namespace
+} // End Eaagles namespace
@@ -0,0 +1,419 @@
+#include "openeaagles/simulation/PlayerSpatialIndex.h"
+
+#include "openeaagles/simulation/Player.h"
+#include "openeaagles/basic/List.h"
+#include "openeaagles/basic/PairStream.h"
+#include "openeaagles/basic/Pair.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Eaagles {
+namespace Simulation {
+
+//==============================================================================
+//  Class: PlayerSpatialIndex
+//==============================================================================
+
+IMPLEMENT_PARTIAL_SUBCLASS(PlayerSpatialIndex,"PlayerSpatialIndex")
+EMPTY_SLOTTABLE(PlayerSpatialIndex)
+EMPTY_SERIALIZER(PlayerSpatialIndex)
+
+const double PlayerSpatialIndex::DEFAULT_CELL_SIZE = 20000.0;
+const double PlayerSpatialIndex::MIN_MOTION_PAD = 100.0;
+
+// Cell indexes are packed into 21 bits each
+static const int CELL_OFFSET = (1 << 20);
+static const int CELL_MAX = (1 << 20) - 1;
+
+//------------------------------------------------------------------------------
+// Constructor(s)
+//------------------------------------------------------------------------------
+PlayerSpatialIndex::PlayerSpatialIndex(const double cs)
+{
+   STANDARD_CONSTRUCTOR()
+   initData();
+   if (cs > 0) cellSize = cs;
+}
+
+PlayerSpatialIndex::PlayerSpatialIndex()
+{
+   STANDARD_CONSTRUCTOR()
+   initData();
+}
+
+PlayerSpatialIndex::PlayerSpatialIndex(const PlayerSpatialIndex& org)
+{
+    STANDARD_CONSTRUCTOR()
+    copyData(org,true);
+}
+
+PlayerSpatialIndex::~PlayerSpatialIndex()
+{
+   STANDARD_DESTRUCTOR()
+}
+
+PlayerSpatialIndex& PlayerSpatialIndex::operator=(const PlayerSpatialIndex& org)
+{
+    if (this != &org) copyData(org,false);
+    return *this;
+}
+
+PlayerSpatialIndex* PlayerSpatialIndex::clone() const
+{
+    return new PlayerSpatialIndex(*this);
+}
+
+void PlayerSpatialIndex::initData()
+{
+   playerList = nullptr;
+   players = nullptr;
+   numPlayers = 0;
+   cellSize = DEFAULT_CELL_SIZE;
+   execTime = 0;
+   maxSpeed = 0;
+
+   ecefGrid.entries = nullptr;
+   ecefGrid.cells = nullptr;
+   ecefGrid.numEntries = 0;
+   ecefGrid.numCells = 0;
+
+   nedGrid.entries = nullptr;
+   nedGrid.cells = nullptr;
+   nedGrid.numEntries = 0;
+   nedGrid.numCells = 0;
+}
+
+//------------------------------------------------------------------------------
+// copyData() -- copy member data; the copy is rebuilt from the same list
+//------------------------------------------------------------------------------
+void PlayerSpatialIndex::copyData(const PlayerSpatialIndex& org, const bool cc)
+{
+   BaseClass::copyData(org);
+   if (cc) initData();
+
+   cellSize = org.cellSize;
+   build(org.playerList, org.execTime);
+}
+
+//------------------------------------------------------------------------------
+// deleteData() -- delete member data
+//------------------------------------------------------------------------------
+void PlayerSpatialIndex::deleteData()
+{
+   clear();
+}
+
+//------------------------------------------------------------------------------
+// clear() -- free the grids and our player list
+//------------------------------------------------------------------------------
+void PlayerSpatialIndex::clear()
+{
+   Grid* grids[2] = { &ecefGrid, &nedGrid };
+   for (unsigned int g = 0; g < 2; g++) {
+      if (grids[g]->entries != nullptr) { delete[] grids[g]->entries; grids[g]->entries = nullptr; }
+      if (grids[g]->cells != nullptr)   { delete[] grids[g]->cells;   grids[g]->cells = nullptr; }
+      grids[g]->numEntries = 0;
+      grids[g]->numCells = 0;
+   }
+
+   if (players != nullptr) { delete[] players; players = nullptr; }
+   numPlayers = 0;
+
+   if (playerList != nullptr) { playerList->unref(); playerList = nullptr; }
+}
+
+//------------------------------------------------------------------------------
+// getMotionPad() -- Distance (meters) that the players may have moved since
+// the index was built.  Allows for twice the max speed (i.e., accelerating
+// players) and one extra tenth of a second because the player positions may
+// lag the executive time by a time-critical frame.
+//------------------------------------------------------------------------------
+double PlayerSpatialIndex::getMotionPad(const double currentExecTime) const
+{
+   double dt = currentExecTime - execTime;
+   if (dt < 0) dt = 0;
+   return MIN_MOTION_PAD + (2.0 * maxSpeed * (dt + 0.1));
+}
+
+//------------------------------------------------------------------------------
+// Cell functions
+//------------------------------------------------------------------------------
+int PlayerSpatialIndex::cellIndex(const double v) const
+{
+   double c = std::floor(v / cellSize);
+   if (c < -CELL_OFFSET) c = -CELL_OFFSET;
+   if (c > CELL_MAX) c = CELL_MAX;
+   return static_cast<int>(c);
+}
+
+unsigned long long PlayerSpatialIndex::cellKey(const int i, const int j, const int k)
+{
+   const unsigned long long ii = static_cast<unsigned long long>(i + CELL_OFFSET);
+   const unsigned long long jj = static_cast<unsigned long long>(j + CELL_OFFSET);
+   const unsigned long long kk = static_cast<unsigned long long>(k + CELL_OFFSET);
+   return (ii << 42) | (jj << 21) | kk;
+}
+
+//------------------------------------------------------------------------------
+// build() -- (Re)builds the index from the player list
+//------------------------------------------------------------------------------
+bool PlayerSpatialIndex::build(Basic::PairStream* const list, const double time)
+{
+   if (list != nullptr) list->ref();
+   clear();
+   playerList = list;
+   execTime = time;
+   maxSpeed = 0;
+
+   if (playerList == nullptr) return false;
+
+   // ---
+   // Load the players and their positions
+   // ---
+   const unsigned int n = playerList->entries();
+   if (n > 0) {
+      players = new Player*[n];
+      ecefGrid.entries = new Entry[n];
+      nedGrid.entries = new Entry[n];
+
+      unsigned int i = 0;
+      const Basic::List::Item* item = playerList->getFirstItem();
+      while (item != nullptr && i < n) {
+         const Basic::Pair* pair = static_cast<const Basic::Pair*>(item->getValue());
+         Player* p = static_cast<Player*>(const_cast<Basic::Object*>(pair->object()));
+         players[i] = p;
+
+         const osg::Vec3d pe = p->getGeocPosition();
+         Entry* e = &ecefGrid.entries[ecefGrid.numEntries++];
+         e->idx = i;
+         e->pos[0] = pe[0];
+         e->pos[1] = pe[1];
+         e->pos[2] = pe[2];
+
+         if (p->isPositionVectorValid()) {
+            const osg::Vec3d pn = p->getPosition();
+            Entry* en = &nedGrid.entries[nedGrid.numEntries++];
+            en->idx = i;
+            en->pos[0] = pn[0];
+            en->pos[1] = pn[1];
+            en->pos[2] = pn[2];
+         }
+
+         const double spd = p->getGeocVelocity().length();
+         if (spd > maxSpeed) maxSpeed = spd;
+
+         i++;
+         item = item->getNext();
+      }
+      numPlayers = i;
+   }
+
+   // ---
+   // Build the grids
+   // ---
+   buildGrid(&ecefGrid);
+   buildGrid(&nedGrid);
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// buildGrid() -- sorts the grid's entries by cell and creates the cells
+//------------------------------------------------------------------------------
+void PlayerSpatialIndex::buildGrid(Grid* const grid)
+{
+   const unsigned int n = grid->numEntries;
+   if (n == 0) return;
+
+   for (unsigned int i = 0; i < n; i++) {
+      Entry* e = &grid->entries[i];
+      e->key = cellKey( cellIndex(e->pos[0]), cellIndex(e->pos[1]), cellIndex(e->pos[2]) );
+   }
+
+   // Sort by cell key, then by player list index
+   std::sort(grid->entries, grid->entries + n,
+      [](const Entry& a, const Entry& b) { return (a.key < b.key) || (a.key == b.key && a.idx < b.idx); } );
+
+   // Occupied cells
+   grid->cells = new Cell[n];
+   unsigned int nc = 0;
+   for (unsigned int i = 0; i < n; i++) {
+      const Entry* e = &grid->entries[i];
+      if (nc == 0 || grid->cells[nc-1].key != e->key) {
+         Cell* c = &grid->cells[nc++];
+         c->key = e->key;
+         c->ijk[0] = cellIndex(e->pos[0]);
+         c->ijk[1] = cellIndex(e->pos[1]);
+         c->ijk[2] = cellIndex(e->pos[2]);
+         c->start = i;
+         c->count = 0;
+      }
+      grid->cells[nc-1].count++;
+   }
+   grid->numCells = nc;
+}
+
+//------------------------------------------------------------------------------
+// query() -- candidate players in player list order
+//------------------------------------------------------------------------------
+unsigned int PlayerSpatialIndex::query(
+      const bool ecef,
+      const osg::Vec3d& p0,
+      const double maxRange,
+      const double pad,
+      const osg::Vec3d& boresight,
+      const double maxAngle,
+      Player** const cands,
+      unsigned int* const work
+   ) const
+{
+   if (cands == nullptr || work == nullptr || numPlayers == 0) return 0;
+
+   const Grid* grid = (ecef ? &ecefGrid : &nedGrid);
+   if (grid->numEntries == 0) return 0;
+
+   const unsigned int n = queryGrid(grid, p0, maxRange, pad, boresight, maxAngle, work);
+
+   // Player list order
+   std::sort(work, work + n);
+   for (unsigned int i = 0; i < n; i++) {
+      cands[i] = players[work[i]];
+   }
+
+   return n;
+}
+
+//------------------------------------------------------------------------------
+// queryGrid() -- player list indexes of the grid's candidate players (unsorted)
+//------------------------------------------------------------------------------
+unsigned int PlayerSpatialIndex::queryGrid(
+      const Grid* const grid,
+      const osg::Vec3d& p0,
+      const double maxRange,
+      const double pad,
+      const osg::Vec3d& boresight,
+      const double maxAngle,
+      unsigned int* const idx
+   ) const
+{
+   const double radius = maxRange + pad;
+   const double radius2 = radius * radius;
+   const bool useCone = (maxAngle > 0 && maxAngle < PI);
+   const double cellRadius = cellSize * 0.8660254037844386;  // half diagonal: sqrt(3)/2
+
+   // Query box (cell indexes)
+   int lo[3];
+   int hi[3];
+   double nBox = 1.0;
+   for (unsigned int a = 0; a < 3; a++) {
+      lo[a] = cellIndex(p0[a] - radius);
+      hi[a] = cellIndex(p0[a] + radius);
+      nBox *= static_cast<double>(hi[a] - lo[a] + 1);
+   }
+
+   // Either look up each cell in the query box, or scan all of the occupied
+   // cells, which ever is less work
+   const bool scanAll = (nBox > static_cast<double>(grid->numCells));
+   int ijk[3] = { lo[0], lo[1], lo[2] };
+   unsigned int ic = 0;
+
+   unsigned int n = 0;
+   for (;;) {
+
+      // ---
+      // Next cell
+      // ---
+      const Cell* c = nullptr;
+      if (scanAll) {
+         if (ic >= grid->numCells) break;
+         c = &grid->cells[ic++];
+         bool inBox = true;
+         for (unsigned int a = 0; a < 3 && inBox; a++) {
+            inBox = (c->ijk[a] >= lo[a] && c->ijk[a] <= hi[a]);
+         }
+         if (!inBox) continue;
+      }
+      else {
+         if (ijk[0] > hi[0]) break;
+         const unsigned long long key = cellKey(ijk[0], ijk[1], ijk[2]);
+         // step to the next cell in the box
+         if (++ijk[2] > hi[2]) {
+            ijk[2] = lo[2];
+            if (++ijk[1] > hi[1]) {
+               ijk[1] = lo[1];
+               ++ijk[0];
+            }
+         }
+         const Cell* const first = grid->cells;
+         const Cell* const end = first + grid->numCells;
+         const Cell* p = std::lower_bound(first, end, key,
+            [](const Cell& cell, const unsigned long long k) { return cell.key < k; } );
+         if (p == end || p->key != key) continue;
+         c = p;
+      }
+
+      // ---
+      // Cell range check: distance from p0 to the cell's box
+      // ---
+      double d2 = 0;
+      double cv[3];
+      for (unsigned int a = 0; a < 3; a++) {
+         const double cmin = c->ijk[a] * cellSize;
+         const double cmax = cmin + cellSize;
+         double d = 0;
+         if (p0[a] < cmin) d = cmin - p0[a];
+         else if (p0[a] > cmax) d = p0[a] - cmax;
+         d2 += d * d;
+         cv[a] = (cmin + cellSize * 0.5) - p0[a];
+      }
+      if (d2 > radius2) continue;
+
+      // ---
+      // Cell cone check: the cell's bounding sphere, padded
+      // ---
+      if (useCone) {
+         const double dist = std::sqrt(cv[0]*cv[0] + cv[1]*cv[1] + cv[2]*cv[2]);
+         if ( !inCone(cv, dist, (cellRadius + pad), boresight, maxAngle) ) continue;
+      }
+
+      // ---
+      // The cell's players
+      // ---
+      for (unsigned int i = c->start; i < (c->start + c->count); i++) {
+         const Entry* e = &grid->entries[i];
+         double v[3] = { e->pos[0] - p0[0], e->pos[1] - p0[1], e->pos[2] - p0[2] };
+         const double r2 = v[0]*v[0] + v[1]*v[1] + v[2]*v[2];
+         if (r2 <= radius2) {
+            if ( !useCone || inCone(v, std::sqrt(r2), pad, boresight, maxAngle) ) {
+               idx[n++] = e->idx;
+            }
+         }
+      }
+   }
+
+   return n;
+}
+
+//------------------------------------------------------------------------------
+// inCone() -- is the vector 'v' of length 'dist' within 'maxAngle' of the
+// boresight, give or take the angle subtended by 'margin' meters?
+//------------------------------------------------------------------------------
+bool PlayerSpatialIndex::inCone(
+      const double* const v,
+      const double dist,
+      const double margin,
+      const osg::Vec3d& boresight,
+      const double maxAngle)
+{
+   if (dist <= margin) return true;
+
+   double cosAng = (v[0]*boresight[0] + v[1]*boresight[1] + v[2]*boresight[2]) / dist;
+   if (cosAng > 1.0) cosAng = 1.0;
+   if (cosAng < -1.0) cosAng = -1.0;
+
+   return std::acos(cosAng) <= (maxAngle + std::asin(margin / dist));
+}
+
+} // End Simulation namespace
+} // End Eaagles namespace
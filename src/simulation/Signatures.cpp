@@ -11,6 +11,8 @@
 #include "openeaagles/basic/units/Areas.h"
 #include "openeaagles/basic/units/Distances.h"
 
+#include <cmath>
+
 namespace Eaagles {
 namespace Simulation {
 
@@ -545,6 +547,8 @@ BEGIN_SLOTTABLE(SigAzEl)
                         //    el are in degrees instead of the default radians
     "inDecibel",        // 4: True if the dependent data is in decibel meters
                         //    squared instead of the default meters squared
+    "cacheResolution",  // 5: Angular resolution of the aspect angle RCS cache (default: no cache)
+    "cacheInterpolate", // 6: True to interpolate between the cache's aspect bins
 END_SLOTTABLE(SigAzEl)
 
 // Map slot table to handles
@@ -553,6 +557,9 @@ BEGIN_SLOT_MAP(SigAzEl)
     ON_SLOT(2, setSlotSwapOrder,    Basic::Number)
     ON_SLOT(3, setSlotInDegrees,    Basic::Number)
     ON_SLOT(4, setSlotDecibel,      Basic::Number)
+    ON_SLOT(5, setSlotCacheResolution,  Basic::Angle)     // Check for Basic::Angle before Basic::Number
+    ON_SLOT(5, setSlotCacheResolution,  Basic::Number)
+    ON_SLOT(6, setSlotCacheInterpolate, Basic::Number)
 END_SLOT_MAP()
 
 //------------------------------------------------------------------------------
@@ -562,23 +569,39 @@ SigAzEl::SigAzEl()
 {
    STANDARD_CONSTRUCTOR()
 
-   tbl = nullptr;
-   swapOrderFlg = false;
-   degFlg = false;
-   dbFlg = false;
+   initData();
 }
 
 SigAzEl::SigAzEl(const Basic::Table2* const tbl0)
 {
    STANDARD_CONSTRUCTOR()
 
-   tbl = nullptr;
+   initData();
    if (tbl0 != nullptr) {
       tbl = tbl0->clone();
    }
+}
+
+void SigAzEl::initData()
+{
+   tbl = nullptr;
    swapOrderFlg = false;
    degFlg = false;
    dbFlg = false;
+
+   cacheRes = 0.0;
+   cacheLfiFlg = true;
+   cacheValid = false;
+   cache = nullptr;
+   cacheNumAz = 0;
+   cacheNumEl = 0;
+   cacheMinAz = 0.0;
+   cacheMaxAz = 0.0;
+   cacheMinEl = 0.0;
+   cacheMaxEl = 0.0;
+   cacheAzScale = 0.0;
+   cacheElScale = 0.0;
+   cacheMaxErr = 0.0;
 }
 
 //------------------------------------------------------------------------------
@@ -588,7 +611,7 @@ void SigAzEl::copyData(const SigAzEl& org, const bool cc)
 {
    BaseClass::copyData(org);
    if (cc) {
-      tbl = nullptr;
+      initData();
    }
 
    if (tbl != nullptr) { tbl->unref(); tbl = nullptr; }
@@ -599,6 +622,26 @@ void SigAzEl::copyData(const SigAzEl& org, const bool cc)
    swapOrderFlg = org.swapOrderFlg;
    degFlg = org.degFlg;
    dbFlg = org.dbFlg;
+
+   // Copy the cache
+   clearCache();
+   cacheRes = org.cacheRes;
+   cacheLfiFlg = org.cacheLfiFlg;
+   if (org.cacheValid) {
+      const unsigned int n = org.cacheNumAz * org.cacheNumEl;
+      cache = new LCreal[n];
+      for (unsigned int i = 0; i < n; i++) cache[i] = org.cache[i];
+      cacheNumAz = org.cacheNumAz;
+      cacheNumEl = org.cacheNumEl;
+      cacheMinAz = org.cacheMinAz;
+      cacheMaxAz = org.cacheMaxAz;
+      cacheMinEl = org.cacheMinEl;
+      cacheMaxEl = org.cacheMaxEl;
+      cacheAzScale = org.cacheAzScale;
+      cacheElScale = org.cacheElScale;
+      cacheMaxErr = org.cacheMaxErr;
+      cacheValid = true;
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -606,6 +649,7 @@ void SigAzEl::copyData(const SigAzEl& org, const bool cc)
 //------------------------------------------------------------------------------
 void SigAzEl::deleteData()
 {
+    clearCache();
     if (tbl != nullptr) { tbl->unref(); tbl = nullptr; }
 }
 
@@ -618,13 +662,35 @@ LCreal SigAzEl::getRCS(const Emission* const em)
    if (em != nullptr && tbl != nullptr) {
 
       // angle of arrival (radians)
-      LCreal iv1 = em->getAzimuthAoi();
-      LCreal iv2 = em->getElevationAoi();
+      const LCreal az = em->getAzimuthAoi();
+      const LCreal el = em->getElevationAoi();
+
+      // (the cache is only read here; it's built by the set functions)
+      if (cacheValid && az >= cacheMinAz && az <= cacheMaxAz && el >= cacheMinEl && el <= cacheMaxEl) {
+         rcs = lookupCache(az, el);
+      }
+      else {
+         rcs = computeRCS(az, el);
+      }
+   }
+   return rcs;
+}
+
+//------------------------------------------------------------------------------
+// computeRCS() -- RCS from the table for the angles of arrival (radians)
+//------------------------------------------------------------------------------
+LCreal SigAzEl::computeRCS(const LCreal az, const LCreal el) const
+{
+   LCreal rcs = 0.0;
+   if (tbl != nullptr) {
+
+      LCreal iv1 = az;
+      LCreal iv2 = el;
 
       // If the table's independent variable's order is swapped: (El, Az)
       if (isOrderSwapped()) {
-         iv1 = em->getElevationAoi();
-         iv2 = em->getAzimuthAoi();
+         iv1 = el;
+         iv2 = az;
       }
 
       // If the table's independent variables are in degrees ..
@@ -643,6 +709,128 @@ LCreal SigAzEl::getRCS(const Emission* const em)
    return rcs;
 }
 
+//------------------------------------------------------------------------------
+// buildCache() -- Builds the aspect angle RCS cache from the table
+//------------------------------------------------------------------------------
+bool SigAzEl::buildCache()
+{
+   clearCache();
+   if (cacheRes <= 0.0 || !isTableValid()) return false;
+
+   // The table's az/el breakpoint limits (radians)
+   LCreal min1 = tbl->getMinX();
+   LCreal max1 = tbl->getMaxX();
+   LCreal min2 = tbl->getMinY();
+   LCreal max2 = tbl->getMaxY();
+   if (isInDegrees()) {
+      min1 *= static_cast<LCreal>(Basic::Angle::D2RCC);
+      max1 *= static_cast<LCreal>(Basic::Angle::D2RCC);
+      min2 *= static_cast<LCreal>(Basic::Angle::D2RCC);
+      max2 *= static_cast<LCreal>(Basic::Angle::D2RCC);
+   }
+   if (isOrderSwapped()) {
+      cacheMinAz = min2; cacheMaxAz = max2;
+      cacheMinEl = min1; cacheMaxEl = max1;
+   }
+   else {
+      cacheMinAz = min1; cacheMaxAz = max1;
+      cacheMinEl = min2; cacheMaxEl = max2;
+   }
+
+   // Grid size: a spacing of no more than the resolution, and at least two points per axis
+   const double nAz = std::ceil((cacheMaxAz - cacheMinAz) / cacheRes) + 1.0;
+   const double nEl = std::ceil((cacheMaxEl - cacheMinEl) / cacheRes) + 1.0;
+   if ((nAz < 2.0 ? 2.0 : nAz) * (nEl < 2.0 ? 2.0 : nEl) > MAX_CACHE_SIZE) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "SigAzEl::buildCache(): cache resolution is too small; not using the cache." << std::endl;
+      }
+      cacheRes = 0.0;
+      return false;
+   }
+   cacheNumAz = (nAz < 2.0 ? 2 : static_cast<unsigned int>(nAz));
+   cacheNumEl = (nEl < 2.0 ? 2 : static_cast<unsigned int>(nEl));
+
+   const LCreal azStep = (cacheMaxAz - cacheMinAz) / static_cast<LCreal>(cacheNumAz - 1);
+   const LCreal elStep = (cacheMaxEl - cacheMinEl) / static_cast<LCreal>(cacheNumEl - 1);
+   cacheAzScale = (azStep > 0.0 ? 1.0 / azStep : 0.0);
+   cacheElScale = (elStep > 0.0 ? 1.0 / elStep : 0.0);
+
+   // The RCS at the grid points
+   cache = new LCreal[cacheNumAz * cacheNumEl];
+   for (unsigned int i = 0; i < cacheNumAz; i++) {
+      const LCreal az = cacheMinAz + azStep * static_cast<LCreal>(i);
+      LCreal* const row = &cache[i * cacheNumEl];
+      for (unsigned int j = 0; j < cacheNumEl; j++) {
+         row[j] = computeRCS(az, cacheMinEl + elStep * static_cast<LCreal>(j));
+      }
+   }
+   cacheValid = true;
+
+   // Compare with the table at the center of each cell
+   for (unsigned int i = 0; i < (cacheNumAz - 1); i++) {
+      const LCreal az = cacheMinAz + azStep * (static_cast<LCreal>(i) + 0.5);
+      for (unsigned int j = 0; j < (cacheNumEl - 1); j++) {
+         const LCreal el = cacheMinEl + elStep * (static_cast<LCreal>(j) + 0.5);
+         const LCreal exact = computeRCS(az, el);
+         const LCreal cached = lookupCache(az, el);
+         const LCreal mag = (exact > cached ? exact : cached);
+         if (mag > 0.0) {
+            const LCreal err = lcAbs(cached - exact) / mag;
+            if (err > cacheMaxErr) cacheMaxErr = err;
+         }
+      }
+   }
+
+   if (isMessageEnabled(MSG_INFO)) {
+      std::cout << "SigAzEl::buildCache(): " << cacheNumAz << " x " << cacheNumEl;
+      std::cout << " aspect bins; max relative error: " << cacheMaxErr << std::endl;
+   }
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// lookupCache() -- RCS from the cache; the angles must be within the cache's limits
+//------------------------------------------------------------------------------
+LCreal SigAzEl::lookupCache(const LCreal az, const LCreal el) const
+{
+   const LCreal x = (az - cacheMinAz) * cacheAzScale;
+   const LCreal y = (el - cacheMinEl) * cacheElScale;
+
+   LCreal rcs = 0.0;
+   if (cacheLfiFlg) {
+      unsigned int i = static_cast<unsigned int>(x);
+      if (i > (cacheNumAz - 2)) i = cacheNumAz - 2;
+      unsigned int j = static_cast<unsigned int>(y);
+      if (j > (cacheNumEl - 2)) j = cacheNumEl - 2;
+      const LCreal fx = x - static_cast<LCreal>(i);
+      const LCreal fy = y - static_cast<LCreal>(j);
+
+      const LCreal* const r0 = &cache[i * cacheNumEl + j];
+      const LCreal* const r1 = r0 + cacheNumEl;
+      const LCreal v0 = r0[0] + (r0[1] - r0[0]) * fy;
+      const LCreal v1 = r1[0] + (r1[1] - r1[0]) * fy;
+      rcs = v0 + (v1 - v0) * fx;
+   }
+   else {
+      const unsigned int i = static_cast<unsigned int>(x + 0.5);
+      const unsigned int j = static_cast<unsigned int>(y + 0.5);
+      rcs = cache[i * cacheNumEl + j];
+   }
+   return rcs;
+}
+
+//------------------------------------------------------------------------------
+// clearCache() -- Frees the cache
+//------------------------------------------------------------------------------
+void SigAzEl::clearCache()
+{
+   if (cache != nullptr) { delete[] cache; cache = nullptr; }
+   cacheValid = false;
+   cacheNumAz = 0;
+   cacheNumEl = 0;
+   cacheMaxErr = 0.0;
+}
+
 //------------------------------------------------------------------------------
 // isTableValid() -- Returns true if this signature has a good az/el table
 //------------------------------------------------------------------------------
@@ -662,18 +850,39 @@ bool SigAzEl::isTableValid() const
 bool SigAzEl::setSwapOrder(const bool flg)
 {
    swapOrderFlg = flg;
+   buildCache();
    return true;
 }
 
 bool SigAzEl::setInDegrees(const bool flg)
 {
    degFlg = flg;
+   buildCache();
    return true;
 }
 
 bool SigAzEl::setDecibel(const bool flg)
 {
    dbFlg = flg;
+   buildCache();
+   return true;
+}
+
+bool SigAzEl::setCacheResolution(const LCreal radians)
+{
+   bool ok = false;
+   if (radians >= 0.0) {
+      cacheRes = radians;
+      buildCache();
+      ok = true;
+   }
+   return ok;
+}
+
+bool SigAzEl::setCacheInterpolate(const bool flg)
+{
+   cacheLfiFlg = flg;
+   buildCache();
    return true;
 }
 
@@ -689,6 +898,7 @@ bool SigAzEl::setSlotTable(const Basic::Table2* const msg)
       if (tbl != nullptr) tbl->unref();
       msg->ref();
       tbl = msg;
+      buildCache();
       ok = true;
    }
    return ok;
@@ -721,6 +931,41 @@ bool SigAzEl::setSlotDecibel(const Basic::Number* const msg)
    return ok;
 }
 
+// Sets the cache resolution as a Basic::Angle
+bool SigAzEl::setSlotCacheResolution(const Basic::Angle* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setCacheResolution( static_cast<LCreal>(Basic::Radians::convertStatic( *msg )) );
+      if (!ok) {
+         std::cerr << "SigAzEl::setSlotCacheResolution: invalid resolution; must be greater than or equal to zero!" << std::endl;
+      }
+   }
+   return ok;
+}
+
+// Sets the cache resolution in radians
+bool SigAzEl::setSlotCacheResolution(const Basic::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setCacheResolution( msg->getReal() );
+      if (!ok) {
+         std::cerr << "SigAzEl::setSlotCacheResolution: invalid resolution; must be greater than or equal to zero!" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool SigAzEl::setSlotCacheInterpolate(const Basic::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setCacheInterpolate( msg->getBoolean() );
+   }
+   return ok;
+}
+
 //------------------------------------------------------------------------------
 // getSlotByIndex()
 //------------------------------------------------------------------------------
@@ -8,6 +8,8 @@
 #include "openeaagles/simulation/NetIO.h"
 #include "openeaagles/simulation/Nib.h"
 #include "openeaagles/simulation/Player.h"
+#include "openeaagles/simulation/PlayerSnapshot.h"
+#include "openeaagles/simulation/PlayerSpatialIndex.h"
 #include "openeaagles/simulation/Station.h"
 #include "openeaagles/simulation/TabLogger.h"
 
@@ -21,6 +23,7 @@
 #include "openeaagles/basic/Nav.h"
 #include "openeaagles/basic/PairStream.h"
 #include "openeaagles/basic/Pair.h"
+#include "openeaagles/basic/PhaseBarrier.h"
 #include "openeaagles/basic/Thread.h"
 #include "openeaagles/basic/units/Angles.h"
 #include "openeaagles/basic/units/Distances.h"
@@ -29,6 +32,7 @@
 #include "openeaagles/basic/osg/Vec4"
 #include "openeaagles/basic/Statistic.h"
 #include "openeaagles/basic/Terrain.h"
+#include "openeaagles/basic/WorkStealingExecutor.h"
 
 #include <cstring>
 #include <cmath>
@@ -43,49 +47,35 @@ namespace Simulation {
 class SimTcThread : public Basic::ThreadSyncTask {
    DECLARE_SUBCLASS(SimTcThread, Basic::ThreadSyncTask)
 public:
-   SimTcThread(Basic::Component* const parent, const LCreal priority);
+   SimTcThread(Basic::Component* const parent, const LCreal priority, Basic::PhaseBarrier* const barrier, const unsigned int worker);
 
-   // Parent thread signals start to this child thread with these parameters.
-   void start(
-      Basic::PairStream* const pl0,
-      const LCreal dt0,
-      const unsigned int idx0,
-      const unsigned int n0
-   );
+   // Parent thread sets our delta time before releasing the barrier.
+   void setDeltaTime(const LCreal dt);
 
 private:
    // ThreadSyncTask class function -- our userFunc()
    virtual unsigned long userFunc();
 
 private:
-   Basic::PairStream* pl0;
    LCreal dt0;
-   unsigned int idx0;
-   unsigned int n0;
+   unsigned int worker0;   // Our executor worker index
 };
 
 class SimBgThread : public Basic::ThreadSyncTask {
    DECLARE_SUBCLASS(SimBgThread,Basic::ThreadSyncTask)
 public:
-   SimBgThread(Basic::Component* const parent, const LCreal priority);
+   SimBgThread(Basic::Component* const parent, const LCreal priority, Basic::PhaseBarrier* const barrier, const unsigned int worker);
 
-   // Parent thread signals start to this child thread with these parameters.
-   void start(
-      Basic::PairStream* const pl0,
-      const LCreal dt0,
-      const unsigned int idx0,
-      const unsigned int n0
-   );
+   // Parent thread sets our delta time before releasing the barrier.
+   void setDeltaTime(const LCreal dt);
 
 private:
    // ThreadSyncTask class function -- our userFunc()
    virtual unsigned long userFunc();
 
 private:
-   Basic::PairStream* pl0;
    LCreal dt0;
-   unsigned int idx0;
-   unsigned int n0;
+   unsigned int worker0;   // Our executor worker index
 };
 
 
@@ -119,10 +109,16 @@ BEGIN_SLOTTABLE(Simulation)
 
    "earthModel",      // 17) Earth model for geodetic lat/lon (default is WGS-84)
 
-   "gamingAreaUseEarthModel" // 18) If true, use the 'earthModel' or its WGS-84 default for flat
+   "gamingAreaUseEarthModel", // 18) If true, use the 'earthModel' or its WGS-84 default for flat
                      //    earth projections between geodetic lat/lon and the gaming
                      //    area's NED coordinates.  Otherwise, use a standard spherical
                      //    earth with a radius of Nav::ERAD60. (default: false)
+
+   "playerIndexCellSize", // 19) Cell size of the player spatial index, or zero to disable the index
+                     //    (default: 0 -- disabled)
+
+   "terrainElevationBatch" // 20) Refresh the players' terrain elevations with one batched query
+                     //    (default: false)
 END_SLOTTABLE(Simulation)
 
 // slot map
@@ -154,6 +150,9 @@ BEGIN_SLOT_MAP(Simulation)
 
     ON_SLOT(18, setSlotGamingAreaEarthModel, Basic::Number)
 
+    ON_SLOT(19, setSlotPlayerIndexCellSize, Basic::Distance)
+    ON_SLOT(20, setSlotTerrainElevationBatch, Basic::Number)
+
 END_SLOT_MAP()
 
 //------------------------------------------------------------------------------
@@ -210,6 +209,16 @@ void Simulation::initData()
    cosRlat = 1.0;
    maxRefRange = 0.0;
    gaUseEmFlg = false;
+   pidxCellSize = 0;
+   spareSnapshot = nullptr;
+
+   tElevBatch = false;
+   tePlayers = nullptr;
+   teLats = nullptr;
+   teLons = nullptr;
+   teElevs = nullptr;
+   teValid = nullptr;
+   teSize = 0;
    Basic::Nav::computeWorldMatrix(refLat, refLon, &wm);
 
    cycleCnt = 0;
@@ -244,6 +253,11 @@ void Simulation::initData()
       tcThreads[i] = nullptr;
    }
    tcThreadsFailed = false;
+   tcExec = nullptr;
+   tcBarrier = nullptr;
+   tcPlayers = nullptr;
+   tcPlayersSize = 0;
+   numTcPlayers = 0;
 
    reqBgThreads = 1;  // Default is one -- no additional background threads
    numBgThreads = 0;
@@ -251,6 +265,11 @@ void Simulation::initData()
       bgThreads[i] = nullptr;
    }
    bgThreadsFailed = false;
+   bgExec = nullptr;
+   bgBarrier = nullptr;
+   bgPlayers = nullptr;
+   bgPlayersSize = 0;
+   numBgPlayers = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -275,6 +294,9 @@ void Simulation::copyData(const Simulation& org, const bool cc)
 
    // Copy active players
    if (players != nullptr)     { players = nullptr; }
+   if (playerIndex != nullptr) { playerIndex = nullptr; }
+   if (snapshot != nullptr)    { snapshot = nullptr; }
+   if (spareSnapshot != nullptr) { spareSnapshot->unref(); spareSnapshot = nullptr; }
    if (org.players != nullptr) {
       players = org.players->clone();
       players->unref();  // safe_ptr<> has it
@@ -316,6 +338,11 @@ void Simulation::copyData(const Simulation& org, const bool cc)
    cosRlat = org.cosRlat;
    maxRefRange = org.maxRefRange;
    gaUseEmFlg = org.gaUseEmFlg;
+   pidxCellSize = org.pidxCellSize;
+   playerIndex = nullptr;
+   snapshot = nullptr;
+   if (spareSnapshot != nullptr) { spareSnapshot->unref(); spareSnapshot = nullptr; }
+   tElevBatch = org.tElevBatch;
    wm = org.wm;
 
    // Timing
@@ -356,6 +383,9 @@ void Simulation::copyData(const Simulation& org, const bool cc)
    numTcThreads = 0;
    tcThreadsFailed = false;
    reqTcThreads = org.reqTcThreads;
+   if (tcExec != nullptr) { delete tcExec; tcExec = nullptr; }
+   if (tcBarrier != nullptr) { delete tcBarrier; tcBarrier = nullptr; }
+   numTcPlayers = 0;
 
    for (unsigned int i = 0; i < numBgThreads; i++) {
       bgThreads[i]->terminate();
@@ -365,6 +395,9 @@ void Simulation::copyData(const Simulation& org, const bool cc)
    numBgThreads = 0;
    bgThreadsFailed = false;
    reqBgThreads = org.reqBgThreads;
+   if (bgExec != nullptr) { delete bgExec; bgExec = nullptr; }
+   if (bgBarrier != nullptr) { delete bgBarrier; bgBarrier = nullptr; }
+   numBgPlayers = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -375,6 +408,10 @@ void Simulation::deleteData()
    if (origPlayers != nullptr) { origPlayers = nullptr; }
    if (players != nullptr)     { players = nullptr; }
 
+   playerIndex = nullptr;
+   snapshot = nullptr;
+   if (spareSnapshot != nullptr) { spareSnapshot->unref(); spareSnapshot = nullptr; }
+
    setSlotIrAtmosphere( nullptr );
    setSlotTerrain( nullptr );
    setAirports( nullptr );
@@ -394,6 +431,11 @@ void Simulation::deleteData()
     }
    numTcThreads = 0;
    tcThreadsFailed = false;
+   if (tcExec != nullptr) { delete tcExec; tcExec = nullptr; }
+   if (tcBarrier != nullptr) { delete tcBarrier; tcBarrier = nullptr; }
+   if (tcPlayers != nullptr) { delete[] tcPlayers; tcPlayers = nullptr; }
+   tcPlayersSize = 0;
+   numTcPlayers = 0;
 
    for (unsigned int i = 0; i < numBgThreads; i++) {
       bgThreads[i]->terminate();
@@ -402,6 +444,18 @@ void Simulation::deleteData()
    }
    numBgThreads = 0;
    bgThreadsFailed = false;
+   if (bgExec != nullptr) { delete bgExec; bgExec = nullptr; }
+   if (bgBarrier != nullptr) { delete bgBarrier; bgBarrier = nullptr; }
+   if (bgPlayers != nullptr) { delete[] bgPlayers; bgPlayers = nullptr; }
+   bgPlayersSize = 0;
+   numBgPlayers = 0;
+
+   if (tePlayers != nullptr) { delete[] tePlayers; tePlayers = nullptr; }
+   if (teLats != nullptr) { delete[] teLats; teLats = nullptr; }
+   if (teLons != nullptr) { delete[] teLons; teLons = nullptr; }
+   if (teElevs != nullptr) { delete[] teElevs; teElevs = nullptr; }
+   if (teValid != nullptr) { delete[] teValid; teValid = nullptr; }
+   teSize = 0;
 
    station = nullptr;
 }
@@ -527,8 +581,11 @@ void Simulation::reset()
          pri = sta->getTimeCriticalPriority();
       }
 
+      // The pool's phase barrier; the threads are created with it
+      if (tcBarrier == nullptr) tcBarrier = new Basic::PhaseBarrier(0);
+
       for (unsigned int i = 0; i < (reqTcThreads-1); i++) {
-         tcThreads[numTcThreads] = new SimTcThread(this, pri);
+         tcThreads[numTcThreads] = new SimTcThread(this, pri, tcBarrier, numTcThreads);
          bool ok = tcThreads[numTcThreads]->create();
          if (ok) {
             std::cout << "Created T/C pool thread[" << i << "] = " << tcThreads[i] << std::endl;
@@ -547,6 +604,13 @@ void Simulation::reset()
       // and we don't want to try again.
       tcThreadsFailed = (reqTcThreads > 1 && numTcThreads == 0);
 
+      // Work stealing executor for the pool threads plus this thread
+      if (numTcThreads > 0) {
+         if (tcExec != nullptr) delete tcExec;
+         tcExec = new Basic::WorkStealingExecutor(numTcThreads + 1);
+      }
+      tcBarrier->setNumWorkers(numTcThreads);
+
    }
 
    // ---
@@ -561,8 +625,11 @@ void Simulation::reset()
          pri = sta->getBackgroundPriority();
       }
 
+      // The pool's phase barrier; the threads are created with it
+      if (bgBarrier == nullptr) bgBarrier = new Basic::PhaseBarrier(0);
+
       for (unsigned int i = 0; i < (reqBgThreads-1); i++) {
-         bgThreads[numBgThreads] = new SimBgThread(this, pri);
+         bgThreads[numBgThreads] = new SimBgThread(this, pri, bgBarrier, numBgThreads);
          bool ok = bgThreads[numBgThreads]->create();
          if (ok) {
             std::cout << "Created background pool thread[" << i << "] = " << bgThreads[i] << std::endl;
@@ -581,6 +648,13 @@ void Simulation::reset()
       // and we don't want to try again.
       bgThreadsFailed = (reqBgThreads > 1 && numBgThreads == 0);
 
+      // Work stealing executor for the pool threads plus this thread
+      if (numBgThreads > 0) {
+         if (bgExec != nullptr) delete bgExec;
+         bgExec = new Basic::WorkStealingExecutor(numBgThreads + 1);
+      }
+      bgBarrier->setNumWorkers(numBgThreads);
+
    }
 
    // ---
@@ -715,18 +789,14 @@ bool Simulation::shutdownNotification()
    // Shut down the thread pools
    // ---
    if (numTcThreads > 0) {
-      for (unsigned int i = 0; i < numTcThreads; i++) {
-         // We're just going to make sure the threads not suspended,
-         // and they'll check our shutdown flag.
-         tcThreads[i]->signalStart();
-      }
+      // We're just going to make sure the threads not suspended,
+      // and they'll check our shutdown flag.
+      tcBarrier->release();
    }
    if (numBgThreads > 0) {
-      for (unsigned int i = 0; i < numBgThreads; i++) {
-         // We're just going to make sure the threads not suspended,
-         // and they'll check our shutdown flag.
-         bgThreads[i]->signalStart();
-      }
+      // We're just going to make sure the threads not suspended,
+      // and they'll check our shutdown flag.
+      bgBarrier->release();
    }
 
    return true;
@@ -826,6 +896,11 @@ void Simulation::updateTC(const LCreal dt)
       // This locks the current player list for this time-critical frame
       Basic::safe_ptr<Basic::PairStream> currentPlayerList = players;
 
+      // With the thread pool, load the player array once per frame
+      if (numTcThreads > 0) {
+         numTcPlayers = loadPlayerArray(currentPlayerList, &tcPlayers, &tcPlayersSize);
+      }
+
       for (unsigned int f = 0; f < 4; f++) {
 
          // Set the current phase
@@ -836,21 +911,22 @@ void Simulation::updateTC(const LCreal dt)
             updateTcPlayerList(currentPlayerList, (dt0/4.0), 1, 1);
          }
          else if (numTcThreads > 0) {
-            // multiple threads
-            for (unsigned short i = 0; i < numTcThreads; i++) {
+            // multiple threads; partition the player array
+            tcExec->beginPass(numTcPlayers);
 
-               // assign the threads from the pool
-               unsigned int idx = (i+1);
-               tcThreads[i]->start(currentPlayerList, (dt0/4.0), idx, reqTcThreads);
+            // start the threads from the pool as workers [ 0 .. numTcThreads-1 ]
+            for (unsigned short i = 0; i < numTcThreads; i++) {
+               tcThreads[i]->setDeltaTime(dt0/4.0);
             }
+            tcBarrier->release();
 
-            // we're the last thread
-            updateTcPlayerList(currentPlayerList, (dt0/4.0), reqTcThreads, reqTcThreads);
+            // we're the last worker
+            updateTcPlayerArray((dt0/4.0), numTcThreads);
 
             // Now wait for the other thread(s) to complete
-            Basic::ThreadSyncTask** pp = reinterpret_cast<Basic::ThreadSyncTask**>(&tcThreads[0]);
-            Basic::ThreadSyncTask::waitForAllCompleted(pp, numTcThreads);
+            tcBarrier->waitForCompleted();
 
+            tcExec->endPass();
          }
          else if (isMessageEnabled(MSG_ERROR)) {
             std::cerr << "Simulation::updateTC() ERROR, invalid T/C thread setup";
@@ -858,6 +934,11 @@ void Simulation::updateTC(const LCreal dt)
             std::cerr << "; numTcThreads = " << numTcThreads;
             std::cerr << std::endl;
          }
+
+         // The dynamics are complete; publish the players' state
+         if (f == 0) {
+            updatePlayerSnapshot(currentPlayerList);
+         }
       }
    }
 
@@ -898,6 +979,25 @@ void Simulation::updateTcPlayerList(
    }
 }
 
+//------------------------------------------------------------------------------
+// Time critical thread processing for executor worker 'worker'; processes
+// chunks of the T/C player array until all players have been claimed.
+//------------------------------------------------------------------------------
+void Simulation::updateTcPlayerArray(const LCreal dt, const unsigned int worker)
+{
+   if (tcExec != nullptr && tcPlayers != nullptr) {
+      tcExec->beginWork(worker);
+      unsigned int b = 0;
+      unsigned int e = 0;
+      while (tcExec->nextChunk(worker, &b, &e)) {
+         for (unsigned int i = b; i < e; i++) {
+            tcPlayers[i]->tcFrame(dt);
+         }
+      }
+      tcExec->endWork(worker);
+   }
+}
+
 //------------------------------------------------------------------------------
 // updateData() -- update non-time critical stuff here
 //------------------------------------------------------------------------------
@@ -913,6 +1013,15 @@ void Simulation::updateData(const LCreal dt)
     // Update the player list
     updatePlayerList();
 
+    // Build a new spatial index of the player list
+    updatePlayerIndex();
+
+    // Start a new frame of the terrain database's LOS result cache
+    if (terrain != nullptr) terrain->updateData(dt0);
+
+    // Refresh the players' terrain elevations
+    updateTerrainElevations();
+
     // Update all players
     if (players != nullptr) {
          Basic::safe_ptr<Basic::PairStream> currentPlayerList = players;
@@ -922,21 +1031,23 @@ void Simulation::updateData(const LCreal dt)
             updateBgPlayerList(currentPlayerList, dt0, 1, 1);
          }
          else if (numBgThreads > 0) {
-            // multiple threads
-            for (unsigned short i = 0; i < numBgThreads; i++) {
+            // multiple threads; load and partition the player array
+            numBgPlayers = loadPlayerArray(currentPlayerList, &bgPlayers, &bgPlayersSize);
+            bgExec->beginPass(numBgPlayers);
 
-               // assign the threads from the pool
-               unsigned int idx = (i+1);
-               bgThreads[i]->start(currentPlayerList, dt0, idx, reqBgThreads);
+            // start the threads from the pool as workers [ 0 .. numBgThreads-1 ]
+            for (unsigned short i = 0; i < numBgThreads; i++) {
+               bgThreads[i]->setDeltaTime(dt0);
             }
+            bgBarrier->release();
 
-            // we're the last thread
-            updateBgPlayerList(currentPlayerList, dt0, reqBgThreads, reqBgThreads);
+            // we're the last worker
+            updateBgPlayerArray(dt0, numBgThreads);
 
             // Now wait for the other thread(s) to complete
-            Basic::ThreadSyncTask** pp = reinterpret_cast<Basic::ThreadSyncTask**>(&bgThreads[0]);
-            Basic::ThreadSyncTask::waitForAllCompleted(pp, numBgThreads);
+            bgBarrier->waitForCompleted();
 
+            bgExec->endPass();
          }
          else if (isMessageEnabled(MSG_ERROR)) {
             std::cerr << "Simulation::updateData() ERROR, invalid background thread setup";
@@ -991,6 +1102,56 @@ void Simulation::updateBgPlayerList(
    }
 }
 
+//------------------------------------------------------------------------------
+// Background thread processing for executor worker 'worker'; processes
+// chunks of the background player array until all players have been claimed.
+//------------------------------------------------------------------------------
+void Simulation::updateBgPlayerArray(const LCreal dt, const unsigned int worker)
+{
+   if (bgExec != nullptr && bgPlayers != nullptr) {
+      bgExec->beginWork(worker);
+      unsigned int b = 0;
+      unsigned int e = 0;
+      while (bgExec->nextChunk(worker, &b, &e)) {
+         for (unsigned int i = b; i < e; i++) {
+            bgPlayers[i]->updateData(dt);
+         }
+      }
+      bgExec->endWork(worker);
+   }
+}
+
+//------------------------------------------------------------------------------
+// loadPlayerArray() -- copies the players from the list into the array,
+// growing the array as needed, and returns the number of players.
+//------------------------------------------------------------------------------
+unsigned int Simulation::loadPlayerArray(
+         Basic::PairStream* const playerList,
+         Player*** const array,
+         unsigned int* const size)
+{
+   unsigned int n = 0;
+   if (playerList != nullptr) {
+      const unsigned int num = playerList->entries();
+      if (num > *size) {
+         // Grow the array
+         if (*array != nullptr) delete[] *array;
+         unsigned int newSize = (*size > 0 ? *size : 64);
+         while (newSize < num) newSize *= 2;
+         *array = new Player*[newSize];
+         *size = newSize;
+      }
+
+      Basic::List::Item* item = playerList->getFirstItem();
+      while (item != nullptr && n < *size) {
+         Basic::Pair* pair = static_cast<Basic::Pair*>(item->getValue());
+         (*array)[n++] = static_cast<Player*>(pair->object());
+         item = item->getNext();
+      }
+   }
+   return n;
+}
+
 //------------------------------------------------------------------------------
 // printTimingStats() -- Update time critical stuff here
 //------------------------------------------------------------------------------
@@ -1004,6 +1165,27 @@ void Simulation::printTimingStats()
       f = 15;
    }
    std::cout << "simulation(" << c << "," << f << "): dt=" << ts->value() << ", ave=" << ts->mean() << ", max=" << ts->maxValue() << std::endl;
+
+   // Per-thread busy and idle times (seconds per phase or frame)
+   // and the phase barrier's dispatch latency (seconds)
+   const Basic::WorkStealingExecutor* execs[2] = { tcExec, bgExec };
+   const Basic::PhaseBarrier* barriers[2] = { tcBarrier, bgBarrier };
+   const char* const names[2] = { "tc", "bg" };
+   for (unsigned int j = 0; j < 2; j++) {
+      if (barriers[j] != nullptr && barriers[j]->getNumWorkers() > 0) {
+         const Basic::Statistic& lat = barriers[j]->getDispatchLatencyStats();
+         std::cout << "   " << names[j] << "Barrier: dispatch ave=" << lat.mean() << ", max=" << lat.maxValue() << std::endl;
+      }
+      if (execs[j] != nullptr) {
+         for (unsigned int w = 0; w < execs[j]->getNumWorkers(); w++) {
+            const Basic::Statistic* busy = execs[j]->getBusyTimeStats(w);
+            const Basic::Statistic* idle = execs[j]->getIdleTimeStats(w);
+            std::cout << "   " << names[j] << "Thread(" << w << "): busy ave=" << busy->mean() << ", max=" << busy->maxValue();
+            std::cout << "; idle ave=" << idle->mean() << ", max=" << idle->maxValue();
+            std::cout << "; steals=" << execs[j]->getNumSteals(w) << std::endl;
+         }
+      }
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -1181,6 +1363,46 @@ Dafif::WaypointLoader* Simulation::getWaypoints()
    return waypoints;
 }
 
+// Work stealing executors for the T/C and background thread pools
+const Basic::WorkStealingExecutor* Simulation::getTcExecutor() const
+{
+   return tcExec;
+}
+
+const Basic::WorkStealingExecutor* Simulation::getBgExecutor() const
+{
+   return bgExec;
+}
+
+// Spatial index of the current player list; pre-ref()'d
+PlayerSpatialIndex* Simulation::getPlayerIndex()
+{
+   return playerIndex.getRefPtr();
+}
+
+const PlayerSpatialIndex* Simulation::getPlayerIndex() const
+{
+   return playerIndex.getRefPtr();
+}
+
+// Snapshot of the players' state; pre-ref()'d
+const PlayerSnapshot* Simulation::getPlayerSnapshot() const
+{
+   return snapshot.getRefPtr();
+}
+
+// Player spatial index cell size (meters), or zero if disabled
+double Simulation::getPlayerIndexCellSize() const
+{
+   return pidxCellSize;
+}
+
+// True if the players' terrain elevations are refreshed by our batched query
+bool Simulation::isTerrainElevationBatched() const
+{
+   return tElevBatch;
+}
+
 // Returns the data recorder
 DataRecorder* Simulation::getDataRecorder()
 {
@@ -1383,6 +1605,109 @@ bool Simulation::setSlotPlayers(Basic::PairStream* const pl)
    return ok;
 }
 
+//------------------------------------------------------------------------------
+// updatePlayerSnapshot() -- copies the players' state into a snapshot and
+// publishes it.  (Time critical thread; end of the dynamics phase)
+//------------------------------------------------------------------------------
+void Simulation::updatePlayerSnapshot(Basic::PairStream* const playerList)
+{
+   if (playerList == nullptr) return;
+
+   // Reuse the previous snapshot if no one else is holding it
+   PlayerSnapshot* p = nullptr;
+   if (spareSnapshot != nullptr && spareSnapshot->getRefCount() == 1) {
+      p = spareSnapshot;
+   }
+   else {
+      if (spareSnapshot != nullptr) spareSnapshot->unref();
+      p = new PlayerSnapshot();
+   }
+   spareSnapshot = nullptr;
+
+   p->build(playerList, getExecCounter(), getExecTimeSec());
+
+   // Publish it; the current snapshot becomes our spare
+   PlayerSnapshot* prev = snapshot.getRefPtr();
+   snapshot = p;
+   p->unref();
+   spareSnapshot = prev;
+}
+
+//------------------------------------------------------------------------------
+// updatePlayerIndex() -- builds a new spatial index of the current player list
+//------------------------------------------------------------------------------
+void Simulation::updatePlayerIndex()
+{
+   if (pidxCellSize > 0 && players != nullptr) {
+      Basic::safe_ptr<Basic::PairStream> currentPlayerList = players;
+      PlayerSpatialIndex* p = new PlayerSpatialIndex(pidxCellSize);
+      p->build(currentPlayerList, getExecTimeSec());
+      playerIndex = p;
+      p->unref();
+   }
+   else {
+      playerIndex = nullptr;
+   }
+}
+
+//------------------------------------------------------------------------------
+// updateTerrainElevations() -- refreshes the terrain elevations of the active
+// players with one batched terrain query for each interpolation setting
+//------------------------------------------------------------------------------
+void Simulation::updateTerrainElevations()
+{
+   if (!tElevBatch || terrain == nullptr || players == nullptr) return;
+
+   Basic::safe_ptr<Basic::PairStream> currentPlayerList = players;
+
+   // Grow the arrays (with some room to spare)
+   const unsigned int n = currentPlayerList->entries();
+   if (n > teSize) {
+      if (tePlayers != nullptr) delete[] tePlayers;
+      if (teLats != nullptr) delete[] teLats;
+      if (teLons != nullptr) delete[] teLons;
+      if (teElevs != nullptr) delete[] teElevs;
+      if (teValid != nullptr) delete[] teValid;
+      teSize = n + (n / 4) + 16;
+      tePlayers = new Player*[teSize];
+      teLats = new double[teSize];
+      teLons = new double[teSize];
+      teElevs = new LCreal[teSize];
+      teValid = new bool[teSize];
+   }
+
+   // Two passes: players without and then with interpolation between posts
+   for (unsigned int pass = 0; pass < 2; pass++) {
+      const bool interp = (pass == 1);
+
+      // Gather the players' locations
+      unsigned int cnt = 0;
+      const Basic::List::Item* item = currentPlayerList->getFirstItem();
+      while (item != nullptr && cnt < teSize) {
+         const Basic::Pair* pair = static_cast<const Basic::Pair*>(item->getValue());
+         Player* p = static_cast<Player*>(const_cast<Basic::Object*>(pair->object()));
+         if ( (p->isMode(Player::ACTIVE) || p->isMode(Player::PRE_RELEASE)) &&
+              !p->isTerrainElevationRequired() &&
+              p->isDtedTerrainInterpolationEnabled() == interp ) {
+            tePlayers[cnt] = p;
+            teLats[cnt] = p->getLatitude();
+            teLons[cnt] = p->getLongitude();
+            teValid[cnt] = false;
+            cnt++;
+         }
+         item = item->getNext();
+      }
+
+      // One query for all of them
+      if (cnt > 0) {
+         terrain->getPointElevations(teElevs, teValid, teLats, teLons, cnt, interp);
+         for (unsigned int i = 0; i < cnt; i++) {
+            tePlayers[i]->setTerrainElevation( teValid[i] ? teElevs[i] : 0 );
+         }
+      }
+   }
+}
+
 //------------------------------------------------------------------------------
 // updatePlayerList() -- update the player list ...
 //                       1) remove 'deleteRequest' mode players
@@ -1729,6 +2054,24 @@ bool Simulation::setMaxRefRange(const double v)
    return ok;
 }
 
+// Sets the player spatial index cell size (meters), or zero to disable the index
+bool Simulation::setPlayerIndexCellSize(const double v)
+{
+   bool ok = (v >= 0);
+   if (ok) {
+      pidxCellSize = v;
+      if (pidxCellSize == 0) playerIndex = nullptr;
+   }
+   return ok;
+}
+
+// Enables/disables the batched refresh of the players' terrain elevations
+bool Simulation::setTerrainElevationBatched(const bool flg)
+{
+   tElevBatch = flg;
+   return true;
+}
+
 // Sets the initial simulation time (sec; or less than zero to slave to UTC)
 bool Simulation::setInitialSimulationTime(const long time)
 {
@@ -1966,6 +2309,24 @@ bool Simulation::setSlotGamingAreaRange(const Basic::Distance* const msg)
    return ok;
 }
 
+bool Simulation::setSlotPlayerIndexCellSize(const Basic::Distance* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setPlayerIndexCellSize( Basic::Meters::convertStatic(*msg) );
+   }
+   return ok;
+}
+
+bool Simulation::setSlotTerrainElevationBatch(const Basic::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setTerrainElevationBatched( msg->getBoolean() );
+   }
+   return ok;
+}
+
 bool Simulation::setSlotEarthModel(const Basic::EarthModel* const msg)
 {
    return setEarthModel(msg);
@@ -2075,40 +2436,25 @@ EMPTY_COPYDATA(SimTcThread)
 EMPTY_DELETEDATA(SimTcThread)
 EMPTY_SERIALIZER(SimTcThread)
 
-SimTcThread::SimTcThread(Basic::Component* const parent, const LCreal priority)
-      : Basic::ThreadSyncTask(parent, priority)
+SimTcThread::SimTcThread(Basic::Component* const parent, const LCreal priority, Basic::PhaseBarrier* const barrier, const unsigned int worker)
+      : Basic::ThreadSyncTask(parent, priority, barrier, worker)
 {
    STANDARD_CONSTRUCTOR()
 
-   pl0 = nullptr;
    dt0 = 0.0;
-   idx0 = 0;
-   n0 = 0;
+   worker0 = worker;
 }
 
-void SimTcThread::start(
-         Basic::PairStream* const pl1,
-         const LCreal dt1,
-         const unsigned int idx1,
-         const unsigned int n1
-      )
+void SimTcThread::setDeltaTime(const LCreal dt1)
 {
-   pl0 = pl1;
    dt0 = dt1;
-   idx0 = idx1;
-   n0 = n1;
-
-   signalStart();
 }
 
 unsigned long SimTcThread::userFunc()
 {
-   // Make sure we've a player list and our index is valid ...
-   if (pl0 != nullptr && idx0 > 0 && idx0 <= n0) {
-      // then call the Simulation class' update TC player list functions
-      Simulation* sim = static_cast<Simulation*>(getParent());
-      sim->updateTcPlayerList(pl0, dt0, idx0, n0);
-   }
+   // Call the Simulation class' update TC player array function
+   Simulation* sim = static_cast<Simulation*>(getParent());
+   sim->updateTcPlayerArray(dt0, worker0);
 
    return 0;
 }
@@ -2122,40 +2468,25 @@ EMPTY_COPYDATA(SimBgThread)
 EMPTY_DELETEDATA(SimBgThread)
 EMPTY_SERIALIZER(SimBgThread)
 
-SimBgThread::SimBgThread(Basic::Component* const parent, const LCreal priority)
-      : Basic::ThreadSyncTask(parent, priority)
+SimBgThread::SimBgThread(Basic::Component* const parent, const LCreal priority, Basic::PhaseBarrier* const barrier, const unsigned int worker)
+      : Basic::ThreadSyncTask(parent, priority, barrier, worker)
 {
    STANDARD_CONSTRUCTOR()
 
-   pl0 = nullptr;
    dt0 = 0.0;
-   idx0 = 0;
-   n0 = 0;
+   worker0 = worker;
 }
 
-void SimBgThread::start(
-         Basic::PairStream* const pl1,
-         const LCreal dt1,
-         const unsigned int idx1,
-         const unsigned int n1
-      )
+void SimBgThread::setDeltaTime(const LCreal dt1)
 {
-   pl0 = pl1;
    dt0 = dt1;
-   idx0 = idx1;
-   n0 = n1;
-
-   signalStart();
 }
 
 unsigned long SimBgThread::userFunc()
 {
-   // Make sure we've a player list and our index is valid ...
-   if (pl0 != nullptr && idx0 > 0 && idx0 <= n0) {
-      // then call the Simulation class' update TC player list functions
-      Simulation* sim = static_cast<Simulation*>(getParent());
-      sim->updateBgPlayerList(pl0, dt0, idx0, n0);
-   }
+   // Call the Simulation class' update background player array function
+   Simulation* sim = static_cast<Simulation*>(getParent());
+   sim->updateBgPlayerArray(dt0, worker0);
 
    return 0;
 }
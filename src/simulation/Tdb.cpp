@@ -2,6 +2,7 @@
 
 #include "openeaagles/simulation/Gimbal.h"
 #include "openeaagles/simulation/Player.h"
+#include "openeaagles/simulation/PlayerSpatialIndex.h"
 #include "openeaagles/simulation/Simulation.h"
 #include "openeaagles/basic/List.h"
 #include "openeaagles/basic/Nav.h"
@@ -23,6 +24,9 @@ IMPLEMENT_PARTIAL_SUBCLASS(Tdb,"Gimbal_Tdb")
 EMPTY_SLOTTABLE(Tdb)
 EMPTY_SERIALIZER(Tdb)
 
+// Number of structure-of-arrays columns (see resizeArrays())
+static const unsigned int NUM_SOA_ARRAYS = 20;
+
 //------------------------------------------------------------------------------
 // Constructor(s)
 //------------------------------------------------------------------------------
@@ -72,17 +76,29 @@ void Tdb::initData()
    maxTargets = 0;
    numTgts = 0;
 
-   ranges = nullptr;
-   rngRates = nullptr;
    losG = nullptr;
    losO2T = nullptr;
    losT2O = nullptr;
+
+   soa = nullptr;
+   ranges = nullptr;
+   rngRates = nullptr;
    aar = nullptr;
    aazr = nullptr;
    aelr = nullptr;
 
+   lx = nullptr;
+   ly = nullptr;
+   lz = nullptr;
+   vx = nullptr;
+   vy = nullptr;
+   vz = nullptr;
+   nx = nullptr;
+   ny = nullptr;
+   nz = nullptr;
    xa = nullptr;
    ya = nullptr;
+   ga = nullptr;
    za = nullptr;
    ra2 = nullptr;
    ra = nullptr;
@@ -164,44 +180,70 @@ bool Tdb::resizeArrays(const unsigned int newSize)
       if (newSize != maxTargets) {
 
          // Free up the old memory
-         if (ranges   != nullptr)   { delete[] ranges;   ranges   = nullptr; }
-         if (rngRates != nullptr)   { delete[] rngRates; rngRates = nullptr; }
          if (losG     != nullptr)   { delete[] losG;     losG     = nullptr; }
          if (losO2T   != nullptr)   { delete[] losO2T;   losO2T   = nullptr; }
          if (losT2O   != nullptr)   { delete[] losT2O;   losT2O   = nullptr; }
-         if (aar      != nullptr)   { delete[] aar;      aar      = nullptr; }
-         if (aazr     != nullptr)   { delete[] aazr;     aazr     = nullptr; }
-         if (aelr     != nullptr)   { delete[] aelr;     aelr     = nullptr; }
+         if (soa      != nullptr)   { delete[] soa;      soa      = nullptr; }
 
          if (targets != nullptr)    { delete[] targets;  targets  = nullptr; }
          maxTargets = 0;
 
-         if (xa  != nullptr)  { delete[] xa;  xa  = nullptr; }
-         if (ya  != nullptr)  { delete[] ya;  ya  = nullptr; }
-         if (za  != nullptr)  { delete[] za;  za  = nullptr; }
-         if (ra2 != nullptr)  { delete[] ra2; ra2 = nullptr; }
-         if (ra  != nullptr)  { delete[] ra;  ra  = nullptr; }
-
          // Allocate new memory
          if (newSize > 0) {
-            ranges   = new double[newSize];
-            rngRates = new double[newSize];
             losG     = new osg::Vec3d[newSize];
             losO2T   = new osg::Vec3d[newSize];
             losT2O   = new osg::Vec3d[newSize];
-            aar      = new double[newSize];
-            aazr     = new double[newSize];
-            aelr     = new double[newSize];
             targets  = new Player*[newSize];
             for (unsigned int i = 0; i < newSize; i++) {
                targets[i] = nullptr;
             }
             maxTargets = newSize;
-            xa = new double[newSize];
-            ya = new double[newSize];
-            za = new double[newSize];
-            ra2 = new double[newSize];
-            ra = new double[newSize];
+
+            // One allocation for all of the SoA columns
+            soa = new double[NUM_SOA_ARRAYS * newSize];
+            double* p = soa;
+            ranges   = p; p += newSize;
+            rngRates = p; p += newSize;
+            aar      = p; p += newSize;
+            aazr     = p; p += newSize;
+            aelr     = p; p += newSize;
+            lx       = p; p += newSize;
+            ly       = p; p += newSize;
+            lz       = p; p += newSize;
+            vx       = p; p += newSize;
+            vy       = p; p += newSize;
+            vz       = p; p += newSize;
+            nx       = p; p += newSize;
+            ny       = p; p += newSize;
+            nz       = p; p += newSize;
+            xa       = p; p += newSize;
+            ya       = p; p += newSize;
+            ga       = p; p += newSize;
+            za       = p; p += newSize;
+            ra2      = p; p += newSize;
+            ra       = p;
+         }
+         else {
+            ranges = nullptr;
+            rngRates = nullptr;
+            aar = nullptr;
+            aazr = nullptr;
+            aelr = nullptr;
+            lx = nullptr;
+            ly = nullptr;
+            lz = nullptr;
+            vx = nullptr;
+            vy = nullptr;
+            vz = nullptr;
+            nx = nullptr;
+            ny = nullptr;
+            nz = nullptr;
+            xa = nullptr;
+            ya = nullptr;
+            ga = nullptr;
+            za = nullptr;
+            ra2 = nullptr;
+            ra = nullptr;
          }
 
       }
@@ -212,6 +254,17 @@ bool Tdb::resizeArrays(const unsigned int newSize)
 }
 
 
+//------------------------------------------------------------------------------
+// Is this matrix only a rotation (i.e., no translation or perspective), so
+// that the FOV check (M * los).x() >= cos(maxAngle) is a simple cone?
+//------------------------------------------------------------------------------
+static bool isRotation(const osg::Matrixd& m)
+{
+   const double row0 = m(0,0)*m(0,0) + m(0,1)*m(0,1) + m(0,2)*m(0,2);
+   return m(3,0) == 0 && m(3,1) == 0 && m(3,2) == 0 && m(3,3) == 1.0 &&
+          m(0,3) == 0 && m(1,3) == 0 && m(2,3) == 0 && std::fabs(row0 - 1.0) < 1.0e-6;
+}
+
 //------------------------------------------------------------------------------
 // Process players-of-interest ---  Scan the provided player list and generates
 // a sublist of target players that were filtered by player type, max range,
@@ -321,14 +374,63 @@ unsigned int Tdb::processPlayers(Basic::PairStream* const players)
    const bool osSpaceVehicle = ownship->isMajorType(Player::SPACE_VEHICLE);
 
    // ---
-   // 1) Scan the player list ---
+   // Candidate players from the simulation's player spatial index, if
+   // the index was built from this player list and we have a max range.
+   // ---
+   Player** cands = nullptr;
+   unsigned int numCands = 0;
+   if (maxRange > 0) {
+      const Simulation* const sim = ownship->getSimulation();
+      const PlayerSpatialIndex* const index = (sim != nullptr ? sim->getPlayerIndex() : nullptr);
+      if (index != nullptr) {
+         if (index->getPlayerList() == players && index->getNumPlayers() > 0) {
+            const double pad = index->getMotionPad(sim->getExecTimeSec());
+
+            // Boresight cone (only if the FOV check is a simple cone)
+            osg::Vec3d boresight(1,0,0);
+            double coneAngle = 0;
+            if (maxAngle > 0 && maxAngle < PI && isRotation(rm) && isRotation(wm)) {
+               boresight.set( rm(0,0), rm(0,1), rm(0,2) );
+               if (usingEcefFlg) {
+                  // NED to ECEF: the boresight's row times the world matrix
+                  osg::Vec3d b;
+                  for (unsigned int j = 0; j < 3; j++) {
+                     b[j] = rm(0,0)*wm(0,j) + rm(0,1)*wm(1,j) + rm(0,2)*wm(2,j);
+                  }
+                  boresight = b;
+               }
+               coneAngle = maxAngle;
+            }
+
+            // (the gimbal keeps the arrays between frames)
+            unsigned int* work = nullptr;
+            cands = gimbal->getPoiCandidateArrays(index->getNumPlayers(), &work);
+            numCands = index->query(usingEcefFlg, p0, maxRange, pad, boresight, coneAngle, cands, work);
+         }
+         index->unref();
+      }
+   }
+
+   // ---
+   // 1) Scan the player list (or just the candidate players) ---
    // ---
    bool finished = false;
-   for (Basic::List::Item* item = players->getFirstItem(); item != nullptr && numTgts < maxTargets && !finished; item = item->getNext()) {
+   Basic::List::Item* item = (cands == nullptr ? players->getFirstItem() : nullptr);
+   unsigned int icand = 0;
+   while (numTgts < maxTargets && !finished) {
 
       // Get the pointer to the target player
-      Basic::Pair* pair = static_cast<Basic::Pair*>(item->getValue());
-      Player* target = static_cast<Player*>(pair->object());
+      Player* target = nullptr;
+      if (cands != nullptr) {
+         if (icand >= numCands) break;
+         target = cands[icand++];
+      }
+      else {
+         if (item == nullptr) break;
+         Basic::Pair* pair = static_cast<Basic::Pair*>(item->getValue());
+         target = static_cast<Player*>(pair->object());
+         item = item->getNext();
+      }
 
       // Did we complete the local only players?
       finished = localOnly && target->isNetworkedPlayer();
@@ -478,40 +580,47 @@ unsigned int Tdb::computeBoresightData()
          v0 = ownship->getVelocity();  // Local gaming area velocity vector (NED)
       }
 
+      // Gather the target position and velocity vectors (ECEF or local gaming area NED)
       for (unsigned int i = 0; i < numTgts; i++) {
+         const osg::Vec3d& pt = (usingEcefFlg ? targets[i]->getGeocPosition() : targets[i]->getPosition());
+         const osg::Vec3d& vt = (usingEcefFlg ? targets[i]->getGeocVelocity() : targets[i]->getVelocity());
+         lx[i] = pt[0] - p0[0];
+         ly[i] = pt[1] - p0[1];
+         lz[i] = pt[2] - p0[2];
+         vx[i] = vt[0];
+         vy[i] = vt[1];
+         vz[i] = vt[2];
+      }
 
-         // Target vectors (ECEF or local gaming area NED)
-         osg::Vec3d pt;  // Position Vector
-         osg::Vec3d vt;  // Velocity vector [ x y z ] (meters/second)
-         if (usingEcefFlg) {
-            // Using ECEF
-            pt = targets[i]->getGeocPosition();  // Geocentric position (ECEF)
-            vt = targets[i]->getGeocVelocity();  // Geocentric (ECEF) velocity vector [ x y z ] (meters/second)
-         }
-         else {
-            // Using local gaming area positions
-            pt = targets[i]->getPosition();  // Local gaming area position vector (NED)
-            vt = targets[i]->getVelocity();  // Local gaming area velocity vector (NED)
-         }
-
-         // Target LOS vector
-         osg::Vec3d los = (pt - p0);
+      // Normalized and compute length [unit vector and range(meters)]
+      normalizeVec3Array(lx, ly, lz, ranges, numTgts);
 
-         // Normalized and compute length [unit vector and range(meters)]
-         ranges[i] = los.normalize();
+      // Computer range rate (meters/sec)
+      for (unsigned int i = 0; i < numTgts; i++) {
+         rngRates[i] = (vx[i] - v0[0])*lx[i] + (vy[i] - v0[1])*ly[i] + (vz[i] - v0[2])*lz[i];
+      }
 
-         // Computer range rate (meters/sec)
-         rngRates[i] = ( (vt - v0) * los );
+      // The LOS vectors (own to tgt) in our local tangent plane
+      if (usingEcefFlg) {
+         postMultVec3Array(lx, ly, lz, wm, nx, ny, nz, numTgts);
+      }
+      else {
+         for (unsigned int i = 0; i < numTgts; i++) {
+            nx[i] = lx[i];
+            ny[i] = ly[i];
+            nz[i] = lz[i];
+         }
+      }
 
-         // Save the LOS vectors (own to tgt) and (tgt back to own)
+      // Save the LOS vectors (own to tgt) and (tgt back to own)
+      for (unsigned int i = 0; i < numTgts; i++) {
+         losO2T[i].set(nx[i], ny[i], nz[i]);
          if (usingEcefFlg) {
-            // Rotate the LOS vectors into their local tangent planes
-            losO2T[i] = wm * los;
-            losT2O[i] = targets[i]->getWorldMat() * (-los);
+            // Rotate into the target's local tangent plane
+            losT2O[i] = targets[i]->getWorldMat() * osg::Vec3d(-lx[i], -ly[i], -lz[i]);
          }
          else {
-            losO2T[i] =  los;
-            losT2O[i] = -los;
+            losT2O[i].set(-lx[i], -ly[i], -lz[i]);
          }
       }
 
@@ -544,17 +653,16 @@ unsigned int Tdb::computeBoresightData()
       // 2) Transform the ownship to target LOS vector into gimbal coordinate system
       //       losG = mm * losO2T;
       // ---
-      postMultVec3Array(losO2T,mm,losG,numTgts);
+      postMultVec3Array(nx, ny, nz, mm, xa, ya, ga, numTgts);
    }
 
    // ---
    // Get gimbal coordinate component arrays and x-y range squared
    // ---
    for (unsigned int i = 0; i < numTgts; i++) {
-         xa[i] = losG[i].x();
-         ya[i] = losG[i].y();
-         za[i] = -losG[i].z();
-         ra2[i] = xa[i]*xa[i] + ya[i]*ya[i];
+      losG[i].set(xa[i], ya[i], ga[i]);
+      za[i] = -ga[i];
+      ra2[i] = xa[i]*xa[i] + ya[i]*ya[i];
    }
 
    // ---
@@ -19,6 +19,10 @@
 #include "openeaagles/simulation/DataRecorder.h"
 #include "openeaagles/simulation/Simulation.h"
 
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
 namespace Eaagles {
 namespace Simulation {
 
@@ -111,6 +115,15 @@ void TrackManager::initData()
    beta = 0.0;
    gamma = 0.0;
 
+   // Filter pool
+   filterPool = new LCreal[NUM_FP_ROWS * MAX_TRKS];
+   for (unsigned int i = 0; i < NUM_FP_ROWS; i++) {
+      fp[i] = &filterPool[i * MAX_TRKS];
+   }
+   for (unsigned int i = 0; i < NUM_FP_ROWS * MAX_TRKS; i++) {
+      filterPool[i] = 0.0;
+   }
+
    logTrackUpdates = true;
 }
 
@@ -151,6 +164,11 @@ void TrackManager::copyData(const TrackManager& org, const bool cc)
 void TrackManager::deleteData()
 {
    clearTracksAndQueues();
+
+   if (filterPool != nullptr) {
+      delete[] filterPool;
+      filterPool = nullptr;
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -428,6 +446,88 @@ void TrackManager::makeMatrixA(LCreal dt)
    haveMatrixA = true;
 }
 
+//------------------------------------------------------------------------------
+// setFilterInput() -- sets the input vector, U(k), and the gains, B, of the
+// filter pool's track 'it'
+//------------------------------------------------------------------------------
+void TrackManager::setFilterInput(const unsigned int it, const osg::Vec3& u, const LCreal b0, const LCreal b1, const LCreal b2)
+{
+   if (it < nTrks) {
+      fp[FP_U_X][it] = u[0];
+      fp[FP_U_Y][it] = u[1];
+      fp[FP_U_Z][it] = u[2];
+      fp[FP_B0][it] = b0;
+      fp[FP_B1][it] = b1;
+      fp[FP_B2][it] = b2;
+   }
+}
+
+//------------------------------------------------------------------------------
+// predictFilterStates() -- smooth and predict the filter pool's state vectors
+//
+//    X(k+1) = A*X(k) + B*U(k)
+//
+// X(k) is first copied from the tracks, which own their state (see Note 1
+// in TrackManager.h).  The tracks without an input have zero
+// gains, so all tracks are predicted the same way, one state component
+// (x, y or z) at a time.  The inputs are then cleared for the next frame.
+//------------------------------------------------------------------------------
+void TrackManager::predictFilterStates()
+{
+   for (unsigned int i = 0; i < nTrks; i++) {
+      const osg::Vec3& tpos = tracks[i]->getPosition();
+      const osg::Vec3& tvel = tracks[i]->getVelocity();
+      const osg::Vec3& tacc = tracks[i]->getAcceleration();
+      for (unsigned int j = 0; j < 3; j++) {
+         fp[FP_POS_X + j][i] = tpos[j];
+         fp[FP_VEL_X + j][i] = tvel[j];
+         fp[FP_ACC_X + j][i] = tacc[j];
+      }
+   }
+
+   const LCreal a00 = A[0][0], a01 = A[0][1], a02 = A[0][2];
+   const LCreal a10 = A[1][0], a11 = A[1][1], a12 = A[1][2];
+   const LCreal a20 = A[2][0], a21 = A[2][1], a22 = A[2][2];
+   const LCreal* const b0 = fp[FP_B0];
+   const LCreal* const b1 = fp[FP_B1];
+   const LCreal* const b2 = fp[FP_B2];
+   const unsigned int n = nTrks;
+
+   for (unsigned int j = 0; j < 3; j++) {
+      LCreal* const p = fp[FP_POS_X + j];
+      LCreal* const v = fp[FP_VEL_X + j];
+      LCreal* const a = fp[FP_ACC_X + j];
+      const LCreal* const u = fp[FP_U_X + j];
+      for (unsigned int i = 0; i < n; i++) {
+         const LCreal pi = p[i];
+         const LCreal vi = v[i];
+         const LCreal ai = a[i];
+         p[i] = (pi*a00 + vi*a01 + ai*a02) + u[i]*b0[i];
+         v[i] = (pi*a10 + vi*a11 + ai*a12) + u[i]*b1[i];
+         a[i] = (pi*a20 + vi*a21 + ai*a22) + u[i]*b2[i];
+      }
+   }
+
+   for (unsigned int j = FP_U_X; j <= FP_B2; j++) {
+      LCreal* const x = fp[j];
+      for (unsigned int i = 0; i < n; i++) {
+         x[i] = 0.0;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// storeFilterStates() -- stores the filter pool's state vectors in the tracks
+//------------------------------------------------------------------------------
+void TrackManager::storeFilterStates()
+{
+   for (unsigned int i = 0; i < nTrks; i++) {
+      tracks[i]->setPosition(     osg::Vec3(fp[FP_POS_X][i], fp[FP_POS_Y][i], fp[FP_POS_Z][i]) );
+      tracks[i]->setVelocity(     osg::Vec3(fp[FP_VEL_X][i], fp[FP_VEL_Y][i], fp[FP_VEL_Z][i]) );
+      tracks[i]->setAcceleration( osg::Vec3(fp[FP_ACC_X][i], fp[FP_ACC_Y][i], fp[FP_ACC_Z][i]) );
+   }
+}
+
 //------------------------------------------------------------------------------
 // setMaxTracks() -- Sets the maximum number of active tracks
 //------------------------------------------------------------------------------
@@ -631,6 +731,7 @@ BEGIN_SLOTTABLE(AirTrkMgr)
    "positionGate",     // 1: Position Gate (meters)
    "rangeGate",        // 2: Range Gate (meters)
    "velocityGate",     // 3: Velocity Gate (m/s)
+   "gnnAssociation",   // 4: Associate reports to tracks using the gates
 END_SLOTTABLE(AirTrkMgr)
 
 //  Map slot table
@@ -638,8 +739,33 @@ BEGIN_SLOT_MAP(AirTrkMgr)
    ON_SLOT(1, setPositionGate, Basic::Number)
    ON_SLOT(2, setRangeGate, Basic::Number)
    ON_SLOT(3, setVelocityGate, Basic::Number)
+   ON_SLOT(4, setSlotGnnAssociation, Basic::Number)
 END_SLOT_MAP()
 
+// Cost of leaving a report in a cluster unassigned (the largest gated cost),
+// and of the report/track pairs that aren't gated
+static const double NO_TRACK_COST = 2.0;
+static const double NOT_GATED_COST = 1.0e9;
+
+// Target player of a track
+static const Player* trackTarget(const Track* const trk)
+{
+   return static_cast<const RfTrack*>(trk)->getLastEmission()->getTarget();   // we produce only RfTracks
+}
+
+// Hash of a target player
+static unsigned int targetHash(const Player* const p)
+{
+   const unsigned long long v = reinterpret_cast<unsigned long long>(p);
+   return static_cast<unsigned int>( (v >> 4) * 2654435761ull );
+}
+
+// Hash of a grid cell
+static unsigned int cellHash(const int ix, const int iy, const int iz)
+{
+   return static_cast<unsigned int>(ix) * 73856093u ^ static_cast<unsigned int>(iy) * 19349663u ^ static_cast<unsigned int>(iz) * 83492791u;
+}
+
 //------------------------------------------------------------------------------
 // Constructor(s)
 //------------------------------------------------------------------------------
@@ -657,20 +783,55 @@ void AirTrkMgr::initData()
    posGate =  2.0 * Basic::Distance::NM2M;
    rngGate =  500.0;
    velGate =   10.0;
+   gnnAssociation = false;
 
-   reportNumMatches = new unsigned int[MAX_REPORTS];
-   trackNumMatches = new unsigned int[MAX_TRKS];
-   report2TrackMatch = new bool*[MAX_REPORTS];
+   reportTrack = new int[MAX_REPORTS];
+   rptFirstPair = new unsigned int[MAX_REPORTS + 1];
+   clusterNext = new int[MAX_REPORTS];
    for (unsigned int i = 0; i < MAX_REPORTS; i++) {
-      reportNumMatches[i] = 0;
-      report2TrackMatch[i] = new bool[MAX_TRKS];
-      for (unsigned int j = 0; j < MAX_TRKS; j++) {
-         report2TrackMatch[i][j] = false;
-      }
+      reportTrack[i] = -1;
+      rptFirstPair[i] = 0;
+      clusterNext[i] = -1;
    }
+   rptFirstPair[MAX_REPORTS] = 0;
+
+   trackNext = new int[MAX_TRKS];
+   trackCell = new int[3 * MAX_TRKS];
+   trkNumPairs = new unsigned int[MAX_TRKS];
+   trackLocal = new int[MAX_TRKS];
+   localTrack = new unsigned int[MAX_TRKS];
    for (unsigned int i = 0; i < MAX_TRKS; i++) {
-      trackNumMatches[i] = 0;
+      trackNext[i] = -1;
+      trackCell[3*i] = trackCell[3*i+1] = trackCell[3*i+2] = 0;
+      trkNumPairs[i] = 0;
+      trackLocal[i] = -1;
+      localTrack[i] = 0;
+   }
+
+   clusterParent = new int[MAX_REPORTS + MAX_TRKS];
+   for (unsigned int i = 0; i < (MAX_REPORTS + MAX_TRKS); i++) {
+      clusterParent[i] = static_cast<int>(i);
+   }
+
+   // Hash tables are at least twice the size of the track list
+   hashSize = 16;
+   while (hashSize < 2 * MAX_TRKS) hashSize *= 2;
+   hashHead = new int[hashSize];
+   for (unsigned int i = 0; i < hashSize; i++) {
+      hashHead[i] = -1;
    }
+
+   gated = nullptr;
+   numGated = 0;
+   maxGated = 0;
+   clusterPairs = nullptr;
+   maxClusterPairs = 0;
+
+   lapCost = nullptr;
+   lapCostSize = 0;
+   lapWork = nullptr;
+   lapIdx = nullptr;
+   lapSize = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -684,16 +845,7 @@ void AirTrkMgr::copyData(const AirTrkMgr& org, const bool cc)
    posGate = org.posGate;
    rngGate = org.rngGate;
    velGate = org.velGate;
-
-   for (unsigned int i = 0; i < MAX_REPORTS; i++) {
-      reportNumMatches[i] = org.reportNumMatches[i];
-      for (unsigned int j = 0; j < MAX_TRKS; j++) {
-         report2TrackMatch[i][j] = org.report2TrackMatch[i][j];
-      }
-   }
-   for (unsigned int i = 0; i < MAX_TRKS; i++) {
-      trackNumMatches[i] = org.trackNumMatches[i];
-   }
+   gnnAssociation = org.gnnAssociation;
 }
 
 //------------------------------------------------------------------------------
@@ -701,26 +853,26 @@ void AirTrkMgr::copyData(const AirTrkMgr& org, const bool cc)
 //------------------------------------------------------------------------------
 void AirTrkMgr::deleteData()
 {
-   if (report2TrackMatch != nullptr) {
-      for (unsigned int i = 0; i < MAX_REPORTS; i++) {
-         if (report2TrackMatch[i] != nullptr) {
-            delete[] report2TrackMatch[i];
-            report2TrackMatch[i] = nullptr;
-         }
-      }
-      delete[] report2TrackMatch;
-      report2TrackMatch = nullptr;
-   }
-
-   if (reportNumMatches != nullptr) {
-      delete[] reportNumMatches;
-      reportNumMatches = nullptr;
-   }
-
-   if (trackNumMatches != nullptr) {
-      delete[] trackNumMatches;
-      trackNumMatches = nullptr;
-   }
+   if (reportTrack != nullptr)   { delete[] reportTrack;   reportTrack = nullptr; }
+   if (rptFirstPair != nullptr)  { delete[] rptFirstPair;  rptFirstPair = nullptr; }
+   if (clusterNext != nullptr)   { delete[] clusterNext;   clusterNext = nullptr; }
+   if (trackNext != nullptr)     { delete[] trackNext;     trackNext = nullptr; }
+   if (trackCell != nullptr)     { delete[] trackCell;     trackCell = nullptr; }
+   if (trkNumPairs != nullptr)   { delete[] trkNumPairs;   trkNumPairs = nullptr; }
+   if (trackLocal != nullptr)    { delete[] trackLocal;    trackLocal = nullptr; }
+   if (localTrack != nullptr)    { delete[] localTrack;    localTrack = nullptr; }
+   if (clusterParent != nullptr) { delete[] clusterParent; clusterParent = nullptr; }
+   if (hashHead != nullptr)      { delete[] hashHead;      hashHead = nullptr; }
+   if (gated != nullptr)         { delete[] gated;         gated = nullptr; }
+   if (clusterPairs != nullptr)  { delete[] clusterPairs;  clusterPairs = nullptr; }
+   if (lapCost != nullptr)       { delete[] lapCost;       lapCost = nullptr; }
+   if (lapWork != nullptr)       { delete[] lapWork;       lapWork = nullptr; }
+   if (lapIdx != nullptr)        { delete[] lapIdx;        lapIdx = nullptr; }
+   numGated = 0;
+   maxGated = 0;
+   maxClusterPairs = 0;
+   lapCostSize = 0;
+   lapSize = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -783,7 +935,6 @@ void AirTrkMgr::processTrackList(const LCreal dt)
             emissions[nReports] = em;
             newSignal[nReports] = tmp;
             newRdot[nReports] = emissions[nReports]->getRangeRate();
-            reportNumMatches[nReports] = 0;
             tgtPos[nReports] = tgt->getPosition() - ownship->getPosition();
             nReports++;
       }
@@ -799,31 +950,13 @@ void AirTrkMgr::processTrackList(const LCreal dt)
    }
 
    // ---
-   // 3) Match current tracks to new reports (observations)
+   // 3) and 4) Associate the new reports (observations) with the current tracks
    // ---
    lcLock(trkListLock);
-   for (unsigned int it = 0; it < nTrks; it++) {
-      trackNumMatches[it] = 0;
-      const RfTrack* const trk = static_cast<const RfTrack*>(tracks[it]);  // we produce only RfTracks
-      const Player* const tgt = trk->getLastEmission()->getTarget();
-      for (unsigned int ir = 0; ir < nReports; ir++) {
-         if (emissions[ir]->getTarget() == tgt) {
-            // We have a new report for the same target as this track ...
-            report2TrackMatch[ir][it] = true;
-            trackNumMatches[it]++;
-            reportNumMatches[ir]++;
-         }
-         else report2TrackMatch[ir][it] = false;
-      }
-   }
+   if (gnnAssociation) associateByGates(tgtPos, newRdot, nReports);
+   else associateByTarget(emissions, nReports);
    lcUnlock(trkListLock);
 
-   // ---
-   // 4) Apply rules to associate the proper report to track.
-   // ---
-
-   // No Rules -- Just Right
-
    // ---
    // 5) Create inputs for current tracks
    // ---
@@ -835,24 +968,26 @@ void AirTrkMgr::processTrackList(const LCreal dt)
    for (unsigned int it = 0; it < nTrks; it++) {
       u[it].set(0,0,0);
       haveU[it] = false;
-      if (trackNumMatches[it] > 0) {
-         for (unsigned int ir = 0; ir < nReports; ir++) {
-            if (report2TrackMatch[ir][it]) {
-               RfTrack* const trk = static_cast<RfTrack*>(tracks[it]);  // we produce only RfTracks
+   }
+   for (unsigned int ir = 0; ir < nReports; ir++) {
+      // By target, the report updates each of its target's tracks
+      for (int it = reportTrack[ir]; it >= 0; it = (gnnAssociation ? -1 : trackNext[it])) {
+         RfTrack* const trk = static_cast<RfTrack*>(tracks[it]);  // we produce only RfTracks
 
-               // Update the track's signal
-               trk->setSignal(newSignal[ir],emissions[ir]);
+         // Update the track's signal
+         trk->setSignal(newSignal[ir],emissions[ir]);
 
-               // Create a track input vector
-               u[it] = (tgtPos[ir] - trk->getPosition());
+         // The velocity gate uses the track's last observed range rate
+         if (gnnAssociation) trk->setRangeRate(newRdot[ir]);
 
-               // Track age and flags
-               if (!haveU[it]) {
-                  age[it] = trk->getTrackAge();
-                  tracks[it]->resetTrackAge();
-                  haveU[it] = true;
-               }
-            }
+         // Create a track input vector
+         u[it] = (tgtPos[ir] - trk->getPosition());
+
+         // Track age and flags
+         if (!haveU[it]) {
+            age[it] = trk->getTrackAge();
+            tracks[it]->resetTrackAge();
+            haveU[it] = true;
          }
       }
    }
@@ -869,11 +1004,6 @@ void AirTrkMgr::processTrackList(const LCreal dt)
    LCreal d2 = posGate * posGate;    // position gate squared
    lcLock(trkListLock);
    for (unsigned int i = 0; i < nTrks; i++) {
-      // Save X(k)
-      osg::Vec3 tpos = tracks[i]->getPosition();
-      osg::Vec3 tvel = tracks[i]->getVelocity();
-      osg::Vec3 tacc = tracks[i]->getAcceleration();
-
       if (haveU[i]) {
          // Have Input vector U, use ...
          // where B is ...
@@ -887,12 +1017,16 @@ void AirTrkMgr::processTrackList(const LCreal dt)
             b0 = 1.0;
             b1 = 0.0;
          }
+         setFilterInput(i, u[i], b0, b1, b2);
+      }
+   }
 
-         // X(k+1) = A*X(k) + B*U(k)
-         tracks[i]->setPosition(     (tpos*A[0][0] + tvel*A[0][1] + tacc*A[0][2]) + (u[i]*b0) );
-         tracks[i]->setVelocity(     (tpos*A[1][0] + tvel*A[1][1] + tacc*A[1][2]) + (u[i]*b1) );
-         tracks[i]->setAcceleration( (tpos*A[2][0] + tvel*A[2][1] + tacc*A[2][2]) + (u[i]*b2) );
+   // X(k+1) = A*X(k) + B*U(k)
+   predictFilterStates();
+   storeFilterStates();
 
+   for (unsigned int i = 0; i < nTrks; i++) {
+      if (haveU[i]) {
          // Object 1: player, Object 2: Track Data
          if (getLogTrackUpdates()) {
             BEGIN_RECORD_DATA_SAMPLE( getSimulation()->getDataRecorder(), REID_TRACK_DATA )
@@ -907,13 +1041,6 @@ void AirTrkMgr::processTrackList(const LCreal dt)
             evt->unref();
          }
       }
-      else {
-         // Do not have Input vector U, use ...
-         // X(k+1) = A*X(k)
-         tracks[i]->setPosition(     (tpos*A[0][0] + tvel*A[0][1] + tacc*A[0][2]));
-         tracks[i]->setVelocity(     (tpos*A[1][0] + tvel*A[1][1] + tacc*A[1][2]));
-         tracks[i]->setAcceleration( (tpos*A[2][0] + tvel*A[2][1] + tacc*A[2][2]));
-      }
    }
    lcUnlock(trkListLock);
 
@@ -963,7 +1090,7 @@ void AirTrkMgr::processTrackList(const LCreal dt)
    // ---
    lcLock(trkListLock);
    for (unsigned int i = 0; i < nReports; i++) {
-      if ((reportNumMatches[i] == 0) && (nTrks < maxTrks)) {
+      if ((reportTrack[i] < 0) && (nTrks < maxTrks)) {
          // This is a new report, so create a new track for it
          RfTrack* newTrk = new RfTrack();
          newTrk->setTrackID( getNewTrackID() );
@@ -996,6 +1123,368 @@ void AirTrkMgr::processTrackList(const LCreal dt)
    lcUnlock(trkListLock);
 }
 
+//------------------------------------------------------------------------------
+// associateByTarget() -- associates each report with the tracks of its target
+// player (the first track, which is followed by the others in 'trackNext')
+//------------------------------------------------------------------------------
+void AirTrkMgr::associateByTarget(Emission* const* const emissions, const unsigned int nReports)
+{
+   const unsigned int mask = hashSize - 1;
+
+   // Hash the tracks by their target player
+   for (unsigned int h = 0; h < hashSize; h++) {
+      hashHead[h] = -1;
+   }
+   for (int it = static_cast<int>(nTrks) - 1; it >= 0; it--) {
+      const Player* const tgt = trackTarget(tracks[it]);
+      unsigned int h = targetHash(tgt) & mask;
+      while (hashHead[h] >= 0 && trackTarget(tracks[hashHead[h]]) != tgt) {
+         h = (h + 1) & mask;
+      }
+      trackNext[it] = hashHead[h];
+      hashHead[h] = it;
+   }
+
+   // Look up each report's target
+   for (unsigned int ir = 0; ir < nReports; ir++) {
+      const Player* const tgt = emissions[ir]->getTarget();
+      unsigned int h = targetHash(tgt) & mask;
+      while (hashHead[h] >= 0 && trackTarget(tracks[hashHead[h]]) != tgt) {
+         h = (h + 1) & mask;
+      }
+      reportTrack[ir] = hashHead[h];
+   }
+}
+
+//------------------------------------------------------------------------------
+// associateByGates() -- associates the reports with the tracks using the
+// position, range and velocity gates, and a global nearest neighbor assignment
+//------------------------------------------------------------------------------
+void AirTrkMgr::associateByGates(const osg::Vec3* const rptPos, const LCreal* const rptRdot, const unsigned int nReports)
+{
+   const unsigned int mask = hashSize - 1;
+   const LCreal pg2 = posGate * posGate;
+   const LCreal vg2 = velGate * velGate;
+
+   // ---
+   // Bucket the tracks' predicted positions by grid cell
+   // ---
+   for (unsigned int h = 0; h < hashSize; h++) {
+      hashHead[h] = -1;
+   }
+   for (unsigned int it = 0; it < nTrks; it++) {
+      const osg::Vec3& pos = tracks[it]->getPosition();
+      int* const cell = &trackCell[3*it];
+      cell[0] = static_cast<int>( std::floor(pos.x() / posGate) );
+      cell[1] = static_cast<int>( std::floor(pos.y() / posGate) );
+      cell[2] = static_cast<int>( std::floor(pos.z() / posGate) );
+      const unsigned int h = cellHash(cell[0], cell[1], cell[2]) & mask;
+      trackNext[it] = hashHead[h];
+      hashHead[h] = static_cast<int>(it);
+      trkNumPairs[it] = 0;
+   }
+
+   // ---
+   // Gate each report with the tracks in its own and its neighboring cells
+   // ---
+   numGated = 0;
+   for (unsigned int ir = 0; ir < nReports; ir++) {
+      rptFirstPair[ir] = numGated;
+      reportTrack[ir] = -1;
+
+      const osg::Vec3& pos = rptPos[ir];
+      const LCreal rng = pos.length();
+      const int cx = static_cast<int>( std::floor(pos.x() / posGate) );
+      const int cy = static_cast<int>( std::floor(pos.y() / posGate) );
+      const int cz = static_cast<int>( std::floor(pos.z() / posGate) );
+
+      for (int ix = cx - 1; ix <= cx + 1; ix++) {
+         for (int iy = cy - 1; iy <= cy + 1; iy++) {
+            for (int iz = cz - 1; iz <= cz + 1; iz++) {
+               const unsigned int h = cellHash(ix, iy, iz) & mask;
+               for (int it = hashHead[h]; it >= 0; it = trackNext[it]) {
+                  const int* const cell = &trackCell[3*it];
+                  if (cell[0] != ix || cell[1] != iy || cell[2] != iz) continue;
+
+                  const Track* const trk = tracks[it];
+                  const LCreal d2 = (pos - trk->getPosition()).length2();
+                  const LCreal dv = rptRdot[ir] - trk->getRangeRate();
+                  if (d2 <= pg2 && std::fabs(rng - trk->getRange()) <= rngGate && std::fabs(dv) <= velGate) {
+                     addGatedPair(ir, static_cast<unsigned int>(it), d2/pg2 + dv*dv/vg2);
+                  }
+               }
+            }
+         }
+      }
+   }
+   rptFirstPair[nReports] = numGated;
+
+   // ---
+   // Clusters of reports and tracks that are linked by their gates; the root
+   // of a cluster is its lowest node, which is its first report
+   // ---
+   const unsigned int nNodes = nReports + nTrks;
+   for (unsigned int i = 0; i < nNodes; i++) {
+      clusterParent[i] = static_cast<int>(i);
+   }
+   for (unsigned int i = 0; i < numGated; i++) {
+      const int a = findRoot(static_cast<int>(gated[i].rpt));
+      const int b = findRoot(static_cast<int>(nReports + gated[i].trk));
+      if (a < b) clusterParent[b] = a;
+      else if (b < a) clusterParent[a] = b;
+   }
+
+   // ---
+   // Reports that are gated with only one track, which is gated with only
+   // this report, are associated directly; the other reports are listed
+   // with the first report of their cluster.
+   // ---
+   for (int ir = static_cast<int>(nReports) - 1; ir >= 0; ir--) {
+      clusterNext[ir] = -1;
+   }
+   for (int ir = static_cast<int>(nReports) - 1; ir >= 0; ir--) {
+      const unsigned int n = rptFirstPair[ir+1] - rptFirstPair[ir];
+      if (n == 1 && trkNumPairs[gated[rptFirstPair[ir]].trk] == 1) {
+         reportTrack[ir] = static_cast<int>(gated[rptFirstPair[ir]].trk);
+      }
+      else if (n > 0) {
+         const int root = findRoot(ir);
+         if (root != ir) {
+            clusterNext[ir] = clusterNext[root];
+            clusterNext[root] = ir;
+         }
+      }
+   }
+
+   // ---
+   // Solve each of the other clusters
+   // ---
+   for (unsigned int ir = 0; ir < nReports; ir++) {
+      const unsigned int n = rptFirstPair[ir+1] - rptFirstPair[ir];
+      if (reportTrack[ir] < 0 && n > 0 && findRoot(static_cast<int>(ir)) == static_cast<int>(ir)) {
+         solveCluster(ir);
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// addGatedPair() -- adds a gated report/track pair
+//------------------------------------------------------------------------------
+void AirTrkMgr::addGatedPair(const unsigned int ir, const unsigned int it, const LCreal cost)
+{
+   // Grow the array as needed
+   if (numGated >= maxGated) {
+      const unsigned int n = (maxGated > 0 ? maxGated * 2 : 1024);
+      GatedPair* tmp = new GatedPair[n];
+      for (unsigned int i = 0; i < numGated; i++) {
+         tmp[i] = gated[i];
+      }
+      if (gated != nullptr) delete[] gated;
+      gated = tmp;
+      maxGated = n;
+   }
+
+   gated[numGated].rpt = ir;
+   gated[numGated].trk = it;
+   gated[numGated].cost = cost;
+   numGated++;
+   trkNumPairs[it]++;
+}
+
+//------------------------------------------------------------------------------
+// findRoot() -- root node of a cluster (with path halving)
+//------------------------------------------------------------------------------
+int AirTrkMgr::findRoot(int node) const
+{
+   while (clusterParent[node] != node) {
+      clusterParent[node] = clusterParent[clusterParent[node]];
+      node = clusterParent[node];
+   }
+   return node;
+}
+
+//------------------------------------------------------------------------------
+// solveCluster() -- assigns the cluster's reports to its tracks with the
+// lowest total cost (Hungarian method).  Each report has its own 'no track'
+// column, so it may be left unassigned, and start a new track.
+//------------------------------------------------------------------------------
+void AirTrkMgr::solveCluster(const unsigned int firstRpt)
+{
+   // The cluster's reports (rows) and tracks (columns)
+   unsigned int nRows = 0;
+   unsigned int nTrkCols = 0;
+   for (int ir = static_cast<int>(firstRpt); ir >= 0; ir = clusterNext[ir]) {
+      nRows++;
+      for (unsigned int i = rptFirstPair[ir]; i < rptFirstPair[ir+1]; i++) {
+         const unsigned int it = gated[i].trk;
+         if (trackLocal[it] < 0) {
+            trackLocal[it] = static_cast<int>(nTrkCols);
+            localTrack[nTrkCols++] = it;
+         }
+      }
+   }
+   const unsigned int nCols = nTrkCols + nRows;
+
+   // Too large for the Hungarian method
+   if (nRows > MAX_CLUSTER_SIZE || nTrkCols > MAX_CLUSTER_SIZE) {
+      for (unsigned int j = 0; j < nTrkCols; j++) {
+         trackLocal[localTrack[j]] = -1;
+      }
+      greedyCluster(firstRpt);
+      return;
+   }
+
+   // Make sure we have room
+   if (nRows * nCols > lapCostSize) {
+      if (lapCost != nullptr) delete[] lapCost;
+      lapCostSize = nRows * nCols;
+      lapCost = new double[lapCostSize];
+   }
+   if (nCols > lapSize) {
+      if (lapWork != nullptr) delete[] lapWork;
+      if (lapIdx != nullptr) delete[] lapIdx;
+      lapSize = nCols;
+      lapWork = new double[3 * (lapSize + 1)];
+      lapIdx = new int[4 * (lapSize + 1)];
+   }
+   double* const u = &lapWork[0];
+   double* const v = &lapWork[lapSize + 1];
+   double* const minv = &lapWork[2 * (lapSize + 1)];
+   int* const p = &lapIdx[0];
+   int* const way = &lapIdx[lapSize + 1];
+   int* const used = &lapIdx[2 * (lapSize + 1)];
+   int* const rowRpt = &lapIdx[3 * (lapSize + 1)];
+
+   // Cost matrix
+   unsigned int row = 0;
+   for (int ir = static_cast<int>(firstRpt); ir >= 0; ir = clusterNext[ir]) {
+      double* const a = &lapCost[row * nCols];
+      for (unsigned int j = 0; j < nCols; j++) {
+         a[j] = NOT_GATED_COST;
+      }
+      for (unsigned int i = rptFirstPair[ir]; i < rptFirstPair[ir+1]; i++) {
+         a[trackLocal[gated[i].trk]] = gated[i].cost;
+      }
+      a[nTrkCols + row] = NO_TRACK_COST;
+      rowRpt[row++] = ir;
+   }
+
+   // Hungarian method (rows and columns are one-based; p[j] is the row assigned to column j)
+   for (unsigned int j = 0; j <= nCols; j++) {
+      v[j] = 0;
+      p[j] = 0;
+      way[j] = 0;
+   }
+   for (unsigned int i = 0; i <= nRows; i++) {
+      u[i] = 0;
+   }
+   for (unsigned int i = 1; i <= nRows; i++) {
+      p[0] = static_cast<int>(i);
+      unsigned int j0 = 0;
+      for (unsigned int j = 0; j <= nCols; j++) {
+         minv[j] = DBL_MAX;
+         used[j] = 0;
+      }
+      do {
+         used[j0] = 1;
+         const unsigned int i0 = static_cast<unsigned int>(p[j0]);
+         const double* const a = &lapCost[(i0 - 1) * nCols];
+         double delta = DBL_MAX;
+         unsigned int j1 = 0;
+         for (unsigned int j = 1; j <= nCols; j++) {
+            if (!used[j]) {
+               const double cur = a[j-1] - u[i0] - v[j];
+               if (cur < minv[j]) { minv[j] = cur; way[j] = static_cast<int>(j0); }
+               if (minv[j] < delta) { delta = minv[j]; j1 = j; }
+            }
+         }
+         for (unsigned int j = 0; j <= nCols; j++) {
+            if (used[j]) { u[p[j]] += delta; v[j] -= delta; }
+            else minv[j] -= delta;
+         }
+         j0 = j1;
+      } while (p[j0] != 0);
+      do {
+         const unsigned int j1 = static_cast<unsigned int>(way[j0]);
+         p[j0] = p[j1];
+         j0 = j1;
+      } while (j0 != 0);
+   }
+
+   // Assigned (and gated) tracks
+   for (unsigned int j = 1; j <= nTrkCols; j++) {
+      if (p[j] > 0 && lapCost[(p[j] - 1) * nCols + (j - 1)] < NOT_GATED_COST) {
+         reportTrack[rowRpt[p[j] - 1]] = static_cast<int>(localTrack[j-1]);
+      }
+   }
+
+   for (unsigned int j = 0; j < nTrkCols; j++) {
+      trackLocal[localTrack[j]] = -1;
+   }
+}
+
+//------------------------------------------------------------------------------
+// greedyCluster() -- assigns the reports of a cluster that's too large for
+// solveCluster() to its tracks, in order of increasing cost.  Every gated
+// cost is less than NO_TRACK_COST, so a report is left unassigned only when
+// all of its gated tracks have been taken.
+//------------------------------------------------------------------------------
+void AirTrkMgr::greedyCluster(const unsigned int firstRpt)
+{
+   // Make sure we have room for the cluster's gated pairs
+   unsigned int n = 0;
+   for (int ir = static_cast<int>(firstRpt); ir >= 0; ir = clusterNext[ir]) {
+      n += rptFirstPair[ir+1] - rptFirstPair[ir];
+   }
+   if (n > maxClusterPairs) {
+      if (clusterPairs != nullptr) delete[] clusterPairs;
+      maxClusterPairs = n;
+      clusterPairs = new unsigned int[maxClusterPairs];
+   }
+
+   // The cluster's gated pairs, by increasing cost
+   n = 0;
+   for (int ir = static_cast<int>(firstRpt); ir >= 0; ir = clusterNext[ir]) {
+      for (unsigned int i = rptFirstPair[ir]; i < rptFirstPair[ir+1]; i++) {
+         clusterPairs[n++] = i;
+      }
+   }
+   const GatedPair* const g = gated;
+   std::sort(clusterPairs, clusterPairs + n,
+      [g](const unsigned int a, const unsigned int b) { return (g[a].cost < g[b].cost) || (g[a].cost == g[b].cost && a < b); } );
+
+   // Take each pair whose report and track are both still free
+   for (unsigned int i = 0; i < n; i++) {
+      const GatedPair& gp = gated[clusterPairs[i]];
+      if (reportTrack[gp.rpt] < 0 && trackLocal[gp.trk] < 0) {
+         reportTrack[gp.rpt] = static_cast<int>(gp.trk);
+         trackLocal[gp.trk] = 0;
+      }
+   }
+
+   for (unsigned int i = 0; i < n; i++) {
+      trackLocal[gated[clusterPairs[i]].trk] = -1;
+   }
+}
+
+//------------------------------------------------------------------------------
+// setGnnAssociation() -- associate reports to tracks using the gates
+//------------------------------------------------------------------------------
+bool AirTrkMgr::setGnnAssociation(const bool b)
+{
+   gnnAssociation = b;
+   return true;
+}
+
+bool AirTrkMgr::setSlotGnnAssociation(const Basic::Number* const num)
+{
+   bool ok = false;
+   if (num != nullptr) {
+      ok = setGnnAssociation( num->getBoolean() );
+   }
+   return ok;
+}
+
 //------------------------------------------------------------------------------
 // setPositionGate() -- Sets the size of the position gate
 //------------------------------------------------------------------------------
@@ -1106,6 +1595,9 @@ std::ostream& AirTrkMgr::serialize(std::ostream& sout, const int i, const bool s
    indent(sout,i+j);
    sout << "velocityGate: " << velGate << std::endl;
 
+   indent(sout,i+j);
+   sout << "gnnAssociation: " << (gnnAssociation ? "true" : "false") << std::endl;
+
    BaseClass::serialize(sout,i+j,true);
 
    if ( !slotsOnly ) {
@@ -1328,24 +1820,24 @@ void GmtiTrkMgr::processTrackList(const LCreal dt)
    // ---
    lcLock(trkListLock);
    for (unsigned int i = 0; i < nTrks; i++) {
-      // Save X(k)
-      const osg::Vec3 tpos = tracks[i]->getPosition();
-      const osg::Vec3 tvel = tracks[i]->getVelocity();
-      const osg::Vec3 tacc = tracks[i]->getAcceleration();
-
       if (haveU[i]) {
          // Have Input vector U, use ...
-         // X(k+1) = A*X(k) + B*U(k)
          // where B is ...
          LCreal b0 = alpha;
          LCreal b1 = 0.0;
          if (age[i] != 0) b1 = beta / age[i];
          LCreal b2 = 0.0;
          //LCreal b2 = gamma * 2.0 / (age[i]*age[i]);
-         tracks[i]->setPosition(     (tpos*A[0][0] + tvel*A[0][1] + tacc*A[0][2]) + (u[i]*b0) );
-         tracks[i]->setVelocity(     (tpos*A[1][0] + tvel*A[1][1] + tacc*A[1][2]) + (u[i]*b1) );
-         tracks[i]->setAcceleration( (tpos*A[2][0] + tvel*A[2][1] + tacc*A[2][2]) + (u[i]*b2) );
+         setFilterInput(i, u[i], b0, b1, b2);
+      }
+   }
+
+   // X(k+1) = A*X(k) + B*U(k)
+   predictFilterStates();
+   storeFilterStates();
 
+   for (unsigned int i = 0; i < nTrks; i++) {
+      if (haveU[i]) {
          if (getLogTrackUpdates()) {
             // Object 1: player, Object 2: Track Data
             BEGIN_RECORD_DATA_SAMPLE( getSimulation()->getDataRecorder(), REID_TRACK_DATA )
@@ -1360,13 +1852,6 @@ void GmtiTrkMgr::processTrackList(const LCreal dt)
             evt->unref();
          }
       }
-      else {
-         // Do not have Input vector U, use ...
-         // X(k+1) = A*X(k)
-         tracks[i]->setPosition(     (tpos*A[0][0] + tvel*A[0][1] + tacc*A[0][2]));
-         tracks[i]->setVelocity(     (tpos*A[1][0] + tvel*A[1][1] + tacc*A[1][2]));
-         tracks[i]->setAcceleration( (tpos*A[2][0] + tvel*A[2][1] + tacc*A[2][2]));
-      }
    }
    lcUnlock(trkListLock);
 
@@ -1653,22 +2138,22 @@ void RwrTrkMgr::processTrackList(const LCreal dt)
    // ---
    lcLock(trkListLock);
    for (unsigned int i = 0; i < nTrks; i++) {
-      // Save X(k)
-      osg::Vec3 tpos = tracks[i]->getPosition();
-      osg::Vec3 tvel = tracks[i]->getVelocity();
-      osg::Vec3 tacc = tracks[i]->getAcceleration();
-
       if (haveU[i]) {
          // Have Input vector U, use ...
-         // X(k+1) = A*X(k) + B*U(k)
          // where B is ...
          LCreal b0 = alpha;
          LCreal b1 = 0.0;
          LCreal b2 = 0.0;
-         tracks[i]->setPosition(     (tpos*A[0][0] + tvel*A[0][1] + tacc*A[0][2]) + (u[i]*b0) );
-         tracks[i]->setVelocity(     (tpos*A[1][0] + tvel*A[1][1] + tacc*A[1][2]) + (u[i]*b1) );
-         tracks[i]->setAcceleration( (tpos*A[2][0] + tvel*A[2][1] + tacc*A[2][2]) + (u[i]*b2) );
+         setFilterInput(i, u[i], b0, b1, b2);
+      }
+   }
+
+   // X(k+1) = A*X(k) + B*U(k)
+   predictFilterStates();
+   storeFilterStates();
 
+   for (unsigned int i = 0; i < nTrks; i++) {
+      if (haveU[i]) {
          if (getLogTrackUpdates()) {
             BEGIN_RECORD_DATA_SAMPLE( getSimulation()->getDataRecorder(), REID_TRACK_DATA )
                SAMPLE_2_OBJECTS( ownship, tracks[i] )
@@ -1682,13 +2167,6 @@ void RwrTrkMgr::processTrackList(const LCreal dt)
             evt->unref();
          }
       }
-      else {
-         // Do not have Input vector U, use ...
-         // X(k+1) = A*X(k)
-         tracks[i]->setPosition(     (tpos*A[0][0] + tvel*A[0][1] + tacc*A[0][2]));
-         tracks[i]->setVelocity(     (tpos*A[1][0] + tvel*A[1][1] + tacc*A[1][2]));
-         tracks[i]->setAcceleration( (tpos*A[2][0] + tvel*A[2][1] + tacc*A[2][2]));
-      }
    }
    lcUnlock(trkListLock);
 
@@ -7,6 +7,7 @@
 
 #include "openeaagles/terrain/DataFile.h"
 #include "openeaagles/basic/NetHandler.h"   // for byte-swapping only
+#include "openeaagles/basic/Nav.h"
 #include "openeaagles/basic/units/Angles.h"
 #include "openeaagles/basic/units/Distances.h"
 
@@ -31,6 +32,13 @@ DataFile::DataFile()
    nptlat = 0;
    nptlong = 0;
    voidValue = -32767; // default void (missing) elevation value
+
+   for (unsigned int k = 0; k < MAX_LEVELS; k++) {
+      levels[k] = nullptr;
+      levelCols[k] = 0;
+      levelRows[k] = 0;
+   }
+   numLevels = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -44,6 +52,10 @@ void DataFile::copyData(const DataFile& org, const bool cc)
       columns = nullptr;
       nptlat = 0;
       nptlong = 0;
+      for (unsigned int k = 0; k < MAX_LEVELS; k++) {
+         levels[k] = nullptr;
+      }
+      numLevels = 0;
    }
 
    voidValue = org.voidValue;
@@ -72,6 +84,11 @@ void DataFile::copyData(const DataFile& org, const bool cc)
 
    } // end columns check
 
+   // Rebuild the max elevation pyramid
+   clearMaxPyramid();
+   if (org.numLevels > 0) {
+      buildMaxPyramid();
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -82,6 +99,18 @@ void DataFile::deleteData()
     clearData();
 }
 
+//------------------------------------------------------------------------------
+// reset() -- loads the data (see Basic::Terrain) and builds the pyramid
+//------------------------------------------------------------------------------
+void DataFile::reset()
+{
+   BaseClass::reset();
+
+   if (isDataLoaded() && numLevels == 0) {
+      buildMaxPyramid();
+   }
+}
+
 //------------------------------------------------------------------------------
 // Access functions
 //------------------------------------------------------------------------------
@@ -142,6 +171,51 @@ bool DataFile::isDataLoaded() const
 }
 
 
+//------------------------------------------------------------------------------
+// Returns the maximum elevation (meters) of the posts within the block of
+// columns [ icol0 ... icol1 ] and rows [ irow0 ... irow1 ].  Uses the lowest
+// pyramid level where the block is covered by, at most, 2 by 2 cells.
+//------------------------------------------------------------------------------
+bool DataFile::getMaxElevationInBlock(
+      short* const maxElev,
+      const unsigned int icol0,
+      const unsigned int irow0,
+      const unsigned int icol1,
+      const unsigned int irow1
+   ) const
+{
+   if (maxElev == nullptr || numLevels == 0) return false;
+
+   // Clip the block
+   unsigned int c1 = icol1;
+   unsigned int r1 = irow1;
+   if (c1 >= nptlong) c1 = nptlong - 1;
+   if (r1 >= nptlat) r1 = nptlat - 1;
+   if (icol0 > c1 || irow0 > r1) return false;
+
+   // Find the level
+   unsigned int k = 0;
+   while ( k < (numLevels-1) && ( ((c1 >> k) - (icol0 >> k)) > 1 || ((r1 >> k) - (irow0 >> k)) > 1 ) ) {
+      k++;
+   }
+
+   // Max of the (up to) 2 by 2 cells
+   const unsigned int cc0 = (icol0 >> k);
+   const unsigned int cc1 = (c1 >> k);
+   const unsigned int rr0 = (irow0 >> k);
+   const unsigned int rr1 = (r1 >> k);
+   short value = -32768;
+   for (unsigned int c = cc0; c <= cc1; c++) {
+      const short* const p = (k == 0) ? columns[c] : &levels[k][c * levelRows[k]];
+      for (unsigned int r = rr0; r <= rr1; r++) {
+         if (p[r] > value) value = p[r];
+      }
+   }
+
+   *maxElev = value;
+   return true;
+}
+
 //------------------------------------------------------------------------------
 // Locates an array of (at least two) elevation points (and sets valid flags if found)
 // returns the number of points found within this DataFile
@@ -343,6 +417,129 @@ bool DataFile::getElevation(
    return true;
 }
 
+//------------------------------------------------------------------------------
+// Locates the elevations of an array of 'n' points (and sets the valid flags
+// of the points found).  Points whose valid flags are already set are skipped.
+// Returns the number of points found within this DataFile.  Same results as
+// calling getElevation() for each point.
+//------------------------------------------------------------------------------
+unsigned int DataFile::getPointElevations(
+      LCreal* const elevations,     // The elevation array (meters)
+      bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+      const double* const lats,     // Latitude array (degs)
+      const double* const lons,     // Longitude array (degs)
+      const unsigned int n,         // Size of the arrays
+      const bool interp             // Interpolate between elevation posts (if true)
+   ) const
+{
+   unsigned int num = 0;
+
+   // Early out tests
+   if ( elevations == nullptr || validFlags == nullptr ||
+        lats == nullptr || lons == nullptr || !isDataLoaded() ) return num;
+
+   const double latSW = getLatitudeSW();
+   const double lonSW = getLongitudeSW();
+   const double latNE = getLatitudeNE();
+   const double lonNE = getLongitudeNE();
+
+   // Block arrays
+   unsigned int idx[BLOCK_POINTS];     // Index of the point
+   unsigned int irow[BLOCK_POINTS];    // Post row (south-west post if interpolating)
+   unsigned int icol[BLOCK_POINTS];    // Post column (south-west post if interpolating)
+   LCreal dLat[BLOCK_POINTS];          // Delta from the south-west post (interpolating)
+   LCreal dLon[BLOCK_POINTS];
+   LCreal elevSW[BLOCK_POINTS];        // Posts
+   LCreal elevNW[BLOCK_POINTS];
+   LCreal elevSE[BLOCK_POINTS];
+   LCreal elevNE[BLOCK_POINTS];
+
+   for (unsigned int base = 0; base < n; base += BLOCK_POINTS) {
+      const unsigned int m = ((n - base) < BLOCK_POINTS) ? (n - base) : BLOCK_POINTS;
+
+      // Select the points within our data that haven't been found
+      unsigned int k = 0;
+      for (unsigned int j = 0; j < m; j++) {
+         const unsigned int i = base + j;
+         if ( !validFlags[i] &&
+              (lats[i] >= latSW && lats[i] <= latNE) &&
+              (lons[i] >= lonSW && lons[i] <= lonNE) ) {
+            idx[k++] = i;
+         }
+      }
+      if (k == 0) continue;
+
+      if (interp) {
+         // Post indexes and the deltas from the south-west posts
+         for (unsigned int q = 0; q < k; q++) {
+            const unsigned int i = idx[q];
+            double pointsLat = (lats[i] - latSW) / latSpacing;
+            if (pointsLat < 0) pointsLat = 0;
+            double pointsLon = (lons[i] - lonSW) / lonSpacing;
+            if (pointsLon < 0) pointsLon = 0;
+
+            unsigned int r = static_cast<unsigned int>(pointsLat);
+            unsigned int c = static_cast<unsigned int>(pointsLon);
+            if (r > (nptlat-2)) r = (nptlat-2);
+            if (c > (nptlong-2)) c = (nptlong-2);
+            irow[q] = r;
+            icol[q] = c;
+            dLat[q] = static_cast<LCreal>(pointsLat - static_cast<double>(r));
+            dLon[q] = static_cast<LCreal>(pointsLon - static_cast<double>(c));
+         }
+
+         // Look up the corner posts
+         for (unsigned int q = 0; q < k; q++) {
+            const short* const west = columns[icol[q]];
+            const short* const east = columns[icol[q]+1];
+            const unsigned int r = irow[q];
+            elevSW[q] = static_cast<LCreal>(west[r]);
+            elevNW[q] = static_cast<LCreal>(west[r+1]);
+            elevSE[q] = static_cast<LCreal>(east[r]);
+            elevNE[q] = static_cast<LCreal>(east[r+1]);
+         }
+
+         // Interpolate (see getElevation())
+         for (unsigned int q = 0; q < k; q++) {
+            const LCreal westPoint = elevSW[q] + (elevNW[q] - elevSW[q]) * dLat[q];
+            const LCreal eastPoint = elevSE[q] + (elevNE[q] - elevSE[q]) * dLat[q];
+            elevSW[q] = westPoint + (eastPoint - westPoint) * dLon[q];
+         }
+      }
+
+      else {
+         // Nearest post
+         for (unsigned int q = 0; q < k; q++) {
+            const unsigned int i = idx[q];
+            double pointsLat = (lats[i] - latSW) / latSpacing;
+            if (pointsLat < 0) pointsLat = 0;
+            double pointsLon = (lons[i] - lonSW) / lonSpacing;
+            if (pointsLon < 0) pointsLon = 0;
+
+            unsigned int r = static_cast<unsigned int>(pointsLat + 0.5f);
+            unsigned int c = static_cast<unsigned int>(pointsLon + 0.5f);
+            if (r >= nptlat) r = (nptlat-1);
+            if (c >= nptlong) c = (nptlong-1);
+            irow[q] = r;
+            icol[q] = c;
+         }
+
+         for (unsigned int q = 0; q < k; q++) {
+            elevSW[q] = static_cast<LCreal>(columns[icol[q]][irow[q]]);
+         }
+      }
+
+      // Pass the elevation values and valid flags to the user's arrays
+      for (unsigned int q = 0; q < k; q++) {
+         elevations[idx[q]] = elevSW[q];
+         validFlags[idx[q]] = true;
+      }
+      num += k;
+   }
+
+   return num;
+}
+
 //------------------------------------------------------------------------------
 // Computes the nearest row index for the latitude (degs).
 // Returns true if the index is valid
@@ -427,11 +624,275 @@ bool DataFile::computeLongitude(double* const lon, const unsigned int icol) cons
    return true;
 }
 
+//------------------------------------------------------------------------------
+// Compute target occulting using the max elevation pyramid
+//------------------------------------------------------------------------------
+bool DataFile::computeOcculting(
+      const double refLat,    // Ref latitude (degs)
+      const double refLon,    // Ref longitude (degs)
+      const LCreal refAlt,    // Ref altitude (meters)
+      const double tgtLat,    // Target latitude (degs)
+      const double tgtLon,    // Target longitude (degs)
+      const LCreal tgtAlt     // Target altitude (meters)
+   ) const
+{
+   // No pyramid; sample every point
+   if (numLevels == 0) {
+      return BaseClass::computeOcculting(refLat, refLon, refAlt, tgtLat, tgtLon, tgtAlt);
+   }
+
+   bool occulted = false;
+
+   // Compute bearing and distance to target (flat earth)
+   double brgDeg = 0.0;
+   double distNM = 0.0;
+   Basic::Nav::fll2bd(refLat, refLon, tgtLat, tgtLon, &brgDeg, &distNM);
+   const double dist = (distNM * Basic::Distance::NM2M);
+   const LCreal range = static_cast<LCreal>(dist);
+
+   // Number of points (default: 100M data)
+   const unsigned int numPts = getNumLosPoints(dist);
+
+   if (numPts > 1 && range > 0) {
+      // Tangent of the angle to the target point (see Basic::Terrain::occultCheck())
+      const LCreal tgtTan = (tgtAlt - refAlt) / range;
+      occulted = occultingRay(refLat, refLon, static_cast<LCreal>(brgDeg), range, numPts, refAlt, tgtTan);
+   }
+
+   return occulted;
+}
+
+//------------------------------------------------------------------------------
+// Compute target occulting #2 using the max elevation pyramid
+//------------------------------------------------------------------------------
+bool DataFile::computeOcculting2(
+      const double refLat,    // Ref latitude (degs)
+      const double refLon,    // Ref longitude (degs)
+      const double refAlt,    // Ref altitude (meters)
+      const double truBrg,    // True direction angle from north to look (degs)
+      const double dist,      // Distance to check (meters)
+      const double tanLookAng // Tangent of the look angle
+   ) const
+{
+   // No pyramid; sample every point
+   if (numLevels == 0) {
+      return BaseClass::computeOcculting2(refLat, refLon, refAlt, truBrg, dist, tanLookAng);
+   }
+
+   bool occulted = false;
+
+   // Number of points (default: 100M data)
+   const unsigned int numPts = getNumLosPoints(dist);
+
+   if (numPts > 1 && dist > 0) {
+      occulted = occultingRay(refLat, refLon, static_cast<LCreal>(truBrg), static_cast<LCreal>(dist),
+                              numPts, refAlt, tanLookAng);
+   }
+
+   return occulted;
+}
+
+//------------------------------------------------------------------------------
+// Returns true if the tangent of the angle to any of the 'n' points along the
+// ray (same points as getElevations()), as seen from the ref altitude, is
+// greater than or equal to 'tanLimit'.  The first and last points are not
+// checked (see Basic::Terrain::occultCheck()).
+//------------------------------------------------------------------------------
+bool DataFile::occultingRay(
+      const double lat,             // Starting latitude (degs)
+      const double lon,             // Starting longitude (degs)
+      const LCreal direction,       // True direction (heading) angle of the data (degs)
+      const LCreal maxRng,          // Range to last elevation point (meters)
+      const unsigned int n,         // Number of points
+      const double refAlt,          // Ref altitude (meters)
+      const double tanLimit         // Tangent limit
+   ) const
+{
+   // Early out tests (see getElevations())
+   if ( n < 3 ||                       // there are no points to check, or
+        n > MAX_LOS_POINTS ||          // there are too many points, or
+        (lat < -89.0 || lat > 89.0) || // we're starting at the north or south poles, or
+        maxRng <= 0                    // the max range is less than or equal to zero
+      ) return false;
+
+   // Starting points
+   double pointsLat = (lat - getLatitudeSW()) / latSpacing;
+   double pointsLon = (lon - getLongitudeSW()) / lonSpacing;
+
+   // Spacing between points (in each direction)
+   double deltaPoint = maxRng / (n - 1);
+   double dirR = direction * Basic::Angle::D2RCC;
+   double deltaNorth = deltaPoint * std::cos(dirR) * Basic::Distance::M2NM;  // (NM)
+   double deltaEast  = deltaPoint * std::sin(dirR) * Basic::Distance::M2NM;
+   double deltaLat = deltaNorth/60.0;
+   double deltaLon = deltaEast/(60.0 * std::cos(lat * Basic::Angle::D2RCC));
+   double deltaPointsLat = deltaLat / latSpacing;
+   double deltaPointsLon = deltaLon / lonSpacing;
+
+   // Range between points (see Basic::Terrain::occultCheck())
+   const double deltaRng = (maxRng / (n - 1));
+
+   // Locations of (and ranges to) all points; stepped the same way as
+   // getElevations() and occultCheck() so that we'll sample the same posts.
+   double lats[MAX_LOS_POINTS];
+   double lons[MAX_LOS_POINTS];
+   double ranges[MAX_LOS_POINTS];
+   double currentRange = 0;
+   for (unsigned int i = 0; i < n; i++) {
+      lats[i] = pointsLat;
+      lons[i] = pointsLon;
+      ranges[i] = currentRange;
+      pointsLat += deltaPointsLat;
+      pointsLon += deltaPointsLon;
+      currentRange += deltaRng;
+   }
+
+   LosRay ray;
+   ray.pointsLat = lats;
+   ray.pointsLon = lons;
+   ray.ranges = ranges;
+   ray.refAlt = refAlt;
+   ray.tanLimit = tanLimit;
+
+   return occultingSection(ray, 1, n-2);
+}
+
+//------------------------------------------------------------------------------
+// Checks the points [ i0 ... i1 ] of the ray: skips the whole section if the
+// maximum elevation under it is below the tangent limit, otherwise splits it
+// in half, and samples the posts of the small sections.
+//------------------------------------------------------------------------------
+bool DataFile::occultingSection(const LosRay& ray, const unsigned int i0, const unsigned int i1) const
+{
+   // Upper limit points
+   const double maxLatPoint = static_cast<double>(nptlat-1);
+   const double maxLonPoint = static_cast<double>(nptlong-1);
+
+   // The points are in order along the ray, so the end points bound the section
+   double loLat = ray.pointsLat[i0];
+   double hiLat = ray.pointsLat[i1];
+   if (loLat > hiLat) { const double t = loLat; loLat = hiLat; hiLat = t; }
+   double loLon = ray.pointsLon[i0];
+   double hiLon = ray.pointsLon[i1];
+   if (loLon > hiLon) { const double t = loLon; loLon = hiLon; hiLon = t; }
+
+   // Section is off of our data
+   if (hiLat < 0 || loLat > maxLatPoint || hiLon < 0 || loLon > maxLonPoint) return false;
+
+   // Small section -- sample the nearest posts (see getElevations() and Basic::Terrain::occultCheck())
+   if ((i1 - i0) < LEAF_POINTS) {
+      for (unsigned int i = i0; i <= i1; i++) {
+         const double pLat = ray.pointsLat[i];
+         const double pLon = ray.pointsLon[i];
+         if ( (pLat >= 0 && pLat <= maxLatPoint) && (pLon >= 0 && pLon <= maxLonPoint) ) {
+            unsigned int irow = static_cast<unsigned int>(pLat + 0.5);
+            unsigned int icol = static_cast<unsigned int>(pLon + 0.5);
+            if (irow >= nptlat) irow = (nptlat-1);
+            if (icol >= nptlong) icol = (nptlong-1);
+            const LCreal value = static_cast<LCreal>(columns[icol][irow]);
+            const double tstTan = (value - ray.refAlt) / ray.ranges[i];
+            if (tstTan >= ray.tanLimit) return true;
+         }
+      }
+      return false;
+   }
+
+   // Block of posts that are nearest to the section's points
+   const unsigned int irow0 = (loLat <= 0) ? 0 : static_cast<unsigned int>(loLat + 0.5);
+   const unsigned int irow1 = static_cast<unsigned int>(((hiLat < maxLatPoint) ? hiLat : maxLatPoint) + 0.5);
+   const unsigned int icol0 = (loLon <= 0) ? 0 : static_cast<unsigned int>(loLon + 0.5);
+   const unsigned int icol1 = static_cast<unsigned int>(((hiLon < maxLonPoint) ? hiLon : maxLonPoint) + 0.5);
+
+   // Skip the section if the tangent to its max elevation, at its
+   // nearest (or farthest, if below us) point, is below the limit.
+   short maxElev = 0;
+   if (getMaxElevationInBlock(&maxElev, icol0, irow0, icol1, irow1)) {
+      const double dz = static_cast<LCreal>(maxElev) - ray.refAlt;
+      const double tstTan = (dz >= 0) ? (dz / ray.ranges[i0]) : (dz / ray.ranges[i1]);
+      if (tstTan < ray.tanLimit) return false;
+   }
+
+   // Check each half
+   const unsigned int mid = i0 + (i1 - i0) / 2;
+   return occultingSection(ray, i0, mid) || occultingSection(ray, mid + 1, i1);
+}
+
+//------------------------------------------------------------------------------
+// Builds (or rebuilds) the max elevation pyramid from the elevation data
+//------------------------------------------------------------------------------
+bool DataFile::buildMaxPyramid()
+{
+   clearMaxPyramid();
+
+   if (!isDataLoaded() || nptlat == 0 || nptlong == 0) return false;
+   for (unsigned int i = 0; i < nptlong; i++) {
+      if (columns[i] == nullptr) return false;
+   }
+
+   // Level zero is the elevation data
+   levelCols[0] = nptlong;
+   levelRows[0] = nptlat;
+   unsigned int k = 1;
+
+   // Each level is the max of the 2 by 2 cells of the level below it
+   while (k < MAX_LEVELS && (levelCols[k-1] > 1 || levelRows[k-1] > 1)) {
+      const unsigned int pcols = levelCols[k-1];
+      const unsigned int prows = levelRows[k-1];
+      const unsigned int ncols = (pcols + 1) / 2;
+      const unsigned int nrows = (prows + 1) / 2;
+      short* const level = new short[ncols * nrows];
+
+      for (unsigned int c = 0; c < ncols; c++) {
+         const unsigned int c0 = 2 * c;
+         const unsigned int c1 = ((c0 + 1) < pcols) ? (c0 + 1) : c0;
+         const short* const p0 = (k == 1) ? columns[c0] : &levels[k-1][c0 * prows];
+         const short* const p1 = (k == 1) ? columns[c1] : &levels[k-1][c1 * prows];
+         short* const q = &level[c * nrows];
+         for (unsigned int r = 0; r < nrows; r++) {
+            const unsigned int r0 = 2 * r;
+            const unsigned int r1 = ((r0 + 1) < prows) ? (r0 + 1) : r0;
+            short v = p0[r0];
+            if (p0[r1] > v) v = p0[r1];
+            if (p1[r0] > v) v = p1[r0];
+            if (p1[r1] > v) v = p1[r1];
+            q[r] = v;
+         }
+      }
+
+      levels[k] = level;
+      levelCols[k] = ncols;
+      levelRows[k] = nrows;
+      k++;
+   }
+
+   numLevels = k;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Deletes the max elevation pyramid
+//------------------------------------------------------------------------------
+void DataFile::clearMaxPyramid()
+{
+   for (unsigned int k = 0; k < MAX_LEVELS; k++) {
+      if (levels[k] != nullptr) {
+         delete[] levels[k];
+         levels[k] = nullptr;
+      }
+      levelCols[k] = 0;
+      levelRows[k] = 0;
+   }
+   numLevels = 0;
+}
+
 //------------------------------------------------------------------------------
 // clear our data
 //------------------------------------------------------------------------------
 void DataFile::clearData()
 {
+   // Delete the max elevation pyramid
+   clearMaxPyramid();
+
    // Delete the columns of data
    if (columns != nullptr) {
       // Delete the columns of data
@@ -6,6 +6,7 @@
 #include "openeaagles/basic/Object.h"
 
 #include "openeaagles/terrain/QuadMap.h"
+#include "openeaagles/terrain/TileMap.h"
 #include "openeaagles/terrain/ded/DedFile.h"
 #include "openeaagles/terrain/dted/DtedFile.h"
 #include "openeaagles/terrain/srtm/SrtmHgtFile.h"
@@ -25,6 +26,9 @@ Basic::Object* Factory::createObj(const char* name)
     if ( std::strcmp(name, QuadMap::getFactoryName()) == 0 ) {
         obj = new QuadMap();
     }
+    else if ( std::strcmp(name, TileMap::getFactoryName()) == 0 ) {
+        obj = new TileMap();
+    }
     else if ( std::strcmp(name, DedFile::getFactoryName()) == 0 ) {
         obj = new DedFile();
     }
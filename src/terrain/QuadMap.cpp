@@ -158,6 +158,101 @@ bool QuadMap::getElevation(
 }
 
 
+//------------------------------------------------------------------------------
+// Locates the elevations of an array of 'n' points (and sets the valid flags
+// of the points found); returns the number of points found within this QuadMap
+//------------------------------------------------------------------------------
+unsigned int QuadMap::getPointElevations(
+      LCreal* const elevations,     // The elevation array (meters)
+      bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+      const double* const lats,     // Latitude array (degs)
+      const double* const lons,     // Longitude array (degs)
+      const unsigned int n,         // Size of the arrays
+      const bool interp             // Interpolate between elevation posts (if true)
+   ) const
+{
+   unsigned int num = 0;
+
+   // Early out tests
+   if ( elevations == nullptr || validFlags == nullptr || lats == nullptr || lons == nullptr ) return num;
+
+   for (unsigned int i = 0; i < numDataFiles && num < n; i++) {
+      num += dataFiles[i]->getPointElevations(elevations, validFlags, lats, lons, n, interp);
+   }
+
+   return num;
+}
+
+//------------------------------------------------------------------------------
+// Compute target occulting: occulted if the terrain of any data file occults,
+// or, with overlapping data files, if the first file's terrain occults (Note 1)
+//------------------------------------------------------------------------------
+bool QuadMap::computeOcculting(
+      const double refLat,    // Ref latitude (degs)
+      const double refLon,    // Ref longitude (degs)
+      const LCreal refAlt,    // Ref altitude (meters)
+      const double tgtLat,    // Target latitude (degs)
+      const double tgtLon,    // Target longitude (degs)
+      const LCreal tgtAlt     // Target altitude (meters)
+   ) const
+{
+   if (haveOverlappingFiles()) {
+      return BaseClass::computeOcculting(refLat, refLon, refAlt, tgtLat, tgtLon, tgtAlt);
+   }
+
+   bool occulted = false;
+   for (unsigned int i = 0; i < numDataFiles && !occulted; i++) {
+      occulted = dataFiles[i]->computeOcculting(refLat, refLon, refAlt, tgtLat, tgtLon, tgtAlt);
+   }
+   return occulted;
+}
+
+//------------------------------------------------------------------------------
+// Compute target occulting #2: occulted if the terrain of any data file occults,
+// or, with overlapping data files, if the first file's terrain occults (Note 1)
+//------------------------------------------------------------------------------
+bool QuadMap::computeOcculting2(
+      const double refLat,    // Ref latitude (degs)
+      const double refLon,    // Ref longitude (degs)
+      const double refAlt,    // Ref altitude (meters)
+      const double truBrg,    // True direction angle from north to look (degs)
+      const double dist,      // Distance to check (meters)
+      const double tanLookAng // Tangent of the look angle
+   ) const
+{
+   if (haveOverlappingFiles()) {
+      return BaseClass::computeOcculting2(refLat, refLon, refAlt, truBrg, dist, tanLookAng);
+   }
+
+   bool occulted = false;
+   for (unsigned int i = 0; i < numDataFiles && !occulted; i++) {
+      occulted = dataFiles[i]->computeOcculting2(refLat, refLon, refAlt, truBrg, dist, tanLookAng);
+   }
+   return occulted;
+}
+
+//------------------------------------------------------------------------------
+// Do any of the data files overlap?  Files that only share an edge don't.
+//------------------------------------------------------------------------------
+bool QuadMap::haveOverlappingFiles() const
+{
+   static const double EPS = 1.0e-6;     // degs
+
+   bool overlap = false;
+   for (unsigned int i = 0; i < numDataFiles && !overlap; i++) {
+      for (unsigned int j = i + 1; j < numDataFiles && !overlap; j++) {
+         const Basic::Terrain* const a = dataFiles[i];
+         const Basic::Terrain* const b = dataFiles[j];
+         const double lat0 = (a->getLatitudeSW() > b->getLatitudeSW() ? a->getLatitudeSW() : b->getLatitudeSW());
+         const double lat1 = (a->getLatitudeNE() < b->getLatitudeNE() ? a->getLatitudeNE() : b->getLatitudeNE());
+         const double lon0 = (a->getLongitudeSW() > b->getLongitudeSW() ? a->getLongitudeSW() : b->getLongitudeSW());
+         const double lon1 = (a->getLongitudeNE() < b->getLongitudeNE() ? a->getLongitudeNE() : b->getLongitudeNE());
+         overlap = (lat1 - lat0 > EPS) && (lon1 - lon0 > EPS);
+      }
+   }
+   return overlap;
+}
+
 //------------------------------------------------------------------------------
 // Initializes the channel array
 //------------------------------------------------------------------------------
@@ -0,0 +1,777 @@
+#include "openeaagles/terrain/TileMap.h"
+
+#include "openeaagles/terrain/DataFile.h"
+#include "openeaagles/terrain/dted/DtedFile.h"
+#include "openeaagles/terrain/srtm/SrtmHgtFile.h"
+#include "openeaagles/basic/Nav.h"
+#include "openeaagles/basic/Number.h"
+#include "openeaagles/basic/String.h"
+#include "openeaagles/basic/units/Angles.h"
+#include "openeaagles/basic/units/Distances.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+// Disable all deprecation warnings for now.  Until we fix them,
+// they are quite annoying to see over and over again...
+#if(_MSC_VER>=1400)   // VC8+
+# pragma warning(disable: 4996)
+#endif
+
+namespace Eaagles {
+namespace Terrain {
+
+IMPLEMENT_SUBCLASS(TileMap,"TileMap")
+
+// slot table
+BEGIN_SLOTTABLE(TileMap)
+   "format",      // 1) Tile format: "dted0", "dted1", "dted2" or "srtm"
+   "cacheSize",   // 2) Max memory used by the loaded tiles (megabytes)
+END_SLOTTABLE(TileMap)
+
+// slot map
+BEGIN_SLOT_MAP(TileMap)
+   ON_SLOT(1, setSlotFormat,    Basic::String)
+   ON_SLOT(2, setSlotCacheSize, Basic::Number)
+END_SLOT_MAP()
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+TileMap::TileMap()
+{
+   STANDARD_CONSTRUCTOR()
+
+   format = DTED1;
+   cacheSize = DEFAULT_CACHE_SIZE;
+
+   cells = nullptr;
+   tiles = nullptr;
+   numTiles = 0;
+   maxTiles = 0;
+   memoryUsed = 0;
+   lruCounter = 0;
+   numLoads = 0;
+   numEvictions = 0;
+   tileGeneration = 0;
+   tileLock = 0;
+}
+
+//------------------------------------------------------------------------------
+// copyData() -- copy this object's data; the tiles are not copied
+//------------------------------------------------------------------------------
+void TileMap::copyData(const TileMap& org, const bool cc)
+{
+   if (cc) {
+      cells = nullptr;
+      tiles = nullptr;
+      numTiles = 0;
+      maxTiles = 0;
+      memoryUsed = 0;
+      tileGeneration = 0;
+      tileLock = 0;
+   }
+
+   BaseClass::copyData(org);
+
+   format = org.format;
+   cacheSize = org.cacheSize;
+   lruCounter = 0;
+   numLoads = 0;
+   numEvictions = 0;
+
+   if (org.isDataLoaded()) {
+      loadData();
+   }
+}
+
+//------------------------------------------------------------------------------
+// deleteData() -- delete this object's data
+//------------------------------------------------------------------------------
+void TileMap::deleteData()
+{
+   clearData();
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+
+bool TileMap::setFormat(const Format f)
+{
+   lcLock(tileLock);
+   format = f;
+   lcUnlock(tileLock);
+
+   // The old tiles are no longer valid
+   clearTiles();
+   return true;
+}
+
+bool TileMap::setCacheSize(const unsigned int megabytes)
+{
+   bool ok = false;
+   if (megabytes > 0) {
+      lcLock(tileLock);
+      cacheSize = megabytes;
+      releaseTiles(CELL_UNKNOWN);
+      lcUnlock(tileLock);
+      ok = true;
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+
+bool TileMap::setSlotFormat(const Basic::String* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      if (*msg == "dted0")       ok = setFormat(DTED0);
+      else if (*msg == "dted1")  ok = setFormat(DTED1);
+      else if (*msg == "dted2")  ok = setFormat(DTED2);
+      else if (*msg == "srtm")   ok = setFormat(SRTM);
+      else {
+         std::cerr << "TileMap::setSlotFormat(): invalid format: " << *msg;
+         std::cerr << "; use \"dted0\", \"dted1\", \"dted2\" or \"srtm\"" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool TileMap::setSlotCacheSize(const Basic::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int n = msg->getInt();
+      if (n > 0) {
+         ok = setCacheSize(static_cast<unsigned int>(n));
+      }
+      else {
+         std::cerr << "TileMap::setSlotCacheSize(): invalid cache size; must be greater than zero" << std::endl;
+      }
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Has the data been loaded (i.e., is the cell table ready)
+//------------------------------------------------------------------------------
+bool TileMap::isDataLoaded() const
+{
+   return (cells != nullptr);
+}
+
+//------------------------------------------------------------------------------
+// Load data -- we only set up the cell table; tiles are loaded when needed
+//------------------------------------------------------------------------------
+bool TileMap::loadData()
+{
+   lcLock(tileLock);
+   if (cells == nullptr) {
+      const int n = NUM_CELL_LATS * NUM_CELL_LONS;
+      cells = new int[n];
+      for (int i = 0; i < n; i++) {
+         cells[i] = CELL_UNKNOWN;
+      }
+   }
+   lcUnlock(tileLock);
+
+   setLatitudeSW(-90.0);
+   setLongitudeSW(-180.0);
+   setLatitudeNE(90.0);
+   setLongitudeNE(180.0);
+   setMinElevation(0);
+   setMaxElevation(0);
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Releases all of the loaded tiles, and forgets the missing tiles
+//------------------------------------------------------------------------------
+void TileMap::clearTiles()
+{
+   lcLock(tileLock);
+   for (unsigned int i = 0; i < numTiles; i++) {
+      tiles[i].file->unref();
+      tiles[i].file = nullptr;
+   }
+   numTiles = 0;
+   memoryUsed = 0;
+   tileGeneration++;     // tiles that are being loaded are no longer valid
+   if (cells != nullptr) {
+      const int n = NUM_CELL_LATS * NUM_CELL_LONS;
+      for (int i = 0; i < n; i++) {
+         cells[i] = CELL_UNKNOWN;
+      }
+   }
+   lcUnlock(tileLock);
+}
+
+//------------------------------------------------------------------------------
+// clear our data
+//------------------------------------------------------------------------------
+void TileMap::clearData()
+{
+   BaseClass::clearData();
+
+   clearTiles();
+
+   lcLock(tileLock);
+   if (cells != nullptr) {
+      delete[] cells;
+      cells = nullptr;
+   }
+   if (tiles != nullptr) {
+      delete[] tiles;
+      tiles = nullptr;
+   }
+   maxTiles = 0;
+   lcUnlock(tileLock);
+}
+
+//------------------------------------------------------------------------------
+// Returns the tile's file name, relative to our path, for the one degree
+// cell whose southwest corner is at [ swLat swLon ] (degs)
+//------------------------------------------------------------------------------
+bool TileMap::getTileFilename(char* const buff, const unsigned int size, const int swLat, const int swLon) const
+{
+   if (buff == nullptr || size == 0) return false;
+
+   const char ns = (swLat < 0) ? 's' : 'n';
+   const char ew = (swLon < 0) ? 'w' : 'e';
+   const int alat = std::abs(swLat);
+   const int alon = std::abs(swLon);
+
+   int n = 0;
+   if (format == SRTM) {
+      // N35W118.hgt
+      n = std::snprintf(buff, size, "%c%02d%c%03d.hgt", std::toupper(ns), alat, std::toupper(ew), alon);
+   }
+   else {
+      // w118/n35.dt1
+      int level = 1;
+      if (format == DTED0) level = 0;
+      else if (format == DTED2) level = 2;
+      n = std::snprintf(buff, size, "%c%03d/%c%02d.dt%d", ew, alon, ns, alat, level);
+   }
+
+   return (n > 0 && static_cast<unsigned int>(n) < size);
+}
+
+//------------------------------------------------------------------------------
+// Creates the (not yet loaded) data file object for our format
+//------------------------------------------------------------------------------
+DataFile* TileMap::createTile() const
+{
+   DataFile* p = nullptr;
+   if (format == SRTM) p = new SrtmHgtFile();
+   else p = new DtedFile();
+   return p;
+}
+
+//------------------------------------------------------------------------------
+// Returns the (ref()'d) tile that contains the point, loading it if
+// needed, or zero if there's no tile.
+//------------------------------------------------------------------------------
+const DataFile* TileMap::getTile(const double lat, const double lon) const
+{
+   if (lat < -90.0 || lat > 90.0 || lon < -180.0 || lon > 180.0) return nullptr;
+
+   int ilat = static_cast<int>(std::floor(lat));
+   int ilon = static_cast<int>(std::floor(lon));
+   if (ilat > 89) ilat = 89;
+   if (ilon > 179) ilon = 179;
+
+   return getTileByCell(ilat, ilon);
+}
+
+//------------------------------------------------------------------------------
+// Returns the (ref()'d) tile of the cell [ ilat ilon ] (see getTile())
+//------------------------------------------------------------------------------
+const DataFile* TileMap::getTileByCell(const int ilat, const int ilon) const
+{
+   if (ilat < -90 || ilat > 89 || ilon < -180 || ilon > 179) return nullptr;
+
+   const DataFile* p = nullptr;
+   const int cell = (ilat + 90) * NUM_CELL_LONS + (ilon + 180);
+
+   lcLock(tileLock);
+   while (cells != nullptr) {
+      const int idx = cells[cell];
+      if (idx == CELL_LOADING) {
+         // Another thread is loading this tile; wait for it without holding the lock
+         lcUnlock(tileLock);
+         lcSleep(1);
+         lcLock(tileLock);
+      }
+      else if (idx == CELL_UNKNOWN) {
+         // Mark the cell as loading, and read the tile's file without the lock
+         cells[cell] = CELL_LOADING;
+         const unsigned int gen = tileGeneration;
+         lcUnlock(tileLock);
+         DataFile* const file = readTile(cell);
+         lcLock(tileLock);
+
+         if (cells != nullptr && tileGeneration == gen && cells[cell] == CELL_LOADING) {
+            if (file == nullptr || !addTile(cell, file)) cells[cell] = CELL_MISSING;
+         }
+         else if (file != nullptr) {
+            // The tiles were cleared while we were loading, so look again
+            file->unref();
+         }
+      }
+      else {
+         if (idx >= 0) {
+            Tile* const t = &tiles[idx];
+            t->lastUsed = ++lruCounter;
+            t->file->ref();
+            p = t->file;
+         }
+         break;
+      }
+   }
+   lcUnlock(tileLock);
+
+   return p;
+}
+
+//------------------------------------------------------------------------------
+// Reads the cell's tile file and builds its max elevation pyramid; returns
+// the new data file, or zero if there's no tile.  This is the slow part of a
+// load, so the cache must not be locked.
+//------------------------------------------------------------------------------
+DataFile* TileMap::readTile(const int cell) const
+{
+   const int swLat = (cell / NUM_CELL_LONS) - 90;
+   const int swLon = (cell % NUM_CELL_LONS) - 180;
+
+   char name[64];
+   if (!getTileFilename(name, sizeof(name), swLat, swLon)) return nullptr;
+
+   // Full file name
+   std::string filename;
+   const char* path = getPathname();
+   if (path != nullptr) {
+      filename += path;
+      filename += '/';
+   }
+   filename += name;
+
+   // Quick check that the file exists, so that missing tiles are quiet
+   {
+      std::ifstream in(filename.c_str(), std::ios::binary);
+      if (in.fail()) return nullptr;
+   }
+
+   DataFile* file = createTile();
+   if (file == nullptr) return nullptr;
+
+   Basic::String* fn = new Basic::String(filename.c_str());
+   file->setFilename(fn);
+   fn->unref();
+   file->reset();        // loads the data and builds its max elevation pyramid
+
+   if (!file->isDataLoaded()) {
+      if (isMessageEnabled(MSG_WARNING)) {
+         std::cerr << "TileMap::loadTile(): unable to load tile: " << filename << std::endl;
+      }
+      file->unref();
+      return nullptr;
+   }
+
+   return file;
+}
+
+//------------------------------------------------------------------------------
+// Adds the loaded tile to the cache, and releases the least recently used
+// tiles if we're over our memory limit (the cache must be locked).
+//------------------------------------------------------------------------------
+bool TileMap::addTile(const int cell, DataFile* const file) const
+{
+   // Grow the tile array
+   if (numTiles >= maxTiles) {
+      const unsigned int n = (maxTiles == 0) ? 16 : (maxTiles * 2);
+      Tile* const newTiles = new Tile[n];
+      for (unsigned int i = 0; i < numTiles; i++) {
+         newTiles[i] = tiles[i];
+      }
+      if (tiles != nullptr) delete[] tiles;
+      tiles = newTiles;
+      maxTiles = n;
+   }
+
+   // Add the tile (the data plus about a third more for the pyramid)
+   Tile* const t = &tiles[numTiles];
+   t->file = file;
+   t->cell = cell;
+   t->bytes = static_cast<double>(file->getNumLatPoints()) * file->getNumLonPoints() * sizeof(short) * (4.0 / 3.0);
+   t->lastUsed = ++lruCounter;
+   cells[cell] = static_cast<int>(numTiles);
+   numTiles++;
+   numLoads++;
+   memoryUsed += t->bytes;
+
+   // Min/max elevations of the tiles loaded so far
+   TileMap* const self = const_cast<TileMap*>(this);
+   if (numLoads == 1 || file->getMinElevation() < getMinElevation()) self->setMinElevation(file->getMinElevation());
+   if (numLoads == 1 || file->getMaxElevation() > getMaxElevation()) self->setMaxElevation(file->getMaxElevation());
+
+   // Stay within our memory limit
+   releaseTiles(cell);
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Releases the least recently used tiles, other than the 'keep' cell's tile,
+// until we're under our memory limit (the cache must be locked).
+//------------------------------------------------------------------------------
+void TileMap::releaseTiles(const int keep) const
+{
+   const double limit = static_cast<double>(cacheSize) * 1024.0 * 1024.0;
+
+   while (memoryUsed > limit && numTiles > 0) {
+      // Find the least recently used tile
+      int lru = -1;
+      for (unsigned int i = 0; i < numTiles; i++) {
+         if (tiles[i].cell != keep && (lru < 0 || tiles[i].lastUsed < tiles[lru].lastUsed)) {
+            lru = static_cast<int>(i);
+         }
+      }
+      if (lru < 0) break;
+
+      // Release it; any thread that's still using it holds a reference
+      Tile* const t = &tiles[lru];
+      cells[t->cell] = CELL_UNKNOWN;
+      memoryUsed -= t->bytes;
+      t->file->unref();
+      numEvictions++;
+
+      // Move the last tile into its place
+      numTiles--;
+      if (static_cast<unsigned int>(lru) != numTiles) {
+         *t = tiles[numTiles];
+         cells[t->cell] = lru;
+      }
+      tiles[numTiles].file = nullptr;
+   }
+}
+
+//------------------------------------------------------------------------------
+// Computes the location of the last point of a ray (see DataFile::getElevations())
+//------------------------------------------------------------------------------
+void TileMap::getRayEnd(
+      double* const lat1,
+      double* const lon1,
+      const double lat,
+      const double lon,
+      const double direction,
+      const double maxRng
+   )
+{
+   const double dirR = direction * Basic::Angle::D2RCC;
+   const double north = maxRng * std::cos(dirR) * Basic::Distance::M2NM;  // (NM)
+   const double east  = maxRng * std::sin(dirR) * Basic::Distance::M2NM;
+   *lat1 = lat + north/60.0;
+   *lon1 = lon + east/(60.0 * std::cos(lat * Basic::Angle::D2RCC));
+}
+
+//------------------------------------------------------------------------------
+// Computes the range of cells that contain the box with corners [ lat0 lon0 ]
+// and [ lat1 lon1 ], plus a little extra for the tiles' shared edges
+//------------------------------------------------------------------------------
+void TileMap::getCells(
+      int* const ilat0,
+      int* const ilon0,
+      int* const ilat1,
+      int* const ilon1,
+      const double lat0,
+      const double lon0,
+      const double lat1,
+      const double lon1
+   )
+{
+   static const double EDGE = 1.0e-6;
+   *ilat0 = static_cast<int>(std::floor(((lat0 < lat1) ? lat0 : lat1) - EDGE));
+   *ilat1 = static_cast<int>(std::floor(((lat0 > lat1) ? lat0 : lat1) + EDGE));
+   *ilon0 = static_cast<int>(std::floor(((lon0 < lon1) ? lon0 : lon1) - EDGE));
+   *ilon1 = static_cast<int>(std::floor(((lon0 > lon1) ? lon0 : lon1) + EDGE));
+}
+
+//------------------------------------------------------------------------------
+// Locates an array of (at least two) elevation points (and sets valid flags if found)
+// returns the number of points found within this TileMap
+//------------------------------------------------------------------------------
+unsigned int TileMap::getElevations(
+      LCreal* const elevations,     // The elevation array (meters)
+      bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+      const unsigned int n,         // Size of elevation and valdFlags arrays
+      const double lat,             // Starting latitude (degs)
+      const double lon,             // Starting longitude (degs)
+      const LCreal direction,       // True direction (heading) angle of the data (degs)
+      const LCreal maxRng,          // Range to last elevation point (meters)
+      const bool interp            // Interpolate between elevation posts (if true)
+   ) const
+{
+   unsigned int num = 0;
+
+   // Early out tests
+   if ( elevations == nullptr ||       // The elevation array wasn't provided, or
+        validFlags == nullptr ||       // the valid flag array wasn't provided, or
+        n < 2 ||                       // there are too few points, or
+        (lat < -89.0 || lat > 89.0) || // and we're not starting at the north or south poles
+        maxRng <= 0 ||                 // the max range is less than or equal to zero
+        !isDataLoaded()                // the cell table isn't ready
+      ) return num;
+
+   // Cells under the ray
+   double lat1 = 0;
+   double lon1 = 0;
+   getRayEnd(&lat1, &lon1, lat, lon, direction, maxRng);
+   int ilat0 = 0, ilon0 = 0, ilat1 = 0, ilon1 = 0;
+   getCells(&ilat0, &ilon0, &ilat1, &ilon1, lat, lon, lat1, lon1);
+
+   for (int ilat = ilat0; ilat <= ilat1 && num < n; ilat++) {
+      for (int ilon = ilon0; ilon <= ilon1 && num < n; ilon++) {
+         const DataFile* tile = getTileByCell(ilat, ilon);
+         if (tile != nullptr) {
+            num += tile->getElevations(elevations, validFlags, n, lat, lon, direction, maxRng, interp);
+            tile->unref();
+         }
+      }
+   }
+
+   return num;
+}
+
+//------------------------------------------------------------------------------
+// Locates an elevation value (meters) for a given reference point and returns
+// it in 'elev'.  Function returns true if successful, otherwise 'elev' is unchanged.
+//------------------------------------------------------------------------------
+bool TileMap::getElevation(
+      LCreal* const elev,     // The elevation value (meters)
+      const double lat,       // Reference latitude (degs)
+      const double lon,       // Reference longitude (degs)
+      const bool interp       // Interpolate between elevation posts (if true)
+   ) const
+{
+   bool found = false;
+   const DataFile* tile = getTile(lat, lon);
+   if (tile != nullptr) {
+      found = tile->getElevation(elev, lat, lon, interp);
+      tile->unref();
+   }
+   return found;
+}
+
+//------------------------------------------------------------------------------
+// Locates the elevations of an array of 'n' points (and sets the valid flags
+// of the points found); returns the number of points found within this TileMap.
+// The points are sorted by tile, and each tile is passed all of its points at once.
+//------------------------------------------------------------------------------
+unsigned int TileMap::getPointElevations(
+      LCreal* const elevations,     // The elevation array (meters)
+      bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+      const double* const lats,     // Latitude array (degs)
+      const double* const lons,     // Longitude array (degs)
+      const unsigned int n,         // Size of the arrays
+      const bool interp             // Interpolate between elevation posts (if true)
+   ) const
+{
+   unsigned int num = 0;
+
+   // Early out tests
+   if ( elevations == nullptr || validFlags == nullptr ||
+        lats == nullptr || lons == nullptr || n == 0 || !isDataLoaded() ) return num;
+
+   // Sort keys: cell index (upper 32 bits) and point index (lower 32 bits)
+   unsigned long long* const keys = new unsigned long long[n];
+   unsigned int nk = 0;
+   for (unsigned int i = 0; i < n; i++) {
+      const double lat = lats[i];
+      const double lon = lons[i];
+      if (!validFlags[i] && lat >= -90.0 && lat <= 90.0 && lon >= -180.0 && lon <= 180.0) {
+         int ilat = static_cast<int>(std::floor(lat));
+         int ilon = static_cast<int>(std::floor(lon));
+         if (ilat > 89) ilat = 89;
+         if (ilon > 179) ilon = 179;
+         const unsigned long long cell = static_cast<unsigned long long>((ilat + 90) * NUM_CELL_LONS + (ilon + 180));
+         keys[nk++] = (cell << 32) | i;
+      }
+   }
+   std::sort(keys, keys + nk);
+
+   // Each tile's points
+   double* const tLats = new double[nk > 0 ? nk : 1];
+   double* const tLons = new double[nk > 0 ? nk : 1];
+   LCreal* const tElevs = new LCreal[nk > 0 ? nk : 1];
+   bool* const tValid = new bool[nk > 0 ? nk : 1];
+
+   unsigned int b = 0;
+   while (b < nk) {
+      const unsigned int cell = static_cast<unsigned int>(keys[b] >> 32);
+      unsigned int e = b;
+      while (e < nk && static_cast<unsigned int>(keys[e] >> 32) == cell) {
+         e++;
+      }
+
+      const DataFile* tile = getTileByCell(static_cast<int>(cell / NUM_CELL_LONS) - 90, static_cast<int>(cell % NUM_CELL_LONS) - 180);
+      if (tile != nullptr) {
+         const unsigned int m = e - b;
+         for (unsigned int j = 0; j < m; j++) {
+            const unsigned int i = static_cast<unsigned int>(keys[b + j] & 0xffffffff);
+            tLats[j] = lats[i];
+            tLons[j] = lons[i];
+            tValid[j] = false;
+         }
+
+         tile->getPointElevations(tElevs, tValid, tLats, tLons, m, interp);
+         tile->unref();
+
+         for (unsigned int j = 0; j < m; j++) {
+            if (tValid[j]) {
+               const unsigned int i = static_cast<unsigned int>(keys[b + j] & 0xffffffff);
+               elevations[i] = tElevs[j];
+               validFlags[i] = true;
+               num++;
+            }
+         }
+      }
+      b = e;
+   }
+
+   delete[] tValid;
+   delete[] tElevs;
+   delete[] tLons;
+   delete[] tLats;
+   delete[] keys;
+
+   return num;
+}
+
+//------------------------------------------------------------------------------
+// Compute target occulting: occulted if the terrain of any tile under the ray occults
+//------------------------------------------------------------------------------
+bool TileMap::computeOcculting(
+      const double refLat,    // Ref latitude (degs)
+      const double refLon,    // Ref longitude (degs)
+      const LCreal refAlt,    // Ref altitude (meters)
+      const double tgtLat,    // Target latitude (degs)
+      const double tgtLon,    // Target longitude (degs)
+      const LCreal tgtAlt     // Target altitude (meters)
+   ) const
+{
+   if (!isDataLoaded()) return false;
+
+   // End of the ray (see Basic::Terrain::computeOcculting())
+   double brgDeg = 0.0;
+   double distNM = 0.0;
+   Basic::Nav::fll2bd(refLat, refLon, tgtLat, tgtLon, &brgDeg, &distNM);
+   double lat1 = 0;
+   double lon1 = 0;
+   getRayEnd(&lat1, &lon1, refLat, refLon, brgDeg, distNM * Basic::Distance::NM2M);
+
+   int ilat0 = 0, ilon0 = 0, ilat1 = 0, ilon1 = 0;
+   getCells(&ilat0, &ilon0, &ilat1, &ilon1, refLat, refLon, lat1, lon1);
+
+   bool occulted = false;
+   for (int ilat = ilat0; ilat <= ilat1 && !occulted; ilat++) {
+      for (int ilon = ilon0; ilon <= ilon1 && !occulted; ilon++) {
+         const DataFile* tile = getTileByCell(ilat, ilon);
+         if (tile != nullptr) {
+            occulted = tile->computeOcculting(refLat, refLon, refAlt, tgtLat, tgtLon, tgtAlt);
+            tile->unref();
+         }
+      }
+   }
+   return occulted;
+}
+
+//------------------------------------------------------------------------------
+// Compute target occulting #2: occulted if the terrain of any tile under the ray occults
+//------------------------------------------------------------------------------
+bool TileMap::computeOcculting2(
+      const double refLat,    // Ref latitude (degs)
+      const double refLon,    // Ref longitude (degs)
+      const double refAlt,    // Ref altitude (meters)
+      const double truBrg,    // True direction angle from north to look (degs)
+      const double dist,      // Distance to check (meters)
+      const double tanLookAng // Tangent of the look angle
+   ) const
+{
+   if (!isDataLoaded()) return false;
+
+   double lat1 = 0;
+   double lon1 = 0;
+   getRayEnd(&lat1, &lon1, refLat, refLon, truBrg, dist);
+
+   int ilat0 = 0, ilon0 = 0, ilat1 = 0, ilon1 = 0;
+   getCells(&ilat0, &ilon0, &ilat1, &ilon1, refLat, refLon, lat1, lon1);
+
+   bool occulted = false;
+   for (int ilat = ilat0; ilat <= ilat1 && !occulted; ilat++) {
+      for (int ilon = ilon0; ilon <= ilon1 && !occulted; ilon++) {
+         const DataFile* tile = getTileByCell(ilat, ilon);
+         if (tile != nullptr) {
+            occulted = tile->computeOcculting2(refLat, refLon, refAlt, truBrg, dist, tanLookAng);
+            tile->unref();
+         }
+      }
+   }
+   return occulted;
+}
+
+//------------------------------------------------------------------------------
+// getSlotByIndex()
+//------------------------------------------------------------------------------
+Basic::Object* TileMap::getSlotByIndex(const int si)
+{
+   return BaseClass::getSlotByIndex(si);
+}
+
+//------------------------------------------------------------------------------
+// serialize() --
+//------------------------------------------------------------------------------
+std::ostream& TileMap::serialize(std::ostream& sout, const int i, const bool slotsOnly) const
+{
+   int j = 0;
+   if ( !slotsOnly ) {
+      indent(sout,i);
+      sout << "( " << getFactoryName() << std::endl;
+      j = 4;
+   }
+
+   indent(sout,i+j);
+   sout << "format: ";
+   switch (format) {
+      case DTED0: sout << "\"dted0\""; break;
+      case DTED1: sout << "\"dted1\""; break;
+      case DTED2: sout << "\"dted2\""; break;
+      case SRTM:  sout << "\"srtm\""; break;
+   }
+   sout << std::endl;
+
+   indent(sout,i+j);
+   sout << "cacheSize: " << cacheSize << std::endl;
+
+   BaseClass::serialize(sout,i+j,true);
+
+   if ( !slotsOnly ) {
+      indent(sout,i);
+      sout << ")" << std::endl;
+   }
+
+   return sout;
+}
+
+} // End Terrain namespace
+} // End Eaagles namespace
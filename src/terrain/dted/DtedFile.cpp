@@ -38,6 +38,7 @@
 #include <fstream>
 #include <cstdio>
 #include <cstring>
+#include <vector>
 
 // Disable all deprecation warnings for now.  Until we fix them,
 // they are quite annoying to see over and over again...
@@ -327,6 +328,14 @@ bool DtedFile::readDtedData(std::istream& in)
         columns[i] = new short[nptlat];
     }
 
+    // Buffer for each record's elevation values
+    const std::streamsize recordSize = 2 * static_cast<std::streamsize>(nptlat);
+    std::vector<unsigned char> record(static_cast<std::size_t>(recordSize));
+
+    // Min/max elevations of the whole cell
+    LCreal minElev0 = 99999.0;
+    LCreal maxElev0 = 0.0;
+
     // Read the elevation array.
     for(unsigned int lon=0; lon<nptlong; lon++)
     {
@@ -354,19 +363,17 @@ bool DtedFile::readDtedData(std::istream& in)
         }
 
         // Read elevation values for record
-        LCreal minElev0 = 99999.0;
-        LCreal maxElev0 = 0.0;
-        for(unsigned int lat=0; lat<nptlat; lat++)
+        in.read(reinterpret_cast<char*>(&record[0]), recordSize);
+        if (in.fail() || in.gcount() < recordSize)
         {
-            unsigned char values[2];
-            in.read(reinterpret_cast<char*>(values), sizeof(values));
-            if (in.fail() || in.gcount() < sizeof(values))
-            {
-                if (isMessageEnabled(MSG_ERROR)) {
-                    std::cerr << "DtedFile::readDtedData: error reading data value." << std::endl;
-                }
-                return false;
+            if (isMessageEnabled(MSG_ERROR)) {
+                std::cerr << "DtedFile::readDtedData: error reading data value." << std::endl;
             }
+            return false;
+        }
+        for(unsigned int lat=0; lat<nptlat; lat++)
+        {
+            const unsigned char* values = &record[2*lat];
             checksum += values[0] + values[1];
 
             short height = readValue(values[0], values[1]);
@@ -376,8 +383,6 @@ bool DtedFile::readDtedData(std::istream& in)
             if (height < minElev0) minElev0 = height;
             if (height > maxElev0) maxElev0 = height;
         }
-        setMinElevation(minElev0);
-        setMaxElevation(maxElev0);
 
         // Read data record footer and verify checksum
         dtedColumnFooter foot;
@@ -401,6 +406,8 @@ bool DtedFile::readDtedData(std::istream& in)
            }
         }
     }
+    setMinElevation(minElev0);
+    setMaxElevation(maxElev0);
     return true;
 }
 
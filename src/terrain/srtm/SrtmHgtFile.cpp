@@ -62,6 +62,7 @@
 #include <fstream>
 #include <cstdlib>
 #include <cctype>
+#include <vector>
 
 namespace Eaagles {
 namespace Terrain {
@@ -244,25 +245,31 @@ bool SrtmHgtFile::readSrtmData(std::istream& in)
         columns[i] = new short[nptlat];
     }
 
+    // Buffer for each row's elevation values
+    const std::streamsize rowSize = 2 * static_cast<std::streamsize>(nptlong);
+    std::vector<unsigned char> row(static_cast<std::size_t>(rowSize));
+
+    // Min/max elevations of the whole cell
+    LCreal minElev0 = 99999.0;
+    LCreal maxElev0 = 0.0;
+
     // Read the elevation array.
     for(unsigned int lat=0; lat<nptlat; lat++)
     {
         //unsigned long checksum = 0;
 
         // Read elevation values for record
-        LCreal minElev0 = 99999.0;
-        LCreal maxElev0 = 0.0;
-        for(unsigned int lon=0; lon<nptlong; lon++)
+        in.read(reinterpret_cast<char*>(&row[0]), rowSize);
+        if (in.fail() || in.gcount() < rowSize)
         {
-            unsigned char values[2];
-            in.read(reinterpret_cast<char*>(values), sizeof(values));
-            if (in.fail() || in.gcount() < sizeof(values))
-            {
-                if (isMessageEnabled(MSG_ERROR)) {
-                    std::cerr << "SrtmHgtFile::readSrtmData: error reading data value." << std::endl;
-                }
-                return false;
+            if (isMessageEnabled(MSG_ERROR)) {
+                std::cerr << "SrtmHgtFile::readSrtmData: error reading data value." << std::endl;
             }
+            return false;
+        }
+        for(unsigned int lon=0; lon<nptlong; lon++)
+        {
+            const unsigned char* values = &row[2*lon];
 
             short height  = readValue(values[0], values[1]);
             columns[lon][nptlat-lat-1] = height;
@@ -274,9 +281,9 @@ bool SrtmHgtFile::readSrtmData(std::istream& in)
                 if (height > maxElev0) maxElev0 = height;
             }
         }
-        setMinElevation(minElev0);
-        setMaxElevation(maxElev0);
     }
+    setMinElevation(minElev0);
+    setMaxElevation(maxElev0);
     return true;
 }
 